@@ -0,0 +1,87 @@
+"""YOLO 후처리 시간 비교: Python filter_boxes vs C++ (yolo_post.py, scalar / SIMD)
+
+사용:
+  python3 bench_postprocess.py tensors.bin        # tflite_yolo_picam.py 가 기록한 출력 tensor
+  python3 bench_postprocess.py --synthetic 30     # 기록이 없으면 합성 데이터 (yolov4-tiny 416 크기)
+
+tensor 기록: MISPEDAL_RECORD_TENSORS=tensors.bin python3 tflite_yolo_picam.py
+같은 파일을 team_project 의 yolo_post_bench 로도 잴 수 있다 (C++ 안에서의 시간).
+"""
+import argparse
+import time
+
+import numpy as np
+
+from postprocess import filter_boxes, read_tensors
+from yolo_post import YoloPostprocessor
+
+
+def synthesize(frames, n=2535, c=80, seed=0):
+    rng = np.random.default_rng(seed)
+    out = []
+    for f in range(frames):
+        loc = np.empty((n, 4), dtype=np.float32)
+        loc[:, :2] = rng.random((n, 2)) * 416
+        loc[:, 2:] = 10 + rng.random((n, 2)) * 100
+        cls = (rng.random((n, c)) * 0.05).astype(np.float32)
+        for _ in range(3 + f % 5):
+            idx = rng.integers(0, n, 25)
+            center = 40 + rng.random(2) * 336
+            size = 30 + rng.random(2) * 120
+            loc[idx, :2] = center + (rng.random((25, 2)) - 0.5) * 20
+            loc[idx, 2:] = size * (0.8 + rng.random((25, 2)) * 0.4)
+            cls[idx, rng.integers(0, 10)] = 0.15 + rng.random(25) * 0.8
+        out.append((loc, cls))
+    return out
+
+
+def same(a, b):
+    (ba, sa, ca), (bb, sb, cb) = a, b
+    if len(sa) != len(sb):
+        return False
+    if len(sa) == 0:
+        return True
+    return (np.array_equal(np.asarray(ca, dtype=np.int64), np.asarray(cb, dtype=np.int64))
+            and np.allclose(sa, sb, atol=1e-6) and np.allclose(ba, bb, atol=1e-3))
+
+
+def bench(name, fn, frames, repeat):
+    times = []
+    for _ in range(repeat):
+        for loc, cls in frames:
+            t0 = time.perf_counter_ns()
+            fn(loc, cls)
+            times.append(time.perf_counter_ns() - t0)
+    t = np.array(times) / 1e3
+    return name, np.percentile(t, 50), np.percentile(t, 99), t.mean()
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("tensors", nargs="?")
+    ap.add_argument("--synthetic", type=int, default=30)
+    ap.add_argument("--repeat", type=int, default=3)
+    args = ap.parse_args()
+
+    frames = read_tensors(args.tensors) if args.tensors else synthesize(args.synthetic)
+    n, c = frames[0][1].shape
+    scalar = YoloPostprocessor(n, c, use_simd=False)
+    simd = YoloPostprocessor(n, c)
+
+    # 결과가 같은지 먼저 확인
+    mismatch = sum(not same(filter_boxes(loc, cls), simd.run(loc, cls)) for loc, cls in frames)
+
+    rows = [
+        bench("python", filter_boxes, frames, 1),
+        bench("c++ scalar", scalar.run, frames, args.repeat),
+        bench(f"c++ {simd.simd}", simd.run, frames, args.repeat),
+    ]
+    print(f"{args.tensors or 'synthetic'}: {len(frames)} frames, {n} boxes x {c} classes, mismatch {mismatch}")
+    print(f"{'path':<12}{'p50 us':>12}{'p99 us':>12}{'mean us':>12}{'speedup':>10}")
+    base = rows[0][3]
+    for name, p50, p99, mean in rows:
+        print(f"{name:<12}{p50:>12.1f}{p99:>12.1f}{mean:>12.1f}{base / mean:>9.1f}x")
+
+
+if __name__ == "__main__":
+    main()
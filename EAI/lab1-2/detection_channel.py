@@ -0,0 +1,74 @@
+"""team_project/core/detection_channel 의 Python(ctypes) binding
+
+YOLO 쪽(생산자)에서 검출 이벤트를 shared memory ring 으로 보낸다.
+라이브러리 위치: DETECTION_CHANNEL_LIB 환경변수 → 이 파일과 같은 디렉터리
+→ team_project 아래 build 디렉터리 (가장 최근에 빌드된 것) → 시스템 library 경로 순으로 찾는다.
+"""
+import ctypes
+import ctypes.util
+import glob
+import os
+import time
+
+DET_ACCEL = 1
+DET_BRAKE = 2
+
+_LIB_NAME = "libdetection_channel.so"
+_MODULE_DIR = os.path.dirname(os.path.abspath(__file__))
+_PROJECT_DIR = os.path.normpath(os.path.join(_MODULE_DIR, "../../team_project"))
+
+
+def _find_lib():
+    env = os.environ.get("DETECTION_CHANNEL_LIB")
+    if env:
+        return env
+    candidates = [os.path.join(_MODULE_DIR, _LIB_NAME)]
+    built = glob.glob(os.path.join(_PROJECT_DIR, "*", _LIB_NAME))
+    candidates += sorted(built, key=os.path.getmtime, reverse=True)
+    for path in candidates:
+        if os.path.exists(path):
+            return path
+    found = ctypes.util.find_library("detection_channel")
+    if found:
+        return found
+    raise OSError(f"{_LIB_NAME} not found (build team_project or set DETECTION_CHANNEL_LIB)")
+
+
+class DetectionChannel:
+    def __init__(self, name="/mispedal_detect", lib_path=None):
+        lib_path = lib_path or _find_lib()
+        self._lib = ctypes.CDLL(lib_path)
+
+        self._lib.detection_channel_open.argtypes = [ctypes.c_char_p]
+        self._lib.detection_channel_open.restype = ctypes.c_void_p
+        self._lib.detection_channel_publish.argtypes = [
+            ctypes.c_void_p, ctypes.c_uint32, ctypes.c_uint32, ctypes.c_float,
+            ctypes.c_float, ctypes.c_float, ctypes.c_float, ctypes.c_float,
+            ctypes.c_uint64, ctypes.c_uint64]
+        self._lib.detection_channel_publish.restype = ctypes.c_int
+        self._lib.detection_channel_dropped.argtypes = [ctypes.c_void_p]
+        self._lib.detection_channel_dropped.restype = ctypes.c_uint32
+        self._lib.detection_channel_close.argtypes = [ctypes.c_void_p]
+
+        self._handle = self._lib.detection_channel_open(name.encode())
+        if not self._handle:
+            raise RuntimeError(f"cannot open detection channel {name}")
+
+    def publish(self, cls, label, confidence, box, timestamp_ns=None, infer_ns=0):
+        """box = (ymin, xmin, ymax, xmax)
+        timestamp_ns = 프레임 캡처 시각, infer_ns = 추론 완료 시각 (둘 다 time.monotonic_ns() 기준)
+        """
+        ymin, xmin, ymax, xmax = box
+        if timestamp_ns is None:
+            timestamp_ns = time.monotonic_ns()
+        return bool(self._lib.detection_channel_publish(
+            self._handle, cls, int(label), float(confidence),
+            float(xmin), float(ymin), float(xmax), float(ymax), timestamp_ns, infer_ns))
+
+    def dropped(self):
+        return self._lib.detection_channel_dropped(self._handle)
+
+    def close(self):
+        if self._handle:
+            self._lib.detection_channel_close(self._handle)
+            self._handle = None
@@ -0,0 +1,93 @@
+"""YOLO 출력 후처리 (Python 경로) + 출력 tensor 기록
+
+tflite_yolo_picam.py 에서 옮긴 filter_boxes / nms.
+C++ 경로는 yolo_post.py, 둘의 비교는 bench_postprocess.py.
+"""
+import struct
+
+import numpy as np
+
+SCORE_THRESH = 0.2
+IOU_THRESH = 0.3
+
+TENSOR_MAGIC = 0x544C4F59   # "YOLT", team_project/bench/yolo_post_bench.cpp 와 같은 형식
+
+
+# ===== IoU & NMS =====
+def iou(b1, b2):
+    y1, x1 = max(b1[0], b2[0]), max(b1[1], b2[1])
+    y2, x2 = min(b1[2], b2[2]), min(b1[3], b2[3])
+    inter = max(0, y2 - y1) * max(0, x2 - x1)
+    union = (b1[2]-b1[0])*(b1[3]-b1[1]) + (b2[2]-b2[0])*(b2[3]-b2[1]) - inter
+    return inter / union if union > 0 else 0
+
+def nms(boxes, scores, classes, iou_t=IOU_THRESH):
+    idxs = np.argsort(scores)[::-1]
+    keep = []
+    while idxs.size > 0:
+        i = idxs[0]
+        keep.append(i)
+        ious = np.array([iou(boxes[i], boxes[j]) for j in idxs[1:]])
+        idxs = idxs[1:][~((classes[idxs[1:]] == classes[i]) & (ious > iou_t))]
+    return boxes[keep], scores[keep], classes[keep]
+
+# ===== Box Filtering + NMS =====
+def filter_boxes(box_xywh, scores):
+    boxes, confs, clses = [], [], []
+    for i in range(box_xywh.shape[0]):
+        cls_scores = scores[i]
+        cls_id, score = np.argmax(cls_scores), np.max(cls_scores)
+        if score < SCORE_THRESH: continue
+        cx, cy, w, h = box_xywh[i]
+        xmin, ymin = cx - w/2, cy - h/2
+        xmax, ymax = cx + w/2, cy + h/2
+        boxes.append([ymin, xmin, ymax, xmax])
+        confs.append(score)
+        clses.append(cls_id)
+    if boxes:
+        return nms(np.array(boxes), np.array(confs), np.array(clses))
+    return np.array([]), np.array([]), np.array([])
+
+
+# ===== 출력 tensor 기록 (benchmark 입력) =====
+# header: uint32 magic, int32 frames, num_boxes, num_classes / 프레임마다 loc [N,4], cls [N,C] float32
+class TensorRecorder:
+    def __init__(self, path, max_frames=100):
+        self._fp = open(path, "wb")
+        self._frames = 0
+        self._max = max_frames
+        self._shape = None
+        self._fp.write(struct.pack("<Iiii", TENSOR_MAGIC, 0, 0, 0))
+
+    def add(self, loc, cls):
+        if self._frames >= self._max:
+            return False
+        loc = np.ascontiguousarray(loc, dtype=np.float32).reshape(-1, 4)
+        cls = np.ascontiguousarray(cls, dtype=np.float32).reshape(loc.shape[0], -1)
+        self._shape = (loc.shape[0], cls.shape[1])
+        self._fp.write(loc.tobytes())
+        self._fp.write(cls.tobytes())
+        self._frames += 1
+        return True
+
+    def close(self):
+        if self._fp:
+            n, c = self._shape or (0, 0)
+            self._fp.seek(0)
+            self._fp.write(struct.pack("<Iiii", TENSOR_MAGIC, self._frames, n, c))
+            self._fp.close()
+            self._fp = None
+
+
+def read_tensors(path):
+    """[(loc [N,4], cls [N,C]), ...]"""
+    with open(path, "rb") as fp:
+        magic, frames, n, c = struct.unpack("<Iiii", fp.read(16))
+        if magic != TENSOR_MAGIC:
+            raise ValueError(f"not a tensor file: {path}")
+        out = []
+        for _ in range(frames):
+            loc = np.frombuffer(fp.read(n * 4 * 4), dtype=np.float32).reshape(n, 4)
+            cls = np.frombuffer(fp.read(n * c * 4), dtype=np.float32).reshape(n, c)
+            out.append((loc, cls))
+        return out
@@ -3,13 +3,15 @@ import numpy as np
 import tflite_runtime.interpreter as tflite
 
 import RPi.GPIO as GPIO
+import os
 import time
 
+from detection_channel import DetectionChannel, DET_ACCEL, DET_BRAKE
+from postprocess import filter_boxes, TensorRecorder
+
 
 # ===== Constants =====
 IMG_SIZE = 416
-SCORE_THRESH = 0.2
-IOU_THRESH = 0.3
 
 
 # ACCEL_REGION = {
@@ -51,41 +53,6 @@ def is_in_region(box, region):
     )
 
 
-# ===== IoU & NMS =====
-def iou(b1, b2):
-    y1, x1 = max(b1[0], b2[0]), max(b1[1], b2[1])
-    y2, x2 = min(b1[2], b2[2]), min(b1[3], b2[3])
-    inter = max(0, y2 - y1) * max(0, x2 - x1)
-    union = (b1[2]-b1[0])*(b1[3]-b1[1]) + (b2[2]-b2[0])*(b2[3]-b2[1]) - inter
-    return inter / union if union > 0 else 0
-
-def nms(boxes, scores, classes, iou_t=IOU_THRESH):
-    idxs = np.argsort(scores)[::-1]
-    keep = []
-    while idxs.size > 0:
-        i = idxs[0]
-        keep.append(i)
-        ious = np.array([iou(boxes[i], boxes[j]) for j in idxs[1:]])
-        idxs = idxs[1:][~((classes[idxs[1:]] == classes[i]) & (ious > iou_t))]
-    return boxes[keep], scores[keep], classes[keep]
-
-# ===== Box Filtering + NMS =====
-def filter_boxes(box_xywh, scores):
-    boxes, confs, clses = [], [], []
-    for i in range(box_xywh.shape[0]):
-        cls_scores = scores[i]
-        cls_id, score = np.argmax(cls_scores), np.max(cls_scores)
-        if score < SCORE_THRESH: continue
-        cx, cy, w, h = box_xywh[i]
-        xmin, ymin = cx - w/2, cy - h/2
-        xmax, ymax = cx + w/2, cy + h/2
-        boxes.append([ymin, xmin, ymax, xmax])
-        confs.append(score)
-        clses.append(cls_id)
-    if boxes:
-        return nms(np.array(boxes), np.array(confs), np.array(clses))
-    return np.array([]), np.array([]), np.array([])
-
 # ===== Visualization =====
 def visualize(frame, boxes, scores, classes, labels):
     h, w = frame.shape[:2]
@@ -107,6 +74,18 @@ interpreter = tflite.Interpreter(model_path="yolov4-tiny.tflite")
 interpreter.allocate_tensors()
 inp, out = interpreter.get_input_details(), interpreter.get_output_details()
 
+# 후처리: C++ (SIMD) 가 빌드되어 있으면 사용, 없으면 Python filter_boxes
+try:
+    from yolo_post import YoloPostprocessor
+    post = YoloPostprocessor(int(out[0]['shape'][1]), int(out[1]['shape'][2]))
+    print(f"postprocess: C++ ({post.simd})")
+except (ImportError, OSError) as e:
+    post = None
+    print(f"postprocess: Python ({e})")
+
+# MISPEDAL_RECORD_TENSORS=path: 처음 100 프레임의 출력 tensor 기록 (bench_postprocess.py 입력)
+recorder = TensorRecorder(os.environ["MISPEDAL_RECORD_TENSORS"]) if os.environ.get("MISPEDAL_RECORD_TENSORS") else None
+
 labels = {i: n for i, n in enumerate([
     'person','bicycle','car','motorbike','aeroplane','bus','train','truck','boat','traffic light',
     'fire hydrant','stop sign','parking meter','bench','bird','cat','dog','horse','sheep','cow',
@@ -118,6 +97,9 @@ labels = {i: n for i, n in enumerate([
     'toaster','sink','refrigerator','book','clock','vase','scissors','teddy bear','hair drier','toothbrush'
 ])}
 
+# main.cpp 로 검출 이벤트 전송 (shared memory ring)
+channel = DetectionChannel()
+
 cap = cv2.VideoCapture(0)
 
 if not cap.isOpened():
@@ -128,6 +110,7 @@ prev_time = time.time()
 while True:
     ret, frame = cap.read()
     if not ret: break
+    frame_ts = time.monotonic_ns()   # 제어 쪽과 같은 CLOCK_MONOTONIC
 
     img = cv2.resize(frame, (IMG_SIZE, IMG_SIZE))
     input_data = np.expand_dims(img.astype(np.float32) / 255.0, axis=0)
@@ -136,7 +119,13 @@ while True:
 
     loc = interpreter.get_tensor(out[0]['index'])
     cls = interpreter.get_tensor(out[1]['index'])
-    boxes, scores, clses = filter_boxes(loc.squeeze(), cls.squeeze())
+    if recorder:
+        recorder.add(loc.squeeze(), cls.squeeze())
+    if post:
+        boxes, scores, clses = post.run(loc.squeeze(), cls.squeeze())
+    else:
+        boxes, scores, clses = filter_boxes(loc.squeeze(), cls.squeeze())
+    infer_ts = time.monotonic_ns()   # 추론 + 후처리 완료 (latency trace 단계)
 
     visualize(frame, boxes, scores, clses, labels)
 
@@ -146,7 +135,7 @@ while True:
 
     print("Detected bounding boxes:")
 
-    for box, cls in zip(boxes, clses):
+    for box, score, cls in zip(boxes, scores, clses):
 
         label_name = labels[int(cls)]
 
@@ -156,10 +145,12 @@ while True:
         # === ACCEL 감지 ===
         if is_in_region(box, ACCEL_REGION):
             accel_detected = True
+            channel.publish(DET_ACCEL, cls, score, box, frame_ts, infer_ts)
 
         # === BRAKE 감지 ===
         if is_in_region(box, BRAKE_REGION):
             brake_detected = True
+            channel.publish(DET_BRAKE, cls, score, box, frame_ts, infer_ts)
 
     # ======= 화면 표시 & FLAG 생성 =======
 
@@ -171,11 +162,6 @@ while True:
             cv2.putText(frame, text, (20, 10 + th + 5),
                 cv2.FONT_HERSHEY_SIMPLEX, 1.0, (255, 255, 255), 3)
 
-            # main.cpp로 트리거 전송
-            with open("/tmp/accel_detected.flag", "w") as f:
-                f.write(str(time.time()))
-                print("ACCEL FLAG SENT")
-
         # BRAKE
         if brake_detected:
             text = "BRAKE DETECTED"
@@ -184,10 +170,6 @@ while True:
             cv2.putText(frame, text, (20, 10 + th + 5),
                 cv2.FONT_HERSHEY_SIMPLEX, 1.0, (255, 255, 255), 3)
 
-            with open("/tmp/brake_detected.flag", "w") as f:
-                f.write(str(time.time()))
-                print("BRAKE FLAG SENT")
-
 
 
     cv2.imshow("YOLOv4-Tiny Detection", frame)
@@ -202,4 +184,7 @@ while True:
 
 
 cap.release()
+channel.close()
+if recorder:
+    recorder.close()
 cv2.destroyAllWindows()
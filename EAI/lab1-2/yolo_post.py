@@ -0,0 +1,67 @@
+"""team_project/vision/yolo_postprocess 의 Python(ctypes) binding
+
+filter_boxes(loc, cls) 와 같은 결과를 C++ (SIMD) 로 계산한다.
+라이브러리 위치는 YOLO_POST_LIB 환경변수로 바꿀 수 있다.
+"""
+import ctypes
+import os
+
+import numpy as np
+
+_DEFAULT_LIB = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                            "../../team_project/build1/libyolo_post.so")
+
+_f32p = ctypes.POINTER(ctypes.c_float)
+_i32p = ctypes.POINTER(ctypes.c_int32)
+
+
+class YoloPostprocessor:
+    def __init__(self, num_boxes, num_classes, score_thresh=0.2, iou_thresh=0.3,
+                 top_k=100, use_simd=True, max_out=64, lib_path=None):
+        lib_path = lib_path or os.environ.get("YOLO_POST_LIB", _DEFAULT_LIB)
+        self._lib = ctypes.CDLL(lib_path)
+
+        self._lib.yolo_post_create.argtypes = [
+            ctypes.c_int, ctypes.c_int, ctypes.c_float, ctypes.c_float, ctypes.c_int, ctypes.c_int]
+        self._lib.yolo_post_create.restype = ctypes.c_void_p
+        self._lib.yolo_post_run.argtypes = [
+            ctypes.c_void_p, _f32p, _f32p, _f32p, _f32p, _i32p, ctypes.c_int]
+        self._lib.yolo_post_run.restype = ctypes.c_int
+        self._lib.yolo_post_simd.argtypes = [ctypes.c_void_p]
+        self._lib.yolo_post_simd.restype = ctypes.c_char_p
+        self._lib.yolo_post_destroy.argtypes = [ctypes.c_void_p]
+
+        self.num_boxes = num_boxes
+        self.num_classes = num_classes
+        self._handle = self._lib.yolo_post_create(
+            num_boxes, num_classes, score_thresh, iou_thresh, top_k, 1 if use_simd else 0)
+
+        # 출력 버퍼는 한 번만 만들고 재사용
+        self._boxes = np.zeros((max_out, 4), dtype=np.float32)
+        self._scores = np.zeros(max_out, dtype=np.float32)
+        self._labels = np.zeros(max_out, dtype=np.int32)
+
+    @property
+    def simd(self):
+        return self._lib.yolo_post_simd(self._handle).decode()
+
+    def run(self, loc, cls):
+        """loc [N,4] (cx,cy,w,h), cls [N,C] → (boxes [K,4] ymin/xmin/ymax/xmax, scores [K], classes [K])
+        반환 배열은 다음 run() 에서 덮어쓰므로 보관하려면 copy
+        """
+        loc = np.ascontiguousarray(loc, dtype=np.float32).reshape(-1, 4)
+        cls = np.ascontiguousarray(cls, dtype=np.float32).reshape(loc.shape[0], -1)
+        if loc.shape[0] != self.num_boxes or cls.shape[1] != self.num_classes:
+            raise ValueError(f"expected {self.num_boxes} boxes x {self.num_classes} classes, "
+                             f"got {loc.shape[0]} x {cls.shape[1]}")
+
+        n = self._lib.yolo_post_run(
+            self._handle, loc.ctypes.data_as(_f32p), cls.ctypes.data_as(_f32p),
+            self._boxes.ctypes.data_as(_f32p), self._scores.ctypes.data_as(_f32p),
+            self._labels.ctypes.data_as(_i32p), self._boxes.shape[0])
+        return self._boxes[:n], self._scores[:n], self._labels[:n]
+
+    def close(self):
+        if self._handle:
+            self._lib.yolo_post_destroy(self._handle)
+            self._handle = None
@@ -0,0 +1,128 @@
+// capture → 전처리 benchmark: 프레임을 Image 로 복사해 넘기던 기존 방식 (fread, cv2.VideoCapture 와 같은 복사)
+// 와 source buffer 를 빌려 바로 전처리하고 돌려주는 방식 (RawVideoSource mmap, V4L2 도 같은 경로)
+// 프레임당 capture / capture+전처리 시간과 복사한 byte 수를 낸다.
+// stdout 에는 JSON, stderr 에는 표.
+//
+// 사용: capture_bench video.bgr --size WxH [--repeat N] [--input-size N]
+#include "../vision/frame_source.hpp"
+#include "../vision/preprocess.hpp"
+#include "../core/hdr_histogram.hpp"
+#include "../core/mono_clock.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+
+namespace {
+
+struct Result {
+    const char* name;
+    HdrHistogram capture;
+    HdrHistogram total;
+    uint64_t copied;     // 프레임당 복사한 byte
+};
+
+volatile float g_sink;
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+    const char* path = nullptr;
+    int width = 0, height = 0, repeat = 3, size = 416;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc)
+            sscanf(argv[++i], "%dx%d", &width, &height);
+        else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+            repeat = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--input-size") == 0 && i + 1 < argc)
+            size = atoi(argv[++i]);
+        else
+            path = argv[i];
+    }
+    if (!path || width <= 0 || height <= 0) {
+        fprintf(stderr, "usage: capture_bench video.bgr --size WxH [--repeat N] [--input-size N]\n");
+        return EXIT_FAILURE;
+    }
+
+    Preprocessor::Config pc;
+    pc.size = size;
+    Preprocessor pre(pc);
+    std::vector<float> tensor(static_cast<size_t>(size) * size * 3);
+    size_t frame_bytes = static_cast<size_t>(width) * height * 3;
+
+    static Result results[2] = { { "copy", HdrHistogram(), HdrHistogram(), frame_bytes },
+                                 { "mmap ref", HdrHistogram(), HdrHistogram(), 0 } };
+    uint64_t frames = 0;
+
+    for (int r = 0; r < repeat; r++) {
+        // 기존: 파일에서 Image 로 읽고 (복사) 그 Image 를 전처리
+        FILE* fp = fopen(path, "rb");
+        if (!fp) {
+            fprintf(stderr, "cannot open %s\n", path);
+            return EXIT_FAILURE;
+        }
+        Image image;
+        image.resize(width, height);
+        for (;;) {
+            uint64_t t0 = monoNowNs();
+            if (fread(&image.pixels[0], 1, frame_bytes, fp) != frame_bytes)
+                break;
+            uint64_t t1 = monoNowNs();
+            pre.run(image, &tensor[0]);
+            uint64_t t2 = monoNowNs();
+            results[0].capture.record(t1 - t0);
+            results[0].total.record(t2 - t0);
+            g_sink = tensor[0];
+        }
+        fclose(fp);
+
+        // 새 방식: mmap 한 buffer 를 빌려 바로 전처리, 전처리 후 release
+        RawVideoSource source(path, width, height, false);
+        if (!source.isOpen())
+            return EXIT_FAILURE;
+        Frame frame;
+        for (;;) {
+            uint64_t t0 = monoNowNs();
+            if (!source.acquire(frame))
+                break;
+            uint64_t t1 = monoNowNs();
+            pre.run(frame.image, &tensor[0]);
+            source.release(frame);
+            uint64_t t2 = monoNowNs();
+            results[1].capture.record(t1 - t0);
+            results[1].total.record(t2 - t0);
+            g_sink = tensor[0];
+            frames++;
+        }
+    }
+
+    fprintf(stderr, "%s: %dx%d, %llu frames -> %dx%d float\n", path, width, height,
+            static_cast<unsigned long long>(frames), size, size);
+    fprintf(stderr, "%-10s %12s %12s %12s %12s %12s\n", "path", "capture p50", "capture p99",
+            "+pre p50", "+pre mean", "copied KB");
+    for (int k = 0; k < 2; k++) {
+        const Result& res = results[k];
+        fprintf(stderr, "%-10s %12.1f %12.1f %12.1f %12.1f %12.1f\n", res.name,
+                res.capture.percentile(0.50) / 1e3, res.capture.percentile(0.99) / 1e3,
+                res.total.percentile(0.50) / 1e3, res.total.mean() / 1e3, res.copied / 1024.0);
+    }
+
+    printf("{\"source\":\"%s\",\"frame\":[%d,%d],\"frames\":%llu,\"benchmarks\":[", path, width, height,
+           static_cast<unsigned long long>(frames));
+    for (int k = 0; k < 2; k++) {
+        const Result& res = results[k];
+        printf("%s\n  {\"name\":\"%s\",\"capture_p50_ns\":%llu,\"capture_p99_ns\":%llu,"
+               "\"total_p50_ns\":%llu,\"total_mean_ns\":%.0f,\"copied_bytes\":%llu}",
+               k ? "," : "", res.name,
+               static_cast<unsigned long long>(res.capture.percentile(0.50)),
+               static_cast<unsigned long long>(res.capture.percentile(0.99)),
+               static_cast<unsigned long long>(res.total.percentile(0.50)), res.total.mean(),
+               static_cast<unsigned long long>(res.copied));
+    }
+    printf("\n]}\n");
+    return EXIT_SUCCESS;
+}
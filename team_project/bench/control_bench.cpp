@@ -0,0 +1,461 @@
+// 제어 hot path micro-benchmark (하드웨어 없이 시뮬레이션 센서로 실행)
+//   computeTTC / computeCap+computeThrottleCmd / 오조작·잠금 판단(controlTask) / scheduler 한 주기
+//   log_off / log_on: 꺼진 level / 켜진 level 의 LOG_* 한 번 (formatter 는 /dev/null 로)
+// 각 항목의 p50 / p99 / p99.9 / max latency, iteration 당 할당 수와 syscall 수를 잰다.
+// stdout 에는 JSON (회귀 비교용), stderr 에는 사람이 읽는 표를 쓴다.
+// steady_state 는 검출 이벤트 / stomp / outlier 없이 페달을 유지한 채 앞차를 따라가는 평상시 주행 (scheduler 한 주기)
+// --check: 어느 항목이든 할당이나 syscall 이 있으면 실패 (exit 1), 진단 메시지도 EventLog 로 가므로 이벤트 경로도 0 이어야 함
+// syscall 은 SyscallCounter (perf tracepoint, 안 되면 seccomp user notification) 로 모든 종류를 센다.
+// 둘 다 안 되면 proc_io (read/write 계열만) 로 재고 표에 그렇게 표시한다.
+//
+// 사용: bench [--iterations N] [--log path] [--check]
+#include "../control/mispedal_controller.hpp"
+#include "../control/sim_devices.hpp"
+#include "../core/alloc_counter.hpp"
+#include "../core/clock.hpp"
+#include "../core/csv_logger.hpp"
+#include "../core/detection_channel.hpp"
+#include "../core/event_log.hpp"
+#include "../core/mono_clock.hpp"
+#include "../core/scheduler.hpp"
+#include "../core/syscall_counter.hpp"
+#include "../sensors/hall_sensor.hpp"
+#include "../sensors/pedal_sampler.hpp"
+#include "../sensors/spi_bus.hpp"
+#include "../sensors/ultrasonic.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include <sys/resource.h>
+
+
+namespace {
+
+constexpr int ADC_CHANNEL = 0;
+constexpr int TRIG = 29;
+constexpr int ECHO = 28;
+
+uint64_t contextSwitches()
+{
+    struct rusage ru;
+    getrusage(RUSAGE_THREAD, &ru);
+    return static_cast<uint64_t>(ru.ru_nvcsw + ru.ru_nivcsw);
+}
+
+
+// ================= 실행 / 결과 =================
+
+struct BenchResult {
+    std::string name;
+    long     iterations = 0;
+    uint64_t p50_ns = 0, p99_ns = 0, p999_ns = 0, max_ns = 0;
+    double   mean_ns = 0.0;
+    double   allocs_per_iter = 0.0;
+    double   syscalls_per_iter = 0.0;
+    double   ctx_switches_per_iter = 0.0;
+};
+
+uint64_t percentile(const std::vector<uint64_t>& sorted, double p)
+{
+    size_t idx = static_cast<size_t>(p * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+// prepare(i): 측정하지 않는 준비 (센서 스레드 몫 등), body(i): 측정 대상
+template <typename Prepare, typename Body>
+BenchResult runBench(const char* name, long iters, long warmup, SyscallCounter& sc, Prepare prepare, Body body)
+{
+    std::vector<uint64_t> samples(static_cast<size_t>(iters));
+
+    for (long i = 0; i < warmup; i++) {
+        prepare(i);
+        body(i);
+    }
+
+    uint64_t sc_overhead = sc.overhead();
+    uint64_t allocs = 0;
+    uint64_t ctx0   = contextSwitches();
+    uint64_t sys0    = sc.read();
+    uint64_t sys_prepare = 0;
+
+    for (long i = 0; i < iters; i++) {
+        // prepare 의 syscall 은 빼고 셈
+        uint64_t s0 = sc.read();
+        prepare(warmup + i);
+        sys_prepare += sc.read() - s0 + sc_overhead;
+
+        uint64_t a0 = threadAllocCount();
+        uint64_t t0 = monoNowNs();
+        body(warmup + i);
+        uint64_t t1 = monoNowNs();
+        samples[static_cast<size_t>(i)] = t1 - t0;
+        allocs += threadAllocCount() - a0;
+    }
+
+    uint64_t sys1    = sc.read();
+    uint64_t ctx1    = contextSwitches();
+
+    BenchResult r;
+    r.name       = name;
+    r.iterations = iters;
+
+    uint64_t sum = 0;
+    for (size_t i = 0; i < samples.size(); i++)
+        sum += samples[i];
+    std::sort(samples.begin(), samples.end());
+    r.p50_ns  = percentile(samples, 0.50);
+    r.p99_ns  = percentile(samples, 0.99);
+    r.p999_ns = percentile(samples, 0.999);
+    r.max_ns  = samples.back();
+    r.mean_ns = static_cast<double>(sum) / iters;
+
+    int64_t sys = static_cast<int64_t>(sys1 - sys0) - static_cast<int64_t>(sys_prepare) - static_cast<int64_t>(sc_overhead);
+    r.syscalls_per_iter     = std::max<int64_t>(0, sys) / static_cast<double>(iters);
+    r.allocs_per_iter       = static_cast<double>(allocs) / iters;
+    r.ctx_switches_per_iter = static_cast<double>(ctx1 - ctx0) / iters;
+    return r;
+}
+
+
+// ================= 시뮬레이션 센서 =================
+
+// 150cm 에서 0.4m/s 로 다가오다 20cm 에서 다시 멀어짐, ±0.3cm 잡음
+// follow = true: 앞차를 100cm 근처에서 따라가는 평상시 (150cm 로 튀는 outlier 없음)
+class SynthRange : public RangeSource {
+public:
+    explicit SynthRange(Clock& clock, bool follow = false) : clock_(clock), follow_(follow) {}
+
+    bool poll(float& distance_cm, uint64_t& t_ns) override
+    {
+        t_ns = clock_.nowNs();
+        if (follow_)
+            d_ = 100.0f + 20.0f * static_cast<float>(std::sin(t_ns / 1e9));
+        else {
+            d_ -= 2.0f;    // 20Hz * 2cm = 0.4m/s
+            if (d_ < 20.0f)
+                d_ = 150.0f;
+        }
+        rng_ = rng_ * 1664525u + 1013904223u;
+        distance_cm = d_ + (static_cast<float>(rng_ >> 8) / 16777216.0f - 0.5f) * 0.6f;
+        return true;
+    }
+
+private:
+    Clock& clock_;
+    bool follow_;
+    float d_ = 150.0f;
+    uint32_t rng_ = 1;
+};
+
+// control 주기마다 tick(): 7 주기마다 ACCEL, 가끔 BRAKE
+class SynthDetections : public DetectionSource {
+public:
+    void tick(uint64_t now_ns)
+    {
+        k_++;
+        now_ns_ = now_ns;
+        pending_accel_ = (k_ % 7 == 0);
+        pending_brake_ = (k_ % 997 == 0);
+    }
+
+    bool poll(DetectionEvent& event) override
+    {
+        uint32_t cls = DET_NONE;
+        if (pending_accel_) {
+            pending_accel_ = false;
+            cls = DET_ACCEL;
+        }
+        else if (pending_brake_) {
+            pending_brake_ = false;
+            cls = DET_BRAKE;
+        }
+        else {
+            return false;
+        }
+        memset(&event, 0, sizeof(event));
+        event.cls = cls;
+        event.timestamp_ns = now_ns_;
+        event.seq = ++seq_;
+        return true;
+    }
+
+private:
+    uint64_t k_ = 0, seq_ = 0, now_ns_ = 0;
+    bool pending_accel_ = false, pending_brake_ = false;
+};
+
+// 3초 주기: 30% 유지 → 100ms 만에 100% (stomp) → 유지 → 복귀
+int pedalRaw(uint64_t t_ns)
+{
+    uint64_t ms = (t_ns / 1000000ull) % 3000;
+    float thr;
+    if (ms < 2000)      thr = 30.0f;
+    else if (ms < 2100) thr = 30.0f + 70.0f * (ms - 2000) / 100.0f;
+    else if (ms < 2500) thr = 100.0f;
+    else                thr = 30.0f;
+
+    float v = 1.7f + thr / 100.0f * 0.5f;
+    return static_cast<int>(v / 3.3f * 4095.0f);
+}
+
+// 30% 유지 (stomp 없음)
+int pedalSteadyRaw(uint64_t)
+{
+    return static_cast<int>((1.7f + 0.3f * 0.5f) / 3.3f * 4095.0f);
+}
+
+// PedalSampler 는 원래 별도 스레드: 측정 구간 밖에서 [from, to) 를 1kHz 로 진행
+void stepPedal(PedalSampler& pedal, MockMcp3208Bus& bus, uint64_t from_ns, uint64_t to_ns,
+               int (*raw)(uint64_t) = pedalRaw)
+{
+    for (uint64_t t = from_ns; t < to_ns; t += 1000000ull) {
+        bus.setChannelValue(ADC_CHANNEL, raw(t));
+        pedal.step(t);
+    }
+}
+
+
+
+// 판단 / 한 주기 bench 공용 구성: 시뮬레이션 센서 + 세는 장치 + MispedalController (가상 시간)
+struct SimRig {
+    SimClock          clock;
+    PedalSampler      pedal;
+    Ultrasonic        ultra;
+    SynthRange        range;
+    SynthDetections   detections;
+    CountingBuzzer    buzzer;
+    CountingDisplay   display;
+    CountingBrake     brake;
+    MispedalController ctl;
+
+    SimRig(MCP3208& hall, const PedalSampler::Config& pedal_cfg, LogSink& log, bool follow = false)
+        : clock(1000000000ull),
+          pedal(hall, pedal_cfg, &clock),
+          ultra(TRIG, ECHO),
+          range(clock, follow),
+          ctl(devices(hall, log), 0)
+    {
+    }
+
+private:
+    MispedalController::Devices devices(MCP3208& hall, LogSink& log)
+    {
+        MispedalController::Devices dev;
+        dev.range      = &range;
+        dev.detections = &detections;
+        dev.pedal      = &pedal;
+        dev.ultra      = &ultra;
+        dev.hall       = &hall;
+        dev.buzzer     = &buzzer;
+        dev.display    = &display;
+        dev.brake      = &brake;
+        dev.log        = &log;
+        return dev;
+    }
+};
+
+void printJson(const std::vector<BenchResult>& results, const char* syscall_source)
+{
+    printf("{\"syscall_source\":\"%s\",\"benchmarks\":[", syscall_source);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        printf("%s\n  {\"name\":\"%s\",\"iterations\":%ld,\"p50_ns\":%llu,\"p99_ns\":%llu,\"p999_ns\":%llu,"
+               "\"max_ns\":%llu,\"mean_ns\":%.1f,\"allocs_per_iter\":%.4f,\"syscalls_per_iter\":%.4f,"
+               "\"ctx_switches_per_iter\":%.4f}",
+               i ? "," : "", r.name.c_str(), r.iterations,
+               static_cast<unsigned long long>(r.p50_ns), static_cast<unsigned long long>(r.p99_ns),
+               static_cast<unsigned long long>(r.p999_ns), static_cast<unsigned long long>(r.max_ns),
+               r.mean_ns, r.allocs_per_iter, r.syscalls_per_iter, r.ctx_switches_per_iter);
+    }
+    printf("\n]}\n");
+}
+
+void printTable(const std::vector<BenchResult>& results, const char* syscall_source)
+{
+    fprintf(stderr, "%-16s %9s %9s %9s %9s %9s %8s %9s\n",
+            "bench", "p50(ns)", "p99(ns)", "p99.9(ns)", "max(ns)", "mean(ns)", "alloc/it", "sys/it");
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        fprintf(stderr, "%-16s %9llu %9llu %9llu %9llu %9.0f %8.3f %9.3f\n",
+                r.name.c_str(),
+                static_cast<unsigned long long>(r.p50_ns), static_cast<unsigned long long>(r.p99_ns),
+                static_cast<unsigned long long>(r.p999_ns), static_cast<unsigned long long>(r.max_ns),
+                r.mean_ns, r.allocs_per_iter, r.syscalls_per_iter);
+    }
+    fprintf(stderr, "(syscalls: %s)\n", syscall_source);
+}
+
+// 모든 항목 (측정 스레드에서 실행, 로그 writer 등 다른 스레드는 main 이 미리 띄워 둠)
+void runAll(long iters, long warmup, SyscallCounter& sc, LogSink& log_file, std::vector<BenchResult>& results)
+{
+    // ---- computeTTC (20Hz 측정)
+    {
+        Ultrasonic ultra(TRIG, ECHO);
+        SimClock clock(1000000000ull);
+        SynthRange range(clock);
+        float d = 0.0f;
+        uint64_t t = 0;
+        results.push_back(runBench("computeTTC", iters, warmup, sc,
+            [&](long) { clock.advance(50000000ull); range.poll(d, t); },
+            [&](long) { ultra.computeTTC(d, t); }));
+    }
+
+    // ---- computeCap + computeThrottleCmd
+    {
+        MockMcp3208Bus bus;
+        MCP3208 hall(&bus);
+        volatile float sink = 0.0f;
+        results.push_back(runBench("computeCap+Cmd", iters, warmup, sc,
+            [&](long) {},
+            [&](long i) {
+                float ttc = 0.5f + static_cast<float>(i % 64) * 0.07f;
+                float cap = hall.computeCap(ttc);
+                sink = hall.computeThrottleCmd(60.0f, cap);
+            }));
+        (void)sink;
+    }
+
+    // ---- LOG_* (기본 level info)
+    {
+        float d = 123.4f;
+        results.push_back(runBench("log_off", iters, warmup, sc,
+            [&](long) {},
+            [&](long i) { LOG_DEBUG("debug {} {} {}", d, i, "x"); }));
+        results.push_back(runBench("log_on", iters, warmup, sc,
+            [&](long) {},
+            [&](long i) { LOG_INFO("info {} {} {}", d, i, "x"); }));
+    }
+
+    // ---- 판단 블록 / 전체 한 주기: 같은 구성, 시뮬레이션 센서
+    MockMcp3208Bus adc_bus;
+    MCP3208 hall(&adc_bus);
+    PedalSampler::Config pedal_cfg;
+    pedal_cfg.channel = ADC_CHANNEL;
+
+    {
+        SimRig rig(hall, pedal_cfg, log_file);
+
+        results.push_back(runBench("decision", iters, warmup, sc,
+            [&](long) {
+                uint64_t now = rig.clock.nowNs();
+                stepPedal(rig.pedal, adc_bus, now, now + 10000000ull);
+                rig.clock.advance(10000000ull);
+                rig.detections.tick(rig.clock.nowNs());
+            },
+            [&](long) { rig.ctl.controlTask(rig.clock.nowNs()); }));
+    }
+
+    {
+        SimRig rig(hall, pedal_cfg, log_file);
+
+        PeriodicScheduler sched(&rig.clock);
+        rig.ctl.addTasks(sched);
+        sched.runOnce();   // 시작 시각 고정
+
+        // 한 iteration = control 주기(10ms) 하나, 5번에 1번은 ultrasonic + log 도 실행
+        results.push_back(runBench("loop_iteration", iters, warmup, sc,
+            [&](long) {
+                uint64_t now = rig.clock.nowNs();
+                stepPedal(rig.pedal, adc_bus, now + 1000000ull, now + 10000000ull + 1);
+                rig.detections.tick(now + 10000000ull);
+            },
+            [&](long) { sched.runOnce(); }));
+    }
+
+    {
+        SimRig rig(hall, pedal_cfg, log_file, true);     // detections 는 tick 하지 않음 → 이벤트 없음
+
+        PeriodicScheduler sched(&rig.clock);
+        rig.ctl.addTasks(sched);
+        sched.runOnce();
+
+        results.push_back(runBench("steady_state", iters, warmup, sc,
+            [&](long) {
+                uint64_t now = rig.clock.nowNs();
+                stepPedal(rig.pedal, adc_bus, now + 1000000ull, now + 10000000ull + 1, pedalSteadyRaw);
+            },
+            [&](long) { sched.runOnce(); }));
+    }
+}
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+    long iters = 20000;
+    std::string log_path = "/dev/null";
+    bool check = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc)
+            iters = std::max(1L, atol(argv[++i]));
+        else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc)
+            log_path = argv[++i];
+        else if (strcmp(argv[i], "--check") == 0)
+            check = true;
+        else {
+            fprintf(stderr, "usage: bench [--iterations N] [--log path] [--check]\n");
+            return EXIT_FAILURE;
+        }
+    }
+    long warmup = std::max(100L, iters / 10);
+
+    // 제어 코드의 std::cout 출력은 실제처럼 write() 까지 가되 화면(JSON) 에는 섞이지 않게
+    std::ofstream devnull("/dev/null");
+    std::streambuf* cout_buffer = std::cout.rdbuf(devnull.rdbuf());
+
+    int log_fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    EventLog::Config event_cfg;
+    event_cfg.fd = log_fd;
+    EventLog::instance().start(event_cfg);
+
+    // log.csv writer 스레드는 측정 스레드 밖에서 (seccomp filter 를 물려받지 않게)
+    CsvLogger log_file;
+    log_file.open(log_path);
+
+    // 측정은 전용 스레드에서: seccomp 로 셀 때 filter 가 그 스레드에만 걸리고 스레드와 함께 사라짐
+    SyscallCounter sc;
+    std::vector<BenchResult> results;
+    std::thread worker([&]() {
+        sc.attach();
+        runAll(iters, warmup, sc, log_file, results);
+    });
+    worker.join();
+
+    log_file.close();
+    EventLog::instance().stop();
+    close(log_fd);
+    std::cout.rdbuf(cout_buffer);
+
+    printJson(results, sc.source());
+    printTable(results, sc.source());
+
+    if (!check)
+        return 0;
+    bool ok = true;
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        if (r.allocs_per_iter > 0) {
+            fprintf(stderr, "check: %s allocates (%.4f per iteration)\n", r.name.c_str(), r.allocs_per_iter);
+            ok = false;
+        }
+        if (r.syscalls_per_iter > 0) {
+            fprintf(stderr, "check: %s makes syscalls (%.4f per iteration, %s)\n", r.name.c_str(),
+                    r.syscalls_per_iter, sc.source());
+            ok = false;
+        }
+    }
+    if (!sc.exact())
+        fprintf(stderr, "check: syscall count is %s (read/write only), other syscalls are not checked\n", sc.source());
+    fprintf(stderr, "check: %s\n", ok ? "ok" : "FAILED");
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,228 @@
+// 페달 상태 검출 조절 (InferenceGate) 평가: 기록한 세션을 가상 시간으로 재생
+// 카메라 (fps) 와 추론 하나 (infer_ms, 추론 중 들어온 프레임은 버림 = mispedal_detect --drop) 를 흉내내고
+// 매 프레임 검출 (always) 과 gate 를 비교한다.
+// - compute: 추론 횟수 / 추론 CPU 시간 (횟수 x infer_ms)
+// - latency: 페달을 새로 밟기 시작한 시점 (onset) → 그 이후 프레임의 첫 검출 결과가 나온 시각
+// 페달 입력은 실제 PedalSampler 를 가상 ADC 로 1kHz 구동 (mispedal_replay 와 같은 방식)
+// 세션마다 카메라 프레임 시점을 --phases 개로 바꿔 여러 번 재생 (onset 과 프레임 / 추론 시점의 어긋남이 분포로 나오도록)
+// 기록한 log.csv 는 페달 시험 구간만 있으므로 --idle-s 로 각 세션 앞에 페달을 뗀 구간 (주행 중 대기) 을 붙인다.
+// stdout 에는 JSON, stderr 에는 표.
+//
+// 사용: gate_replay <trace.csv|log.csv> ... [--fps F] [--infer-ms X] [--idle-hz X] [--active-percent X] [--hold-ms N]
+//                   [--idle-s S] [--phases N]
+#include "../vision/inference_gate.hpp"
+#include "../core/hdr_histogram.hpp"
+#include "../core/clock.hpp"
+#include "../core/trace.hpp"
+#include "../sensors/hall_sensor.hpp"
+#include "../sensors/pedal_sampler.hpp"
+#include "../sensors/spi_bus.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+namespace {
+
+// mispedal_main 과 같은 값
+constexpr int   ADC_CHANNEL = 0;
+constexpr float V_MIN = 1.7f;
+constexpr float V_MAX = 2.2f;
+
+constexpr uint64_t LEGACY_START_NS  = 1000000000ull;
+constexpr uint64_t LEGACY_PERIOD_NS = 50000000ull;
+constexpr uint64_t STEP_NS          = 1000000ull;     // 페달 1kHz
+
+enum Policy { POLICY_ALWAYS, POLICY_GATE, POLICY_COUNT };
+const char* const POLICY_NAMES[] = { "always", "gate" };
+
+struct Engine {
+    uint64_t busy_until = 0;
+    uint64_t runs = 0;
+    std::vector<uint64_t> frame_ns;     // 검출한 프레임 시각
+    std::vector<uint64_t> done_ns;      // 그 결과가 나온 시각
+};
+
+struct Totals {
+    uint64_t frames = 0;
+    uint64_t runs = 0;
+    HdrHistogram latency;
+    uint64_t missed = 0;                // onset 이후 세션 끝까지 검출이 없음
+};
+
+// onset 뒤 첫 프레임의 결과 시각
+bool onsetLatency(const Engine& e, uint64_t onset, uint64_t& latency)
+{
+    std::vector<uint64_t>::const_iterator it = std::lower_bound(e.frame_ns.begin(), e.frame_ns.end(), onset);
+    if (it == e.frame_ns.end())
+        return false;
+    latency = e.done_ns[it - e.frame_ns.begin()] - onset;
+    return true;
+}
+
+void usage()
+{
+    fprintf(stderr, "usage: gate_replay <trace.csv|log.csv> ... [--fps F] [--infer-ms X] [--idle-hz X]\n"
+                    "                   [--active-percent X] [--hold-ms N] [--idle-s S] [--phases N]\n");
+}
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> paths;
+    double fps = 30.0, infer_ms = 150.0, idle_s = 0;
+    int phases = 8;
+    InferenceGate::Config gate_cfg;
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--fps") == 0 && has_value)
+            fps = atof(argv[++i]);
+        else if (strcmp(argv[i], "--infer-ms") == 0 && has_value)
+            infer_ms = atof(argv[++i]);
+        else if (strcmp(argv[i], "--idle-hz") == 0 && has_value)
+            gate_cfg.idle_hz = static_cast<float>(atof(argv[++i]));
+        else if (strcmp(argv[i], "--active-percent") == 0 && has_value)
+            gate_cfg.active_percent = static_cast<float>(atof(argv[++i]));
+        else if (strcmp(argv[i], "--hold-ms") == 0 && has_value)
+            gate_cfg.hold_ms = static_cast<uint32_t>(atoi(argv[++i]));
+        else if (strcmp(argv[i], "--idle-s") == 0 && has_value)
+            idle_s = atof(argv[++i]);
+        else if (strcmp(argv[i], "--phases") == 0 && has_value)
+            phases = atoi(argv[++i]);
+        else if (argv[i][0] != '-')
+            paths.push_back(argv[i]);
+        else {
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+    if (paths.empty() || fps <= 0 || phases < 1) {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    const uint64_t frame_ns = static_cast<uint64_t>(1e9 / fps);
+    const uint64_t infer_ns = static_cast<uint64_t>(infer_ms * 1e6);
+    static Totals totals[POLICY_COUNT];
+    uint64_t onsets = 0;
+    double session_s = 0;
+
+    for (size_t f = 0; f < paths.size(); f++) {
+        std::vector<TraceEvent> events;
+        TraceInfo info;
+        if (!loadTrace(paths[f], events, info, LEGACY_START_NS, LEGACY_PERIOD_NS) || events.empty())
+            return EXIT_FAILURE;
+        if (idle_s > 0) {
+            // 세션 앞에 페달을 뗀 구간 (V_MIN = 0%)
+            uint64_t shift = static_cast<uint64_t>(idle_s * 1e9);
+            for (size_t k = 0; k < events.size(); k++)
+                events[k].t_ns += shift;
+            TraceEvent released = { events.front().t_ns - shift, TRACE_PEDAL, V_MIN };
+            events.insert(events.begin(), released);
+        }
+
+        for (int phase = 0; phase < phases; phase++) {
+            SimClock clock(events.front().t_ns);
+            MockMcp3208Bus adc_bus;
+            MCP3208 hall(&adc_bus);
+            PedalSampler::Config pedal_cfg;
+            pedal_cfg.channel = ADC_CHANNEL;
+            pedal_cfg.v_min   = V_MIN;
+            pedal_cfg.v_max   = V_MAX;
+            PedalSampler pedal(hall, pedal_cfg, &clock);
+            InferenceGate gate(gate_cfg);
+
+            Engine engines[POLICY_COUNT];
+            std::vector<uint64_t> onset_ns;
+            bool active = false;
+            uint64_t last_active = 0;
+            size_t pos = 0;
+            uint64_t start = events.front().t_ns, end = events.back().t_ns;
+            uint64_t next_frame = start + frame_ns * phase / phases;
+
+            for (uint64_t t = start; t <= end; t += STEP_NS) {
+                clock.set(t);
+                for (; pos < events.size() && events[pos].t_ns <= t; pos++) {
+                    if (events[pos].kind != TRACE_PEDAL)
+                        continue;
+                    int raw = static_cast<int>(events[pos].value / 3.3f * 4095.0f + 0.5f);
+                    adc_bus.setChannelValue(ADC_CHANNEL, std::max(0, std::min(4095, raw)));
+                }
+                pedal.step(t);
+                PedalState st = pedal.latest();
+
+                // onset: hold_ms 이상 쉬었다가 다시 밟기 시작 (gate 의 ACTIVE 조건과 같음)
+                bool now_active = st.thr_filtered >= gate_cfg.active_percent || st.slope >= gate_cfg.rising_slope;
+                if (now_active && !active && (last_active == 0 || t - last_active >= gate_cfg.hold_ms * 1000000ull))
+                    onset_ns.push_back(t);
+                if (now_active)
+                    last_active = t;
+                active = now_active;
+
+                if (t < next_frame)
+                    continue;
+                next_frame += frame_ns;
+                for (int p = 0; p < POLICY_COUNT; p++) {
+                    Engine& e = engines[p];
+                    totals[p].frames++;
+                    if (e.busy_until > t)
+                        continue;   // 추론 중 → 프레임 버림
+                    if (p == POLICY_GATE && !gate.shouldRun(t, &st))
+                        continue;
+                    e.busy_until = t + infer_ns;
+                    e.runs++;
+                    e.frame_ns.push_back(t);
+                    e.done_ns.push_back(t + infer_ns);
+                }
+            }
+
+            for (int p = 0; p < POLICY_COUNT; p++) {
+                totals[p].runs += engines[p].runs;
+                for (size_t k = 0; k < onset_ns.size(); k++) {
+                    uint64_t latency;
+                    if (onsetLatency(engines[p], onset_ns[k], latency))
+                        totals[p].latency.record(latency);
+                    else
+                        totals[p].missed++;
+                }
+            }
+            onsets += onset_ns.size();
+            session_s += (end - start) / 1e9;
+        }
+    }
+
+    double base_runs = static_cast<double>(std::max<uint64_t>(1, totals[POLICY_ALWAYS].runs));
+    fprintf(stderr, "%zu session(s) + %.0f s idle each, %.1f s replayed, %.0f fps, infer %.0f ms, idle %.1f Hz, active >= %.0f%% or %.0f%%/s, "
+            "%d phases, %llu onsets\n", paths.size(), idle_s, session_s, fps, infer_ms, gate_cfg.idle_hz, gate_cfg.active_percent,
+            gate_cfg.rising_slope, phases, static_cast<unsigned long long>(onsets));
+    fprintf(stderr, "%-8s %8s %8s %10s %9s %12s %12s %12s %7s\n", "policy", "frames", "infer",
+            "cpu s", "saved", "onset p50", "onset p99", "onset max", "missed");
+    for (int p = 0; p < POLICY_COUNT; p++) {
+        const Totals& t = totals[p];
+        fprintf(stderr, "%-8s %8llu %8llu %10.2f %8.1f%% %10.1fms %10.1fms %10.1fms %7llu\n", POLICY_NAMES[p],
+                static_cast<unsigned long long>(t.frames), static_cast<unsigned long long>(t.runs),
+                t.runs * infer_ms / 1e3, 100.0 * (1.0 - t.runs / base_runs),
+                t.latency.percentile(0.50) / 1e6, t.latency.percentile(0.99) / 1e6, t.latency.max() / 1e6,
+                static_cast<unsigned long long>(t.missed));
+    }
+
+    printf("{\"sessions\":%zu,\"idle_s\":%.1f,\"seconds\":%.1f,\"fps\":%.1f,\"infer_ms\":%.1f,\"onsets\":%llu,\"policies\":[",
+           paths.size(), idle_s, session_s, fps, infer_ms, static_cast<unsigned long long>(onsets));
+    for (int p = 0; p < POLICY_COUNT; p++) {
+        const Totals& t = totals[p];
+        printf("%s\n  {\"name\":\"%s\",\"inferences\":%llu,\"cpu_s\":%.3f,\"saved\":%.4f,"
+               "\"onset_p50_ns\":%llu,\"onset_p99_ns\":%llu,\"onset_max_ns\":%llu,\"missed\":%llu}",
+               p ? "," : "", POLICY_NAMES[p], static_cast<unsigned long long>(t.runs), t.runs * infer_ms / 1e3,
+               1.0 - t.runs / base_runs,
+               static_cast<unsigned long long>(t.latency.percentile(0.50)),
+               static_cast<unsigned long long>(t.latency.percentile(0.99)),
+               static_cast<unsigned long long>(t.latency.max()), static_cast<unsigned long long>(t.missed));
+    }
+    printf("\n]}\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+// LCD 한 줄 갱신 비용: 기존 (글자마다 1byte I2C write 6번 + usleep(500) 6번) vs LcdTransport (한 트랜잭션)
+// MockI2CBus 로 버스 시간 (byte * 9bit / bus_hz) 과 장치 대기 시간을 모델링, 인코딩 CPU 시간은 실측
+// 사용: ./lcd_bench [--repeat N]
+// stdout: JSON, stderr: 표
+#include "../sensors/lcd_transport.hpp"
+#include "../core/mono_clock.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+namespace {
+
+const char LINE[] = "Dist: 123.4 cm  ";
+constexpr size_t LINE_LEN = 16;
+
+// 기존 LCD::lcd_byte / lcd_toggle_enable 와 같은 순서 (wiringPiI2CWrite 하나 = 1byte 트랜잭션)
+void legacyByte(MockI2CBus& bus, int bits, int mode)
+{
+    int high = mode | (bits & 0xF0) | 0x08;
+    int low  = mode | ((bits << 4) & 0xF0) | 0x08;
+    int halves[2] = { high, low };
+    for (int h : halves) {
+        uint8_t b = static_cast<uint8_t>(h);
+        bus.write(&b, 1);
+        bus.delayUs(500);
+        b = static_cast<uint8_t>(h | 0x04);
+        bus.write(&b, 1);
+        bus.delayUs(500);
+        b = static_cast<uint8_t>(h & ~0x04);
+        bus.write(&b, 1);
+        bus.delayUs(500);
+    }
+}
+
+void legacyLine(MockI2CBus& bus)
+{
+    legacyByte(bus, 0xC0, 0);
+    for (size_t i = 0; i < LINE_LEN; i++)
+        legacyByte(bus, LINE[i], 1);
+}
+
+struct Result {
+    const char* name;
+    uint32_t bus_hz;
+    size_t   transactions;
+    size_t   bytes;
+    double   bus_us;        // 한 줄
+    double   delay_us;
+    double   per_char_us;   // (버스 + 대기) / 글자 수
+    double   encode_ns;     // 한 줄 인코딩 CPU 시간 (legacy 는 0: 인코딩이 곧 write)
+};
+
+Result runLegacy(uint32_t bus_hz)
+{
+    MockI2CBus bus(bus_hz);
+    legacyLine(bus);
+
+    Result r;
+    r.name         = "legacy";
+    r.bus_hz       = bus_hz;
+    r.transactions = bus.transactions().size();
+    r.bytes        = bus.bytes().size();
+    r.bus_us       = bus.busNs() / 1000.0;
+    r.delay_us     = bus.delayNs() / 1000.0;
+    r.per_char_us  = bus.totalNs() / 1000.0 / LINE_LEN;
+    r.encode_ns    = 0.0;
+    return r;
+}
+
+Result runTransport(uint32_t bus_hz, int repeat)
+{
+    MockI2CBus bus(bus_hz);
+    LcdTransport lcd(&bus);
+    lcd.writeAt(0x40, LINE, LINE_LEN);
+
+    Result r;
+    r.name         = "transport";
+    r.bus_hz       = bus_hz;
+    r.transactions = bus.transactions().size();
+    r.bytes        = bus.bytes().size();
+    r.bus_us       = bus.busNs() / 1000.0;
+    r.delay_us     = bus.delayNs() / 1000.0;
+    r.per_char_us  = bus.totalNs() / 1000.0 / LINE_LEN;
+
+    // 인코딩만 (mock 기록 비용을 빼려고 매번 reset)
+    uint64_t total = 0;
+    for (int i = 0; i < repeat; i++) {
+        bus.reset();
+        uint64_t t0 = monoNowNs();
+        lcd.writeAt(0x40, LINE, LINE_LEN);
+        total += monoNowNs() - t0;
+    }
+    r.encode_ns = static_cast<double>(total) / repeat;
+    return r;
+}
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+    int repeat = 10000;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc) {
+            repeat = atoi(argv[++i]);
+        }
+        else {
+            fprintf(stderr, "usage: lcd_bench [--repeat N]\n");
+            return 1;
+        }
+    }
+    if (repeat < 1)
+        repeat = 1;
+
+    const uint32_t speeds[] = { 100000, 400000, 1000000 };
+    Result results[6];
+    int n = 0;
+    for (uint32_t hz : speeds) {
+        results[n++] = runLegacy(hz);
+        results[n++] = runTransport(hz, repeat);
+    }
+
+    fprintf(stderr, "16-char line (cursor + 16 chars), modelled bus time + device waits\n");
+    fprintf(stderr, "%-10s %8s %6s %6s %10s %10s %12s %10s\n",
+            "path", "bus kHz", "xfers", "bytes", "bus(us)", "wait(us)", "us/char", "encode(ns)");
+    for (int i = 0; i < n; i++) {
+        const Result& r = results[i];
+        fprintf(stderr, "%-10s %8u %6zu %6zu %10.1f %10.1f %12.1f %10.0f\n",
+                r.name, r.bus_hz / 1000, r.transactions, r.bytes, r.bus_us, r.delay_us, r.per_char_us, r.encode_ns);
+    }
+
+    printf("{\"line_chars\":%zu,\"benchmarks\":[", LINE_LEN);
+    for (int i = 0; i < n; i++) {
+        const Result& r = results[i];
+        printf("%s\n  {\"name\":\"%s\",\"bus_hz\":%u,\"transactions\":%zu,\"bytes\":%zu,"
+               "\"bus_us\":%.1f,\"wait_us\":%.1f,\"per_char_us\":%.2f,\"encode_ns\":%.0f}",
+               i ? "," : "", r.name, r.bus_hz, r.transactions, r.bytes, r.bus_us, r.delay_us,
+               r.per_char_us, r.encode_ns);
+    }
+    printf("\n]}\n");
+    return 0;
+}
@@ -0,0 +1,158 @@
+// 검출기 입력 전처리 benchmark: 기존 두 단계 (resize → 중간 이미지 → /255 → slot → interpreter 복사)
+// 와 Preprocessor 한 번 (interpreter 입력 버퍼에 바로) 의 프레임당 시간
+// 기존 경로와의 pixel 값 차이 (0~255 단위 최대값) 도 같이 낸다.
+// stdout 에는 JSON, stderr 에는 표.
+//
+// 사용: preprocess_bench [image.ppm|jpg] [--size N] [--repeat N]
+//   이미지가 없으면 640x480 합성 프레임 (카메라 기본 해상도)
+#include "../vision/frame_source.hpp"
+#include "../vision/preprocess.hpp"
+#include "../core/hdr_histogram.hpp"
+#include "../core/mono_clock.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+
+namespace {
+
+// 부드러운 gradient + 잡음 (보간 결과가 단순하지 않게)
+void synthesize(Image& img, int width, int height)
+{
+    img.resize(width, height);
+    uint32_t seed = 12345;
+    for (int y = 0; y < height; y++) {
+        uint8_t* p = img.row(y);
+        for (int x = 0; x < width; x++, p += 3) {
+            seed = seed * 1664525u + 1013904223u;
+            int noise = static_cast<int>(seed >> 28) - 8;
+            p[0] = static_cast<uint8_t>(std::min(255, std::max(0, x * 255 / width + noise)));
+            p[1] = static_cast<uint8_t>(std::min(255, std::max(0, y * 255 / height + noise)));
+            p[2] = static_cast<uint8_t>(std::min(255, std::max(0, (x + y) * 255 / (width + height) + noise)));
+        }
+    }
+}
+
+struct Result {
+    const char* name;
+    HdrHistogram hist;
+    float max_diff;     // 기존 경로 대비, 0~255 단위
+};
+
+volatile float g_sink;
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+    const char* path = nullptr;
+    int size = 416, repeat = 300;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--size") == 0 && i + 1 < argc)
+            size = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+            repeat = atoi(argv[++i]);
+        else
+            path = argv[i];
+    }
+
+    Image frame;
+    if (path) {
+        if (!loadImage(path, frame)) {
+            fprintf(stderr, "cannot load %s\n", path);
+            return EXIT_FAILURE;
+        }
+    }
+    else {
+        synthesize(frame, 640, 480);
+    }
+
+    size_t elems = static_cast<size_t>(size) * size * 3;
+    std::vector<float> tensor(elems), reference(elems), slot(elems);
+    std::vector<int8_t> tensor_i8(elems);
+    Image resized;
+
+    Preprocessor::Config fused_cfg;
+    fused_cfg.size = size;
+    Preprocessor::Config scalar_cfg = fused_cfg;
+    scalar_cfg.use_simd = false;
+    Preprocessor::Config rgb_cfg = fused_cfg;
+    rgb_cfg.swap_rb = true;
+    Preprocessor::Config int8_cfg = fused_cfg;
+    int8_cfg.type = INPUT_INT8;
+    int8_cfg.q_scale = 1.0f / 255.0f;
+    int8_cfg.q_zero = -128;
+    Preprocessor::Config letterbox_cfg = fused_cfg;
+    letterbox_cfg.letterbox = true;
+
+    Preprocessor fused(fused_cfg), scalar(scalar_cfg), rgb(rgb_cfg), int8(int8_cfg), letterbox(letterbox_cfg);
+
+    static Result results[] = { { "two-pass", HdrHistogram(), 0 },
+                                { "scalar", HdrHistogram(), 0 },
+                                { "simd", HdrHistogram(), 0 },
+                                { "simd rgb", HdrHistogram(), 0 },
+                                { "simd int8", HdrHistogram(), 0 },
+                                { "letterbox", HdrHistogram(), 0 } };
+    const int count = sizeof(results) / sizeof(results[0]);
+
+    // 기준 값 (tflite_yolo_picam.py 와 같은 경로)
+    resizeBilinear(frame, resized, size, size);
+    normalizeToFloat(resized, &reference[0]);
+
+    for (int r = 0; r < repeat; r++) {
+        // 기존 pipeline: 전처리 스레드가 slot 에 float 로 만들고 infer 스레드가 interpreter 입력으로 복사
+        uint64_t t0 = monoNowNs();
+        resizeBilinear(frame, resized, size, size);
+        normalizeToFloat(resized, &slot[0]);
+        memcpy(&tensor[0], &slot[0], elems * sizeof(float));
+        results[0].hist.record(monoNowNs() - t0);
+        g_sink = tensor[elems / 2];
+
+        Preprocessor* impl[] = { &scalar, &fused, &rgb, &int8, &letterbox };
+        for (int k = 0; k < count - 1; k++) {
+            void* out = impl[k] == &int8 ? static_cast<void*>(&tensor_i8[0]) : static_cast<void*>(&tensor[0]);
+            uint64_t s0 = monoNowNs();
+            impl[k]->run(frame, out);
+            results[k + 1].hist.record(monoNowNs() - s0);
+
+            if (r > 0)
+                continue;
+            // 첫 반복에서만 정확도 확인 (letterbox 는 좌표계가 달라 제외)
+            float diff = 0;
+            for (size_t i = 0; i < elems && impl[k] != &letterbox; i++) {
+                size_t ref = impl[k] == &rgb ? i - i % 3 + (2 - i % 3) : i;
+                float v = impl[k] == &int8 ? (tensor_i8[i] + 128) / 255.0f : tensor[i];
+                diff = std::max(diff, std::fabs(v - reference[ref]) * 255.0f);
+            }
+            results[k + 1].max_diff = diff;
+        }
+    }
+
+    fprintf(stderr, "%s: %dx%d -> %dx%d, %d frames, simd=%s\n", path ? path : "synthetic",
+            frame.width, frame.height, size, size, repeat, simdName(fused.simdLevel()));
+    fprintf(stderr, "%-10s %10s %10s %10s %10s %9s\n", "path", "p50 us", "p99 us", "mean us", "speedup", "max diff");
+    double base = results[0].hist.mean();
+    for (int k = 0; k < count; k++) {
+        const HdrHistogram& h = results[k].hist;
+        fprintf(stderr, "%-10s %10.1f %10.1f %10.1f %9.2fx %9.2f\n", results[k].name,
+                h.percentile(0.50) / 1e3, h.percentile(0.99) / 1e3, h.mean() / 1e3,
+                base / std::max(1.0, h.mean()), results[k].max_diff);
+    }
+    fprintf(stderr, "saved per frame: %.1f us (two-pass -> simd)\n", (base - results[2].hist.mean()) / 1e3);
+
+    printf("{\"source\":\"%s\",\"simd\":\"%s\",\"input\":[%d,%d],\"size\":%d,\"frames\":%d,\"benchmarks\":[",
+           path ? path : "synthetic", simdName(fused.simdLevel()), frame.width, frame.height, size, repeat);
+    for (int k = 0; k < count; k++) {
+        const HdrHistogram& h = results[k].hist;
+        printf("%s\n  {\"name\":\"%s\",\"p50_ns\":%llu,\"p99_ns\":%llu,\"mean_ns\":%.0f,\"max_diff\":%.2f}",
+               k ? "," : "", results[k].name,
+               static_cast<unsigned long long>(h.percentile(0.50)),
+               static_cast<unsigned long long>(h.percentile(0.99)), h.mean(), results[k].max_diff);
+    }
+    printf("\n]}\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+// SlidingWindow vs 기존 circular buffer + 매번 합산 비교
+// 사용: ./sliding_window_bench [iterations]
+#include "../core/sliding_window.hpp"
+#include "../core/mono_clock.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+
+namespace {
+
+// 기존 computeTTC / main() 방식: 고정 배열에 넣고 매번 전체 합산, min/max 는 누적
+template <int N>
+struct LegacyWindow {
+    float buf[N] = {0};
+    int   index = 0;
+    float avg = 0.0f;
+    float vmin = 9999.0f;
+    float vmax = -9999.0f;
+
+    void push(float v)
+    {
+        buf[index] = v;
+        index = (index + 1) % N;
+
+        float sum = 0;
+        for (int i = 0; i < N; i++)
+            sum += buf[i];
+        avg  = sum / N;
+        vmin = std::min(vmin, v);
+        vmax = std::max(vmax, v);
+    }
+};
+
+// window 안을 매번 다시 훑는 정확한 min/max (기존 코드로 windowed min/max 를 구했을 때의 비용)
+template <int N>
+struct LegacyWindowedMinMax {
+    float buf[N] = {0};
+    int   index = 0;
+    float avg = 0.0f, vmin = 0.0f, vmax = 0.0f;
+
+    void push(float v)
+    {
+        buf[index] = v;
+        index = (index + 1) % N;
+
+        float sum = 0;
+        vmin = buf[0];
+        vmax = buf[0];
+        for (int i = 0; i < N; i++) {
+            sum += buf[i];
+            vmin = std::min(vmin, buf[i]);
+            vmax = std::max(vmax, buf[i]);
+        }
+        avg = sum / N;
+    }
+};
+
+volatile float g_sink;
+
+float sample(uint32_t& rng)
+{
+    rng = rng * 1664525u + 1013904223u;
+    return static_cast<float>(rng >> 8) / 16777216.0f - 0.5f;
+}
+
+template <typename W>
+double runNsPerPush(W& w, long iters, float (*read)(const W&))
+{
+    uint32_t rng = 1;
+    uint64_t t0 = monoNowNs();
+    for (long i = 0; i < iters; i++) {
+        w.push(sample(rng));
+        g_sink = read(w);
+    }
+    return static_cast<double>(monoNowNs() - t0) / iters;
+}
+
+template <int N> float readLegacy(const LegacyWindow<N>& w) { return w.avg + w.vmin + w.vmax; }
+template <int N> float readLegacyMM(const LegacyWindowedMinMax<N>& w) { return w.avg + w.vmin + w.vmax; }
+template <int N> float readSliding(const SlidingWindow<float, N>& w)
+{
+    return static_cast<float>(w.mean()) + w.min() + w.max();
+}
+
+// 정확성: brute force 와 비교
+template <int N>
+bool verify(long iters)
+{
+    SlidingWindow<float, N> w;
+    LegacyWindowedMinMax<N> ref;
+    uint32_t rng = 7;
+    for (long i = 0; i < iters; i++) {
+        float v = sample(rng);
+        w.push(v);
+        ref.push(v);
+        if (i >= N && (std::fabs(w.mean() - ref.avg) > 1e-5 || w.min() != ref.vmin || w.max() != ref.vmax)) {
+            printf("mismatch at %ld\n", i);
+            return false;
+        }
+    }
+    return true;
+}
+
+template <int N>
+void benchWindow(long iters)
+{
+    LegacyWindow<N> legacy;
+    LegacyWindowedMinMax<N> legacy_mm;
+    SlidingWindow<float, N> sliding;
+
+    double a = runNsPerPush(legacy, iters, &readLegacy<N>);
+    double b = runNsPerPush(legacy_mm, iters, &readLegacyMM<N>);
+    double c = runNsPerPush(sliding, iters, &readSliding<N>);
+
+    printf("N=%-5d legacy(sum, lifetime min/max)=%7.1f ns  legacy(windowed)=%7.1f ns  SlidingWindow=%7.1f ns  verify=%s\n",
+           N, a, b, c, verify<N>(20000) ? "ok" : "FAIL");
+}
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+    long iters = argc > 1 ? atol(argv[1]) : 2000000;
+
+    benchWindow<10>(iters);     // vrel / delta window 크기
+    benchWindow<64>(iters);
+    benchWindow<1024>(iters / 10);
+
+    SlidingQuantile<float, 64> q;
+    uint32_t rng = 3;
+    uint64_t t0 = monoNowNs();
+    for (long i = 0; i < iters; i++) {
+        q.push(sample(rng));
+        g_sink = static_cast<float>(q.median());
+    }
+    printf("SlidingQuantile<64> push+median = %.1f ns\n", static_cast<double>(monoNowNs() - t0) / iters);
+    return 0;
+}
@@ -0,0 +1,270 @@
+// tracker 평가: 검출을 N 프레임마다만 하고 사이를 tracker 로 채울 때 페달 class 결정의 정확도 / 깜빡임 / CPU
+// 발 box 가 ACCEL ↔ BRAKE 영역을 오가는 합성 장면 (30 fps) 에 검출기 흉내 (box 흔들림, 놓침, 오검출) 를 씌우고
+// 매 프레임의 결정 (최고 score box 의 영역, 없으면 NONE) 을 실제 영역과 비교한다.
+// - raw N   : N 프레임마다 검출, 사이 프레임은 마지막 결정 유지 (N=1 이 기존 tflite_yolo_picam.py)
+// - track N : N 프레임마다 검출 + Tracker (사이 프레임은 예측), 결정은 confidence 가 가장 큰 track 의 class
+// 비교 값: 추론 수, 결정 정확도, 깜빡임 (결정이 바뀐 횟수 / 분, 실제 바뀐 횟수와 비교), 실제 class 가 바뀐 뒤 따라가기까지,
+// tracker update / predict 시간 (실제 측정)
+// stdout 에는 JSON, stderr 에는 표.
+//
+// 사용: tracker_bench [--seconds S] [--fps F] [--jitter PX] [--miss P] [--false-pos P] [--min-hits N] [--seed N]
+#include "../vision/tracker.hpp"
+#include "../core/hdr_histogram.hpp"
+#include "../core/mono_clock.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+constexpr int CLASS_FOOT = 0;      // 검출기가 내는 label (장면에 발 하나)
+constexpr float FOOT_W = 90.0f;
+constexpr float FOOT_H = 70.0f;
+
+struct Scene {
+    std::vector<Detection> truth;   // 프레임마다 실제 box
+    std::vector<uint32_t> cls;      // 실제 페달 class
+};
+
+float centerX(const PedalRegion& r) { return (r.xmin + r.xmax) / 2; }
+float centerY(const PedalRegion& r) { return (r.ymin + r.ymax) / 2; }
+
+// ACCEL 에 1~4 s, 0.4 s 동안 이동, BRAKE 에 1~3 s, 이동 ... (영역 안에서도 조금씩 흔들림)
+Scene makeScene(int frames, double fps, std::mt19937& rng)
+{
+    Scene s;
+    s.truth.resize(frames);
+    s.cls.resize(frames);
+    std::uniform_real_distribution<float> hold_accel(1.0f, 4.0f), hold_brake(1.0f, 3.0f);
+    const float move_s = 0.4f;
+    bool on_accel = true;
+    float seg_end = hold_accel(rng);
+    float seg_start = 0;
+    bool moving = false;
+    for (int i = 0; i < frames; i++) {
+        float t = static_cast<float>(i / fps);
+        if (t >= seg_end) {
+            seg_start = seg_end;
+            if (moving) {
+                moving = false;
+                on_accel = !on_accel;
+                seg_end += on_accel ? hold_accel(rng) : hold_brake(rng);
+            }
+            else {
+                moving = true;
+                seg_end += move_s;
+            }
+        }
+        const PedalRegion& from = on_accel ? ACCEL_REGION : BRAKE_REGION;
+        const PedalRegion& to   = on_accel ? BRAKE_REGION : ACCEL_REGION;
+        float a = moving ? (t - seg_start) / move_s : 0.0f;
+        float cx = centerX(from) + (centerX(to) - centerX(from)) * a + 6.0f * std::sin(t * 2.1f);
+        float cy = centerY(from) + (centerY(to) - centerY(from)) * a + 4.0f * std::sin(t * 3.3f);
+        Detection& d = s.truth[i];
+        d.xmin = cx - FOOT_W / 2;
+        d.xmax = cx + FOOT_W / 2;
+        d.ymin = cy - FOOT_H / 2;
+        d.ymax = cy + FOOT_H / 2;
+        d.score = 1.0f;
+        d.label = CLASS_FOOT;
+        s.cls[i] = Tracker::pedalClass(d);
+    }
+    return s;
+}
+
+struct DetectorModel {
+    float jitter, miss, false_pos;
+};
+
+// 검출기 흉내: 실제 box 에 잡음, miss 확률로 놓침, false_pos 확률로 아무 데나 box 하나 더
+int detect(const Detection& truth, const DetectorModel& m, std::mt19937& rng, Detection* out)
+{
+    std::normal_distribution<float> noise(0.0f, m.jitter);
+    std::uniform_real_distribution<float> u(0.0f, 1.0f);
+    int n = 0;
+    if (u(rng) >= m.miss) {
+        Detection d = truth;
+        d.xmin += noise(rng);
+        d.xmax += noise(rng);
+        d.ymin += noise(rng);
+        d.ymax += noise(rng);
+        d.score = 0.5f + 0.4f * u(rng);
+        out[n++] = d;
+    }
+    if (u(rng) < m.false_pos) {
+        Detection d;
+        float cx = 40.0f + 336.0f * u(rng), cy = 40.0f + 336.0f * u(rng);
+        d.xmin = cx - 30;
+        d.xmax = cx + 30;
+        d.ymin = cy - 30;
+        d.ymax = cy + 30;
+        d.score = 0.3f + 0.3f * u(rng);
+        d.label = CLASS_FOOT;
+        out[n++] = d;
+    }
+    return n;
+}
+
+uint32_t decideRaw(const Detection* d, int n)
+{
+    int best = -1;
+    for (int i = 0; i < n; i++)
+        if (best < 0 || d[i].score > d[best].score)
+            best = i;
+    return best < 0 ? DET_NONE : Tracker::pedalClass(d[best]);
+}
+
+uint32_t decideTracks(const Track* t, int n)
+{
+    int best = -1;
+    for (int i = 0; i < n; i++)
+        if (best < 0 || t[i].confidence > t[best].confidence)
+            best = i;
+    return best < 0 ? DET_NONE : t[best].cls;
+}
+
+struct Result {
+    char name[16];
+    int every;
+    bool track;
+    uint64_t inferences = 0;
+    uint64_t correct = 0;
+    uint64_t changes = 0;
+    HdrHistogram lag;           // 실제 class 가 바뀐 뒤 결정이 맞을 때까지 (ns)
+    HdrHistogram update_ns, predict_ns;
+};
+
+void usage()
+{
+    fprintf(stderr, "usage: tracker_bench [--seconds S] [--fps F] [--jitter PX] [--miss P] [--false-pos P]\n"
+                    "                     [--min-hits N] [--seed N]\n");
+}
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+    double seconds = 120.0, fps = 30.0;
+    DetectorModel model = { 6.0f, 0.15f, 0.05f };
+    Tracker::Config tcfg;
+    unsigned seed = 1;
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--seconds") == 0 && has_value)
+            seconds = atof(argv[++i]);
+        else if (strcmp(argv[i], "--fps") == 0 && has_value)
+            fps = atof(argv[++i]);
+        else if (strcmp(argv[i], "--jitter") == 0 && has_value)
+            model.jitter = static_cast<float>(atof(argv[++i]));
+        else if (strcmp(argv[i], "--miss") == 0 && has_value)
+            model.miss = static_cast<float>(atof(argv[++i]));
+        else if (strcmp(argv[i], "--false-pos") == 0 && has_value)
+            model.false_pos = static_cast<float>(atof(argv[++i]));
+        else if (strcmp(argv[i], "--min-hits") == 0 && has_value)
+            tcfg.min_hits = static_cast<uint32_t>(atoi(argv[++i]));
+        else if (strcmp(argv[i], "--seed") == 0 && has_value)
+            seed = static_cast<unsigned>(atoi(argv[++i]));
+        else {
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+    if (seconds <= 0 || fps <= 0) {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    const int frames = static_cast<int>(seconds * fps);
+    const uint64_t frame_ns = static_cast<uint64_t>(1e9 / fps);
+    std::mt19937 scene_rng(seed);
+    Scene scene = makeScene(frames, fps, scene_rng);
+    uint64_t truth_changes = 0;
+    for (int i = 1; i < frames; i++)
+        truth_changes += scene.cls[i] != scene.cls[i - 1];
+
+    static Result results[8];
+    int n_results = 0;
+    for (int track = 0; track < 2; track++)
+        for (int every = 1; every <= 4; every++) {
+            Result& r = results[n_results++];
+            snprintf(r.name, sizeof(r.name), "%s %d", track ? "track" : "raw", every);
+            r.every = every;
+            r.track = track != 0;
+        }
+
+    for (int k = 0; k < n_results; k++) {
+        Result& r = results[k];
+        std::mt19937 det_rng(seed * 7919u + 1);   // 정책마다 같은 검출 잡음 순서
+        Tracker tracker(tcfg);
+        std::vector<Track> tracks(tracker.capacity());
+        Detection dets[4];
+        uint32_t decision = DET_NONE;
+        int64_t changed_at = -1;       // 실제 class 가 바뀐 프레임 (아직 못 따라감)
+        for (int i = 0; i < frames; i++) {
+            uint64_t now = (i + 1) * frame_ns;
+            uint32_t prev = decision;
+            if (i % r.every == 0) {
+                int n = detect(scene.truth[i], model, det_rng, dets);
+                r.inferences++;
+                if (r.track) {
+                    uint64_t t0 = monoNowNs();
+                    int nt = tracker.update(now, dets, n, &tracks[0], static_cast<int>(tracks.size()));
+                    r.update_ns.record(monoNowNs() - t0);
+                    decision = decideTracks(&tracks[0], nt);
+                }
+                else
+                    decision = decideRaw(dets, n);
+            }
+            else if (r.track) {
+                uint64_t t0 = monoNowNs();
+                int nt = tracker.predict(now, &tracks[0], static_cast<int>(tracks.size()));
+                r.predict_ns.record(monoNowNs() - t0);
+                decision = decideTracks(&tracks[0], nt);
+            }
+
+            if (i > 0 && scene.cls[i] != scene.cls[i - 1])
+                changed_at = i;
+            if (changed_at >= 0 && decision == scene.cls[i]) {
+                r.lag.record(static_cast<uint64_t>(i - changed_at) * frame_ns);
+                changed_at = -1;
+            }
+            r.correct += decision == scene.cls[i];
+            r.changes += i > 0 && decision != prev;
+        }
+    }
+
+    double minutes = frames / fps / 60.0;
+    fprintf(stderr, "%d frames (%.0f s at %.0f fps), jitter %.1f px, miss %.2f, false positive %.2f, min_hits %u\n",
+            frames, frames / fps, fps, model.jitter, model.miss, model.false_pos, tcfg.min_hits);
+    fprintf(stderr, "true class changes %.1f /min\n", truth_changes / minutes);
+    fprintf(stderr, "%-9s %6s %9s %11s %10s %10s %11s %11s\n", "policy", "infer", "accuracy", "changes/min",
+            "lag p50", "lag p99", "update us", "predict us");
+    for (int k = 0; k < n_results; k++) {
+        const Result& r = results[k];
+        fprintf(stderr, "%-9s %6llu %8.1f%% %11.1f %8.0fms %8.0fms %11.2f %11.2f\n", r.name,
+                static_cast<unsigned long long>(r.inferences), 100.0 * r.correct / frames, r.changes / minutes,
+                r.lag.percentile(0.50) / 1e6, r.lag.percentile(0.99) / 1e6,
+                r.update_ns.mean() / 1e3, r.predict_ns.mean() / 1e3);
+    }
+
+    printf("{\"frames\":%d,\"fps\":%.1f,\"true_changes_per_min\":%.2f,\"policies\":[", frames, fps,
+           truth_changes / minutes);
+    for (int k = 0; k < n_results; k++) {
+        const Result& r = results[k];
+        printf("%s\n  {\"name\":\"%s\",\"inferences\":%llu,\"accuracy\":%.4f,\"changes_per_min\":%.2f,"
+               "\"lag_p50_ns\":%llu,\"lag_p99_ns\":%llu,\"update_mean_ns\":%.0f,\"predict_mean_ns\":%.0f}",
+               k ? "," : "", r.name, static_cast<unsigned long long>(r.inferences),
+               static_cast<double>(r.correct) / frames, r.changes / minutes,
+               static_cast<unsigned long long>(r.lag.percentile(0.50)),
+               static_cast<unsigned long long>(r.lag.percentile(0.99)),
+               r.update_ns.mean(), r.predict_ns.mean());
+    }
+    printf("\n]}\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,239 @@
+// YOLO 후처리 benchmark: Python filter_boxes + nms 를 그대로 옮긴 reference / scalar / SIMD
+// 기록한 출력 tensor (EAI/lab1-2/bench_postprocess.py --export) 가 있으면 그것을, 없으면 합성 데이터를 쓴다.
+// 세 경로의 결과가 같은지 확인하고 프레임당 시간을 잰다.
+// stdout 에는 JSON, stderr 에는 표.
+//
+// 사용: yolo_post_bench [tensors.bin] [--repeat N]
+#include "../vision/yolo_postprocess.hpp"
+#include "../core/hdr_histogram.hpp"
+#include "../core/mono_clock.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+
+namespace {
+
+constexpr uint32_t TENSOR_MAGIC = 0x544C4F59;   // "YOLT"
+constexpr int MAX_OUT = 64;
+
+struct Tensors {
+    int frames = 0;
+    int num_boxes = 0;
+    int num_classes = 0;
+    std::vector<float> loc;   // [frames][N][4]
+    std::vector<float> cls;   // [frames][N][C]
+
+    const float* boxes(int f) const  { return &loc[static_cast<size_t>(f) * num_boxes * 4]; }
+    const float* scores(int f) const { return &cls[static_cast<size_t>(f) * num_boxes * num_classes]; }
+};
+
+// header: uint32 magic, int32 frames, num_boxes, num_classes / 프레임마다 loc [N][4], cls [N][C] (float32)
+bool loadTensors(const char* path, Tensors& t)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return false;
+    }
+    int32_t header[4];
+    bool ok = fread(header, sizeof(header), 1, fp) == 1 && static_cast<uint32_t>(header[0]) == TENSOR_MAGIC;
+    if (ok) {
+        t.frames = header[1];
+        t.num_boxes = header[2];
+        t.num_classes = header[3];
+        t.loc.resize(static_cast<size_t>(t.frames) * t.num_boxes * 4);
+        t.cls.resize(static_cast<size_t>(t.frames) * t.num_boxes * t.num_classes);
+        for (int f = 0; f < t.frames && ok; f++) {
+            size_t nb = static_cast<size_t>(t.num_boxes) * 4, nc = static_cast<size_t>(t.num_boxes) * t.num_classes;
+            ok = fread(&t.loc[f * nb], sizeof(float), nb, fp) == nb &&
+                 fread(&t.cls[f * nc], sizeof(float), nc, fp) == nc;
+        }
+    }
+    fclose(fp);
+    if (!ok)
+        fprintf(stderr, "bad tensor file %s\n", path);
+    return ok;
+}
+
+// yolov4-tiny 416 출력과 비슷한 분포: 대부분 낮은 score, 물체 몇 개 주변에 겹치는 box 묶음
+void synthesize(Tensors& t, int frames)
+{
+    t.frames = frames;
+    t.num_boxes = 2535;
+    t.num_classes = 80;
+    t.loc.resize(static_cast<size_t>(frames) * t.num_boxes * 4);
+    t.cls.resize(static_cast<size_t>(frames) * t.num_boxes * t.num_classes);
+
+    uint32_t seed = 12345;
+    auto rnd = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return (seed >> 8) / 16777216.0f;
+    };
+
+    for (int f = 0; f < frames; f++) {
+        float* loc = &t.loc[static_cast<size_t>(f) * t.num_boxes * 4];
+        float* cls = &t.cls[static_cast<size_t>(f) * t.num_boxes * t.num_classes];
+        for (int i = 0; i < t.num_boxes; i++) {
+            loc[i * 4 + 0] = rnd() * 416;
+            loc[i * 4 + 1] = rnd() * 416;
+            loc[i * 4 + 2] = 10 + rnd() * 100;
+            loc[i * 4 + 3] = 10 + rnd() * 100;
+            for (int c = 0; c < t.num_classes; c++)
+                cls[i * t.num_classes + c] = rnd() * 0.05f;
+        }
+        int objects = 3 + f % 5;
+        for (int o = 0; o < objects; o++) {
+            float cx = 40 + rnd() * 336, cy = 40 + rnd() * 336, w = 30 + rnd() * 120, h = 30 + rnd() * 120;
+            int label = static_cast<int>(rnd() * 10);
+            for (int k = 0; k < 25; k++) {
+                int i = static_cast<int>(rnd() * t.num_boxes);
+                loc[i * 4 + 0] = cx + (rnd() - 0.5f) * 20;
+                loc[i * 4 + 1] = cy + (rnd() - 0.5f) * 20;
+                loc[i * 4 + 2] = w * (0.8f + rnd() * 0.4f);
+                loc[i * 4 + 3] = h * (0.8f + rnd() * 0.4f);
+                cls[i * t.num_classes + label] = 0.15f + rnd() * 0.8f;
+            }
+        }
+    }
+}
+
+// tflite_yolo_picam.py filter_boxes + nms 를 그대로 (box 마다 argmax, 매번 vector, IoU 나눗셈)
+int referencePostprocess(const float* boxes, const float* scores, int n, int classes, Detection* out, int max_out)
+{
+    std::vector<Detection> cand;
+    for (int i = 0; i < n; i++) {
+        const float* s = scores + static_cast<size_t>(i) * classes;
+        int best = static_cast<int>(std::max_element(s, s + classes) - s);
+        if (s[best] < 0.2f)
+            continue;
+        const float* b = boxes + i * 4;
+        Detection d = { b[1] - b[3] / 2, b[0] - b[2] / 2, b[1] + b[3] / 2, b[0] + b[2] / 2, s[best], best };
+        cand.push_back(d);
+    }
+    std::vector<int> idxs(cand.size());
+    for (size_t i = 0; i < idxs.size(); i++)
+        idxs[i] = static_cast<int>(i);
+    std::stable_sort(idxs.begin(), idxs.end(), [&](int a, int b) { return cand[a].score > cand[b].score; });
+
+    int kept = 0;
+    while (!idxs.empty() && kept < max_out) {
+        int i = idxs[0];
+        out[kept++] = cand[i];
+        std::vector<int> rest;
+        for (size_t k = 1; k < idxs.size(); k++) {
+            int j = idxs[k];
+            if (!(cand[j].label == cand[i].label && iou(cand[i], cand[j]) > 0.3f))
+                rest.push_back(j);
+        }
+        idxs.swap(rest);
+    }
+    return kept;
+}
+
+bool sameResult(const Detection* a, int na, const Detection* b, int nb)
+{
+    if (na != nb)
+        return false;
+    for (int i = 0; i < na; i++) {
+        if (a[i].label != b[i].label || a[i].score != b[i].score ||
+            std::fabs(a[i].xmin - b[i].xmin) > 1e-3f || std::fabs(a[i].ymax - b[i].ymax) > 1e-3f)
+            return false;
+    }
+    return true;
+}
+
+struct Result {
+    const char* name;
+    HdrHistogram hist;
+    long mismatches;
+};
+
+volatile int g_sink;
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+    const char* path = nullptr;
+    int repeat = 20;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--repeat") == 0 && i + 1 < argc)
+            repeat = atoi(argv[++i]);
+        else
+            path = argv[i];
+    }
+
+    Tensors t;
+    if (path) {
+        if (!loadTensors(path, t))
+            return EXIT_FAILURE;
+    }
+    else {
+        synthesize(t, 50);
+    }
+
+    YoloPostprocessor::Config scalar_cfg;
+    scalar_cfg.use_simd = false;
+    YoloPostprocessor scalar(t.num_boxes, t.num_classes, scalar_cfg);
+    YoloPostprocessor simd(t.num_boxes, t.num_classes);
+
+    static Result results[3] = { { "reference", HdrHistogram(), 0 },
+                                 { "scalar", HdrHistogram(), 0 },
+                                 { "simd", HdrHistogram(), 0 } };
+
+    Detection ref[MAX_OUT], out[MAX_OUT];
+    long candidates = 0, detections = 0;
+    for (int r = 0; r < repeat; r++) {
+        for (int f = 0; f < t.frames; f++) {
+            uint64_t t0 = monoNowNs();
+            int nref = referencePostprocess(t.boxes(f), t.scores(f), t.num_boxes, t.num_classes, ref, MAX_OUT);
+            uint64_t t1 = monoNowNs();
+            results[0].hist.record(t1 - t0);
+
+            YoloPostprocessor* impl[2] = { &scalar, &simd };
+            for (int k = 0; k < 2; k++) {
+                uint64_t s0 = monoNowNs();
+                int n = impl[k]->run(t.boxes(f), t.scores(f), out, MAX_OUT);
+                uint64_t s1 = monoNowNs();
+                results[k + 1].hist.record(s1 - s0);
+                results[k + 1].mismatches += !sameResult(ref, nref, out, n);
+                g_sink = n;
+            }
+            if (r == 0) {
+                candidates += simd.candidates();
+                detections += nref;
+            }
+        }
+    }
+
+    fprintf(stderr, "%s: %d frames x %d, %d boxes x %d classes, %.1f candidates / %.1f detections per frame, simd=%s\n",
+            path ? path : "synthetic", t.frames, repeat, t.num_boxes, t.num_classes,
+            static_cast<double>(candidates) / t.frames, static_cast<double>(detections) / t.frames,
+            simdName(simd.simdLevel()));
+    fprintf(stderr, "%-10s %10s %10s %10s %10s %9s\n", "path", "p50 us", "p99 us", "mean us", "speedup", "mismatch");
+    double ref_mean = results[0].hist.mean();
+    for (int k = 0; k < 3; k++) {
+        const HdrHistogram& h = results[k].hist;
+        fprintf(stderr, "%-10s %10.1f %10.1f %10.1f %9.2fx %9ld\n", results[k].name,
+                h.percentile(0.50) / 1e3, h.percentile(0.99) / 1e3, h.mean() / 1e3,
+                ref_mean / std::max(1.0, h.mean()), results[k].mismatches);
+    }
+
+    printf("{\"source\":\"%s\",\"simd\":\"%s\",\"frames\":%d,\"benchmarks\":[", path ? path : "synthetic",
+           simdName(simd.simdLevel()), t.frames * repeat);
+    for (int k = 0; k < 3; k++) {
+        const HdrHistogram& h = results[k].hist;
+        printf("%s\n  {\"name\":\"%s\",\"p50_ns\":%llu,\"p99_ns\":%llu,\"mean_ns\":%.0f,\"mismatches\":%ld}",
+               k ? "," : "", results[k].name,
+               static_cast<unsigned long long>(h.percentile(0.50)),
+               static_cast<unsigned long long>(h.percentile(0.99)), h.mean(), results[k].mismatches);
+    }
+    printf("\n]}\n");
+
+    return (results[1].mismatches || results[2].mismatches) ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+#include "misop_fsm.hpp"
+#include <algorithm>
+#include <cstring>
+
+
+namespace {
+
+constexpr uint8_t ANY_STATE  = 0xff;
+constexpr uint8_t NOT_LOCKED = (1 << MISOP_NORMAL) | (1 << MISOP_TTC_LIMITED) | (1 << MISOP_BRAKE_ASSIST);
+constexpr uint8_t LOCKED     = 1 << MISOP_LOCKOUT;
+constexpr int     SAME       = -1;
+
+// from 상태 중 하나이고 입력에 require bit 가 모두 있으면 next 로 (SAME: 그대로)
+struct Rule {
+    uint8_t  from;
+    uint8_t  require;
+    int      next;
+    uint16_t actions;
+};
+
+// 주 규칙: 위에서부터 처음 맞는 하나
+const Rule RULES[] = {
+    // 잠금 해제 (그 주기는 misop 유지, 스로틀은 운전자 입력)
+    { LOCKED,     MISOP_IN_EXPIRED,
+      MISOP_NORMAL,      MISOP_ACT_MISOP | MISOP_ACT_BUZZER_STOP | MISOP_ACT_DISPLAY_OFF },
+    // 잠금 중: 스로틀 0
+    { LOCKED,     0,
+      SAME,              MISOP_ACT_MISOP | MISOP_ACT_THROTTLE_ZERO | MISOP_ACT_SHOW_LOCKOUT },
+    // ACCEL 검출 + stomp: 잠금 시작
+    { NOT_LOCKED, MISOP_IN_ACCEL | MISOP_IN_STOMP,
+      MISOP_LOCKOUT,     MISOP_ACT_MISOP | MISOP_ACT_CONSUME_STOMP | MISOP_ACT_THROTTLE_ZERO | MISOP_ACT_BEEP_LOCKOUT },
+    // ACCEL 검출 + 페달을 밟는 중: TTC 상한, TTC 가 낮으면 경고
+    { NOT_LOCKED, MISOP_IN_ACCEL | MISOP_IN_RISING | MISOP_IN_TTC_LOW,
+      MISOP_TTC_LIMITED, MISOP_ACT_MISOP | MISOP_ACT_THROTTLE_CAP | MISOP_ACT_BEEP_TTC },
+    // 기존 코드의 "else stopBuzzer()" 는 없음: 경고음이 blocking (play → delay → stop) 이라 여기 올 때는 항상 꺼져 있었음
+    // (지금은 패턴이 스스로 끝나므로 멈출 것이 없다)
+    { NOT_LOCKED, MISOP_IN_ACCEL | MISOP_IN_RISING,
+      MISOP_TTC_LIMITED, MISOP_ACT_THROTTLE_CAP },
+    { NOT_LOCKED, 0,
+      MISOP_NORMAL,      0 },
+};
+
+// 주 규칙 결과에 더해지는 규칙: BRAKE 검출 + stomp 면 급제동 보조 (잠금이면 상태는 잠금 유지)
+const Rule BRAKE_RULE = {
+    ANY_STATE, MISOP_IN_BRAKE | MISOP_IN_STOMP,
+    MISOP_BRAKE_ASSIST, MISOP_ACT_CONSUME_STOMP | MISOP_ACT_REQUEST_STOP | MISOP_ACT_BEEP_BRAKE | MISOP_ACT_SHOW_BRAKE
+};
+
+bool matches(const Rule& r, int state, int inputs)
+{
+    return (r.from & (1 << state)) && (inputs & r.require) == r.require;
+}
+
+struct Table {
+    MisopFsm::Cell cells[MISOP_STATE_COUNT][MISOP_INPUT_COMBOS];
+
+    Table()
+    {
+        for (int s = 0; s < MISOP_STATE_COUNT; s++)
+            for (int in = 0; in < MISOP_INPUT_COMBOS; in++) {
+                MisopFsm::Cell& c = cells[s][in];
+                c.next = static_cast<uint8_t>(s);
+                c.actions = 0;
+                for (size_t k = 0; k < sizeof(RULES) / sizeof(RULES[0]); k++)
+                    if (matches(RULES[k], s, in)) {
+                        c.next = static_cast<uint8_t>(RULES[k].next == SAME ? s : RULES[k].next);
+                        c.actions = RULES[k].actions;
+                        break;
+                    }
+                if (matches(BRAKE_RULE, s, in)) {
+                    c.actions |= BRAKE_RULE.actions;
+                    if (c.next != MISOP_LOCKOUT)
+                        c.next = static_cast<uint8_t>(BRAKE_RULE.next);
+                }
+            }
+    }
+};
+
+const Table& table()
+{
+    static const Table t;
+    return t;
+}
+
+} // namespace
+
+constexpr int MisopFsm::HISTORY;
+
+
+MisopFsm::MisopFsm() : MisopFsm(Config()) {}
+
+MisopFsm::MisopFsm(const Config& config) : cfg_(config)
+{
+    memset(history_, 0, sizeof(history_));
+    table();    // 제어 주기 전에 표를 만들어 둠
+}
+
+const MisopFsm::Cell& MisopFsm::cell(MisopState state, uint8_t inputs)
+{
+    return table().cells[state][inputs & (MISOP_INPUT_COMBOS - 1)];
+}
+
+const char* MisopFsm::stateName(MisopState state)
+{
+    static const char* names[MISOP_STATE_COUNT] = { "NORMAL", "TTC_LIMITED", "LOCKOUT", "BRAKE_ASSIST" };
+    return state < MISOP_STATE_COUNT ? names[state] : "?";
+}
+
+uint16_t MisopFsm::step(uint64_t now_ns, uint8_t inputs)
+{
+    uint64_t now_ms = now_ns / 1000000ull;
+    inputs &= static_cast<uint8_t>(~MISOP_IN_EXPIRED);
+    if (state_ == MISOP_LOCKOUT && now_ms - entered_ms_ >= cfg_.lockout_ms)
+        inputs |= MISOP_IN_EXPIRED;
+
+    const Cell& c = table().cells[state_][inputs];
+    // LOCKOUT 으로 다시 들어가는 일은 없으므로 (잠금 중 규칙은 SAME) 진입 시각은 상태가 바뀔 때만 갱신
+    if (c.next != state_) {
+        MisopTransition& t = history_[transitions_ % HISTORY];
+        t.t_ns   = now_ns;
+        t.from   = state_;
+        t.to     = c.next;
+        t.inputs = inputs;
+        transitions_++;
+        state_      = c.next;
+        entered_ns_ = now_ns;
+        entered_ms_ = now_ms;
+    }
+    return c.actions;
+}
+
+int MisopFsm::history(MisopTransition* out, int max) const
+{
+    int n = static_cast<int>(std::min<uint64_t>(transitions_, HISTORY));
+    n = std::min(n, max);
+    for (int i = 0; i < n; i++)
+        out[i] = history_[(transitions_ - n + i) % HISTORY];
+    return n;
+}
@@ -0,0 +1,97 @@
+#ifndef MISOP_FSM_HPP
+#define MISOP_FSM_HPP
+
+#include <cstdint>
+
+// 오조작 / 잠금 판단 상태
+// - NORMAL      : 운전자 입력 그대로
+// - TTC_LIMITED : ACCEL 검출 + 페달을 밟는 중 → TTC 로 스로틀 상한 (TTC 가 낮으면 경고음)
+// - LOCKOUT     : ACCEL 검출 + stomp → lockout_ms 동안 스로틀 0 (이 상태만 시간이 지나야 빠져나감)
+// - BRAKE_ASSIST: BRAKE 검출 + stomp → 급제동 보조 요청 (LOCKOUT 중이면 상태는 LOCKOUT 유지, 동작만 함께)
+// LOCKOUT 외에는 주기마다 그 주기의 입력으로 다시 정해짐
+enum MisopState : uint8_t {
+    MISOP_NORMAL = 0,
+    MISOP_TTC_LIMITED,
+    MISOP_LOCKOUT,
+    MISOP_BRAKE_ASSIST,
+    MISOP_STATE_COUNT
+};
+
+// 한 주기의 입력 (bit)
+enum MisopInput : uint8_t {
+    MISOP_IN_ACCEL   = 1 << 0,    // 이번 주기에 ACCEL 검출
+    MISOP_IN_BRAKE   = 1 << 1,    // 이번 주기에 BRAKE 검출
+    MISOP_IN_STOMP   = 1 << 2,    // 처리하지 않은 최근 stomp
+    MISOP_IN_RISING  = 1 << 3,    // 페달 window 변화량 > 0
+    MISOP_IN_TTC_LOW = 1 << 4,    // TTC <= 경고 기준
+    MISOP_IN_EXPIRED = 1 << 5,    // 잠금 시간이 지남 (MisopFsm 이 채움)
+    MISOP_INPUT_COMBOS = 1 << 6
+};
+
+// 전이에 따라 실행할 동작 (bit, 제어 쪽이 아래 순서대로 장치에 명령)
+enum MisopAction : uint16_t {
+    MISOP_ACT_MISOP          = 1 << 0,    // log 의 misop_flag
+    MISOP_ACT_THROTTLE_ZERO  = 1 << 1,
+    MISOP_ACT_THROTTLE_CAP   = 1 << 2,    // computeCap(TTC) → computeThrottleCmd
+    MISOP_ACT_CONSUME_STOMP  = 1 << 3,
+    MISOP_ACT_BEEP_LOCKOUT   = 1 << 4,
+    MISOP_ACT_BEEP_TTC       = 1 << 5,
+    MISOP_ACT_BUZZER_STOP    = 1 << 6,    // 잠금 경고음만 끔 (다른 경고는 그대로)
+    MISOP_ACT_SHOW_LOCKOUT   = 1 << 7,
+    MISOP_ACT_DISPLAY_OFF    = 1 << 8,
+    MISOP_ACT_REQUEST_STOP   = 1 << 9,
+    MISOP_ACT_BEEP_BRAKE     = 1 << 10,
+    MISOP_ACT_SHOW_BRAKE     = 1 << 11
+};
+
+// 상태가 바뀐 기록 (진입 시각)
+struct MisopTransition {
+    uint64_t t_ns;
+    uint8_t  from;
+    uint8_t  to;
+    uint8_t  inputs;
+};
+
+// 표 기반 상태 기계
+// 규칙 (misop_fsm.cpp 의 RULES, 위에서부터 먼저 맞는 것) 을 처음 한 번 [상태][입력 조합] 표로 펼쳐 두고
+// step() 은 표 한 칸을 읽어 상태를 바꾸고 동작 bit 를 돌려줌 (분기 / 할당 없음, 장치는 건드리지 않음)
+// 같은 입력 순서면 같은 결과이므로 replay 와 모든 [상태][입력] 조합을 그대로 확인할 수 있다 (cell()).
+class MisopFsm {
+public:
+    struct Config {
+        uint32_t lockout_ms = 3000;
+    };
+
+    struct Cell {
+        uint8_t  next;
+        uint16_t actions;
+    };
+
+    static constexpr int HISTORY = 16;
+
+    MisopFsm();
+    explicit MisopFsm(const Config& config);
+
+    // 이번 주기 입력 → 실행할 동작, 상태가 바뀌면 now_ns 를 진입 시각으로 기록
+    uint16_t step(uint64_t now_ns, uint8_t inputs);
+
+    MisopState state()       const { return static_cast<MisopState>(state_); }
+    uint64_t   enteredNs()   const { return entered_ns_; }
+    uint64_t   transitions() const { return transitions_; }
+    const MisopTransition& lastTransition() const { return history_[(transitions_ + HISTORY - 1) % HISTORY]; }
+    // 최근 전이를 오래된 것부터 max 개까지, 개수 반환
+    int history(MisopTransition* out, int max) const;
+
+    static const Cell& cell(MisopState state, uint8_t inputs);
+    static const char* stateName(MisopState state);
+
+private:
+    Config cfg_;
+    uint8_t  state_ = MISOP_NORMAL;
+    uint64_t entered_ns_ = 0;
+    uint64_t entered_ms_ = 0;           // 잠금 시간 비교는 기존과 같이 ms 단위
+    uint64_t transitions_ = 0;
+    MisopTransition history_[HISTORY];
+};
+
+#endif
@@ -0,0 +1,271 @@
+#include "mispedal_controller.hpp"
+#include "../core/detection_channel.hpp"
+#include "../core/event_log.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+namespace {
+
+// task 별 주기 (Hz)
+constexpr double CONTROL_RATE_HZ = 100.0;
+constexpr double ULTRA_RATE_HZ   = 20.0;   // echo timeout(40ms) < 주기(50ms)
+constexpr double LOG_RATE_HZ     = 20.0;
+
+// 스로틀 급변(stomp) 이벤트는 PedalSampler(1kHz) 가 감지, 이후 STOMP_HOLD_MS 동안 YOLO 이벤트와 짝지을 수 있음
+constexpr uint64_t STOMP_HOLD_MS = 200;
+
+constexpr uint32_t LOCKOUT_DURATION_MS = 3000; // 3초 (3000 ms)
+constexpr double   TTC_WARN_S          = 1.86;  // 이하이면 충돌 경고 (TTC_LIMITED 중)
+
+// 경고음 (tone Hz, on ms, off ms, 반복, priority): 부저 쪽이 시간에 맞춰 울리고 제어는 요청만
+// - 충돌 경고: TTC 가 낮은 동안 매 주기 요청, 한 번이 끝나면 다시 울림
+// - 잠금: 잠금 시간 동안 반복, 풀리면 stop()
+// - 급제동 보조: 높은 음으로 짧게 세 번
+constexpr int NOTE_HZ      = 440;      // A4 (기존 softTone NOTE)
+constexpr int NOTE_HIGH_HZ = 880;
+const BeepPattern BEEP_TTC     = { NOTE_HZ, 200, 100, 1, 1 };
+const BeepPattern BEEP_LOCKOUT = { NOTE_HZ, 200, 100, LOCKOUT_DURATION_MS / 300, 2 };
+const BeepPattern BEEP_BRAKE   = { NOTE_HIGH_HZ, 100, 50, 3, 3 };
+
+// sample 나이 (ms), 아직 sample 이 없으면 -1
+float ageMs(uint64_t now_ns, uint64_t sample_ns)
+{
+    if (sample_ns == 0)
+        return -1.0f;
+    return now_ns > sample_ns ? (now_ns - sample_ns) / 1e6f : 0.0f;
+}
+
+} // namespace
+
+
+MispedalController::MispedalController(const Devices& devices, int scenario_id)
+    : dev_(devices), scenario_id_(scenario_id), fsm_(fsmConfig())
+{
+    if (dev_.clock == nullptr)
+        dev_.clock = &systemClock();
+}
+
+void MispedalController::addTasks(PeriodicScheduler& sched)
+{
+    // 같은 주기에서는 등록 순서대로 실행: control → ultrasonic → log
+    sched.addTask("control", CONTROL_RATE_HZ, [this](uint64_t now_ns) { controlTask(now_ns); });
+    sched.addTask("ultrasonic", ULTRA_RATE_HZ, [this](uint64_t now_ns) { rangeTask(now_ns); });
+    sched.addTask("log", LOG_RATE_HZ, [this](uint64_t now_ns) { logTask(now_ns); });
+}
+
+MisopFsm::Config MispedalController::fsmConfig()
+{
+    MisopFsm::Config cfg;
+    cfg.lockout_ms = LOCKOUT_DURATION_MS;
+    return cfg;
+}
+
+// 상태 진입 시각을 남김 (잠금 / 급제동 보조는 warn, 주기마다 바뀔 수 있는 NORMAL ↔ TTC_LIMITED 는 debug)
+void MispedalController::logTransition(const MisopTransition& t)
+{
+    const char* from = MisopFsm::stateName(static_cast<MisopState>(t.from));
+    const char* to   = MisopFsm::stateName(static_cast<MisopState>(t.to));
+    if (t.to == MISOP_LOCKOUT || t.to == MISOP_BRAKE_ASSIST)
+        LOG_WARN("misop {} -> {} at {} ms (inputs {})", from, to, t.t_ns / 1000000ull, t.inputs);
+    else if (t.from == MISOP_LOCKOUT)
+        LOG_INFO("misop {} -> {} at {} ms, lockout {} ms", from, to, t.t_ns / 1000000ull,
+                 (t.t_ns - lockout_entered_ns_) / 1000000ull);
+    else
+        LOG_DEBUG("misop {} -> {} at {} ms (inputs {})", from, to, t.t_ns / 1000000ull, t.inputs);
+    if (t.to == MISOP_LOCKOUT)
+        lockout_entered_ns_ = t.t_ns;
+}
+
+// 구동 직전에 결정 시각(첫 구동 기준), 직후에 구동 발행 완료 시각(마지막 구동 기준)
+void MispedalController::markDecided()
+{
+    if (dev_.tracer && traced_count_ > 0 && decide_ns_ == 0)
+        decide_ns_ = dev_.clock->nowNs();
+}
+
+void MispedalController::markActuated()
+{
+    if (dev_.tracer && traced_count_ > 0)
+        actuate_ns_ = dev_.clock->nowNs();
+}
+
+void MispedalController::beep(const BeepPattern& pattern)
+{
+    markDecided();
+    dev_.buzzer->play(pattern);
+    markActuated();
+}
+
+// ---- 초음파: 새 측정이 있으면 TTC / ΔDistance 갱신
+void MispedalController::rangeTask(uint64_t)
+{
+    float d = 0.0f;
+    uint64_t t_meas = 0;
+    if (!dev_.range->poll(d, t_meas))
+        return;
+
+    if (dev_.recorder)
+        dev_.recorder->record(t_meas, TRACE_RANGE, d);
+
+    distance_ = d;
+    range_ns_ = t_meas;
+    ttc_ = dev_.ultra->computeTTC(distance_, t_meas);
+
+    // ------------------------------
+    // ΔDistance 계산
+    float delta = 0.0f;
+    if (prev_distance_ > 0) {
+        delta = std::fabs(distance_ - prev_distance_);
+    }
+    prev_distance_ = distance_;
+
+    // sliding window 에 저장 + 평균 (O(1))
+    delta_window_.push(delta);
+    delta_avg_ = static_cast<float>(delta_window_.mean());
+}
+
+// ==================== 오조작 감지 및 3초 잠금 로직 =====================
+void MispedalController::controlTask(uint64_t now_ns)
+{
+    int misop_flag = 0;
+
+    // ====== YOLO 이벤트 수집 (syscall 없음)
+    bool accel_detected = false;
+    bool brake_detected = false;
+    DetectionEvent ev;
+    uint64_t consume_ns = dev_.tracer ? dev_.clock->nowNs() : 0;
+    traced_count_ = 0;
+    decide_ns_ = 0;
+    actuate_ns_ = 0;
+    while (dev_.detections && dev_.detections->poll(ev)) {
+        if (dev_.tracer && traced_count_ < MAX_TRACED) {
+            StageStamps& st = traced_[traced_count_++];
+            st.t[STAGE_CAPTURE] = ev.timestamp_ns;
+            st.t[STAGE_INFER]   = ev.infer_ns;
+            st.t[STAGE_PUBLISH] = ev.publish_ns;
+            st.t[STAGE_CONSUME] = consume_ns;
+            st.t[STAGE_DECIDE]  = 0;
+            st.t[STAGE_ACTUATE] = 0;
+        }
+
+        if (dev_.recorder)
+            dev_.recorder->record(now_ns, TRACE_DETECT, static_cast<float>(ev.cls));
+
+        if (ev.cls == DET_ACCEL) {
+            accel_detected = true;
+            latency_ = static_cast<int64_t>(now_ns - ev.timestamp_ns) / 1e9;   // 같은 CLOCK_MONOTONIC 기준
+            LOG_INFO(">>> ACCEL detected (latency {} sec)", latency_);
+        }
+        else if (ev.cls == DET_BRAKE) {
+            brake_detected = true;
+            LOG_INFO(">>> BRAKE detected");
+        }
+    }
+
+    // 페달 상태: ADC 를 직접 읽지 않고 샘플링 스레드의 최신값 사용
+    PedalState pedal_state = dev_.pedal->latest();
+    voltage_ = pedal_state.voltage;
+    thr_raw_ = pedal_state.thr_raw;
+    pedal_ns_ = pedal_state.timestamp_ns;
+    float delta_thr = pedal_state.delta_window;
+
+    // 최신값만 쓰면 100Hz 로 줄어드므로 샘플링 스레드가 남긴 샘플을 모두 기록 (PedalSampler::Config::record)
+    if (dev_.recorder) {
+        PedalSample sample;
+        while (dev_.pedal->popSample(sample))
+            dev_.recorder->record(sample.timestamp_ns, TRACE_PEDAL, sample.voltage);
+    }
+
+    // 아직 처리하지 않은 최근 stomp
+    bool stomp = pedal_state.stomp_count != stomp_consumed_ &&
+                 static_cast<int64_t>(now_ns - pedal_state.stomp_ns) <= static_cast<int64_t>(STOMP_HOLD_MS * 1000000ull);
+
+    // 판단: 입력 bit → 상태 기계 표 한 칸 (상태 / 동작), 장치 명령은 아래에서 동작 bit 순서대로
+    uint8_t inputs = 0;
+    if (accel_detected)   inputs |= MISOP_IN_ACCEL;
+    if (brake_detected)   inputs |= MISOP_IN_BRAKE;
+    if (stomp)            inputs |= MISOP_IN_STOMP;
+    if (delta_thr > 0.0f) inputs |= MISOP_IN_RISING;
+    if (ttc_ <= TTC_WARN_S) inputs |= MISOP_IN_TTC_LOW;
+
+    MisopState prev_state = fsm_.state();
+    uint16_t act = fsm_.step(now_ns, inputs);
+    if (fsm_.state() != prev_state)
+        logTransition(fsm_.lastTransition());
+
+    thr_cmd_ = thr_raw_;
+    if (act & MISOP_ACT_MISOP)
+        misop_flag = 1;
+    if (act & MISOP_ACT_CONSUME_STOMP)
+        stomp_consumed_ = pedal_state.stomp_count;
+    if (act & MISOP_ACT_THROTTLE_ZERO)
+        thr_cmd_ = 0.0f;
+    if (act & MISOP_ACT_THROTTLE_CAP) {
+        float cap = dev_.hall->computeCap(ttc_);
+        thr_cmd_ = dev_.hall->computeThrottleCmd(thr_raw_, cap);
+    }
+    if (act & MISOP_ACT_BEEP_LOCKOUT)
+        beep(BEEP_LOCKOUT);
+    if (act & MISOP_ACT_BEEP_TTC)
+        beep(BEEP_TTC);
+    if (act & MISOP_ACT_BUZZER_STOP)
+        dev_.buzzer->cancel(BEEP_LOCKOUT.priority);     // 잠금 경고음만 (울리는 중인 급제동 경고는 그대로)
+    if (act & MISOP_ACT_SHOW_LOCKOUT)
+        dev_.display->show("LOCKOUT ACTIVE", "Accelerate: 0%");
+    if (act & MISOP_ACT_DISPLAY_OFF)
+        dev_.display->off();   // 백라이트 OFF
+    if (act & MISOP_ACT_REQUEST_STOP) {
+        markDecided();
+        dev_.brake->requestStop();
+        markActuated();
+    }
+    if (act & MISOP_ACT_BEEP_BRAKE)
+        beep(BEEP_BRAKE);
+    if (act & MISOP_ACT_SHOW_BRAKE)
+        dev_.display->show("Hard Brake Detected", "Assist Mode Activated");
+
+    // 이번 주기에 들어온 검출의 결정 / 구동 시각 기록 (구동이 없으면 판단이 끝난 지금이 결정 시각)
+    if (traced_count_ > 0) {
+        uint64_t decide_ns = decide_ns_ ? decide_ns_ : dev_.clock->nowNs();
+        for (int i = 0; i < traced_count_; i++) {
+            traced_[i].t[STAGE_DECIDE]  = decide_ns;
+            traced_[i].t[STAGE_ACTUATE] = actuate_ns_;
+            dev_.tracer->record(traced_[i]);
+        }
+    }
+
+    ctl_delta_thr_ = delta_thr;
+    log_accel_ = log_accel_ || accel_detected;
+    log_brake_ = log_brake_ || brake_detected;
+    log_misop_ = log_misop_ | misop_flag;
+    log_delta_thr_ = std::max(log_delta_thr_, delta_thr);
+}
+
+// ---- log.csv (기존 열 + 끝에 sample 나이, flag 들은 직전 행 이후 누적값)
+void MispedalController::logTask(uint64_t now_ns)
+{
+    LogRecord rec;
+    rec.distance_cm    = distance_;
+    rec.ttc            = ttc_;
+    rec.v_rel          = dev_.ultra->getVrel();
+    rec.voltage        = voltage_;
+    rec.raw_percent    = thr_raw_;
+    rec.cmd_percent    = thr_cmd_;
+    rec.delta_thr_raw  = log_delta_thr_;
+    rec.scenario       = scenario_id_;
+    rec.accel_detected = log_accel_;
+    rec.brake_detected = log_brake_;
+    rec.accel_latency  = latency_;
+    rec.misop_flag     = log_misop_;
+    rec.pedal_age_ms   = ageMs(now_ns, pedal_ns_);
+    rec.range_age_ms   = ageMs(now_ns, range_ns_);
+    rec.misop_state    = fsm_.state();
+    dev_.log->log(rec);
+
+    log_accel_ = false;
+    log_brake_ = false;
+    log_misop_ = 0;
+    log_delta_thr_ = ctl_delta_thr_;
+    latency_ = -1;
+}
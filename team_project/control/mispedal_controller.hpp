@@ -0,0 +1,107 @@
+#ifndef MISPEDAL_CONTROLLER_HPP
+#define MISPEDAL_CONTROLLER_HPP
+
+#include "misop_fsm.hpp"
+#include "../core/hal.hpp"
+#include "../core/clock.hpp"
+#include "../core/csv_logger.hpp"
+#include "../core/latency_trace.hpp"
+#include "../core/scheduler.hpp"
+#include "../core/sliding_window.hpp"
+#include "../core/trace.hpp"
+#include "../sensors/ultrasonic.hpp"
+#include "../sensors/hall_sensor.hpp"
+#include "../sensors/pedal_sampler.hpp"
+#include <cstdint>
+
+// 오조작 감지 + 3초 잠금 제어 루프 (mispedal_main 과 mispedal_replay 가 같이 사용)
+// 입력/장치를 모두 주입받으므로 Pi 에서의 실시간 실행과 trace replay 가 같은 판단 코드를 탄다.
+// 시각은 scheduler 가 넘겨주는 now_ns 만 사용 (replay 에서는 SimClock 시각)
+// 모든 task 는 같은 PeriodicScheduler 스레드에서 실행된다.
+class MispedalController {
+public:
+    struct Devices {
+        RangeSource*     range      = nullptr;
+        DetectionSource* detections = nullptr;   // 없으면 YOLO 이벤트 없음
+        PedalSampler*    pedal      = nullptr;   // latest() 만 사용
+        Ultrasonic*      ultra      = nullptr;   // 거리 → TTC
+        MCP3208*         hall       = nullptr;   // computeCap / computeThrottleCmd
+        BuzzerDevice*    buzzer     = nullptr;
+        StatusDisplay*   display    = nullptr;
+        BrakeAssist*     brake      = nullptr;
+        LogSink*         log        = nullptr;
+        TraceWriter*     recorder   = nullptr;   // 입력 기록 (없으면 기록 안 함, 페달은 Config::record 로 만든 sampler 필요)
+        LatencyTracer*   tracer     = nullptr;   // 검출 → 구동 단계별 latency (없으면 안 잼)
+        Clock*           clock      = nullptr;   // tracer 단계 시각, 없으면 systemClock()
+    };
+
+    MispedalController(const Devices& devices, int scenario_id);
+
+    // ultrasonic / control / log task 등록
+    void addTasks(PeriodicScheduler& sched);
+
+    // task 본체 (addTasks 가 등록하는 것과 같음)
+    void rangeTask(uint64_t now_ns);
+    void controlTask(uint64_t now_ns);
+    void logTask(uint64_t now_ns);
+
+    // status 출력용
+    float distance()  const { return distance_; }
+    float ttc()       const { return ttc_; }
+    float deltaAvg()  const { return delta_avg_; }
+    float voltage()   const { return voltage_; }
+    float thrRaw()    const { return thr_raw_; }
+    float thrCmd()    const { return thr_cmd_; }
+    float deltaThr()  const { return ctl_delta_thr_; }
+    bool  lockedOut() const { return fsm_.state() == MISOP_LOCKOUT; }
+    const MisopFsm& fsm() const { return fsm_; }
+
+private:
+    static constexpr int DELTA_WINDOW = 10;   // 최근 10개로 평균
+
+    Devices dev_;
+    int scenario_id_;
+
+    // 페달 (PedalSampler 최신값 복사본)
+    float voltage_ = 0.0f;
+    float thr_raw_ = 0.0f;
+    uint64_t pedal_ns_ = 0;             // 마지막으로 읽은 sample 시각 (log 의 pedal_age_ms)
+    uint32_t stomp_consumed_ = 0;       // 이미 처리한 stomp_count
+
+    // 초음파
+    float distance_      = 0.0f;
+    float prev_distance_ = -1.0f;
+    float ttc_           = INFINITY;
+    uint64_t range_ns_   = 0;            // 마지막 측정 시각 (log 의 range_age_ms)
+    float delta_avg_     = 0.0f;
+    SlidingWindow<float, DELTA_WINDOW> delta_window_;
+
+    double latency_ = -1;
+
+    // control 결과
+    float thr_cmd_ = 0.0f;
+    float ctl_delta_thr_ = 0.0f;
+    MisopFsm fsm_;                       // 오조작 / 잠금 상태 (진입 시각 포함)
+    uint64_t lockout_entered_ns_ = 0;
+
+    // 로그 한 줄 동안 누적되는 값
+    bool  log_accel_ = false;
+    bool  log_brake_ = false;
+    int   log_misop_ = 0;
+    float log_delta_thr_ = 0.0f;
+
+    // 이번 control 주기에 꺼낸 검출 이벤트의 단계 시각 (tracer 용)
+    static constexpr int MAX_TRACED = 8;
+    StageStamps traced_[MAX_TRACED];
+    int traced_count_ = 0;
+    uint64_t decide_ns_  = 0;
+    uint64_t actuate_ns_ = 0;
+
+    static MisopFsm::Config fsmConfig();
+    void logTransition(const MisopTransition& t);
+    void beep(const BeepPattern& pattern);
+    void markDecided();
+    void markActuated();
+};
+
+#endif
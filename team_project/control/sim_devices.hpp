@@ -0,0 +1,68 @@
+#ifndef SIM_DEVICES_HPP
+#define SIM_DEVICES_HPP
+
+#include "../core/clock.hpp"
+#include "../core/hal.hpp"
+#include <cstdint>
+#include <vector>
+
+// 하드웨어 없는 실행(replay / bench)용 출력 장치: 호출 횟수만 센다
+struct CountingBuzzer : public BuzzerDevice {
+    uint64_t beeps = 0;
+    void play(const BeepPattern&) override { beeps++; }
+    void cancel(int) override {}
+    void stop() override {}
+};
+
+// 시뮬레이션 부저 출력: BuzzerSequencer 가 실제로 울린 시각을 기록 (replay 에서 패턴 타이밍 확인)
+struct SimTone : public ToneOutput {
+    struct Edge {
+        uint64_t t_ns;
+        int      hz;       // 0: 꺼짐
+    };
+
+    explicit SimTone(Clock& clock) : clock_(clock) {}
+
+    void tone(int hz) override
+    {
+        if (edges.empty() ? hz != 0 : edges.back().hz != hz)
+            edges.push_back(Edge{ clock_.nowNs(), hz });
+    }
+
+    // 켜진 횟수
+    uint64_t beeps() const
+    {
+        uint64_t n = 0;
+        for (size_t i = 0; i < edges.size(); i++)
+            n += edges[i].hz != 0 && (i == 0 || edges[i - 1].hz == 0);
+        return n;
+    }
+
+    // 울린 시간 합 (end_ns 에 아직 울리고 있으면 거기까지)
+    uint64_t onNs(uint64_t end_ns) const
+    {
+        uint64_t sum = 0;
+        for (size_t i = 0; i < edges.size(); i++)
+            if (edges[i].hz != 0)
+                sum += (i + 1 < edges.size() ? edges[i + 1].t_ns : end_ns) - edges[i].t_ns;
+        return sum;
+    }
+
+    std::vector<Edge> edges;
+
+private:
+    Clock& clock_;
+};
+
+struct CountingDisplay : public StatusDisplay {
+    uint64_t shows = 0;
+    void show(const char*, const char*) override { shows++; }
+    void off() override {}
+};
+
+struct CountingBrake : public BrakeAssist {
+    uint64_t stops = 0;
+    void requestStop() override { stops++; }
+};
+
+#endif
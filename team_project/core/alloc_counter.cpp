@@ -0,0 +1,48 @@
+#include "alloc_counter.hpp"
+#include <cstdlib>
+#include <new>
+
+
+namespace {
+
+thread_local uint64_t t_allocs = 0;
+
+void* countedAlloc(size_t size)
+{
+    t_allocs++;
+    return malloc(size ? size : 1);
+}
+
+} // namespace
+
+
+uint64_t threadAllocCount()
+{
+    return t_allocs;
+}
+
+void* operator new(size_t size)
+{
+    void* p = countedAlloc(size);
+    if (p == nullptr)
+        throw std::bad_alloc();
+    return p;
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAlloc(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return countedAlloc(size);
+}
+
+void operator delete(void* p) noexcept   { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
@@ -0,0 +1,12 @@
+#ifndef ALLOC_COUNTER_HPP
+#define ALLOC_COUNTER_HPP
+
+#include <cstdint>
+
+// 호출한 스레드가 지금까지 한 heap 할당 (operator new) 횟수
+// alloc_counter.cpp 가 전역 operator new 를 바꿔서 센다 (mispedal_core 를 링크한 실행 파일 전체, 카운터는 thread_local)
+// scheduler 가 task 마다 앞뒤 차이를 TaskStats::allocs 에 쌓고, bench --check 가 0 인지 확인한다.
+// malloc 을 직접 부르는 C 코드는 세지 않음
+uint64_t threadAllocCount();
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef BOUNDED_QUEUE_HPP
+#define BOUNDED_QUEUE_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <vector>
+
+// 고정 크기 blocking queue (pipeline stage 사이, 생산자/소비자 여러 개 가능)
+// - 메모리는 생성할 때 잡음 → push/pop 에서 할당 없음
+// - 가득 차면 push 가, 비면 pop 이 기다림 (backpressure)
+// - close() 후 push 는 실패, pop 은 남은 것을 다 꺼낸 뒤 false
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(size_t capacity) : buf_(capacity) {}
+
+    bool push(const T& item)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return count_ < buf_.size() || closed_; });
+        if (closed_)
+            return false;
+        put(item);
+        lock.unlock();
+        not_empty_.notify_one();
+        return true;
+    }
+
+    bool tryPush(const T& item)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (closed_ || count_ == buf_.size())
+            return false;
+        put(item);
+        lock.unlock();
+        not_empty_.notify_one();
+        return true;
+    }
+
+    bool pop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [this] { return count_ > 0 || closed_; });
+        if (count_ == 0)
+            return false;
+        take(item);
+        lock.unlock();
+        not_full_.notify_one();
+        return true;
+    }
+
+    bool tryPop(T& item)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (count_ == 0)
+            return false;
+        take(item);
+        lock.unlock();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        not_full_.notify_all();
+        not_empty_.notify_all();
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return count_;
+    }
+
+private:
+    std::vector<T> buf_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    bool closed_ = false;
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_full_;
+    std::condition_variable not_empty_;
+
+    void put(const T& item)
+    {
+        buf_[(head_ + count_) % buf_.size()] = item;
+        count_++;
+    }
+
+    void take(T& item)
+    {
+        item = buf_[head_];
+        head_ = (head_ + 1) % buf_.size();
+        count_--;
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+};
+
+#endif
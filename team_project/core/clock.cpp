@@ -0,0 +1,24 @@
+#include "clock.hpp"
+#include "mono_clock.hpp"
+#include <cerrno>
+#include <time.h>
+
+
+uint64_t MonotonicClock::nowNs()
+{
+    return monoNowNs();
+}
+
+void MonotonicClock::sleepUntil(uint64_t t_ns)
+{
+    struct timespec ts;
+    ts.tv_sec  = static_cast<time_t>(t_ns / 1000000000ull);
+    ts.tv_nsec = static_cast<long>(t_ns % 1000000000ull);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+}
+
+Clock& systemClock()
+{
+    static MonotonicClock clock;
+    return clock;
+}
@@ -0,0 +1,43 @@
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+#include <cstdint>
+
+// 시간 인터페이스 (scheduler / 센서 polling 이 micros()/millis() 대신 사용)
+// - MonotonicClock: 실제 CLOCK_MONOTONIC + clock_nanosleep
+// - SimClock      : replay 용 가상 시간, sleepUntil() 은 기다리지 않고 시각만 옮김
+class Clock {
+public:
+    virtual ~Clock() {}
+
+    virtual uint64_t nowNs() = 0;
+    virtual void sleepUntil(uint64_t t_ns) = 0;
+
+    uint64_t nowUs() { return nowNs() / 1000ull; }
+    void sleepFor(uint64_t dt_ns) { sleepUntil(nowNs() + dt_ns); }
+};
+
+class MonotonicClock : public Clock {
+public:
+    uint64_t nowNs() override;
+    void sleepUntil(uint64_t t_ns) override;
+};
+
+class SimClock : public Clock {
+public:
+    explicit SimClock(uint64_t start_ns = 0) : now_ns_(start_ns) {}
+
+    uint64_t nowNs() override { return now_ns_; }
+    void sleepUntil(uint64_t t_ns) override { if (t_ns > now_ns_) now_ns_ = t_ns; }
+
+    void set(uint64_t t_ns) { now_ns_ = t_ns; }
+    void advance(uint64_t dt_ns) { now_ns_ += dt_ns; }
+
+private:
+    uint64_t now_ns_;
+};
+
+// 프로세스 공용 MonotonicClock (clock 을 주입하지 않은 경우의 기본값)
+Clock& systemClock();
+
+#endif
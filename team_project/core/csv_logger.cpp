@@ -0,0 +1,210 @@
+#include "csv_logger.hpp"
+#include "mono_clock.hpp"
+#include "event_log.hpp"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+const char* CsvLogger::header()
+{
+    return "distance_cm,ttc,v_rel,voltage,raw_percent,cmd_percent,delta_thr_raw,scenario,accel_detected,brake_detected,accel_latency,misop_flag,pedal_age_ms,range_age_ms,misop_state\n";
+}
+
+CsvLogger::~CsvLogger()
+{
+    close();
+}
+
+bool CsvLogger::open(const std::string& path, const Policy& policy)
+{
+    if (fd_ >= 0)
+        return true;
+
+    // 기존 std::ofstream(std::ios::out) 과 같이 매번 새로 씀
+    fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        std::cerr << "log open failed: " << path << " (" << strerror(errno) << ")" << std::endl;
+        return false;
+    }
+
+    policy_ = policy;
+    failed_ = false;
+    if (!writeAll(header(), strlen(header()))) {
+        std::cerr << "log header write failed: " << path << " (" << strerror(errno) << ")" << std::endl;
+        ::close(fd_);
+        fd_ = -1;
+        return false;
+    }
+
+    running_ = true;
+    writer_ = std::thread(&CsvLogger::writerLoop, this);
+    return true;
+}
+
+void CsvLogger::close()
+{
+    if (fd_ < 0)
+        return;
+
+    running_ = false;
+    if (writer_.joinable())
+        writer_.join();
+
+    // 쓰기 실패 뒤 ring 에 남은 행도 잃은 것으로 셈 (writer 가 끝났으므로 여기서 읽어도 됨)
+    if (failed_.load())
+        dropped_.fetch_add(ring_.size(), std::memory_order_relaxed);
+
+    ::close(fd_);
+    fd_ = -1;
+}
+
+bool CsvLogger::log(const LogRecord& rec)
+{
+    if (!ring_.push(rec)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint32_t depth = ring_.size();
+    if (depth > max_depth_.load(std::memory_order_relaxed))
+        max_depth_.store(depth, std::memory_order_relaxed);
+    return true;
+}
+
+int CsvLogger::format(char* out, size_t size, const LogRecord& rec)
+{
+    // %g 는 std::ostream 기본 출력(precision 6)과 같은 형식 → 기존 log.csv 와 동일
+    return snprintf(out, size, "%g,%g,%g,%g,%g,%g,%g,%d,%d,%d,%g,%d,%g,%g,%d\n",
+                    rec.distance_cm, rec.ttc, rec.v_rel, rec.voltage,
+                    rec.raw_percent, rec.cmd_percent, rec.delta_thr_raw,
+                    rec.scenario, rec.accel_detected ? 1 : 0, rec.brake_detected ? 1 : 0,
+                    rec.accel_latency, rec.misop_flag, rec.pedal_age_ms, rec.range_age_ms, rec.misop_state);
+}
+
+bool CsvLogger::writeAll(const char* buf, size_t len)
+{
+    while (len > 0) {
+        ssize_t n = ::write(fd_, buf, len);
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        buf += n;
+        len -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+void CsvLogger::fail(const char* what, size_t rows)
+{
+    dropped_.fetch_add(rows, std::memory_order_relaxed);
+    failed_.store(true, std::memory_order_relaxed);
+    LOG_ERROR("log.csv {} failed (errno {}), {} row(s) lost, logging stopped", what, errno, rows);
+}
+
+bool CsvLogger::flushText(size_t len, size_t rows)
+{
+    if (writeAll(text_, len))
+        return true;
+    fail("write", rows);
+    return false;
+}
+
+size_t CsvLogger::drain()
+{
+    size_t rows = 0;        // 쓴 행
+    size_t pending = 0;     // text_ 에 있고 아직 쓰지 않은 행
+    size_t used = 0;
+    LogRecord rec;
+
+    while (!failed_.load(std::memory_order_relaxed) && ring_.pop(rec)) {
+        int n = format(text_ + used, TEXT_BUFFER - used, rec);
+        if (n > 0)
+            used += static_cast<size_t>(n);
+        pending++;
+
+        // 버퍼가 거의 차면 한 번 내보냄
+        if (TEXT_BUFFER - used < MAX_LINE) {
+            if (!flushText(used, pending))
+                break;
+            rows += pending;
+            pending = 0;
+            used = 0;
+        }
+    }
+
+    if (used > 0 && flushText(used, pending))
+        rows += pending;
+
+    written_.fetch_add(rows, std::memory_order_relaxed);
+    return rows;
+}
+
+void CsvLogger::writerLoop()
+{
+    uint32_t unsynced = 0;
+    uint64_t last_sync_ms = monoNowNs() / 1000000ull;
+
+    while (true) {
+        bool stopping = !running_.load();
+        unsynced += static_cast<uint32_t>(drain());
+
+        uint64_t now_ms = monoNowNs() / 1000000ull;
+        if (unsynced > 0 && !failed_.load(std::memory_order_relaxed) &&
+            (stopping || unsynced >= policy_.sync_every_records ||
+             now_ms - last_sync_ms >= policy_.sync_every_ms)) {
+            // 지연 할당 file system 은 여기서 ENOSPC / EIO 를 알려줌 (이미 센 행이라 dropped 는 그대로)
+            if (fdatasync(fd_) < 0 && errno != EINVAL)
+                fail("fdatasync", 0);
+            unsynced = 0;
+            last_sync_ms = now_ms;
+        }
+
+        if (stopping)
+            break;
+        usleep(policy_.poll_interval_ms * 1000);
+    }
+}
+
+
+// ================= CsvFileWriter =================
+
+bool CsvFileWriter::open(const std::string& path)
+{
+    if (fp_ != nullptr)
+        return true;
+
+    fp_ = fopen(path.c_str(), "w");
+    if (fp_ == nullptr) {
+        std::cerr << "log open failed: " << path << " (" << strerror(errno) << ")" << std::endl;
+        return false;
+    }
+    fputs(CsvLogger::header(), fp_);
+    return true;
+}
+
+void CsvFileWriter::close()
+{
+    if (fp_ == nullptr)
+        return;
+    fclose(fp_);
+    fp_ = nullptr;
+}
+
+bool CsvFileWriter::log(const LogRecord& rec)
+{
+    if (fp_ == nullptr)
+        return false;
+
+    char line[256];
+    int n = CsvLogger::format(line, sizeof(line), rec);
+    if (n <= 0 || fwrite(line, 1, static_cast<size_t>(n), fp_) != static_cast<size_t>(n))
+        return false;
+    written_++;
+    return true;
+}
@@ -0,0 +1,125 @@
+#ifndef CSV_LOGGER_HPP
+#define CSV_LOGGER_HPP
+
+#include "spsc_ring.hpp"
+#include <atomic>
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <thread>
+
+// log.csv 한 행 (analyze.py / measurment.py 가 읽는 스키마와 같은 순서)
+// distance_cm .. misop_flag 는 기존 열 그대로, 그 뒤에 열을 덧붙이기만 함 (스크립트는 열 이름으로 읽으므로 영향 없음)
+//   pedal_age_ms, range_age_ms : 센서 sample 나이 (ms, 아직 sample 이 없으면 -1)
+//   misop_state                : 그 행의 MisopFsm 상태 번호
+//                                0 NORMAL, 1 TTC_LIMITED, 2 LOCKOUT, 3 BRAKE_ASSIST
+//                                misop_flag 는 직전 행 이후 한 번이라도 오조작이면 1 (누적), misop_state 는 쓰는 순간의 상태
+struct LogRecord {
+    float  distance_cm;
+    float  ttc;
+    float  v_rel;
+    float  voltage;
+    float  raw_percent;
+    float  cmd_percent;
+    float  delta_thr_raw;
+    int    scenario;
+    bool   accel_detected;
+    bool   brake_detected;
+    double accel_latency;
+    int    misop_flag;
+    float  pedal_age_ms;     // 이 행을 쓸 때 페달 / 초음파 최신 sample 의 나이 (센서 스레드가 밀리면 커짐)
+    float  range_age_ms;
+    int    misop_state;      // 이 행을 쓸 때의 MisopState (위 설명)
+};
+
+// LogRecord 를 받는 쪽 (제어 루프는 이것만 본다)
+class LogSink {
+public:
+    virtual ~LogSink() {}
+    virtual bool log(const LogRecord& rec) = 0;
+};
+
+// 비동기 CSV logger
+// 제어 스레드는 log() 로 ring 에 넣기만 하고 (lock-free, 할당 없음),
+// 별도 writer 스레드가 모아서 포맷 → write() → fdatasync() 한다.
+// ring 이 가득 차면 행을 버리고 dropped 를 올린다.
+// write / fdatasync 가 실패하면 (디스크 가득 참, I/O 오류) 그 버퍼의 행을 dropped 로 세고 더는 쓰지 않음
+// → 이후 행은 ring 이 차면서 dropped 로 셈 (failed() 로 확인)
+class CsvLogger : public LogSink {
+public:
+    struct Policy {
+        uint32_t sync_every_records = 50;    // N 행마다 fdatasync
+        uint32_t sync_every_ms      = 1000;  // 또는 T ms 마다
+        uint32_t poll_interval_ms   = 20;    // writer 가 ring 을 확인하는 주기
+    };
+
+    CsvLogger() {}
+    ~CsvLogger();
+
+    bool open(const std::string& path, const Policy& policy);
+    bool open(const std::string& path) { return open(path, Policy()); }
+    void close();   // 남은 행을 모두 쓰고 writer 종료
+
+    bool log(const LogRecord& rec) override;
+
+    uint64_t dropped()       const { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t written()       const { return written_.load(std::memory_order_relaxed); }
+    uint32_t queueDepth()    const { return ring_.size(); }
+    uint32_t maxQueueDepth() const { return max_depth_.load(std::memory_order_relaxed); }
+    bool     failed()        const { return failed_.load(std::memory_order_relaxed); }
+
+    static const char* header();
+    static int format(char* out, size_t size, const LogRecord& rec);   // 한 행 + '\n'
+
+private:
+    static constexpr uint32_t RING_SIZE   = 1024;
+    static constexpr size_t   MAX_LINE    = 224;
+    static constexpr size_t   TEXT_BUFFER = 64 * 1024;
+
+    SpscRing<LogRecord, RING_SIZE> ring_;
+    int fd_ = -1;
+    Policy policy_;
+
+    std::thread writer_;
+    std::atomic<bool> running_{false};
+
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> written_{0};
+    std::atomic<uint32_t> max_depth_{0};
+    std::atomic<bool>     failed_{false};
+
+    char text_[TEXT_BUFFER];
+
+    void writerLoop();
+    size_t drain();                      // ring → text_ → write(), 쓴 행 수
+    bool flushText(size_t len, size_t rows);    // 실패하면 rows 를 dropped 로 세고 failed_
+    bool writeAll(const char* buf, size_t len);
+    void fail(const char* what, size_t rows);
+
+    CsvLogger(const CsvLogger&) = delete;
+    CsvLogger& operator=(const CsvLogger&) = delete;
+};
+
+
+// 동기 CSV writer (replay / 오프라인 도구용, 행을 버리지 않음)
+// 형식은 CsvLogger 와 같으므로 실제 log.csv 와 그대로 diff 할 수 있다.
+class CsvFileWriter : public LogSink {
+public:
+    CsvFileWriter() {}
+    ~CsvFileWriter() { close(); }
+
+    bool open(const std::string& path);
+    void close();
+
+    bool log(const LogRecord& rec) override;
+    uint64_t written() const { return written_; }
+
+private:
+    FILE* fp_ = nullptr;
+    uint64_t written_ = 0;
+
+    CsvFileWriter(const CsvFileWriter&) = delete;
+    CsvFileWriter& operator=(const CsvFileWriter&) = delete;
+};
+
+#endif
@@ -0,0 +1,211 @@
+#include "detection_channel.hpp"
+#include "mono_clock.hpp"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+namespace {
+
+constexpr uint32_t CHANNEL_MAGIC   = 0x44455431;   // "DET1"
+constexpr uint32_t CHANNEL_VERSION = 3;   // 2: DetectionEvent 에 infer_ns / publish_ns 추가, 3: futex 대기 필드 제거
+
+enum : uint32_t { INIT_NONE = 0, INIT_BUSY = 1, INIT_DONE = 2 };
+
+} // namespace
+
+
+// head 와 tail 은 서로 다른 cache line 에 둔다 (생산자/소비자 false sharing 방지)
+struct DetectionChannel::Shared {
+    std::atomic<uint32_t> init_state;
+    uint32_t magic;
+    uint32_t version;
+    uint32_t capacity;
+
+    alignas(64) std::atomic<uint32_t> head;       // 생산자만 씀
+    std::atomic<uint32_t> dropped;
+    uint32_t next_seq;
+
+    alignas(64) std::atomic<uint32_t> tail;       // 소비자만 씀
+
+    alignas(64) DetectionEvent events[CAPACITY];
+};
+
+
+DetectionChannel::~DetectionChannel()
+{
+    close();
+}
+
+bool DetectionChannel::open(const char* name, Role role)
+{
+    if (shm_ != nullptr)
+        return true;
+
+    int fd = shm_open(name, O_RDWR | O_CREAT, 0666);
+    if (fd < 0) {
+        std::cerr << "shm_open failed: " << name << " (" << strerror(errno) << ")" << std::endl;
+        return false;
+    }
+
+    // 같은 크기로의 ftruncate 는 양쪽에서 호출해도 안전 (새 영역은 0 으로 채워짐)
+    if (ftruncate(fd, sizeof(Shared)) < 0) {
+        std::cerr << "ftruncate failed (" << strerror(errno) << ")" << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    void* p = mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        std::cerr << "mmap failed (" << strerror(errno) << ")" << std::endl;
+        return false;
+    }
+
+    Shared* shm = static_cast<Shared*>(p);
+
+    // 먼저 도착한 쪽이 초기화, 나머지는 끝날 때까지 대기
+    uint32_t state = INIT_NONE;
+    if (shm->init_state.compare_exchange_strong(state, INIT_BUSY)) {
+        shm->magic    = CHANNEL_MAGIC;
+        shm->version  = CHANNEL_VERSION;
+        shm->capacity = CAPACITY;
+        shm->init_state.store(INIT_DONE, std::memory_order_release);
+    }
+    else {
+        uint64_t deadline = monoNowNs() + INIT_TIMEOUT_MS * 1000000ull;
+        while (shm->init_state.load(std::memory_order_acquire) != INIT_DONE) {
+            if (monoNowNs() > deadline) {
+                std::cerr << "detection channel init never finished (creator died?): " << name
+                          << ", remove /dev/shm" << name << std::endl;
+                munmap(p, sizeof(Shared));
+                return false;
+            }
+            usleep(100);
+        }
+    }
+
+    if (shm->magic != CHANNEL_MAGIC || shm->version != CHANNEL_VERSION || shm->capacity != CAPACITY) {
+        std::cerr << "detection channel layout mismatch: " << name << std::endl;
+        munmap(p, sizeof(Shared));
+        return false;
+    }
+
+    if (role == CONSUMER) {
+        uint32_t head = shm->head.load(std::memory_order_acquire);
+        uint32_t left = head - shm->tail.load(std::memory_order_relaxed);
+        shm->tail.store(head, std::memory_order_release);
+        if (left > 0)
+            std::cerr << "detection channel: discarded " << left << " stale event(s) from a previous run" << std::endl;
+        stale_ += left;
+    }
+
+    shm_ = shm;
+    return true;
+}
+
+void DetectionChannel::close()
+{
+    if (shm_ != nullptr) {
+        munmap(shm_, sizeof(Shared));
+        shm_ = nullptr;
+    }
+}
+
+bool DetectionChannel::publish(DetectionEvent& event)
+{
+    uint32_t head = shm_->head.load(std::memory_order_relaxed);
+    uint32_t tail = shm_->tail.load(std::memory_order_acquire);
+    if (head - tail >= CAPACITY) {
+        shm_->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    event.seq = shm_->next_seq++;
+    event.publish_ns = monoNowNs();
+    shm_->events[head & (CAPACITY - 1)] = event;
+    shm_->head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+bool DetectionChannel::tryPop(DetectionEvent& event)
+{
+    uint32_t tail = shm_->tail.load(std::memory_order_relaxed);
+    uint32_t head = shm_->head.load(std::memory_order_acquire);
+    if (tail == head)
+        return false;
+
+    event = shm_->events[tail & (CAPACITY - 1)];
+    shm_->tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool DetectionChannel::poll(DetectionEvent& event)
+{
+    if (!isOpen())
+        return false;
+
+    uint64_t now = monoNowNs();
+    while (tryPop(event)) {
+        // timestamp 가 now 보다 뒤면 (다른 clock 기준 등) 나이를 알 수 없으므로 그대로 사용
+        if (event.timestamp_ns > now || now - event.timestamp_ns <= max_age_ns_)
+            return true;
+        stale_++;
+    }
+    return false;
+}
+
+uint32_t DetectionChannel::dropped() const
+{
+    return shm_->dropped.load(std::memory_order_relaxed);
+}
+
+uint32_t DetectionChannel::size() const
+{
+    return shm_->head.load(std::memory_order_acquire) - shm_->tail.load(std::memory_order_acquire);
+}
+
+
+// ================= C API =================
+
+void* detection_channel_open(const char* name)
+{
+    DetectionChannel* ch = new DetectionChannel();
+    if (!ch->open(name != nullptr ? name : DETECTION_CHANNEL_NAME)) {
+        delete ch;
+        return nullptr;
+    }
+    return ch;
+}
+
+int detection_channel_publish(void* handle, uint32_t cls, uint32_t label, float confidence,
+                              float xmin, float ymin, float xmax, float ymax,
+                              uint64_t timestamp_ns, uint64_t infer_ns)
+{
+    DetectionEvent ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.cls          = cls;
+    ev.label        = label;
+    ev.confidence   = confidence;
+    ev.xmin         = xmin;
+    ev.ymin         = ymin;
+    ev.xmax         = xmax;
+    ev.ymax         = ymax;
+    ev.timestamp_ns = timestamp_ns != 0 ? timestamp_ns : monoNowNs();
+    ev.infer_ns     = infer_ns;
+    return static_cast<DetectionChannel*>(handle)->publish(ev) ? 1 : 0;
+}
+
+uint32_t detection_channel_dropped(void* handle)
+{
+    return static_cast<DetectionChannel*>(handle)->dropped();
+}
+
+void detection_channel_close(void* handle)
+{
+    delete static_cast<DetectionChannel*>(handle);
+}
@@ -0,0 +1,95 @@
+#ifndef DETECTION_CHANNEL_HPP
+#define DETECTION_CHANNEL_HPP
+
+#include "hal.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// YOLO 프로세스 → 제어 프로세스 검출 이벤트 채널
+// POSIX shared memory 위의 단일 생산자/단일 소비자 ring buffer.
+// - publish / tryPop 은 syscall 없이 atomic 연산만 사용
+// - 소비자 (제어 루프) 는 scheduler 주기마다 poll() 로 비우고, 기다리는 것은 scheduler 의 다음 release 까지 잠드는 것뿐
+//   (채널에서 잠들면 다른 task 가 밀리므로 blocking pop 은 두지 않음)
+// - 가득 차면 새 이벤트를 버리고 dropped 를 올린다
+// - ring 은 /dev/shm 에 남으므로 소비자는 열 때 남아 있던 이벤트를 버리고,
+//   poll() 은 캡처 시각이 max_age 보다 오래된 이벤트를 버린다 (제어 쪽이 멈췄다 다시 돈 경우 등)
+
+constexpr const char* DETECTION_CHANNEL_NAME = "/mispedal_detect";
+
+enum DetectionClass : uint32_t {
+    DET_NONE  = 0,
+    DET_ACCEL = 1,
+    DET_BRAKE = 2,
+};
+
+// Python binding(ctypes) 과 같은 layout 이어야 함 → 고정 크기 필드만 사용
+struct DetectionEvent {
+    uint32_t cls;            // DetectionClass
+    uint32_t label;          // YOLO class id (COCO)
+    float    confidence;
+    float    xmin, ymin, xmax, ymax;    // 입력 이미지(IMG_SIZE) 좌표
+    uint32_t reserved;
+    uint64_t timestamp_ns;   // CLOCK_MONOTONIC (프레임 캡처 시각)
+    uint64_t seq;            // 생산자가 매기는 일련번호
+    uint64_t infer_ns;       // 추론 + 후처리 완료 시각 (모르면 0)
+    uint64_t publish_ns;     // publish() 가 ring 에 넣은 시각 (publish 가 채움)
+};
+
+static_assert(sizeof(DetectionEvent) == 64, "DetectionEvent layout changed");
+static_assert(ATOMIC_INT_LOCK_FREE == 2, "shared memory ring needs lock-free atomics");
+
+class DetectionChannel : public DetectionSource {
+public:
+    static constexpr uint32_t CAPACITY = 64;    // 2의 거듭제곱
+    static constexpr uint64_t DEFAULT_MAX_AGE_NS = 300000000ull;   // 300ms (검출 주기 + 추론 시간보다 충분히 김)
+    static constexpr int      INIT_TIMEOUT_MS    = 1000;
+
+    enum Role { PRODUCER, CONSUMER };
+
+    DetectionChannel() {}
+    ~DetectionChannel();
+
+    // 어느 쪽이 먼저 실행되든 같은 함수로 연다 (없으면 생성 + 초기화)
+    // 다른 프로세스가 초기화하는 중이면 INIT_TIMEOUT_MS 까지 기다리고, 그 안에 끝나지 않으면 (초기화 중 죽음) 실패
+    // CONSUMER 는 이전 실행에서 남은 이벤트를 버림 (tail = head, tail 은 소비자만 쓰므로 안전)
+    bool open(const char* name = DETECTION_CHANNEL_NAME, Role role = PRODUCER);
+    void close();
+    bool isOpen() const { return shm_ != nullptr; }
+
+    // 생산자
+    bool publish(DetectionEvent& event);
+
+    // 소비자
+    bool tryPop(DetectionEvent& event);
+
+    // DetectionSource (닫혀 있으면 항상 false), max_age 보다 오래된 이벤트는 버리고 다음 것
+    bool poll(DetectionEvent& event) override;
+    void setMaxAgeNs(uint64_t max_age_ns) { max_age_ns_ = max_age_ns; }
+
+    uint32_t dropped() const;
+    uint32_t size() const;
+    uint64_t stale() const { return stale_; }       // poll() 이 오래돼서 버린 수 (open 때 버린 것 포함)
+
+private:
+    struct Shared;
+    Shared* shm_ = nullptr;
+    uint64_t max_age_ns_ = DEFAULT_MAX_AGE_NS;
+    uint64_t stale_ = 0;
+
+    DetectionChannel(const DetectionChannel&) = delete;
+    DetectionChannel& operator=(const DetectionChannel&) = delete;
+};
+
+
+// ---- Python(ctypes) 용 C API
+extern "C" {
+    void* detection_channel_open(const char* name);
+    int   detection_channel_publish(void* handle, uint32_t cls, uint32_t label, float confidence,
+                                    float xmin, float ymin, float xmax, float ymax,
+                                    uint64_t timestamp_ns, uint64_t infer_ns);
+    uint32_t detection_channel_dropped(void* handle);
+    void  detection_channel_close(void* handle);
+}
+
+#endif
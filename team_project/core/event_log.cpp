@@ -0,0 +1,239 @@
+#include "event_log.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+
+
+namespace {
+
+constexpr size_t OUT_BUFFER  = 64 * 1024;
+constexpr size_t MAX_LINE    = 512;
+
+const char* levelName(LogLevel level)
+{
+    switch (level) {
+    case LogLevel::Debug: return "DEBUG";
+    case LogLevel::Info:  return "INFO ";
+    case LogLevel::Warn:  return "WARN ";
+    case LogLevel::Error: return "ERROR";
+    default:              return "?    ";
+    }
+}
+
+const char* baseName(const char* path)
+{
+    const char* slash = strrchr(path, '/');
+    return slash ? slash + 1 : path;
+}
+
+int formatArg(char* out, size_t size, const LogArg& a)
+{
+    switch (a.type) {
+    case LogArg::INT:    return snprintf(out, size, "%lld", static_cast<long long>(a.i));
+    case LogArg::UINT:   return snprintf(out, size, "%llu", static_cast<unsigned long long>(a.u));
+    case LogArg::DOUBLE: return snprintf(out, size, "%g", a.d);
+    case LogArg::STR:    return snprintf(out, size, "%s", a.s ? a.s : "(null)");
+    }
+    return 0;
+}
+
+bool lessTime(const EventLog::Entry& a, const EventLog::Entry& b)
+{
+    return a.t_ns < b.t_ns;
+}
+
+} // namespace
+
+
+std::atomic<int> EventLog::level_(static_cast<int>(LogLevel::Info));
+thread_local EventLog::RingLease EventLog::lease_;
+
+EventLog::RingLease::~RingLease()
+{
+    // 남은 기록은 formatter 가 마저 비운 뒤 FREE 로 돌림
+    if (index >= 0)
+        EventLog::instance().rings_[index].state.store(RING_RELEASED, std::memory_order_release);
+    index = -1;
+}
+
+EventLog& EventLog::instance()
+{
+    static EventLog log;
+    return log;
+}
+
+bool EventLog::parseLevel(const char* name, LogLevel& level)
+{
+    static const char* names[] = { "debug", "info", "warn", "error", "off" };
+    for (int i = 0; i <= static_cast<int>(LogLevel::Off); i++)
+        if (strcmp(name, names[i]) == 0) {
+            level = static_cast<LogLevel>(i);
+            return true;
+        }
+    return false;
+}
+
+bool EventLog::admit(LogSite& site, uint64_t now_ns, uint32_t& suppressed)
+{
+    suppressed = 0;
+    if (site.min_interval_ms == 0)
+        return true;
+
+    uint64_t last = site.last_ns.load(std::memory_order_relaxed);
+    if (last != 0 && now_ns - last < site.min_interval_ms * 1000000ull) {
+        site.suppressed.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    site.last_ns.store(now_ns, std::memory_order_relaxed);
+    suppressed = site.suppressed.exchange(0, std::memory_order_relaxed);
+    return true;
+}
+
+int EventLog::acquireRing()
+{
+    for (int i = 0; i < MAX_THREADS; i++) {
+        int expected = RING_FREE;
+        if (rings_[i].state.compare_exchange_strong(expected, RING_OWNED, std::memory_order_acq_rel))
+            return i;
+    }
+    return -1;
+}
+
+void EventLog::push(const Entry& e)
+{
+    // 스레드마다 처음 기록할 때 ring 하나를 빌림 (모두 쓰는 중이면 다음 기록 때 다시 시도)
+    if (lease_.index < 0)
+        lease_.index = acquireRing();
+    if (lease_.index < 0) {
+        unregistered_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ThreadRing& r = rings_[lease_.index];
+    if (!r.ring.push(e))
+        r.dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint64_t EventLog::dropped() const
+{
+    uint64_t n = unregistered_.load(std::memory_order_relaxed);
+    for (int i = 0; i < MAX_THREADS; i++)
+        n += rings_[i].dropped.load(std::memory_order_relaxed);
+    return n;
+}
+
+int EventLog::format(char* out, size_t size, const Entry& e)
+{
+    const LogSite& site = *e.site;
+    int n = snprintf(out, size, "[%12.6f] %s %s:%d ", e.t_ns / 1e9, levelName(site.level),
+                     baseName(site.file), site.line);
+    size_t len = n > 0 ? std::min(static_cast<size_t>(n), size - 1) : 0;
+
+    int arg = 0;
+    for (const char* p = e.fmt; *p && len + 1 < size; p++) {
+        if (p[0] == '{' && p[1] == '}' && arg < e.nargs) {
+            int w = formatArg(out + len, size - len, e.args[arg++]);
+            len += w > 0 ? std::min(static_cast<size_t>(w), size - len - 1) : 0;
+            p++;
+        }
+        else
+            out[len++] = *p;
+    }
+    if (e.suppressed && len + 1 < size) {
+        int w = snprintf(out + len, size - len, " (%u suppressed)", e.suppressed);
+        len += w > 0 ? std::min(static_cast<size_t>(w), size - len - 1) : 0;
+    }
+    if (len + 1 < size)
+        out[len++] = '\n';
+    out[len] = '\0';
+    return static_cast<int>(len);
+}
+
+void EventLog::prepare(const Config& config)
+{
+    cfg_ = config;
+    batch_.reserve(MAX_THREADS * RING_SIZE);
+    out_.resize(OUT_BUFFER);
+}
+
+void EventLog::start(const Config& config)
+{
+    if (running_)
+        return;
+    prepare(config);
+    running_ = true;
+    formatter_ = std::thread(&EventLog::formatterLoop, this);
+}
+
+void EventLog::stop()
+{
+    if (!running_)
+        return;
+    running_ = false;
+    if (formatter_.joinable())
+        formatter_.join();
+}
+
+void EventLog::flush()
+{
+    if (running_)
+        return;
+    if (out_.empty())
+        prepare(cfg_);
+    drain();
+}
+
+void EventLog::formatterLoop()
+{
+    while (running_) {
+        drain();
+        std::this_thread::sleep_for(std::chrono::milliseconds(cfg_.poll_interval_ms));
+    }
+    drain();
+}
+
+void EventLog::drain()
+{
+    // 스레드 ring 을 모두 비우고 시각 순으로 (스레드 사이 순서)
+    batch_.clear();
+    Entry e;
+    for (int i = 0; i < MAX_THREADS; i++) {
+        ThreadRing& r = rings_[i];
+        int state = r.state.load(std::memory_order_acquire);
+        if (state == RING_FREE)
+            continue;
+        while (batch_.size() < batch_.capacity() && r.ring.pop(e))
+            batch_.push_back(e);
+        // 끝난 스레드의 ring 은 비었으면 돌려줌 (다음 스레드가 이어서 생산자가 됨)
+        if (state == RING_RELEASED && r.ring.empty())
+            r.state.store(RING_FREE, std::memory_order_release);
+    }
+    if (batch_.empty())
+        return;
+    std::stable_sort(batch_.begin(), batch_.end(), lessTime);
+
+    size_t len = 0;
+    for (size_t i = 0; i <= batch_.size(); i++) {
+        bool last = i == batch_.size();
+        if (len > 0 && (last || out_.size() - len < MAX_LINE)) {
+            const char* p = &out_[0];
+            size_t left = len;
+            while (left > 0) {
+                ssize_t w = ::write(cfg_.fd, p, left);
+                if (w < 0 && errno == EINTR)
+                    continue;
+                if (w <= 0)
+                    break;
+                p += w;
+                left -= static_cast<size_t>(w);
+            }
+            len = 0;
+        }
+        if (last)
+            break;
+        len += static_cast<size_t>(format(&out_[len], out_.size() - len, batch_[i]));
+    }
+    written_.fetch_add(batch_.size(), std::memory_order_relaxed);
+}
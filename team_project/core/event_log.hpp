@@ -0,0 +1,186 @@
+#ifndef EVENT_LOG_HPP
+#define EVENT_LOG_HPP
+
+#include "clock.hpp"
+#include "spsc_ring.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// 제어 / 센서 코드의 진단 메시지 (std::cout 대신)
+// - 호출한 스레드는 format 문자열 pointer + 인자 (숫자 / static 문자열) 를 자기 ring 에 넣기만 함 (lock-free, 할당 / syscall 없음)
+// - 백그라운드 스레드가 ring 들을 모아 시각 순으로 포맷 → write()
+// - level 은 실행 중 바꿀 수 있음, 꺼진 level 은 atomic load 하나 (인자도 계산하지 않음)
+// - 호출 위치마다 최소 간격 (LOG_*_EVERY), 그 사이 버린 수는 다음 줄에 붙임
+// format 의 {} 자리에 인자를 차례로 넣는다: LOG_WARN("outlier rejected: {} cm", d)
+// 문자열 인자는 pointer 만 저장하므로 string literal 등 계속 살아 있는 것만 넘길 것
+enum class LogLevel : int { Debug = 0, Info, Warn, Error, Off };
+
+struct LogArg {
+    enum Type : uint8_t { INT, UINT, DOUBLE, STR };
+    Type type;
+    union {
+        int64_t     i;
+        uint64_t    u;
+        double      d;
+        const char* s;
+    };
+};
+
+// 호출 위치 하나 (매크로 안의 static, rate limit 상태)
+struct LogSite {
+    LogLevel    level;
+    uint32_t    min_interval_ms;
+    const char* file;
+    int         line;
+    std::atomic<uint64_t> last_ns;
+    std::atomic<uint32_t> suppressed;
+
+    LogSite(LogLevel lv, uint32_t interval_ms, const char* f, int l)
+        : level(lv), min_interval_ms(interval_ms), file(f), line(l), last_ns(0), suppressed(0) {}
+};
+
+class EventLog {
+public:
+    static constexpr int      MAX_ARGS    = 10;
+    static constexpr int      MAX_THREADS = 16;     // 동시에 기록하는 스레드 수 (넘으면 그 스레드 기록은 버림, 끝난 스레드의 ring 은 재사용)
+    static constexpr uint32_t RING_SIZE   = 128;    // 스레드당
+
+    struct Entry {
+        const LogSite* site;
+        const char*    fmt;
+        uint64_t       t_ns;
+        uint32_t       suppressed;      // 이 줄 전에 rate limit 으로 버린 수
+        uint8_t        nargs;
+        LogArg         args[MAX_ARGS];
+    };
+
+    struct Config {
+        int      fd               = 1;        // stdout
+        uint32_t poll_interval_ms = 20;
+    };
+
+    // 프로세스 공용 (systemClock() 처럼)
+    static EventLog& instance();
+
+    static bool enabled(LogLevel level)
+    {
+        return static_cast<int>(level) >= level_.load(std::memory_order_relaxed);
+    }
+    static void setLevel(LogLevel level) { level_.store(static_cast<int>(level), std::memory_order_relaxed); }
+    static bool parseLevel(const char* name, LogLevel& level);   // "debug" / "info" / "warn" / "error" / "off"
+
+    // 시각 / rate limit 기준 (replay: SimClock), 기록 스레드가 하나일 때만 바꿀 것
+    void setClock(Clock* clock) { clock_ = clock ? clock : &systemClock(); }
+
+    void start(const Config& config);
+    void start() { start(Config()); }
+    void stop();        // 남은 기록을 모두 쓰고 formatter 종료
+    void flush();       // formatter 없이 호출한 스레드에서 비움 (replay 처럼 한 스레드가 가상 시간으로 돌 때)
+
+    template <typename... Args>
+    void write(LogSite& site, const char* fmt, const Args&... args)
+    {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "too many log arguments");
+        uint64_t now = clock_->nowNs();
+        uint32_t suppressed;
+        if (!admit(site, now, suppressed))
+            return;
+        Entry e;
+        e.site       = &site;
+        e.fmt        = fmt;
+        e.t_ns       = now;
+        e.suppressed = suppressed;
+        e.nargs      = 0;
+        fill(e, args...);
+        push(e);
+    }
+
+    uint64_t written() const { return written_.load(std::memory_order_relaxed); }
+    uint64_t dropped() const;
+
+    // 한 줄 포맷 (formatter 스레드가 사용), 쓴 길이 반환
+    static int format(char* out, size_t size, const Entry& e);
+
+private:
+    typedef SpscRing<Entry, RING_SIZE> Ring;
+    // FREE → (스레드가 처음 기록) OWNED → (스레드 종료) RELEASED → (formatter 가 다 비움) FREE
+    enum RingState { RING_FREE = 0, RING_OWNED, RING_RELEASED };
+    struct ThreadRing {
+        Ring ring;
+        std::atomic<uint64_t> dropped{0};
+        std::atomic<int> state{RING_FREE};
+    };
+
+    // 스레드가 빌린 ring (스레드가 끝날 때 소멸자가 돌려줌)
+    struct RingLease {
+        int index = -1;
+        ~RingLease();
+    };
+    static thread_local RingLease lease_;
+
+    static std::atomic<int> level_;
+
+    Clock* clock_ = &systemClock();
+    ThreadRing rings_[MAX_THREADS];
+    std::atomic<uint64_t> unregistered_{0};    // MAX_THREADS 를 넘은 스레드가 버린 수
+    std::atomic<uint64_t> written_{0};
+
+    Config cfg_;
+    std::thread formatter_;
+    std::atomic<bool> running_{false};
+    std::vector<Entry> batch_;
+    std::vector<char>  out_;
+
+    EventLog() {}
+    ~EventLog() { stop(); }
+    EventLog(const EventLog&) = delete;
+    EventLog& operator=(const EventLog&) = delete;
+
+    bool admit(LogSite& site, uint64_t now_ns, uint32_t& suppressed);
+    void push(const Entry& e);
+    int  acquireRing();
+    void formatterLoop();
+    void prepare(const Config& config);
+    void drain();
+
+    static void fill(Entry&) {}
+    template <typename T, typename... Rest>
+    static void fill(Entry& e, const T& first, const Rest&... rest)
+    {
+        e.args[e.nargs++] = toArg(first);
+        fill(e, rest...);
+    }
+
+    static LogArg toArg(int v)                { LogArg a; a.type = LogArg::INT;    a.i = v; return a; }
+    static LogArg toArg(long v)               { LogArg a; a.type = LogArg::INT;    a.i = v; return a; }
+    static LogArg toArg(long long v)          { LogArg a; a.type = LogArg::INT;    a.i = v; return a; }
+    static LogArg toArg(unsigned v)           { LogArg a; a.type = LogArg::UINT;   a.u = v; return a; }
+    static LogArg toArg(unsigned long v)      { LogArg a; a.type = LogArg::UINT;   a.u = v; return a; }
+    static LogArg toArg(unsigned long long v) { LogArg a; a.type = LogArg::UINT;   a.u = v; return a; }
+    static LogArg toArg(bool v)               { LogArg a; a.type = LogArg::INT;    a.i = v; return a; }
+    static LogArg toArg(float v)              { LogArg a; a.type = LogArg::DOUBLE; a.d = v; return a; }
+    static LogArg toArg(double v)             { LogArg a; a.type = LogArg::DOUBLE; a.d = v; return a; }
+    static LogArg toArg(const char* v)        { LogArg a; a.type = LogArg::STR;    a.s = v; return a; }
+};
+
+// level 이 꺼져 있으면 site 초기화 / 인자 계산 모두 건너뜀
+#define EVENT_LOG_AT(lv, interval_ms, ...)                                           \
+    do {                                                                             \
+        if (EventLog::enabled(lv)) {                                                 \
+            static LogSite event_log_site_(lv, interval_ms, __FILE__, __LINE__);     \
+            EventLog::instance().write(event_log_site_, __VA_ARGS__);                \
+        }                                                                            \
+    } while (0)
+
+#define LOG_DEBUG(...) EVENT_LOG_AT(LogLevel::Debug, 0, __VA_ARGS__)
+#define LOG_INFO(...)  EVENT_LOG_AT(LogLevel::Info,  0, __VA_ARGS__)
+#define LOG_WARN(...)  EVENT_LOG_AT(LogLevel::Warn,  0, __VA_ARGS__)
+#define LOG_ERROR(...) EVENT_LOG_AT(LogLevel::Error, 0, __VA_ARGS__)
+
+// 같은 위치에서 interval_ms 안에 다시 오면 버리고 수만 셈 (센서 timeout 처럼 연달아 나는 것)
+#define LOG_INFO_EVERY(interval_ms, ...)  EVENT_LOG_AT(LogLevel::Info, interval_ms, __VA_ARGS__)
+#define LOG_WARN_EVERY(interval_ms, ...)  EVENT_LOG_AT(LogLevel::Warn, interval_ms, __VA_ARGS__)
+
+#endif
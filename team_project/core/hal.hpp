@@ -0,0 +1,79 @@
+#ifndef HAL_HPP
+#define HAL_HPP
+
+#include <cstdint>
+
+// 제어 로직이 보는 장치 인터페이스
+// Pi 에서는 wiringPi / spidev / i2c-dev 구현을, replay 에서는 trace 재생 / 기록용 구현을 넣는다.
+
+struct DetectionEvent;
+
+// GPIO 핀 (Ultrasonic polling 경로)
+class GpioPins {
+public:
+    virtual ~GpioPins() {}
+
+    virtual void setOutput(int pin) = 0;
+    virtual void setInput(int pin) = 0;
+    virtual void write(int pin, bool high) = 0;
+    virtual bool read(int pin) = 0;
+};
+
+// 거리 측정 입력: 새 측정이 있으면 true (distance_cm, 측정 시각 t_ns)
+class RangeSource {
+public:
+    virtual ~RangeSource() {}
+    virtual bool poll(float& distance_cm, uint64_t& t_ns) = 0;
+};
+
+// YOLO 검출 이벤트 입력 (non-blocking)
+class DetectionSource {
+public:
+    virtual ~DetectionSource() {}
+    virtual bool poll(DetectionEvent& event) = 0;
+};
+
+// 경고음 한 종류: tone_hz 로 on_ms 울리고 off_ms 쉬기를 repeat 번 (0: stop() 까지 계속)
+struct BeepPattern {
+    int      tone_hz;
+    uint32_t on_ms;
+    uint32_t off_ms;
+    uint32_t repeat;
+    int      priority;     // 클수록 우선
+};
+
+// 경고음 출력 (non-blocking, 바로 반환)
+// - 울리는 중인 것보다 priority 가 높으면 바꾸고, 같거나 낮으면 무시 (같은 경고를 매 주기 요청해도 처음부터 다시 울리지 않음)
+// - 밀려난 pattern 은 높은 것이 끝나면 남은 횟수만큼 이어서 울림
+// - cancel(priority) 는 그 priority 의 pattern 만 (울리는 중이든 밀려나 있든) 없앰, stop() 은 모두
+class BuzzerDevice {
+public:
+    virtual ~BuzzerDevice() {}
+    virtual void play(const BeepPattern& pattern) = 0;
+    virtual void cancel(int priority) = 0;
+    virtual void stop() = 0;
+};
+
+// 부저에 실제로 소리를 내는 쪽 (hz = 0 이면 끔): sysfs PWM / softTone / 시뮬레이션
+class ToneOutput {
+public:
+    virtual ~ToneOutput() {}
+    virtual void tone(int hz) = 0;
+};
+
+// 운전자 표시 (2줄)
+class StatusDisplay {
+public:
+    virtual ~StatusDisplay() {}
+    virtual void show(const char* line1, const char* line2) = 0;
+    virtual void off() = 0;
+};
+
+// 급제동 보조 (차량 속도 0 요청)
+class BrakeAssist {
+public:
+    virtual ~BrakeAssist() {}
+    virtual void requestStop() = 0;
+};
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef HDR_HISTOGRAM_HPP
+#define HDR_HISTOGRAM_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+// 고정 메모리 HDR(High Dynamic Range) histogram (ns 단위 latency 용)
+// - log-linear bucket: 2^k 구간마다 SUB_BUCKETS/2 칸 → 상대 오차 1/128 (약 0.8%) 이하
+// - 1ns ~ 2^36ns(약 68초), 넘는 값은 마지막 칸에 넣고 max 는 그대로 기록
+// - record() 는 상수 시간, 할당 없음 (단일 스레드에서 기록)
+class HdrHistogram {
+public:
+    HdrHistogram() { reset(); }
+
+    void reset()
+    {
+        memset(counts_, 0, sizeof(counts_));
+        total_ = 0;
+        min_ = UINT64_MAX;
+        max_ = 0;
+        sum_ = 0;
+    }
+
+    void record(uint64_t v)
+    {
+        counts_[indexOf(v < MAX_TRACKABLE ? v : MAX_TRACKABLE)]++;
+        total_++;
+        sum_ += v;
+        min_ = std::min(min_, v);
+        max_ = std::max(max_, v);
+    }
+
+    uint64_t count() const { return total_; }
+    uint64_t min()   const { return total_ ? min_ : 0; }
+    uint64_t max()   const { return max_; }
+    double   mean()  const { return total_ ? static_cast<double>(sum_) / total_ : 0.0; }
+
+    // p: 0~1, 해당 bucket 의 상한값 (실제 max 를 넘지 않게)
+    uint64_t percentile(double p) const
+    {
+        if (total_ == 0)
+            return 0;
+        uint64_t rank = static_cast<uint64_t>(p * total_ + 0.5);
+        if (rank < 1)
+            rank = 1;
+
+        uint64_t seen = 0;
+        for (size_t i = 0; i < BUCKETS; i++) {
+            seen += counts_[i];
+            if (seen >= rank)
+                return std::min(highestOf(i), max_);
+        }
+        return max_;
+    }
+
+    void merge(const HdrHistogram& other)
+    {
+        for (size_t i = 0; i < BUCKETS; i++)
+            counts_[i] += other.counts_[i];
+        total_ += other.total_;
+        sum_   += other.sum_;
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+
+private:
+    static constexpr unsigned SUB_BITS     = 8;
+    static constexpr uint64_t SUB_BUCKETS  = 1ull << SUB_BITS;        // 256
+    static constexpr uint64_t HALF         = SUB_BUCKETS / 2;         // 128
+    static constexpr unsigned MAX_BITS     = 36;
+    static constexpr uint64_t MAX_TRACKABLE = (1ull << MAX_BITS) - 1;
+    static constexpr size_t   BUCKETS      = (MAX_BITS - SUB_BITS + 1) * HALF + HALF;
+
+    uint64_t counts_[BUCKETS];
+    uint64_t total_;
+    uint64_t min_;
+    uint64_t max_;
+    uint64_t sum_;
+
+    static unsigned msb(uint64_t v)
+    {
+        return 63u - static_cast<unsigned>(__builtin_clzll(v));
+    }
+
+    // v < 256 은 그대로, 그 이상은 (지수, 상위 8bit) 로
+    static size_t indexOf(uint64_t v)
+    {
+        if (v < SUB_BUCKETS)
+            return static_cast<size_t>(v);
+        unsigned e = msb(v) - (SUB_BITS - 1);
+        return static_cast<size_t>(e * HALF + (v >> e));
+    }
+
+    static uint64_t highestOf(size_t idx)
+    {
+        if (idx < SUB_BUCKETS)
+            return idx;
+        uint64_t e = idx / HALF - 1;
+        uint64_t mant = idx - e * HALF;
+        return ((mant + 1) << e) - 1;
+    }
+};
+
+#endif
@@ -0,0 +1,106 @@
+#include "latency_trace.hpp"
+#include "event_log.hpp"
+#include <iomanip>
+#include <string>
+
+
+namespace {
+
+// 시각이 거꾸로면 (다른 clock / 잘못된 stamp) 기록하지 않는다
+bool span(uint64_t from, uint64_t to, uint64_t& out)
+{
+    if (from == 0 || to == 0 || to < from)
+        return false;
+    out = to - from;
+    return true;
+}
+
+void printRow(std::ostream& os, const std::string& name, const HdrHistogram& h)
+{
+    os << std::left << std::setw(20) << name << std::right
+       << std::setw(8) << h.count()
+       << std::setw(11) << h.percentile(0.50) / 1000.0
+       << std::setw(11) << h.percentile(0.90) / 1000.0
+       << std::setw(11) << h.percentile(0.99) / 1000.0
+       << std::setw(11) << h.percentile(0.999) / 1000.0
+       << std::setw(11) << h.max() / 1000.0
+       << "\n";
+}
+
+void logRow(const char* from, const char* to, const HdrHistogram& h)
+{
+    LOG_INFO("latency {}->{}: count {} p50 {} p90 {} p99 {} p99.9 {} max {} us",
+             from, to, h.count(), h.percentile(0.50) / 1000.0, h.percentile(0.90) / 1000.0,
+             h.percentile(0.99) / 1000.0, h.percentile(0.999) / 1000.0, h.max() / 1000.0);
+}
+
+} // namespace
+
+
+const char* LatencyTracer::stageName(int stage)
+{
+    static const char* names[STAGE_COUNT] = {
+        "capture", "infer", "publish", "consume", "decide", "actuate"
+    };
+    return (stage >= 0 && stage < STAGE_COUNT) ? names[stage] : "?";
+}
+
+void LatencyTracer::record(const StageStamps& stamps)
+{
+    uint64_t d;
+
+    // 인접 단계 (앞 단계가 비어 있으면 그 앞의 마지막 단계부터)
+    int prev = -1;
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        if (stamps.t[i] == 0)
+            continue;
+        if (prev >= 0 && span(stamps.t[prev], stamps.t[i], d))
+            interval_[i].record(d);
+        prev = i;
+    }
+
+    if (span(stamps.t[STAGE_CAPTURE], stamps.t[STAGE_DECIDE], d))
+        to_decide_.record(d);
+    if (span(stamps.t[STAGE_CAPTURE], stamps.t[STAGE_ACTUATE], d))
+        to_actuate_.record(d);
+}
+
+void LatencyTracer::reset()
+{
+    for (int i = 0; i < STAGE_COUNT; i++)
+        interval_[i].reset();
+    to_decide_.reset();
+    to_actuate_.reset();
+}
+
+void LatencyTracer::copyFrom(const LatencyTracer& other)
+{
+    for (int i = 0; i < STAGE_COUNT; i++)
+        interval_[i] = other.interval_[i];
+    to_decide_  = other.to_decide_;
+    to_actuate_ = other.to_actuate_;
+}
+
+void LatencyTracer::log() const
+{
+    for (int i = 1; i < STAGE_COUNT; i++)
+        logRow(stageName(i - 1), stageName(i), interval_[i]);
+    logRow("capture", "decide", to_decide_);
+    logRow("capture", "actuate", to_actuate_);
+}
+
+void LatencyTracer::dump(std::ostream& os) const
+{
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+
+    os << "latency (us)            count        p50        p90        p99      p99.9        max\n";
+    os << std::fixed << std::setprecision(1);
+    for (int i = 1; i < STAGE_COUNT; i++)
+        printRow(os, std::string(stageName(i - 1)) + "->" + stageName(i), interval_[i]);
+    printRow(os, "capture->decide", to_decide_);
+    printRow(os, "capture->actuate", to_actuate_);
+
+    os.flags(flags);
+    os.precision(precision);
+}
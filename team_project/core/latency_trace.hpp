@@ -0,0 +1,61 @@
+#ifndef LATENCY_TRACE_HPP
+#define LATENCY_TRACE_HPP
+
+#include "hdr_histogram.hpp"
+#include <cstdint>
+#include <ostream>
+
+// 검출 → 구동 latency trace
+// 모든 단계 시각은 같은 CLOCK_MONOTONIC (Python 은 time.monotonic_ns()) 으로 찍는다.
+//   CAPTURE  프레임 캡처          (YOLO 프로세스)
+//   INFER    추론 + 후처리 완료    (YOLO 프로세스)
+//   PUBLISH  ring 에 넣음          (DetectionChannel::publish)
+//   CONSUME  제어 루프가 꺼냄      (control task)
+//   DECIDE   throttle 명령 결정
+//   ACTUATE  부저 / 감속 요청 발행 (구동이 없으면 0)
+// 인접 단계 사이와 CAPTURE 기준 end-to-end 를 HDR histogram 에 모은다. 0 인 단계는 건너뛴다.
+enum TraceStage {
+    STAGE_CAPTURE = 0,
+    STAGE_INFER,
+    STAGE_PUBLISH,
+    STAGE_CONSUME,
+    STAGE_DECIDE,
+    STAGE_ACTUATE,
+    STAGE_COUNT
+};
+
+struct StageStamps {
+    uint64_t t[STAGE_COUNT];
+};
+
+class LatencyTracer {
+public:
+    LatencyTracer() {}
+
+    void record(const StageStamps& stamps);
+    void reset();
+    // 다른 스레드에서 dump 하기 위한 사본 (할당 없음, histogram 째로 복사)
+    void copyFrom(const LatencyTracer& other);
+
+    // stage i-1 → i 구간 (i = 1..STAGE_COUNT-1)
+    const HdrHistogram& interval(int stage) const { return interval_[stage]; }
+    const HdrHistogram& captureToDecide()   const { return to_decide_; }
+    const HdrHistogram& captureToActuate()  const { return to_actuate_; }
+
+    // 구간별 count / p50 / p90 / p99 / p99.9 / max (us)
+    void dump(std::ostream& os) const;
+    // 같은 내용을 구간당 EventLog INFO 한 줄로
+    void log() const;
+
+    static const char* stageName(int stage);
+
+private:
+    HdrHistogram interval_[STAGE_COUNT];   // [0] 은 사용 안 함
+    HdrHistogram to_decide_;
+    HdrHistogram to_actuate_;
+
+    LatencyTracer(const LatencyTracer&) = delete;
+    LatencyTracer& operator=(const LatencyTracer&) = delete;
+};
+
+#endif
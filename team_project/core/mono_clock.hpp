@@ -0,0 +1,18 @@
+#ifndef MONO_CLOCK_HPP
+#define MONO_CLOCK_HPP
+
+#include <cstdint>
+#include <time.h>
+
+// CLOCK_MONOTONIC 기준 현재 시각 (ns)
+// wiringPi 의 micros()/millis() 는 32bit 라 약 71분/49일 마다 wrap 되므로 새 코드는 이것을 쓴다.
+inline uint64_t monoNowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+inline uint64_t monoNowUs() { return monoNowNs() / 1000ull; }
+
+#endif
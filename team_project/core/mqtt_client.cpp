@@ -0,0 +1,578 @@
+#include "mqtt_client.hpp"
+#include "event_log.hpp"
+#include "mono_clock.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+
+namespace {
+
+enum : uint8_t {
+    PKT_CONNECT    = 0x10,
+    PKT_CONNACK    = 0x20,
+    PKT_PUBLISH    = 0x30,
+    PKT_PUBACK     = 0x40,
+    PKT_PINGREQ    = 0xC0,
+    PKT_PINGRESP   = 0xD0,
+    PKT_DISCONNECT = 0xE0,
+};
+
+constexpr uint8_t  PUBLISH_QOS1 = 0x02;
+constexpr uint8_t  PUBLISH_DUP  = 0x08;
+constexpr int      POLL_MS      = 100;   // retry / keepalive 확인 주기
+constexpr uint64_t MS           = 1000000ull;
+
+// remaining length (1~4 byte varint), 쓴 byte 수
+size_t encodeLength(uint8_t* out, size_t len)
+{
+    size_t n = 0;
+    do {
+        uint8_t b = len & 0x7F;
+        len >>= 7;
+        if (len)
+            b |= 0x80;
+        out[n++] = b;
+    } while (len && n < 4);
+    return n;
+}
+
+// 0: 아직 덜 받음, -1: 잘못된 길이, 그 외: header 전체 byte 수 (type + varint)
+int decodeLength(const uint8_t* buf, size_t avail, size_t& len)
+{
+    len = 0;
+    for (size_t i = 1; i < 5; i++) {
+        if (i >= avail)
+            return 0;
+        len |= static_cast<size_t>(buf[i] & 0x7F) << (7 * (i - 1));
+        if (!(buf[i] & 0x80))
+            return static_cast<int>(i + 1);
+    }
+    return -1;
+}
+
+size_t putString(uint8_t* out, const char* s, size_t len)
+{
+    out[0] = static_cast<uint8_t>(len >> 8);
+    out[1] = static_cast<uint8_t>(len);
+    memcpy(out + 2, s, len);
+    return len + 2;
+}
+
+} // namespace
+
+
+MqttClient::MqttClient(const Config& config)
+    : cfg_(config)
+{
+    memset(inflight_, 0, sizeof(inflight_));
+}
+
+MqttClient::~MqttClient()
+{
+    stop();
+}
+
+bool MqttClient::start()
+{
+    if (running_.load())
+        return true;
+
+    wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wake_fd_ < 0) {
+        LOG_ERROR("mqtt: eventfd failed (errno {})", errno);
+        return false;
+    }
+
+    running_.store(true);
+    worker_ = std::thread(&MqttClient::run, this);
+    return true;
+}
+
+void MqttClient::stop()
+{
+    if (!running_.exchange(false))
+        return;
+
+    uint64_t one = 1;
+    if (write(wake_fd_, &one, sizeof(one)) < 0) {
+        // worker 는 POLL_MS 안에 running_ 을 보고 종료
+    }
+    if (worker_.joinable())
+        worker_.join();
+
+    close(wake_fd_);
+    wake_fd_ = -1;
+}
+
+bool MqttClient::publish(const char* topic, const void* payload, size_t len)
+{
+    size_t topic_len = strlen(topic);
+    if (topic_len == 0 || topic_len > MAX_TOPIC || len > MAX_PAYLOAD) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    Message msg;
+    msg.enqueue_ns  = monoNowNs();
+    msg.topic_len   = static_cast<uint16_t>(topic_len);
+    msg.payload_len = static_cast<uint16_t>(len);
+    memcpy(msg.topic, topic, topic_len);
+    memcpy(msg.payload, payload, len);
+
+    if (!queue_.push(msg)) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    published_.fetch_add(1, std::memory_order_relaxed);
+
+    uint64_t one = 1;
+    if (wake_fd_ >= 0 && write(wake_fd_, &one, sizeof(one)) < 0) {
+        // eventfd 가 가득 찬 경우뿐, worker 는 이미 깨어 있음
+    }
+    return true;
+}
+
+MqttClient::Stats MqttClient::stats() const
+{
+    Stats s;
+    s.connected        = connected_.load(std::memory_order_relaxed);
+    s.published        = published_.load(std::memory_order_relaxed);
+    s.dropped          = dropped_.load(std::memory_order_relaxed);
+    s.sent             = sent_.load(std::memory_order_relaxed);
+    s.retransmits      = retransmits_.load(std::memory_order_relaxed);
+    s.acked            = acked_.load(std::memory_order_relaxed);
+    s.reconnects       = reconnects_.load(std::memory_order_relaxed);
+    s.connect_failures = connect_failures_.load(std::memory_order_relaxed);
+    return s;
+}
+
+void MqttClient::latency(HdrHistogram& enqueue_to_ack, HdrHistogram& send_to_ack) const
+{
+    std::lock_guard<std::mutex> lock(latency_mutex_);
+    enqueue_to_ack = enqueue_to_ack_;
+    send_to_ack    = send_to_ack_;
+}
+
+void MqttClient::printStats(std::ostream& os) const
+{
+    Stats s = stats();
+    uint64_t p50, p99, max;
+    {
+        std::lock_guard<std::mutex> lock(latency_mutex_);
+        p50 = enqueue_to_ack_.percentile(0.50);
+        p99 = enqueue_to_ack_.percentile(0.99);
+        max = enqueue_to_ack_.max();
+    }
+
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << "mqtt " << cfg_.host << ":" << cfg_.port << (s.connected ? " up" : " down")
+       << ", published " << s.published << ", acked " << s.acked
+       << ", dropped " << s.dropped << ", retransmits " << s.retransmits
+       << ", connects " << s.reconnects << " (failed " << s.connect_failures << ")"
+       << std::fixed << std::setprecision(1)
+       << ", pub->ack p50 " << p50 / 1e3 << " p99 " << p99 / 1e3 << " max " << max / 1e3 << " us\n";
+    os.flags(flags);
+    os.precision(precision);
+}
+
+void MqttClient::logStats() const
+{
+    Stats s = stats();
+    uint64_t p50, p99, max;
+    {
+        std::lock_guard<std::mutex> lock(latency_mutex_);
+        p50 = enqueue_to_ack_.percentile(0.50);
+        p99 = enqueue_to_ack_.percentile(0.99);
+        max = enqueue_to_ack_.max();
+    }
+    LOG_INFO("mqtt {}:{} {}, published {}, acked {}, dropped {}, retransmits {}, connects {} (failed {})",
+             cfg_.host.c_str(), cfg_.port, s.connected ? "up" : "down", s.published, s.acked,
+             s.dropped, s.retransmits, s.reconnects, s.connect_failures);
+    LOG_INFO("mqtt pub->ack p50 {} p99 {} max {} us", p50 / 1e3, p99 / 1e3, max / 1e3);
+}
+
+
+// ---------------- worker 스레드
+
+void MqttClient::run()
+{
+    uint32_t backoff_ms = cfg_.backoff_min_ms;
+    uint32_t jitter = static_cast<uint32_t>(monoNowNs()) | 1u;
+
+    while (running_.load()) {
+        if (!connectBroker()) {
+            connect_failures_.fetch_add(1, std::memory_order_relaxed);
+            disconnect(false);
+
+            // backoff ± 25% jitter (여러 노드가 동시에 재접속하지 않게, xorshift)
+            jitter ^= jitter << 13;
+            jitter ^= jitter >> 17;
+            jitter ^= jitter << 5;
+            uint32_t wait_ms = backoff_ms * 3 / 4 + jitter % (backoff_ms / 2 + 1);
+
+            uint64_t until = monoNowNs() + wait_ms * MS;
+            uint64_t now;
+            while (running_.load() && (now = monoNowNs()) < until)
+                waitWake(static_cast<int>((until - now) / MS) + 1);
+
+            backoff_ms = std::min(backoff_ms * 2, cfg_.backoff_max_ms);
+            continue;
+        }
+
+        backoff_ms = cfg_.backoff_min_ms;
+        reconnects_.fetch_add(1, std::memory_order_relaxed);
+        connected_.store(true);
+
+        // 이전 연결에서 PUBACK 못 받은 것 재전송 (publish 순서대로)
+        int order[MAX_INFLIGHT];
+        int count = inflightInOrder(order);
+        if (count)
+            LOG_INFO("mqtt: connected, resending {} unacked message(s)", count);
+        else
+            LOG_INFO("mqtt: connected");
+        bool ok = true;
+        for (int k = 0; ok && k < count; k++) {
+            ok = sendPublish(inflight_[order[k]], true);
+            retransmits_.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        while (ok && running_.load())
+            ok = serviceConnection();
+
+        connected_.store(false);
+        if (running_.load())
+            LOG_WARN("mqtt: connection lost");
+        disconnect(!running_.load());
+    }
+}
+
+bool MqttClient::connectBroker()
+{
+    char port[8];
+    snprintf(port, sizeof(port), "%u", static_cast<unsigned>(cfg_.port));
+
+    struct addrinfo hints;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family   = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+
+    struct addrinfo* res = nullptr;
+    if (getaddrinfo(cfg_.host.c_str(), port, &hints, &res) != 0 || !res)
+        return false;
+
+    for (struct addrinfo* ai = res; ai && sock_ < 0; ai = ai->ai_next) {
+        int fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0)
+            continue;
+
+        int rc = connect(fd, ai->ai_addr, ai->ai_addrlen);
+        if (rc < 0 && errno == EINPROGRESS) {
+            struct pollfd pfd = { fd, POLLOUT, 0 };
+            int err = 0;
+            socklen_t err_len = sizeof(err);
+            if (poll(&pfd, 1, static_cast<int>(cfg_.connect_timeout_ms)) == 1 &&
+                getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &err_len) == 0 && err == 0)
+                rc = 0;
+        }
+        if (rc < 0) {
+            close(fd);
+            continue;
+        }
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        sock_ = fd;
+    }
+    freeaddrinfo(res);
+    if (sock_ < 0)
+        return false;
+
+    // CONNECT: protocol "MQTT" level 4, clean session
+    // PUBACK 못 받은 메시지는 client 가 들고 있다가 재전송하므로 broker 쪽 session 은 필요 없음
+    uint8_t pkt[16 + 256];
+    size_t id_len = std::min<size_t>(cfg_.client_id.size(), 200);
+    uint8_t body[12 + 256];
+    size_t n = putString(body, "MQTT", 4);
+    body[n++] = 4;
+    body[n++] = 0x02;
+    body[n++] = static_cast<uint8_t>(cfg_.keepalive_s >> 8);
+    body[n++] = static_cast<uint8_t>(cfg_.keepalive_s);
+    n += putString(body + n, cfg_.client_id.data(), id_len);
+
+    pkt[0] = PKT_CONNECT;
+    size_t h = 1 + encodeLength(pkt + 1, n);
+    memcpy(pkt + h, body, n);
+    if (!sendAll(pkt, h + n))
+        return false;
+
+    // CONNACK 대기
+    rx_len_ = 0;
+    uint64_t deadline = monoNowNs() + cfg_.connect_timeout_ms * MS;
+    while (rx_len_ < 4) {
+        uint64_t now = monoNowNs();
+        if (now >= deadline || !running_.load())
+            return false;
+        struct pollfd pfd = { sock_, POLLIN, 0 };
+        if (poll(&pfd, 1, static_cast<int>((deadline - now) / MS) + 1) <= 0)
+            continue;
+        ssize_t r = recv(sock_, rx_ + rx_len_, sizeof(rx_) - rx_len_, 0);
+        if (r <= 0)
+            return false;
+        rx_len_ += static_cast<size_t>(r);
+    }
+    if (rx_[0] != PKT_CONNACK || rx_[1] != 0x02 || rx_[3] != 0) {
+        LOG_WARN("mqtt: connection refused (return code {})", static_cast<unsigned>(rx_[3]));
+        return false;
+    }
+    rx_len_ -= 4;
+    memmove(rx_, rx_ + 4, rx_len_);
+
+    last_tx_ns_ = monoNowNs();
+    ping_sent_ns_ = 0;
+    return true;
+}
+
+void MqttClient::disconnect(bool graceful)
+{
+    if (sock_ < 0)
+        return;
+    if (graceful) {
+        const uint8_t pkt[2] = { PKT_DISCONNECT, 0 };
+        sendAll(pkt, sizeof(pkt));
+    }
+    close(sock_);
+    sock_ = -1;
+    rx_len_ = 0;
+    ping_sent_ns_ = 0;
+}
+
+bool MqttClient::serviceConnection()
+{
+    if (!drainQueue())
+        return false;
+    uint64_t now = monoNowNs();   // drainQueue 가 보낸 sent_ns 보다 뒤
+
+    // PUBACK 이 늦으면 DUP 재전송 (publish 순서대로)
+    int order[MAX_INFLIGHT];
+    int count = inflightInOrder(order);
+    for (int k = 0; k < count; k++) {
+        Inflight& slot = inflight_[order[k]];
+        if (now - slot.sent_ns >= cfg_.retry_ms * MS) {
+            retransmits_.fetch_add(1, std::memory_order_relaxed);
+            if (!sendPublish(slot, true))
+                return false;
+        }
+    }
+
+    // keepalive: 보낸 게 없으면 keepalive/2 마다 PINGREQ, keepalive 안에 PINGRESP 가 없으면 끊김으로 봄
+    if (cfg_.keepalive_s) {
+        uint64_t keepalive_ns = cfg_.keepalive_s * 1000ull * MS;
+        if (ping_sent_ns_ && now - ping_sent_ns_ > keepalive_ns) {
+            LOG_WARN("mqtt: keepalive timeout");
+            return false;
+        }
+        if (!ping_sent_ns_ && now - last_tx_ns_ >= keepalive_ns / 2) {
+            const uint8_t pkt[2] = { PKT_PINGREQ, 0 };
+            if (!sendAll(pkt, sizeof(pkt)))
+                return false;
+            ping_sent_ns_ = now;
+        }
+    }
+
+    struct pollfd pfd[2] = {
+        { sock_,   POLLIN, 0 },
+        { wake_fd_, POLLIN, 0 },
+    };
+    if (poll(pfd, 2, POLL_MS) < 0)
+        return errno == EINTR;
+
+    if (pfd[1].revents & POLLIN) {
+        uint64_t count;
+        if (read(wake_fd_, &count, sizeof(count)) < 0) {
+            // 다른 쪽에서 이미 비움
+        }
+    }
+    if (pfd[0].revents & (POLLERR | POLLNVAL))
+        return false;
+    if (pfd[0].revents & (POLLIN | POLLHUP))
+        return handleInput();
+    return true;
+}
+
+bool MqttClient::drainQueue()
+{
+    for (;;) {
+        int free_slot = -1;
+        for (int i = 0; i < MAX_INFLIGHT && free_slot < 0; i++)
+            if (!inflight_[i].in_use)
+                free_slot = i;
+
+        if (!have_pending_) {
+            if (!queue_.pop(pending_))
+                return true;
+            have_pending_ = true;
+        }
+        if (free_slot < 0)
+            return true;   // PUBACK 이 와서 자리가 날 때까지 보관
+
+        // packet id: 0 은 쓰지 않고, 아직 inflight 인 id 는 건너뜀
+        uint16_t id;
+        bool used;
+        do {
+            id = next_packet_id_++;
+            if (next_packet_id_ == 0)
+                next_packet_id_ = 1;
+            used = false;
+            for (int i = 0; i < MAX_INFLIGHT; i++)
+                used |= inflight_[i].in_use && inflight_[i].packet_id == id;
+        } while (used);
+
+        Inflight& slot = inflight_[free_slot];
+        slot.in_use    = true;
+        slot.packet_id = id;
+        slot.seq       = next_seq_++;
+        slot.msg       = pending_;
+        have_pending_  = false;
+
+        if (!sendPublish(slot, false))
+            return false;
+    }
+}
+
+int MqttClient::inflightInOrder(int* order) const
+{
+    // 최대 MAX_INFLIGHT 개, 삽입 정렬
+    int n = 0;
+    for (int i = 0; i < MAX_INFLIGHT; i++) {
+        if (!inflight_[i].in_use)
+            continue;
+        int k = n++;
+        while (k > 0 && inflight_[order[k - 1]].seq > inflight_[i].seq) {
+            order[k] = order[k - 1];
+            k--;
+        }
+        order[k] = i;
+    }
+    return n;
+}
+
+bool MqttClient::sendPublish(Inflight& slot, bool dup)
+{
+    const Message& msg = slot.msg;
+    size_t remaining = 2 + msg.topic_len + 2 + msg.payload_len;
+
+    tx_[0] = PKT_PUBLISH | PUBLISH_QOS1 | (dup ? PUBLISH_DUP : 0);
+    size_t n = 1 + encodeLength(tx_ + 1, remaining);
+    n += putString(tx_ + n, msg.topic, msg.topic_len);
+    tx_[n++] = static_cast<uint8_t>(slot.packet_id >> 8);
+    tx_[n++] = static_cast<uint8_t>(slot.packet_id);
+    memcpy(tx_ + n, msg.payload, msg.payload_len);
+    n += msg.payload_len;
+
+    slot.sent_ns = monoNowNs();
+    if (!sendAll(tx_, n))
+        return false;
+    sent_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool MqttClient::handleInput()
+{
+    ssize_t r = recv(sock_, rx_ + rx_len_, sizeof(rx_) - rx_len_, 0);
+    if (r == 0)
+        return false;
+    if (r < 0)
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    rx_len_ += static_cast<size_t>(r);
+
+    size_t pos = 0;
+    for (;;) {
+        size_t len;
+        int header = decodeLength(rx_ + pos, rx_len_ - pos, len);
+        if (header < 0 || header + len > sizeof(rx_))
+            return false;   // 구독을 하지 않으므로 큰 packet 은 올 일이 없음
+        if (header == 0 || pos + header + len > rx_len_)
+            break;
+        if (!handlePacket(rx_[pos], rx_ + pos + header, len))
+            return false;
+        pos += header + len;
+    }
+    rx_len_ -= pos;
+    memmove(rx_, rx_ + pos, rx_len_);
+    return true;
+}
+
+bool MqttClient::handlePacket(uint8_t type, const uint8_t* body, size_t len)
+{
+    switch (type & 0xF0) {
+    case PKT_PUBACK: {
+        if (len < 2)
+            return false;
+        uint16_t id = static_cast<uint16_t>((body[0] << 8) | body[1]);
+        uint64_t now = monoNowNs();
+        for (int i = 0; i < MAX_INFLIGHT; i++) {
+            Inflight& slot = inflight_[i];
+            if (!slot.in_use || slot.packet_id != id)
+                continue;
+            {
+                std::lock_guard<std::mutex> lock(latency_mutex_);
+                enqueue_to_ack_.record(now - slot.msg.enqueue_ns);
+                send_to_ack_.record(now - slot.sent_ns);
+            }
+            slot.in_use = false;
+            acked_.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+        return true;   // 재전송 뒤 중복 PUBACK 은 무시
+    }
+    case PKT_PINGRESP:
+        ping_sent_ns_ = 0;
+        return true;
+    default:
+        return true;   // 구독하지 않으므로 그 외 packet 은 무시
+    }
+}
+
+bool MqttClient::sendAll(const uint8_t* data, size_t len)
+{
+    while (len > 0) {
+        ssize_t w = send(sock_, data, len, MSG_NOSIGNAL);
+        if (w < 0) {
+            if (errno == EINTR)
+                continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK)
+                return false;
+            struct pollfd pfd = { sock_, POLLOUT, 0 };
+            if (poll(&pfd, 1, static_cast<int>(cfg_.connect_timeout_ms)) <= 0)
+                return false;
+            continue;
+        }
+        data += w;
+        len  -= static_cast<size_t>(w);
+    }
+    last_tx_ns_ = monoNowNs();
+    return true;
+}
+
+void MqttClient::waitWake(int timeout_ms)
+{
+    struct pollfd pfd = { wake_fd_, POLLIN, 0 };
+    if (poll(&pfd, 1, std::min(timeout_ms, POLL_MS)) > 0) {
+        uint64_t count;
+        if (read(wake_fd_, &count, sizeof(count)) < 0) {
+            // 이미 비워짐
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#ifndef MQTT_CLIENT_HPP
+#define MQTT_CLIENT_HPP
+
+#include "hdr_histogram.hpp"
+#include "spsc_ring.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+// MQTT 3.1.1 QoS1 publisher (send_speed.py / paho 대체)
+// - 연결은 전용 스레드가 계속 유지 (CONNECT / PINGREQ keepalive / 끊기면 지수 backoff 로 재접속)
+// - publish() 는 미리 잡힌 ring 에 넣고 eventfd 로 깨우기만 함 (할당 없음, 블록 안 함)
+//   → 생산자는 한 스레드 (제어 루프) 만
+// - PUBACK 을 못 받은 메시지는 retry_ms 마다, 그리고 재접속 직후 DUP 로 다시 보냄 (at-least-once)
+//   재전송은 inflight slot 순서가 아니라 publish() 순서대로 (broker 가 받는 속도 명령 순서가 바뀌지 않게)
+// - 연결 / 끊김 메시지는 EventLog 로 (worker 스레드에서 stderr 에 직접 쓰지 않음)
+// - publish → PUBACK latency 를 HDR histogram 으로 모음
+class MqttClient {
+public:
+    static constexpr size_t MAX_TOPIC   = 96;
+    static constexpr size_t MAX_PAYLOAD = 160;
+
+    struct Config {
+        std::string host      = "127.0.0.1";
+        uint16_t    port      = 1883;
+        std::string client_id = "mispedal";
+        uint16_t    keepalive_s        = 30;
+        uint32_t    connect_timeout_ms = 2000;
+        uint32_t    retry_ms           = 2000;   // PUBACK 대기 후 재전송
+        uint32_t    backoff_min_ms     = 100;
+        uint32_t    backoff_max_ms     = 5000;
+    };
+
+    struct Stats {
+        bool     connected;
+        uint64_t published;     // publish() 로 받은 수
+        uint64_t dropped;       // ring 이 가득 차서 버린 수
+        uint64_t sent;          // PUBLISH 전송 (재전송 포함)
+        uint64_t retransmits;
+        uint64_t acked;
+        uint64_t reconnects;    // 성공한 (재)접속 수
+        uint64_t connect_failures;
+    };
+
+    explicit MqttClient(const Config& config);
+    ~MqttClient();
+
+    bool start();
+    void stop();   // DISCONNECT 후 스레드 종료 (PUBACK 못 받은 메시지는 버림)
+
+    // topic / payload 는 복사됨, 너무 길거나 ring 이 가득 차면 false
+    bool publish(const char* topic, const void* payload, size_t len);
+
+    bool connected() const { return connected_.load(std::memory_order_relaxed); }
+    Stats stats() const;
+
+    // enqueue → PUBACK / 전송 → PUBACK (ns)
+    void latency(HdrHistogram& enqueue_to_ack, HdrHistogram& send_to_ack) const;
+    void printStats(std::ostream& os) const;
+    void logStats() const;      // 같은 내용을 EventLog INFO 두 줄로
+
+private:
+    struct Message {
+        uint64_t enqueue_ns;
+        uint16_t topic_len;
+        uint16_t payload_len;
+        char     topic[MAX_TOPIC];
+        uint8_t  payload[MAX_PAYLOAD];
+    };
+
+    struct Inflight {
+        bool     in_use;
+        uint16_t packet_id;
+        uint64_t seq;           // publish 순서 (packet id 는 돌아가므로 순서로 쓸 수 없음)
+        uint64_t sent_ns;
+        Message  msg;
+    };
+
+    static constexpr uint32_t QUEUE_SIZE   = 32;
+    static constexpr int      MAX_INFLIGHT = 16;
+    static constexpr size_t   RX_BUFFER    = 512;
+
+    Config cfg_;
+
+    SpscRing<Message, QUEUE_SIZE> queue_;
+    int wake_fd_ = -1;     // eventfd: publish → worker
+
+    std::thread worker_;
+    std::atomic<bool> running_{false};
+    std::atomic<bool> connected_{false};
+
+    // ---- worker 스레드 전용
+    int sock_ = -1;
+    uint16_t next_packet_id_ = 1;
+    uint64_t next_seq_ = 0;
+    Inflight inflight_[MAX_INFLIGHT];
+    bool     have_pending_ = false;    // inflight 가 가득 차서 ring 에서 꺼내 둔 메시지
+    Message  pending_;
+    uint8_t  rx_[RX_BUFFER];
+    size_t   rx_len_ = 0;
+    uint64_t last_tx_ns_ = 0;
+    uint64_t ping_sent_ns_ = 0;        // 응답 대기 중인 PINGREQ (0 이면 없음)
+    uint8_t  tx_[8 + MAX_TOPIC + MAX_PAYLOAD];
+
+    // ---- 통계
+    std::atomic<uint64_t> published_{0}, dropped_{0}, sent_{0}, retransmits_{0}, acked_{0};
+    std::atomic<uint64_t> reconnects_{0}, connect_failures_{0};
+    mutable std::mutex latency_mutex_;
+    HdrHistogram enqueue_to_ack_;
+    HdrHistogram send_to_ack_;
+
+    void run();
+    bool connectBroker();
+    void disconnect(bool graceful);
+    bool serviceConnection();          // 한 번 poll, 연결이 끊기면 false
+    bool drainQueue();
+    bool sendPublish(Inflight& slot, bool dup);
+    int  inflightInOrder(int* order) const;   // 사용 중인 slot 을 publish 순서로, 개수 반환
+    bool handleInput();
+    bool handlePacket(uint8_t type, const uint8_t* body, size_t len);
+    bool sendAll(const uint8_t* data, size_t len);
+    void waitWake(int timeout_ms);
+
+    MqttClient(const MqttClient&) = delete;
+    MqttClient& operator=(const MqttClient&) = delete;
+};
+
+#endif
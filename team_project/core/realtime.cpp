@@ -0,0 +1,76 @@
+#include "realtime.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+namespace {
+
+void reportError(const char* what)
+{
+    std::cerr << "[realtime] " << what << " failed: " << strerror(errno) << std::endl;
+}
+
+// 인라인되면 호출한 함수의 stack 만 커지므로 막음
+__attribute__((noinline)) void prefaultStack(size_t size)
+{
+    volatile unsigned char* buf = static_cast<volatile unsigned char*>(alloca(size));
+    long page = sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < size; i += static_cast<size_t>(page))
+        buf[i] = 0;
+}
+
+void prefaultHeap(size_t size)
+{
+    unsigned char* buf = static_cast<unsigned char*>(malloc(size));
+    if (!buf)
+        return;
+    long page = sysconf(_SC_PAGESIZE);
+    for (size_t i = 0; i < size; i += static_cast<size_t>(page))
+        buf[i] = 0;
+    free(buf);      // M_TRIM_THRESHOLD = -1 이므로 heap 에 남음
+}
+
+} // namespace
+
+
+bool enterRealtime(const RealtimeConfig& config)
+{
+    bool ok = true;
+
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+        reportError("mlockall");
+        ok = false;
+    }
+
+    // 큰 할당도 mmap 이 아닌 heap 에서, free 해도 heap 을 줄이지 않음
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+    prefaultHeap(config.heap_reserve);
+    prefaultStack(config.stack_prefault);
+
+    sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = config.priority;
+    if (sched_setscheduler(0, SCHED_FIFO, &param) != 0) {
+        reportError("sched_setscheduler(SCHED_FIFO)");
+        ok = false;
+    }
+
+    if (config.cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(config.cpu, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+            reportError("sched_setaffinity");
+            ok = false;
+        }
+    }
+    return ok;
+}
@@ -0,0 +1,23 @@
+#ifndef REALTIME_HPP
+#define REALTIME_HPP
+
+#include <cstddef>
+
+// 제어 루프 (scheduler 스레드) 를 실시간으로 돌리기 위한 설정 (mispedal_main --realtime)
+// 평균보다 최악 주기가 중요하므로 page fault / 다른 스레드 / heap 반환 때문에 튀지 않게 한다.
+struct RealtimeConfig {
+    int    priority       = 80;                  // SCHED_FIFO 우선순위 (1~99)
+    int    cpu            = -1;                  // 고정할 core (-1: 그대로)
+    size_t stack_prefault = 256 * 1024;          // 미리 건드려 둘 stack 크기
+    size_t heap_reserve   = 8 * 1024 * 1024;     // 미리 잡아 두고 돌려주지 않을 heap 크기
+};
+
+// 호출한 스레드에 적용 (다른 스레드를 모두 띄운 뒤, 루프 직전에 호출)
+// 1. mlockall(MCL_CURRENT | MCL_FUTURE): 이후 잡는 메모리도 swap / page fault 없음
+// 2. malloc 이 heap 을 OS 에 돌려주거나 mmap 으로 잡지 않게 하고, heap_reserve 만큼 미리 늘려 둠
+// 3. stack_prefault 만큼 stack 을 건드려 page 를 미리 잡음
+// 4. SCHED_FIFO priority, cpu 고정
+// 실패한 단계는 cerr 에 쓰고 계속 진행, 모두 성공하면 true (root / CAP_SYS_NICE 필요)
+bool enterRealtime(const RealtimeConfig& config);
+
+#endif
@@ -0,0 +1,159 @@
+#include "scheduler.hpp"
+#include "alloc_counter.hpp"
+#include "event_log.hpp"
+#include <algorithm>
+#include <iomanip>
+
+
+int PeriodicScheduler::addTask(const std::string& name, double rate_hz, TaskFn fn)
+{
+    // 0 / 음수면 period 가 inf 나 음수 → uint64_t 변환이 정의되지 않음, 1GHz 초과면 period 0
+    if (!(rate_hz > 0.0 && rate_hz <= 1e9)) {
+        LOG_ERROR("scheduler: task rejected, rate {} Hz", rate_hz);
+        return -1;
+    }
+
+    Task task;
+    task.name            = name;
+    task.period_ns       = static_cast<uint64_t>(1e9 / rate_hz);
+    task.next_release_ns = 0;
+    task.fn              = fn;
+    tasks_.push_back(task);
+
+    int id = static_cast<int>(tasks_.size()) - 1;
+
+    // 주기가 짧은 task 가 먼저 오도록 삽입
+    std::vector<int>::iterator it = order_.begin();
+    while (it != order_.end() && tasks_[*it].period_ns <= task.period_ns)
+        ++it;
+    order_.insert(it, id);
+
+    if (started_)
+        tasks_[id].next_release_ns = clock_->nowNs();
+    return id;
+}
+
+void PeriodicScheduler::start(uint64_t now_ns)
+{
+    for (size_t i = 0; i < tasks_.size(); i++)
+        tasks_[i].next_release_ns = now_ns;
+    started_ = true;
+}
+
+void PeriodicScheduler::runTask(Task& task, uint64_t now_ns)
+{
+    TaskStats& st = task.stats;
+    uint64_t release = task.next_release_ns;
+    uint64_t jitter  = now_ns - release;
+
+    uint64_t allocs = threadAllocCount();
+    task.fn(now_ns);
+    st.allocs += threadAllocCount() - allocs;
+
+    uint64_t end  = clock_->nowNs();
+    uint64_t exec = end - now_ns;
+
+    st.runs++;
+    st.jitter_sum_ns += jitter;
+    st.exec_sum_ns   += exec;
+    st.jitter_max_ns  = std::max(st.jitter_max_ns, jitter);
+    st.exec_max_ns    = std::max(st.exec_max_ns, exec);
+
+    // implicit deadline = 다음 release
+    uint64_t next = release + task.period_ns;
+    if (end > next) {
+        st.misses++;
+
+        // 밀린 주기는 몰아서 실행하지 않고 건너뛴다 (phase 는 유지)
+        uint64_t behind = (end - next) / task.period_ns + 1;
+        st.skipped += behind;
+        next += behind * task.period_ns;
+    }
+    task.next_release_ns = next;
+}
+
+void PeriodicScheduler::runOnce()
+{
+    if (tasks_.empty())
+        return;
+
+    if (!started_)
+        start(clock_->nowNs());
+
+    uint64_t earliest = tasks_[0].next_release_ns;
+    for (size_t i = 1; i < tasks_.size(); i++)
+        earliest = std::min(earliest, tasks_[i].next_release_ns);
+
+    clock_->sleepUntil(earliest);
+
+    for (size_t i = 0; i < order_.size(); i++) {
+        Task& task = tasks_[order_[i]];
+        uint64_t now = clock_->nowNs();
+        if (task.next_release_ns <= now)
+            runTask(task, now);
+    }
+}
+
+void PeriodicScheduler::run()
+{
+    running_.store(true);
+    while (running_.load(std::memory_order_relaxed))
+        runOnce();
+}
+
+void PeriodicScheduler::resetStats()
+{
+    for (size_t i = 0; i < tasks_.size(); i++)
+        tasks_[i].stats = TaskStats();
+}
+
+void PeriodicScheduler::copyStats(std::vector<TaskStats>& out) const
+{
+    out.resize(tasks_.size());
+    for (size_t i = 0; i < tasks_.size(); i++)
+        out[i] = tasks_[i].stats;
+}
+
+void PeriodicScheduler::printStats(std::ostream& os) const
+{
+    std::vector<TaskStats> stats;
+    copyStats(stats);
+    printStats(os, stats);
+}
+
+void PeriodicScheduler::logStats(const std::vector<TaskStats>& stats) const
+{
+    for (size_t i = 0; i < order_.size(); i++) {
+        const Task& t = tasks_[order_[i]];
+        const TaskStats& st = stats[order_[i]];
+        LOG_INFO("task {} {} Hz: runs {} miss {} skip {} jitter avg {} max {} us, exec avg {} max {} us, allocs {}",
+                 t.name.c_str(), 1e9 / t.period_ns, st.runs, st.misses, st.skipped,
+                 st.jitterAvgUs(), st.jitter_max_ns / 1000.0, st.execAvgUs(), st.exec_max_ns / 1000.0, st.allocs);
+    }
+}
+
+void PeriodicScheduler::printStats(std::ostream& os, const std::vector<TaskStats>& stats) const
+{
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+
+    os << "task         rate(Hz)   runs   miss  skip  jit_avg(us) jit_max(us) exec_avg(us) exec_max(us) allocs\n";
+    for (size_t i = 0; i < order_.size(); i++) {
+        const Task& t = tasks_[order_[i]];
+        const TaskStats& st = stats[order_[i]];
+        os << std::left  << std::setw(12) << t.name << std::right
+           << std::fixed << std::setprecision(1)
+           << std::setw(9)  << 1e9 / t.period_ns
+           << std::setw(7)  << st.runs
+           << std::setw(7)  << st.misses
+           << std::setw(6)  << st.skipped
+           << std::setw(13) << st.jitterAvgUs()
+           << std::setw(12) << st.jitter_max_ns / 1000.0
+           << std::setw(13) << st.execAvgUs()
+           << std::setw(13) << st.exec_max_ns / 1000.0
+           << std::setw(7)  << st.allocs
+           << "\n";
+    }
+    os.flags(flags);
+    os.precision(precision);
+}
@@ -0,0 +1,80 @@
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include "clock.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// task 별 실행 통계
+// - jitter : 실제 시작 시각 - 예정(release) 시각
+// - miss   : 다음 주기 시작 전에 끝나지 못한 횟수
+// - skipped: overrun 때문에 건너뛴 주기 수
+// - allocs : task 안에서 일어난 heap 할당 수 (평상시 0 이어야 함, --realtime)
+struct TaskStats {
+    uint64_t runs    = 0;
+    uint64_t misses  = 0;
+    uint64_t skipped = 0;
+    uint64_t allocs  = 0;
+
+    uint64_t jitter_max_ns = 0;
+    uint64_t jitter_sum_ns = 0;
+    uint64_t exec_max_ns   = 0;
+    uint64_t exec_sum_ns   = 0;
+
+    double jitterAvgUs() const { return runs ? jitter_sum_ns / 1000.0 / runs : 0.0; }
+    double execAvgUs()   const { return runs ? exec_sum_ns / 1000.0 / runs : 0.0; }
+};
+
+// 절대 deadline 기반 다중 주기 scheduler (단일 스레드)
+// 각 task 는 release 시각 = 이전 release + period 로 진행하므로 실행 시간 때문에 주기가 밀리지 않는다.
+// Clock::sleepUntil() 로 가장 가까운 release 까지 잠든다. (기본: CLOCK_MONOTONIC, replay: SimClock)
+// 동시에 release 된 task 는 주기가 짧은 순서(rate monotonic)로 실행된다.
+class PeriodicScheduler {
+public:
+    typedef std::function<void(uint64_t now_ns)> TaskFn;
+
+    explicit PeriodicScheduler(Clock* clock = nullptr) : clock_(clock ? clock : &systemClock()) {}
+
+    // 반환값: task id (stats() 조회용), rate_hz 가 0 이하 / 1GHz 초과 / NaN 이면 추가하지 않고 -1
+    int addTask(const std::string& name, double rate_hz, TaskFn fn);
+
+    void run();           // stop() 이 불릴 때까지 반복
+    void runOnce();       // 다음 release 까지 대기 후 도래한 task 실행
+    void stop() { running_.store(false); }
+
+    const TaskStats& stats(int id) const { return tasks_[id].stats; }
+    size_t taskCount() const { return tasks_.size(); }
+    void resetStats();
+    void printStats(std::ostream& os) const;
+
+    // 다른 스레드에서 출력하려면: task 안에서 copyStats() 로 떠 두고 (out 이 taskCount() 크기면 할당 없음),
+    // 그 스레드에서 printStats(os, out). task 이름 / 주기는 addTask 이후 바뀌지 않으므로 같이 읽어도 됨
+    void copyStats(std::vector<TaskStats>& out) const;
+    void printStats(std::ostream& os, const std::vector<TaskStats>& stats) const;
+    // task 하나당 EventLog INFO 한 줄
+    void logStats(const std::vector<TaskStats>& stats) const;
+
+private:
+    struct Task {
+        std::string name;
+        uint64_t    period_ns;
+        uint64_t    next_release_ns;
+        TaskFn      fn;
+        TaskStats   stats;
+    };
+
+    Clock* clock_;
+    std::vector<Task> tasks_;
+    std::vector<int>  order_;      // period 오름차순 index
+    bool started_ = false;
+    std::atomic<bool> running_{false};     // stop() 은 다른 스레드 (signal 처리 등) 에서도 호출
+
+    void start(uint64_t now_ns);
+    void runTask(Task& task, uint64_t now_ns);
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef SEQLOCK_HPP
+#define SEQLOCK_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// 단일 writer / 다수 reader 최신값 슬롯
+// - writer 는 기다리지 않음 (seq 홀수 → 데이터 복사 → seq 짝수)
+// - reader 는 seq 가 바뀌지 않은 일관된 복사본을 얻을 때까지 재시도
+// 데이터는 atomic word 배열에 relaxed 로 복사하므로 data race 없이 동작한다.
+template <typename T>
+class Seqlock {
+    static_assert(std::is_trivially_copyable<T>::value, "Seqlock needs a trivially copyable type");
+
+public:
+    Seqlock() : seq_(0)
+    {
+        for (size_t i = 0; i < WORDS; i++)
+            words_[i].store(0, std::memory_order_relaxed);
+    }
+
+    void write(const T& value)
+    {
+        uint32_t buf[WORDS] = {0};
+        memcpy(buf, &value, sizeof(T));
+
+        uint32_t seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < WORDS; i++)
+            words_[i].store(buf[i], std::memory_order_relaxed);
+
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    T read() const
+    {
+        uint32_t buf[WORDS];
+        uint32_t before, after;
+        do {
+            before = seq_.load(std::memory_order_acquire);
+            for (size_t i = 0; i < WORDS; i++)
+                buf[i] = words_[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = seq_.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+
+        T value;
+        memcpy(&value, buf, sizeof(T));
+        return value;
+    }
+
+    // 한 번도 write 되지 않았으면 0
+    uint32_t version() const { return seq_.load(std::memory_order_acquire) / 2; }
+
+private:
+    static constexpr size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+    std::atomic<uint32_t> seq_;
+    std::atomic<uint32_t> words_[WORDS];
+};
+
+#endif
@@ -0,0 +1,201 @@
+#ifndef SLIDING_WINDOW_HPP
+#define SLIDING_WINDOW_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// 최근 N 개 샘플에 대한 고정 크기 sliding window 통계 (header-only, 할당 없음)
+// - push / mean / variance / min / max 모두 상수 시간 (min/max 는 amortized)
+// - 평균/분산은 sliding Welford 로 갱신하고, 누적 오차를 막기 위해 RECOMPUTE_EVERY 번마다 다시 계산
+// - min/max 는 단조(monotonic) deque: 앞쪽이 항상 현재 window 의 최소/최대
+template <typename T, size_t N>
+class SlidingWindow {
+    static_assert(N >= 1, "SlidingWindow needs N >= 1");
+
+public:
+    static constexpr size_t CAPACITY = N;
+
+    SlidingWindow() { clear(); }
+
+    void clear()
+    {
+        seq_ = 0;
+        count_ = 0;
+        mean_ = 0.0;
+        m2_ = 0.0;
+        min_q_.clear();
+        max_q_.clear();
+    }
+
+    void push(T x)
+    {
+        const uint64_t s = seq_;
+        const double xn = static_cast<double>(x);
+
+        // 덮어쓸 칸을 가리키는 deque 원소부터 만료
+        if (s >= N) {
+            min_q_.expire(s - N);
+            max_q_.expire(s - N);
+        }
+
+        if (count_ < N) {
+            // 채우는 중: 일반 Welford
+            count_++;
+            double d = xn - mean_;
+            mean_ += d / count_;
+            m2_ += d * (xn - mean_);
+        }
+        else {
+            // 가득 참: 가장 오래된 값을 빼고 새 값을 더함
+            double xo = static_cast<double>(buf_[s % N]);
+            double old_mean = mean_;
+            mean_ += (xn - xo) / N;
+            m2_ += (xn - xo) * (xn - mean_ + xo - old_mean);
+            if (m2_ < 0.0)
+                m2_ = 0.0;
+        }
+
+        buf_[s % N] = x;
+        seq_ = s + 1;
+
+        while (!min_q_.empty() && !(buf_[min_q_.back() % N] < x))
+            min_q_.popBack();
+        min_q_.pushBack(s);
+
+        while (!max_q_.empty() && !(x < buf_[max_q_.back() % N]))
+            max_q_.popBack();
+        max_q_.pushBack(s);
+
+        if (seq_ % RECOMPUTE_EVERY == 0)
+            recompute();
+    }
+
+    size_t size()  const { return count_; }
+    bool   full()  const { return count_ == N; }
+    bool   empty() const { return count_ == 0; }
+
+    T newest() const { return buf_[(seq_ - 1) % N]; }
+    T oldest() const { return buf_[(seq_ - count_) % N]; }
+
+    // i = 0 이 가장 오래된 값
+    T at(size_t i) const { return buf_[(seq_ - count_ + i) % N]; }
+
+    double mean()     const { return mean_; }
+    double variance() const { return count_ > 1 ? m2_ / (count_ - 1) : 0.0; }   // 표본 분산
+    double stddev()   const { return std::sqrt(variance()); }
+
+    // 비어있으면 T()
+    T min() const { return min_q_.empty() ? T() : buf_[min_q_.front() % N]; }
+    T max() const { return max_q_.empty() ? T() : buf_[max_q_.front() % N]; }
+
+private:
+    static constexpr uint64_t RECOMPUTE_EVERY = N * 64;
+
+    // window 안의 sequence 번호만 담는 고정 크기 deque
+    struct IndexDeque {
+        uint64_t idx[N];
+        size_t head;
+        size_t len;
+
+        void clear()               { head = 0; len = 0; }
+        bool empty() const         { return len == 0; }
+        uint64_t front() const     { return idx[head]; }
+        uint64_t back() const      { return idx[(head + len - 1) % N]; }
+        void popBack()             { len--; }
+        void pushBack(uint64_t s)  { idx[(head + len) % N] = s; len++; }
+        void expire(uint64_t s)
+        {
+            if (len > 0 && idx[head] <= s) {
+                head = (head + 1) % N;
+                len--;
+            }
+        }
+    };
+
+    T buf_[N];
+    uint64_t seq_;
+    size_t count_;
+    double mean_;
+    double m2_;
+    IndexDeque min_q_;
+    IndexDeque max_q_;
+
+    void recompute()
+    {
+        double sum = 0.0;
+        for (size_t i = 0; i < count_; i++)
+            sum += static_cast<double>(at(i));
+        mean_ = sum / count_;
+
+        double m2 = 0.0;
+        for (size_t i = 0; i < count_; i++) {
+            double d = static_cast<double>(at(i)) - mean_;
+            m2 += d * d;
+        }
+        m2_ = m2;
+    }
+};
+
+
+// 최근 N 개 샘플의 median / percentile (선택 사용)
+// 정렬된 사본을 유지: push 는 이분 탐색 + memmove 로 O(log N + N), 조회는 O(1)
+// N 이 작은 센서 window(수십 개)에서는 매번 정렬하는 것보다 훨씬 싸다.
+template <typename T, size_t N>
+class SlidingQuantile {
+    static_assert(std::is_trivially_copyable<T>::value, "SlidingQuantile moves elements with memmove");
+
+public:
+    SlidingQuantile() : seq_(0), count_(0) {}
+
+    void clear() { seq_ = 0; count_ = 0; }
+
+    void push(T x)
+    {
+        if (count_ == N) {
+            T old = ring_[seq_ % N];
+            T* pos = std::lower_bound(sorted_, sorted_ + count_, old);
+            memmove(pos, pos + 1, (sorted_ + count_ - pos - 1) * sizeof(T));
+            count_--;
+        }
+
+        T* pos = std::upper_bound(sorted_, sorted_ + count_, x);
+        memmove(pos + 1, pos, (sorted_ + count_ - pos) * sizeof(T));
+        *pos = x;
+        count_++;
+
+        ring_[seq_ % N] = x;
+        seq_++;
+    }
+
+    size_t size() const { return count_; }
+
+    // p: 0~1 (밖이면 최소 / 최대, NaN 은 최소), 인접 순위 사이 선형 보간
+    double quantile(double p) const
+    {
+        if (count_ == 0)
+            return 0.0;
+        if (!(p > 0.0))
+            p = 0.0;
+        else if (p > 1.0)
+            p = 1.0;
+        double pos = p * (count_ - 1);
+        size_t lo = static_cast<size_t>(pos);
+        size_t hi = lo + 1 < count_ ? lo + 1 : lo;
+        double frac = pos - lo;
+        return sorted_[lo] + (sorted_[hi] - sorted_[lo]) * frac;
+    }
+
+    double median() const { return quantile(0.5); }
+
+private:
+    T ring_[N];
+    T sorted_[N];
+    uint64_t seq_;
+    size_t count_;
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef SPAN_HPP
+#define SPAN_HPP
+
+#include <cstddef>
+
+// C++11 용 최소 span (소유하지 않는 포인터 + 길이)
+template <typename T>
+struct Span {
+    T*     ptr  = nullptr;
+    size_t len  = 0;
+
+    Span() {}
+    Span(T* p, size_t n) : ptr(p), len(n) {}
+
+    T*     data()  const { return ptr; }
+    size_t size()  const { return len; }
+    bool   empty() const { return len == 0; }
+
+    T* begin() const { return ptr; }
+    T* end()   const { return ptr + len; }
+
+    T& operator[](size_t i) const { return ptr[i]; }
+};
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// 고정 크기 단일 생산자/단일 소비자 lock-free ring buffer
+// - 메모리는 객체 안에 미리 잡혀 있으므로 push/pop 에서 할당 없음
+// - N 은 2의 거듭제곱
+template <typename T, uint32_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    static constexpr uint32_t CAPACITY = N;
+
+    bool push(const T& item)
+    {
+        uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) >= N)
+            return false;
+
+        buf_[head & (N - 1)] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item)
+    {
+        uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire))
+            return false;
+
+        item = buf_[tail & (N - 1)];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint32_t size() const
+    {
+        return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+    }
+
+    bool empty() const { return size() == 0; }
+
+private:
+    alignas(64) std::atomic<uint32_t> head_{0};   // 생산자
+    alignas(64) std::atomic<uint32_t> tail_{0};   // 소비자
+    alignas(64) T buf_[N];
+};
+
+#endif
@@ -0,0 +1,180 @@
+#include "syscall_counter.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <linux/filter.h>
+#include <linux/perf_event.h>
+#include <linux/seccomp.h>
+
+
+namespace {
+
+int openTracepoint()
+{
+    const char* paths[] = {
+        "/sys/kernel/tracing/events/raw_syscalls/sys_enter/id",
+        "/sys/kernel/debug/tracing/events/raw_syscalls/sys_enter/id",
+    };
+    for (size_t i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        FILE* fp = fopen(paths[i], "r");
+        if (fp == nullptr)
+            continue;
+        unsigned long long id = 0;
+        int ok = fscanf(fp, "%llu", &id);
+        fclose(fp);
+        if (ok != 1)
+            continue;
+
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type   = PERF_TYPE_TRACEPOINT;
+        attr.size   = sizeof(attr);
+        attr.config = id;
+        int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd >= 0)
+            return fd;
+    }
+    return -1;
+}
+
+uint64_t readProcIo()
+{
+    int fd = open("/proc/thread-self/io", O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return 0;
+    char buf[512];
+    ssize_t n = ::read(fd, buf, sizeof(buf) - 1);
+    close(fd);
+    if (n <= 0)
+        return 0;
+    buf[n] = '\0';
+
+    uint64_t total = 0;
+    const char* keys[] = { "syscr: ", "syscw: " };
+    for (int i = 0; i < 2; i++) {
+        const char* p = strstr(buf, keys[i]);
+        if (p != nullptr)
+            total += strtoull(p + strlen(keys[i]), nullptr, 10);
+    }
+    return total;
+}
+
+} // namespace
+
+
+SyscallCounter::~SyscallCounter()
+{
+    if (perf_fd_ >= 0)
+        close(perf_fd_);
+    if (supervisor_.joinable())
+        supervisor_.join();    // attach 한 스레드가 끝나면 listener 가 POLLHUP
+}
+
+SyscallCounter::Source SyscallCounter::attach(bool use_seccomp)
+{
+    if (source_ != NONE)
+        return source_;
+
+    perf_fd_ = openTracepoint();
+    if (perf_fd_ >= 0)
+        source_ = PERF;
+    else if (use_seccomp && attachSeccomp())
+        source_ = SECCOMP;
+    else
+        source_ = PROC_IO;
+    return source_;
+}
+
+const char* SyscallCounter::source() const
+{
+    switch (source_) {
+    case PERF:    return "perf";
+    case SECCOMP: return "seccomp";
+    case PROC_IO: return "proc_io";
+    default:      return "none";
+    }
+}
+
+uint64_t SyscallCounter::read()
+{
+    switch (source_) {
+    case PERF: {
+        uint64_t count = 0;
+        if (::read(perf_fd_, &count, sizeof(count)) != sizeof(count))
+            return 0;
+        return count;
+    }
+    case SECCOMP:
+        return count_.load(std::memory_order_acquire);   // 알림은 동기식이라 돌아온 syscall 은 이미 셈
+    case PROC_IO:
+        return readProcIo();
+    default:
+        return 0;
+    }
+}
+
+uint64_t SyscallCounter::overhead()
+{
+    uint64_t a = read();
+    uint64_t b = read();
+    return b - a;
+}
+
+bool SyscallCounter::attachSeccomp()
+{
+    tid_ = static_cast<int>(syscall(SYS_gettid));
+    // 감시 스레드는 filter 를 걸기 전에 만들어야 filter 를 물려받지 않음
+    supervisor_ = std::thread(&SyscallCounter::superviseLoop, this);
+
+    int fd = -1;
+    if (prctl(PR_SET_NO_NEW_PRIVS, 1, 0, 0, 0) == 0) {
+        struct sock_filter filter[] = {
+            BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_USER_NOTIF),
+        };
+        struct sock_fprog prog = { static_cast<unsigned short>(sizeof(filter) / sizeof(filter[0])), filter };
+        fd = static_cast<int>(syscall(SYS_seccomp, SECCOMP_SET_MODE_FILTER, SECCOMP_FILTER_FLAG_NEW_LISTENER, &prog));
+    }
+    listener_.store(fd >= 0 ? fd : -2, std::memory_order_release);
+    if (fd < 0) {
+        supervisor_.join();
+        return false;
+    }
+    return true;
+}
+
+void SyscallCounter::superviseLoop()
+{
+    int fd;
+    while ((fd = listener_.load(std::memory_order_acquire)) == -1)
+        usleep(100);
+    if (fd < 0)
+        return;
+
+    struct seccomp_notif req;
+    struct seccomp_notif_resp resp;
+    for (;;) {
+        struct pollfd pfd = { fd, POLLIN, 0 };
+        if (poll(&pfd, 1, -1) < 0)
+            continue;
+        if (pfd.revents & (POLLHUP | POLLERR | POLLNVAL))
+            break;      // filter 를 쓰는 스레드가 모두 끝남
+
+        memset(&req, 0, sizeof(req));
+        if (ioctl(fd, SECCOMP_IOCTL_NOTIF_RECV, &req) < 0)
+            continue;   // 그 사이 스레드가 signal 등으로 빠져나감
+        if (static_cast<int>(req.pid) == tid_)
+            count_.fetch_add(1, std::memory_order_release);
+
+        memset(&resp, 0, sizeof(resp));
+        resp.id    = req.id;
+        resp.flags = SECCOMP_USER_NOTIF_FLAG_CONTINUE;
+        ioctl(fd, SECCOMP_IOCTL_NOTIF_SEND, &resp);
+    }
+    close(fd);
+}
@@ -0,0 +1,50 @@
+#ifndef SYSCALL_COUNTER_HPP
+#define SYSCALL_COUNTER_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// 한 스레드의 syscall 수 (bench --check / 테스트의 "hot path 에서 syscall 0" 확인용)
+// attach() 를 부른 스레드를 센다. 방법은 되는 것 중 앞의 것:
+//   perf    : raw_syscalls:sys_enter tracepoint 를 이 스레드에 대해 (tracefs 읽기 + perf_event_paranoid 허용 필요)
+//   seccomp : SECCOMP_RET_USER_NOTIF filter 를 이 스레드에 걸고, 감시 스레드가 하나씩 세고 그대로 진행시킴
+//             (권한 불필요, Linux 5.5+). filter 는 스레드가 끝날 때까지 남고 syscall 마다 수 us 가 더해지므로
+//             측정 전용 스레드에서 attach 할 것. 이 객체는 그 스레드가 끝난 뒤에 없앨 것 (소멸자가 감시 스레드를 기다림)
+//   proc_io : /proc/thread-self/io 의 syscr + syscw (read/write 계열만, exact() == false)
+class SyscallCounter {
+public:
+    enum Source { NONE, PERF, SECCOMP, PROC_IO };
+
+    SyscallCounter() {}
+    ~SyscallCounter();
+
+    // 호출한 스레드를 센다 (한 번만), use_seccomp = false 면 seccomp 는 쓰지 않음
+    Source attach(bool use_seccomp = true);
+
+    Source      kind()   const { return source_; }
+    const char* source() const;
+    bool        exact()  const { return source_ == PERF || source_ == SECCOMP; }
+
+    // attach 한 스레드에서 호출 (seccomp 는 어느 스레드에서나)
+    uint64_t read();
+    // read() 자체가 만드는 syscall 수 (측정값에서 뺌)
+    uint64_t overhead();
+
+private:
+    Source source_ = NONE;
+    int    perf_fd_ = -1;
+
+    std::thread supervisor_;
+    std::atomic<int>      listener_{-1};   // -1: 아직, -2: 실패
+    std::atomic<uint64_t> count_{0};
+    int tid_ = 0;                           // attach 한 스레드 (그 스레드가 만든 스레드도 filter 를 물려받지만 세지 않음)
+
+    bool attachSeccomp();
+    void superviseLoop();
+
+    SyscallCounter(const SyscallCounter&) = delete;
+    SyscallCounter& operator=(const SyscallCounter&) = delete;
+};
+
+#endif
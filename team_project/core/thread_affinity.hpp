@@ -0,0 +1,31 @@
+#ifndef THREAD_AFFINITY_HPP
+#define THREAD_AFFINITY_HPP
+
+#include <pthread.h>
+#include <sched.h>
+#include <thread>
+
+// 스레드를 core 하나에 고정 (cpu < 0 이면 그대로 둠), 실패하면 false
+// 센서 수집 스레드가 제어 / 검출 스레드와 같은 core 에서 밀리지 않게 할 때 사용
+inline bool pinThread(std::thread& thread, int cpu)
+{
+    if (cpu < 0)
+        return true;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set) == 0;
+}
+
+// 스레드를 SCHED_FIFO 로 (priority <= 0 이면 그대로 둠), 실패하면 false (root / CAP_SYS_NICE 필요)
+// --realtime 에서 센서 수집 스레드가 제어 스레드보다 먼저 돌도록 할 때 사용
+inline bool setThreadFifo(std::thread& thread, int priority)
+{
+    if (priority <= 0)
+        return true;
+    sched_param param;
+    param.sched_priority = priority;
+    return pthread_setschedparam(thread.native_handle(), SCHED_FIFO, &param) == 0;
+}
+
+#endif
@@ -0,0 +1,163 @@
+#include "trace.hpp"
+#include "detection_channel.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+
+namespace {
+
+const char* NATIVE_HEADER = "t_ns,kind,value";   // loadTrace 의 header 비교와 맞출 것
+
+bool byTime(const TraceEvent& a, const TraceEvent& b)
+{
+    return a.t_ns < b.t_ns;
+}
+
+} // namespace
+
+
+void splitCsvLine(const std::string& line, std::vector<std::string>& cols)
+{
+    size_t len = line.size();
+    if (len > 0 && line[len - 1] == '\r')
+        len--;
+
+    cols.clear();
+    size_t start = 0;
+    while (true) {
+        size_t comma = line.find(',', start);
+        if (comma == std::string::npos || comma > len) {
+            cols.push_back(line.substr(start, len - start));
+            break;
+        }
+        cols.push_back(line.substr(start, comma - start));
+        start = comma + 1;
+    }
+}
+
+int csvColumn(const std::vector<std::string>& header, const char* name)
+{
+    for (size_t i = 0; i < header.size(); i++) {
+        if (header[i] == name)
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+
+bool loadTrace(const std::string& path, std::vector<TraceEvent>& events, TraceInfo& info,
+               uint64_t legacy_start_ns, uint64_t legacy_period_ns)
+{
+    std::ifstream in(path.c_str());
+    if (!in) {
+        std::cerr << "trace open failed: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    if (!std::getline(in, line))
+        return false;
+
+    std::vector<std::string> header;
+    splitCsvLine(line, header);
+
+    events.clear();
+    info = TraceInfo();
+    int col_distance = csvColumn(header, "distance_cm");
+    int col_voltage  = csvColumn(header, "voltage");
+    int col_scenario = csvColumn(header, "scenario");
+    int col_accel    = csvColumn(header, "accel_detected");
+    int col_brake    = csvColumn(header, "brake_detected");
+
+    info.legacy_log = (col_distance >= 0 && col_voltage >= 0);
+    if (!info.legacy_log && header != std::vector<std::string>{"t_ns", "kind", "value"}) {
+        std::cerr << "unknown trace format: " << path << std::endl;
+        return false;
+    }
+
+    std::vector<std::string> cols;
+    while (std::getline(in, line)) {
+        splitCsvLine(line, cols);
+        if (cols.size() < header.size())
+            continue;
+
+        if (info.legacy_log) {
+            uint64_t t = legacy_start_ns + info.rows * legacy_period_ns;
+            if (col_scenario >= 0)
+                info.scenario = atoi(cols[col_scenario].c_str());
+
+            TraceEvent ev;
+            ev.t_ns = t;
+            ev.kind = TRACE_PEDAL;
+            ev.value = strtof(cols[col_voltage].c_str(), nullptr);
+            events.push_back(ev);
+
+            ev.kind = TRACE_RANGE;
+            ev.value = strtof(cols[col_distance].c_str(), nullptr);
+            events.push_back(ev);
+
+            ev.kind = TRACE_DETECT;
+            if (col_accel >= 0 && atoi(cols[col_accel].c_str()) != 0) {
+                ev.value = DET_ACCEL;
+                events.push_back(ev);
+            }
+            if (col_brake >= 0 && atoi(cols[col_brake].c_str()) != 0) {
+                ev.value = DET_BRAKE;
+                events.push_back(ev);
+            }
+        }
+        else {
+            if (cols[1].size() != 1)
+                continue;
+            TraceEvent ev;
+            ev.t_ns  = strtoull(cols[0].c_str(), nullptr, 10);
+            ev.kind  = cols[1][0];
+            ev.value = strtof(cols[2].c_str(), nullptr);
+            events.push_back(ev);
+        }
+        info.rows++;
+    }
+
+    // 거리는 ping 시각으로 찍히므로 파일 안에서 순서가 조금 뒤바뀔 수 있다.
+    std::stable_sort(events.begin(), events.end(), byTime);
+    return true;
+}
+
+
+// ================= TraceWriter =================
+
+bool TraceWriter::open(const std::string& path)
+{
+    if (fp_ != nullptr)
+        return true;
+
+    fp_ = fopen(path.c_str(), "w");
+    if (fp_ == nullptr) {
+        std::cerr << "trace open failed: " << path << " (" << strerror(errno) << ")" << std::endl;
+        return false;
+    }
+    buffer_.resize(BUFFER);
+    setvbuf(fp_, buffer_.data(), _IOFBF, buffer_.size());
+    fprintf(fp_, "%s\n", NATIVE_HEADER);
+    return true;
+}
+
+void TraceWriter::close()
+{
+    if (fp_ == nullptr)
+        return;
+    fclose(fp_);
+    fp_ = nullptr;
+}
+
+void TraceWriter::record(uint64_t t_ns, TraceKind kind, float value)
+{
+    if (fp_ == nullptr)
+        return;
+    fprintf(fp_, "%" PRIu64 ",%c,%g\n", t_ns, static_cast<char>(kind), value);
+}
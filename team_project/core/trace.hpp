@@ -0,0 +1,65 @@
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// 제어 루프 입력 trace (mispedal_replay 가 재생)
+// native 형식: 헤더 "t_ns,kind,value" + 한 줄에 이벤트 하나 (t_ns 는 CLOCK_MONOTONIC)
+//   R = 초음파 거리 (cm), P = 페달 전압 (V), D = YOLO 검출 (value = DetectionClass)
+// 기존 log.csv (20Hz, 시각 없음) 도 읽는다: i 번째 행을 start + i * period 시각의 R/P/D 이벤트로 바꿈
+enum TraceKind : char {
+    TRACE_RANGE  = 'R',
+    TRACE_PEDAL  = 'P',
+    TRACE_DETECT = 'D',
+};
+
+struct TraceEvent {
+    uint64_t t_ns;
+    char     kind;
+    float    value;
+};
+
+struct TraceInfo {
+    bool   legacy_log = false;   // log.csv 에서 만든 trace
+    int    scenario   = 0;       // log.csv 의 scenario 열 (native 는 0)
+    size_t rows       = 0;
+};
+
+// 쉼표로 나눈 열 (빈 열 포함, 끝의 '\r' 제거)
+void splitCsvLine(const std::string& line, std::vector<std::string>& cols);
+
+// header 에서 열 이름의 위치, 없으면 -1
+int csvColumn(const std::vector<std::string>& header, const char* name);
+
+// log.csv 는 header 이름으로 열을 찾으므로 검출 열이 없는 예전 9열 log 도 읽는다.
+// 시각 순으로 정렬해서 돌려준다 (같은 시각은 파일 순서 유지)
+bool loadTrace(const std::string& path, std::vector<TraceEvent>& events, TraceInfo& info,
+               uint64_t legacy_start_ns, uint64_t legacy_period_ns);
+
+// 실행 중 입력 기록 (scheduler 스레드에서만 호출)
+// stdio 버퍼(64KB)가 찰 때만 write() 가 나가므로 주기 task 안에서 불러도 된다.
+class TraceWriter {
+public:
+    TraceWriter() {}
+    ~TraceWriter() { close(); }
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return fp_ != nullptr; }
+
+    void record(uint64_t t_ns, TraceKind kind, float value);
+
+private:
+    static constexpr size_t BUFFER = 64 * 1024;
+
+    FILE* fp_ = nullptr;
+    std::vector<char> buffer_;
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+};
+
+#endif
@@ -0,0 +1,320 @@
+// C++ YOLO 검출 서비스 (tflite_yolo_picam.py 대체)
+// capture / preprocess / inference / postprocess 를 stage 별 스레드로 돌리고
+// ACCEL / BRAKE 영역 검출을 DetectionChannel 로 제어 프로세스에 바로 보낸다.
+// 카메라는 V4L2 mmap buffer 를 복사 없이 쓰고, 카메라 없이 파일로 FPS / 프레임 latency 를 잴 수 있다.
+//
+// 사용: mispedal_detect --source <image_dir | video.bgr | /dev/videoN> [--size WxH] [--fps F] [--loop]
+//                       [--frames N] [--buffers N] [--dmabuf]
+//                       [--model yolov4-tiny.tflite] [--threads N] [--sim-infer-ms X]
+//                       [--serial] [--slots N] [--drop] [--letterbox] [--rgb] [--no-publish] [--verbose]
+//                       [--gate] [--idle-hz X] [--active-percent X] [--roi] [--track] [--detect-every N]
+//   --source        : /dev/video* 면 V4L2 카메라 (--size 기본 640x480), .bgr 은 mmap 한 raw 영상
+//   --fps           : 카메라 frame rate, raw 영상은 이 간격으로 재생 (카메라 흉내, 기본 최대 속도)
+//   --buffers       : 카메라 / 파일 source 의 buffer 수 (기본 4)
+//   --dmabuf        : 카메라 buffer 를 DMABUF fd 로도 내보냄
+//   --model         : TFLite 모델 (MISPEDAL_WITH_TFLITE 로 빌드했을 때), 없으면 SimDetector
+//   --sim-infer-ms  : SimDetector 의 추론 시간 (기본 150ms, Pi4 yolov4-tiny 정도)
+//   --serial        : 기존 Python loop 처럼 한 스레드에서 차례로 (비교용)
+//   --drop          : 추론이 밀리면 새 프레임을 버림 (카메라처럼 실시간 latency 측정)
+//   --letterbox     : 비율 유지 resize + pad (기본은 Python 과 같이 늘려 맞춤)
+//   --rgb           : 입력을 RGB 순서로 (RGB 로 학습한 모델)
+//   --gate          : 제어 프로세스의 페달 상태 (PedalChannel) 로 검출 빈도 조절
+//                     throttle 이 --active-percent (기본 10%) 이상이거나 올라가는 중이면 매 프레임, 아니면 --idle-hz (기본 2)
+//   --roi           : 페달 검출이 나온 영역을 학습해 그 부분만 잘라 검출 (--gate 와 같이)
+//   --track         : tracker 로 box / 페달 class 를 이어서 이벤트는 tracker 결과로 (class 깜빡임 완화)
+//   --detect-every  : N 프레임에 한 번만 검출, 사이 프레임은 tracker 예측으로 이벤트 (--track 포함)
+#include "vision/detect_pipeline.hpp"
+#include "vision/detector.hpp"
+#include "vision/frame_source.hpp"
+#include "vision/pedal_regions.hpp"
+#include "vision/tracker.hpp"
+#include "vision/v4l2_source.hpp"
+#include "core/detection_channel.hpp"
+#include "sensors/pedal_channel.hpp"
+#ifdef MISPEDAL_WITH_TFLITE
+#include "vision/tflite_detector.hpp"
+#endif
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/resource.h>
+#include <sys/stat.h>
+
+
+namespace {
+
+constexpr int DEFAULT_THREADS = 4;   // Pi 4 core
+
+DetectPipeline* g_pipeline = nullptr;
+
+void onSignal(int)
+{
+    if (g_pipeline)
+        g_pipeline->requestStop();
+}
+
+void usage()
+{
+    std::cerr << "usage: mispedal_detect --source <image_dir|video.bgr|/dev/videoN> [--size WxH] [--fps F] [--loop]\n"
+              << "                       [--frames N] [--buffers N] [--dmabuf]\n"
+              << "                       [--model model.tflite] [--threads N] [--sim-infer-ms X]\n"
+              << "                       [--serial] [--slots N] [--drop] [--letterbox] [--rgb]\n"
+              << "                       [--no-publish] [--verbose] [--gate] [--idle-hz X] [--active-percent X] [--roi]\n"
+              << "                       [--track] [--detect-every N]\n";
+}
+
+bool isDirectory(const std::string& path)
+{
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISDIR(st.st_mode);
+}
+
+// 프로세스 전체 CPU 시간 (user + sys, 초)
+double cpuSeconds()
+{
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    return ru.ru_utime.tv_sec + ru.ru_stime.tv_sec + (ru.ru_utime.tv_usec + ru.ru_stime.tv_usec) / 1e6;
+}
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+    std::string source_path, model_path;
+    int width = 0, height = 0, threads = DEFAULT_THREADS;
+    int buffers = 4;
+    double sim_infer_ms = 150.0, fps = 0;
+    bool loop = false, serial = false, publish = true, verbose = false, dmabuf = false, gate = false;
+    bool track = false;
+    DetectPipeline::Config cfg;
+    InferenceGate::Config gate_cfg;
+
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--source") == 0 && has_value)
+            source_path = argv[++i];
+        else if (strcmp(argv[i], "--size") == 0 && has_value) {
+            if (sscanf(argv[++i], "%dx%d", &width, &height) != 2) {
+                usage();
+                return EXIT_FAILURE;
+            }
+        }
+        else if (strcmp(argv[i], "--fps") == 0 && has_value)
+            fps = atof(argv[++i]);
+        else if (strcmp(argv[i], "--buffers") == 0 && has_value)
+            buffers = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--dmabuf") == 0)
+            dmabuf = true;
+        else if (strcmp(argv[i], "--model") == 0 && has_value)
+            model_path = argv[++i];
+        else if (strcmp(argv[i], "--threads") == 0 && has_value)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--sim-infer-ms") == 0 && has_value)
+            sim_infer_ms = atof(argv[++i]);
+        else if (strcmp(argv[i], "--frames") == 0 && has_value)
+            cfg.max_frames = strtoull(argv[++i], nullptr, 10);
+        else if (strcmp(argv[i], "--slots") == 0 && has_value)
+            cfg.slots = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--loop") == 0)
+            loop = true;
+        else if (strcmp(argv[i], "--serial") == 0)
+            serial = true;
+        else if (strcmp(argv[i], "--drop") == 0)
+            cfg.drop_when_busy = true;
+        else if (strcmp(argv[i], "--gate") == 0)
+            gate = true;
+        else if (strcmp(argv[i], "--idle-hz") == 0 && has_value)
+            gate_cfg.idle_hz = static_cast<float>(atof(argv[++i]));
+        else if (strcmp(argv[i], "--active-percent") == 0 && has_value)
+            gate_cfg.active_percent = static_cast<float>(atof(argv[++i]));
+        else if (strcmp(argv[i], "--roi") == 0)
+            gate_cfg.roi = true;
+        else if (strcmp(argv[i], "--track") == 0)
+            track = true;
+        else if (strcmp(argv[i], "--detect-every") == 0 && has_value) {
+            cfg.detect_every = atoi(argv[++i]);
+            track = true;
+        }
+        else if (strcmp(argv[i], "--letterbox") == 0)
+            cfg.letterbox = true;
+        else if (strcmp(argv[i], "--rgb") == 0)
+            cfg.swap_rb = true;
+        else if (strcmp(argv[i], "--no-publish") == 0)
+            publish = false;
+        else if (strcmp(argv[i], "--verbose") == 0)
+            verbose = true;
+        else {
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+    if (source_path.empty() || cfg.slots < 1 || cfg.detect_every < 1) {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    // ---- 입력
+    std::unique_ptr<FrameSource> source;
+    V4l2Source* camera = nullptr;
+    if (source_path.compare(0, 10, "/dev/video") == 0) {
+        camera = new V4l2Source(source_path, width ? width : 640, height ? height : 480, fps, buffers, dmabuf);
+        source.reset(camera);
+        if (!camera->isOpen())
+            return EXIT_FAILURE;
+    }
+    else if (isDirectory(source_path)) {
+        ImageDirSource* dir = new ImageDirSource(source_path, loop, buffers);
+        source.reset(dir);
+        if (!dir->isOpen())
+            return EXIT_FAILURE;
+    }
+    else {
+        RawVideoSource* raw = new RawVideoSource(source_path, width, height, loop, fps, buffers);
+        source.reset(raw);
+        if (!raw->isOpen())
+            return EXIT_FAILURE;
+    }
+
+    // ---- 추론 backend
+    std::unique_ptr<Detector> detector;
+    if (!model_path.empty()) {
+#ifdef MISPEDAL_WITH_TFLITE
+        TfliteDetector* tflite = new TfliteDetector;
+        detector.reset(tflite);
+        if (!tflite->load(model_path, threads))
+            return EXIT_FAILURE;
+#else
+        std::cerr << "built without TFLite (cmake -DMISPEDAL_WITH_TFLITE=ON), cannot load " << model_path << std::endl;
+        return EXIT_FAILURE;
+#endif
+    }
+    else {
+        std::cout << "no --model: SimDetector, " << sim_infer_ms << " ms per inference" << std::endl;
+        if (threads != DEFAULT_THREADS)
+            std::cerr << "--threads only applies to the TFLite backend" << std::endl;
+        detector.reset(new SimDetector(static_cast<uint32_t>(sim_infer_ms * 1000.0)));
+    }
+
+    // ---- 출력: 제어 프로세스로 (shared memory ring)
+    DetectionChannel channel;
+    if (publish && !channel.open(DETECTION_CHANNEL_NAME)) {
+        std::cerr << "Detection channel unavailable, running without publishing" << std::endl;
+        publish = false;
+    }
+
+    DetectPipeline pipeline(*source, *detector, cfg);
+
+    // ---- 페달 상태로 검출 빈도 조절 (제어 프로세스가 없으면 항상 검출)
+    InferenceGate inference_gate(gate_cfg);
+    PedalChannel pedal;
+    if (gate) {
+        if (!pedal.open(PEDAL_CHANNEL_NAME))
+            std::cerr << "Pedal channel unavailable, gate always runs inference" << std::endl;
+        pipeline.setGate(&inference_gate, pedal.isOpen() ? &pedal : nullptr);
+    }
+    else if (gate_cfg.roi)
+        std::cerr << "--roi needs --gate" << std::endl;
+
+    Tracker tracker;
+    if (track)
+        pipeline.setTracker(&tracker);
+
+    uint64_t accel_events = 0, brake_events = 0;
+    pipeline.setCallback([&](const FrameResult& r) {
+        // tracker: 매 프레임 track 마다 다듬은 class 로 이벤트
+        for (int i = 0; i < r.num_tracks; i++) {
+            const Track& t = r.tracks[i];
+            if (verbose)
+                std::cout << "frame " << r.seq << (r.inferred ? "" : " (predicted)") << " track " << t.id
+                          << " label " << t.box.label << " conf " << t.confidence
+                          << " box " << t.box.xmin << "," << t.box.ymin << "," << t.box.xmax << "," << t.box.ymax
+                          << (t.cls == DET_ACCEL ? " ACCEL" : t.cls == DET_BRAKE ? " BRAKE" : "") << "\n";
+            if (t.cls == DET_NONE)
+                continue;
+            (t.cls == DET_ACCEL ? accel_events : brake_events)++;
+            if (!publish)
+                continue;
+            DetectionEvent ev;
+            memset(&ev, 0, sizeof(ev));
+            ev.cls          = t.cls;
+            ev.label        = static_cast<uint32_t>(t.box.label);
+            ev.confidence   = t.confidence;
+            ev.xmin         = t.box.xmin;
+            ev.ymin         = t.box.ymin;
+            ev.xmax         = t.box.xmax;
+            ev.ymax         = t.box.ymax;
+            ev.timestamp_ns = r.capture_ns;
+            ev.infer_ns     = r.infer_ns;
+            channel.publish(ev);
+        }
+        if (track)
+            return;
+
+        for (int i = 0; i < r.num_detections; i++) {
+            const Detection& d = r.detections[i];
+            uint32_t cls = DET_NONE;
+            if (inRegion(d.xmin, d.ymin, d.xmax, d.ymax, ACCEL_REGION)) {
+                cls = DET_ACCEL;
+                accel_events++;
+            }
+            else if (inRegion(d.xmin, d.ymin, d.xmax, d.ymax, BRAKE_REGION)) {
+                cls = DET_BRAKE;
+                brake_events++;
+            }
+
+            if (verbose)
+                std::cout << "frame " << r.seq << " label " << d.label << " score " << d.score
+                          << " box " << d.xmin << "," << d.ymin << "," << d.xmax << "," << d.ymax
+                          << (cls == DET_ACCEL ? " ACCEL" : cls == DET_BRAKE ? " BRAKE" : "") << "\n";
+
+            if (cls == DET_NONE || !publish)
+                continue;
+            DetectionEvent ev;
+            memset(&ev, 0, sizeof(ev));
+            ev.cls          = cls;
+            ev.label        = static_cast<uint32_t>(d.label);
+            ev.confidence   = d.score;
+            ev.xmin         = d.xmin;
+            ev.ymin         = d.ymin;
+            ev.xmax         = d.xmax;
+            ev.ymax         = d.ymax;
+            ev.timestamp_ns = r.capture_ns;
+            ev.infer_ns     = r.infer_ns;
+            channel.publish(ev);
+        }
+    });
+
+    g_pipeline = &pipeline;
+    signal(SIGINT, onSignal);
+    signal(SIGTERM, onSignal);
+
+    double cpu_start = cpuSeconds();
+    if (serial)
+        pipeline.runSerial();
+    else
+        pipeline.runPipelined();
+    g_pipeline = nullptr;
+    double cpu = cpuSeconds() - cpu_start;
+
+    std::cout << (serial ? "serial" : "pipelined") << ": ";
+    pipeline.printStats(std::cout);
+    if (gate)
+        inference_gate.printStats(std::cout);
+    std::cout << "events: accel " << accel_events << ", brake " << brake_events;
+    if (publish)
+        std::cout << ", channel dropped " << channel.dropped();
+    if (camera)
+        std::cout << ", camera dropped " << camera->dropped();
+    std::cout << std::endl;
+    double secs = pipeline.elapsedSeconds();
+    std::cout << "cpu " << cpu << " s (" << (secs > 0 ? 100.0 * cpu / secs : 0.0) << "% of one core)";
+    if (track)
+        std::cout << ", tracks created " << tracker.created();
+    std::cout << std::endl;
+    return EXIT_SUCCESS;
+}
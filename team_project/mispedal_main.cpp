@@ -1,11 +1,34 @@
 #include "sensors/ultrasonic.hpp"
+#include "sensors/ultrasonic_sampler.hpp"
 #include "sensors/buzzer.hpp"
+#include "sensors/buzzer_sequencer.hpp"
+#include "sensors/pwm_tone.hpp"
 #include "sensors/hall_sensor.hpp"
 #include "sensors/lcd.hpp"
+#include "sensors/pedal_sampler.hpp"
+#include "sensors/pedal_channel.hpp"
+#include "sensors/wiringpi_gpio.hpp"
+#include "control/mispedal_controller.hpp"
+#include "core/scheduler.hpp"
+#include "core/detection_channel.hpp"
+#include "core/csv_logger.hpp"
+#include "core/event_log.hpp"
+#include "core/trace.hpp"
+#include "core/latency_trace.hpp"
+#include "core/mqtt_client.hpp"
+#include "core/mono_clock.hpp"
+#include "core/realtime.hpp"
+#include <wiringPi.h>
+#include <atomic>
+#include <csignal>
 #include <iostream>
 #include <cstdlib>
-#include <fstream>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
 #include <vector>
+#include <unistd.h>
 
 
 // 상수 정의
@@ -23,13 +46,160 @@ constexpr float HALL_THRESHOLD = 1.9;
 constexpr int TRIG = 29;  // GPIO 21 (물리 핀 40)
 constexpr int ECHO = 28;  // GPIO 20 (물리 핀 38)
 
-constexpr int DELTA_WINDOW = 10;   // 최근 10개로 평균
-std::vector<float> delta_buffer(DELTA_WINDOW, 0.0f);
-int delta_index = 0;
-float prev_distance = -1;   
+// 초음파 edge capture (gpiochip, BCM 번호)
+constexpr const char* GPIO_CHIP = "/dev/gpiochip0";
+constexpr int TRIG_GPIO = 21;
+constexpr int ECHO_GPIO = 20;
+
+// 부저 하드웨어 PWM (dtoverlay=pwm → pwmchip0/pwm0 = GPIO18), 없으면 softTone (SPKR)
+constexpr int PWM_CHIP    = 0;
+constexpr int PWM_CHANNEL = 0;
+
+// 센서 수집 스레드를 고정할 core (Pi 4: 0~1 은 scheduler / 기타, 검출 프로세스는 나머지를 같이 씀)
+constexpr int PEDAL_CPU = 2;
+constexpr int ULTRA_CPU = 3;
+constexpr double ULTRA_SAMPLE_HZ = 15.0;   // HC-SR04 ping 간격 60ms 이상
+
+// --realtime: scheduler 스레드는 SCHED_FIFO (--rt-priority), 센서 수집 스레드는 그보다 높게 (주기가 짧고 일이 적음)
+constexpr int RT_PRIORITY_DEFAULT = 80;
+constexpr int RT_SAMPLER_BOOST    = 5;
+constexpr int LCD_LINE_RESERVE    = 32;     // 16x2 LCD 문구 + 여유, show() 에서 할당하지 않도록
+
+// 차량 속도 제어 broker (send_speed.py 기본값과 같음, --broker host:port 로 변경)
+constexpr const char* MQTT_HOST        = "wyjae.sytes.net";
+constexpr uint16_t    MQTT_PORT        = 4341;
+constexpr const char* MQTT_SPEED_TOPIC = "roadcast/control/speed/A";
+
+// task 별 주기 (Hz), ultrasonic / control / log 는 MispedalController 가 등록
+constexpr double LCD_RATE_HZ     = 5.0;
+constexpr double STATUS_RATE_HZ  = 2.0;
+constexpr double STATS_RATE_HZ   = 0.2;
+constexpr double PEDAL_SHARE_RATE_HZ = 100.0;   // 카메라 프레임 간격보다 충분히 짧게
+
+
+// control 이 쓰고 lcd task 가 반영 (같은 문구는 다시 보내지 않음)
+class LcdStatus : public StatusDisplay {
+public:
+    explicit LcdStatus(LCD& lcd) : lcd_(lcd)
+    {
+        line1_.reserve(LCD_LINE_RESERVE);
+        line2_.reserve(LCD_LINE_RESERVE);
+    }
+
+    void show(const char* line1, const char* line2) override
+    {
+        if (line1_ != line1 || line2_ != line2) {
+            line1_ = line1;
+            line2_ = line2;
+            dirty_ = true;
+        }
+    }
+
+    void off() override
+    {
+        off_request_ = true;
+        line1_.clear();
+        line2_.clear();
+    }
+
+    // 실제 I2C 전송은 LCD worker 스레드가 함
+    void update()
+    {
+        if (off_request_) {
+            off_request_ = false;
+            dirty_ = false;
+            lcd_.backlight(0);
+            lcd_.lcd_clear();
+        }
+        else if (dirty_) {
+            dirty_ = false;
+            lcd_.backlight(1);
+            lcd_.displayStatus(line1_, line2_);
+        }
+    }
 
-int main()
+private:
+    LCD& lcd_;
+    std::string line1_, line2_;
+    bool dirty_ = false;
+    bool off_request_ = false;
+};
+
+// kill -USR1 <pid> 로 latency histogram 출력 (stats task 가 확인)
+volatile sig_atomic_t g_dump_latency = 0;
+
+// stats task (FIFO 스레드) 는 여기에 복사만 하고, 보통 우선순위 reporter 스레드가 EventLog 로 보냄
+// ready == false 일 때만 stats task 가 쓰고, true 일 때만 reporter 가 읽음
+struct StatsSnapshot {
+    std::atomic<bool> ready{false};
+    std::vector<TaskStats> tasks;
+    bool latency = false;
+    std::unique_ptr<LatencyTracer> tracer{new LatencyTracer};
+};
+
+void onDumpLatency(int)
 {
+    g_dump_latency = 1;
+}
+
+// 속도 0 요청을 MQTT QoS1 로 보냄 (연결 유지 / 재전송은 MqttClient 스레드가 함, 제어 루프는 enqueue 만)
+class MqttSpeedBrake : public BrakeAssist {
+public:
+    explicit MqttSpeedBrake(MqttClient& mqtt) : mqtt_(mqtt) {}
+
+    void requestStop() override
+    {
+        static const char payload[] = "{\"speed\": 0.0}";
+        if (!mqtt_.publish(MQTT_SPEED_TOPIC, payload, sizeof(payload) - 1))
+            LOG_ERROR("speed stop request dropped (mqtt queue full)");
+    }
+
+private:
+    MqttClient& mqtt_;
+};
+
+int main(int argc, char** argv)
+{
+    // --record <path>: 제어 입력을 trace 로 남김 (mispedal_replay 로 재생)
+    // --broker host:port: 속도 제어 MQTT broker
+    // --realtime [--rt-priority N] [--rt-cpu N]: 제어 루프를 SCHED_FIFO / mlockall 로 (root 필요)
+    // --log-level debug|info|warn|error|off: 진단 메시지 level (기본 info, warn 이면 2Hz status 줄을 끔)
+    TraceWriter recorder;
+    MqttClient::Config mqtt_cfg;
+    mqtt_cfg.host = MQTT_HOST;
+    mqtt_cfg.port = MQTT_PORT;
+    bool realtime = false;
+    RealtimeConfig rt_cfg;
+    rt_cfg.priority = RT_PRIORITY_DEFAULT;
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--record") == 0 && has_value)
+            recorder.open(argv[++i]);
+        else if (strcmp(argv[i], "--broker") == 0 && has_value) {
+            std::string broker = argv[++i];
+            size_t colon = broker.rfind(':');
+            mqtt_cfg.host = broker.substr(0, colon);
+            if (colon != std::string::npos)
+                mqtt_cfg.port = static_cast<uint16_t>(atoi(broker.c_str() + colon + 1));
+        }
+        else if (strcmp(argv[i], "--realtime") == 0)
+            realtime = true;
+        else if (strcmp(argv[i], "--rt-priority") == 0 && has_value)
+            rt_cfg.priority = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--rt-cpu") == 0 && has_value)
+            rt_cfg.cpu = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--log-level") == 0 && has_value) {
+            LogLevel level;
+            if (EventLog::parseLevel(argv[++i], level))
+                EventLog::setLevel(level);
+            else
+                std::cerr << "unknown log level: " << argv[i] << std::endl;
+        }
+    }
+
+    // 제어 / 센서 스레드의 메시지는 formatter 스레드가 stdout 으로
+    EventLog::instance().start();
+
     std::cout << "Measurement start" << std::endl;
     
     // wiringPi 초기화
@@ -40,237 +210,172 @@ int main()
     }
  
 
-    if (setuid(getuid()) < 0)
+    // --realtime 은 SCHED_FIFO / mlockall 을 한 뒤 (sched.run() 직전) 권한을 내려놓음
+    if (!realtime && setuid(getuid()) < 0)
     {
         perror("Dropping privileges failed");
         return EXIT_FAILURE;
     }
 
     MCP3208 hall(SPI_CHANNEL, SPI_SPEED, CS_MCP3208);
-    Ultrasonic ultra(TRIG, ECHO);
-    initBuzzer();
+    // 페달 1kHz 샘플링 + 미분 기반 stomp 감지 (전용 스레드)
+    PedalSampler::Config pedal_cfg;
+    pedal_cfg.channel = ADC_CHANNEL;
+    pedal_cfg.v_min   = V_MIN;
+    pedal_cfg.v_max   = V_MAX;
+    pedal_cfg.cpu     = PEDAL_CPU;
+    pedal_cfg.record  = recorder.isOpen();    // trace 에 1kHz 샘플 모두
+    if (realtime)
+        pedal_cfg.rt_priority = rt_cfg.priority + RT_SAMPLER_BOOST;
+    PedalSampler pedal(hall, pedal_cfg);
+    pedal.start();
+    // gpiochip 을 열 수 있으면 커널 edge timestamp 로 측정, 아니면 기존 polling
+    // 어느 쪽이든 전용 스레드에서 측정하고 제어 루프는 최신 측정만 읽음 (echo 를 기다리지 않음)
+    GpioCdevEdgeSource echo_source(GPIO_CHIP, TRIG_GPIO, ECHO_GPIO);
+    WiringPiGpio gpio;
+    Ultrasonic ultra(TRIG, ECHO, echo_source.isOpen() ? &echo_source : nullptr, &gpio);
+    UltrasonicSampler::Config ultra_cfg;
+    ultra_cfg.rate_hz = ULTRA_SAMPLE_HZ;
+    ultra_cfg.cpu     = ULTRA_CPU;
+    // polling 경로는 echo 를 busy-wait 하므로 FIFO 를 주지 않음 (최대 40ms 동안 그 core 의 다른 스레드를 막음)
+    if (realtime && echo_source.isOpen())
+        ultra_cfg.rt_priority = rt_cfg.priority + RT_SAMPLER_BOOST;
+    UltrasonicSampler range(ultra, ultra_cfg);
+    range.start();
     LCD lcd(0x27);
 
-    std::ofstream logFile("log.csv", std::ios::out);
-
-    if (logFile.tellp() == 0) {
-       logFile << "distance_cm,ttc,v_rel,voltage,raw_percent,cmd_percent,delta_thr_raw,scenario,accel_detected,brake_detected,accel_latency,misop_flag\n";
-   }
-
-    float prev_thr_raw = 0.0f;
-
-    
-    unsigned long lockout_start_time = 0; // 0이면 잠금 아님, 0보다 크면 잠금 시작 시간
-    const unsigned long LOCKOUT_DURATION_MS = 3000; // 3초 (3000 ms)
+    // log.csv 는 별도 writer 스레드가 기록 (제어 쪽은 enqueue 만)
+    CsvLogger logFile;
+    logFile.open("log.csv");
 
     // ---- 시나리오 입력
     int scenario_id;
     std::cout << "Enter scenario ID (0=normal, 1=slow, 2=fast, 3=stomp ...): ";
     std::cin >> scenario_id;
 
+    // YOLO 검출 이벤트 (shared memory ring, tflite_yolo_picam.py 가 생산자)
+    DetectionChannel detections;
+    if (!detections.open(DETECTION_CHANNEL_NAME, DetectionChannel::CONSUMER))
+        std::cerr << "Detection channel unavailable, YOLO events disabled" << std::endl;
 
-    while (true)
-    {
-        int misop_flag = 0;
-
-        float vrel_avg = ultra.getVrelAvg();
-        float vrel_min = ultra.getVrelMin();
-        float vrel_max = ultra.getVrelMax();
+    // 급제동 요청 때 접속하지 않도록 시작할 때 연결해 둠
+    MqttClient mqtt(mqtt_cfg);
+    mqtt.start();
 
-        unsigned long current_time = millis(); // wiringPi의 ms 타이머
-        float distance = ultra.getDistance();
-        float ttc = ultra.computeTTC(distance);
+    LatencyTracer tracer;
+    signal(SIGUSR1, onDumpLatency);
 
-        // ------------------------------
-        // ΔDistance 계산
-        float delta = 0.0f;
-        if (prev_distance > 0) {
-            delta = std::fabs(distance - prev_distance);
-        }
-        prev_distance = distance;
-
-        // circular buffer 에 저장
-        delta_buffer[delta_index] = delta;
-        delta_index = (delta_index + 1) % DELTA_WINDOW;
-
-        // delta 평균 계산
-        float delta_sum = 0;
-        for (float d : delta_buffer) delta_sum += d;
-        float delta_avg = delta_sum / DELTA_WINDOW;
-        //-------------------------------------
-
-        float voltage = hall.readRawThrottle(0); 
-        float thr_raw = std::max(0.0f, (voltage - V_MIN) / (V_MAX - V_MIN) * 100);
-
-        float delta_thr_raw = thr_raw - prev_thr_raw;
-        float thr_cmd = thr_raw; 
-
-
-        bool accel_detected = false;
-        bool brake_detected = false;
-        double latency = -1;
-        // ====== YOLO flag check
-        
-        // BRAKE 체크
-        std::ifstream brakeFile("/tmp/brake_detected.flag");
-        if (brakeFile.good()) {
-            double ts;
-            brakeFile >> ts;
-            double now = millis() / 1000.0;
-
-            // if (now - ts <= 1.5) {
-            brake_detected = true;
-            std::cout << ">>> BRAKE detected\n";
-            // }
-
-            system("rm /tmp/brake_detected.flag");
-        }
-        
-        // ACCEL 체크  
-        std::ifstream accelFile("/tmp/accel_detected.flag");
-        if (accelFile.good()) 
-        {
-            double ts;
-            accelFile >> ts;
-
-            double now = millis() / 1000.0;
-            latency = now - ts;
-            std::cout << "ACCEL flag latency: " << latency << " sec\n";
-            // if (now - ts <= 1.5) {     // 최근 1.5초 이내 감지
-            accel_detected = true;
-            std::cout << ">>> ACCEL detected\n";
-                // }
-            // 파일 삭제해서 중복 감지 방지
-            std::system("rm /tmp/accel_detected.flag");
+    // 경고음은 BuzzerSequencer 스레드가 울림 (제어는 pattern 요청만)
+    SysfsPwmTone pwm_tone(PWM_CHIP, PWM_CHANNEL);
+    std::unique_ptr<SoftToneOutput> soft_tone;
+    if (!pwm_tone.isOpen()) {
+        std::cerr << "hardware PWM unavailable, buzzer falls back to softTone" << std::endl;
+        soft_tone.reset(new SoftToneOutput());
+    }
+    BuzzerSequencer buzzer(pwm_tone.isOpen() ? static_cast<ToneOutput&>(pwm_tone) : *soft_tone);
+    buzzer.start();
+    LcdStatus lcd_status(lcd);
+    MqttSpeedBrake brake(mqtt);
+
+    MispedalController::Devices dev;
+    dev.range      = &range;
+    dev.detections = &detections;
+    dev.pedal      = &pedal;
+    dev.ultra      = &ultra;
+    dev.hall       = &hall;
+    dev.buzzer     = &buzzer;
+    dev.display    = &lcd_status;
+    dev.brake      = &brake;
+    dev.log        = &logFile;
+    dev.recorder   = recorder.isOpen() ? &recorder : nullptr;
+    dev.tracer     = &tracer;
+    MispedalController ctl(dev, scenario_id);
+
+    PeriodicScheduler sched;
+    ctl.addTasks(sched);
+
+    // 검출 프로세스 (mispedal_detect --gate) 가 페달 상태로 검출 빈도를 정함
+    PedalChannel pedal_channel;
+    if (pedal_channel.open(PEDAL_CHANNEL_NAME)) {
+        sched.addTask("pedal_share", PEDAL_SHARE_RATE_HZ, [&](uint64_t) {
+            pedal_channel.publish(pedal.latest());
+        });
+    }
 
+    sched.addTask("lcd", LCD_RATE_HZ, [&](uint64_t) {
+        lcd_status.update();
+    });
+
+    sched.addTask("status", STATUS_RATE_HZ, [&](uint64_t) {
+        LOG_INFO("Dist: {} | ΔAvg: {} cm | TTC: {} s | Vrel_avg: {} | voltage: {} | raw: {} % | cmd: {} %"
+                 " | delta_thr_raw: {} | misop_flag: {}",
+                 ctl.distance(), ctl.deltaAvg(), ctl.ttc(), ultra.getVrelAvg(), ctl.voltage(),
+                 ctl.thrRaw(), ctl.thrCmd(), ctl.deltaThr(), ctl.lockedOut());
+    });
+
+    // ---- task 별 deadline miss / jitter 보고 (복사만, 포맷 / 출력은 reporter 스레드 → EventLog)
+    StatsSnapshot snapshot;
+    snapshot.tasks.resize(sched.taskCount() + 1);      // stats task 자신 포함
+    sched.addTask("stats", STATS_RATE_HZ, [&](uint64_t) {
+        if (snapshot.ready.load(std::memory_order_acquire))
+            return;     // 지난 보고를 아직 출력 중
+        sched.copyStats(snapshot.tasks);
+        snapshot.latency = g_dump_latency != 0;
+        if (snapshot.latency) {
+            g_dump_latency = 0;
+            snapshot.tracer->copyFrom(tracer);
         }
-        // ==================== 오조작 감지 및 3초 잠금 로직 =====================
-
-        // 1. 현재 잠금 상태인지 확인
-        if (lockout_start_time > 0) 
-        {
-            misop_flag = 1;
-
-            // 3초가 지났는지 확인
-            if (current_time - lockout_start_time < LOCKOUT_DURATION_MS)
-            {
-                // [상태 1: 잠금 활성화]
-                // 3초가 아직 안 지났으면, 스로틀을 0%로 강제 고정
-                thr_cmd = 0.0f;
-                std::cout << "!!! LOCKOUT ACTIVE !!! -> Throttle disabled (" 
-                          << (LOCKOUT_DURATION_MS - (current_time - lockout_start_time)) / 1000.0f
-                          << "s left)\n";
-                playBuzzer();            
-                delay(200);
-                stopBuzzer();
-                delay(100);
-
-                lcd.displayStatus("LOCKOUT ACTIVE", "Accelerate: 0%");
-            }
+        snapshot.ready.store(true, std::memory_order_release);
+    });
+
+    std::atomic<bool> reporting{true};
+    std::thread reporter([&]() {
+        while (reporting.load(std::memory_order_relaxed)) {
+            systemClock().sleepFor(50000000ull);   // 50ms
+            if (!snapshot.ready.load(std::memory_order_acquire))
+                continue;
+            sched.logStats(snapshot.tasks);
+            LOG_INFO("log: written={} dropped={}{} queue={} max_queue={}",
+                     logFile.written(), logFile.dropped(), logFile.failed() ? " (write failed)" : "",
+                     logFile.queueDepth(), logFile.maxQueueDepth());
+            LOG_INFO("event log: written={} dropped={}",
+                     EventLog::instance().written(), EventLog::instance().dropped());
+            LOG_INFO("lcd: requested={} drawn={}", lcd.framesRequested(), lcd.framesDrawn());
+            mqtt.logStats();
+            uint64_t now = monoNowNs();
+            PedalState p = pedal.latest();
+            RangeSample r = range.latest();
+            double pedal_age = (now - p.timestamp_ns) / 1e6;
+            double range_age = r.sample_count ? (now - r.timestamp_ns) / 1e6 : -1.0;
+            if (recorder.isOpen())
+                LOG_INFO("sensors: pedal age={} ms, range age={} ms, range samples={} timeouts={}, pedal record dropped={}",
+                         pedal_age, range_age, r.sample_count, r.timeouts, pedal.recordDropped());
             else
-            {
-                // [상태 2: 잠금 해제]
-                // 3초가 지났으므로 잠금 해제
-                lockout_start_time = 0;
-                std::cout << "Lockout expired. Resuming normal control.\n";
-                stopBuzzer();
-
-                lcd.backlight(0);   // 백라이트 OFF
-                lcd.lcd_clear();
-            }
-        }
-
-
-        // 2. 잠금 상태가 아니라면, 정상 로직 수행 (새로운 오조작 감지)
-        else{
-            if (accel_detected)
-            {
-                // std::cout << ">>> CAR DETECTED (from YOLO) — Starting mis-operation detection!\n";
-                
-
-                // 2a. 새로운 오조작 감지
-                if (delta_thr_raw >= 70.0f) 
-                {
-                    std::cout << "!!! PEDAL STOMP DETECTED !!! -> Engaging 3-second lockout.\n";
-
-                    misop_flag = 1;
-
-                    lockout_start_time = current_time; // 3초 잠금 타이머 시작
-                    thr_cmd = 0.0f; // 즉시 0%로 고정
-                    playBuzzer();            
-                    delay(200);
-                    stopBuzzer();
-                }
-
-                // 2b. 정상 주행 (TTC 기반)
-                else if (delta_thr_raw > 0.0f && delta_thr_raw < 70.0f) 
-                {
-                    float cap = hall.computeCap(ttc);
-                    thr_cmd = hall.computeThrottleCmd(thr_raw, cap);
-                    if (ttc <= 1.86){
-                        misop_flag = 1;
-                        playBuzzer();            
-                        delay(200);
-                        stopBuzzer();
-                    } 
-
-                    else stopBuzzer();
-                }
-
-            }
-
+                LOG_INFO("sensors: pedal age={} ms, range age={} ms, range samples={} timeouts={}",
+                         pedal_age, range_age, r.sample_count, r.timeouts);
+            if (snapshot.latency)
+                snapshot.tracer->log();
+            snapshot.ready.store(false, std::memory_order_release);
         }
-
-        if (brake_detected){
-            if (delta_thr_raw >= 70.0f){
-                system("python3 /home/pi/AIEmbedded/AIEmbedded/team_project/send_speed.py --speed 0");
-                playBuzzer();            
-                delay(200);
-                stopBuzzer();   
-                lcd.displayStatus("Hard Brake Detected", "Assist Mode Activated"); 
-            }  
-        
+    });
+
+    // 다른 스레드 (logger / mqtt / lcd / 센서 / reporter) 를 모두 띄운 뒤 이 스레드만 FIFO 로
+    // (먼저 바꾸면 새 스레드가 FIFO 를 물려받음)
+    if (realtime) {
+        if (!enterRealtime(rt_cfg))
+            std::cerr << "realtime setup incomplete, control loop may see page faults / preemption" << std::endl;
+        if (setuid(getuid()) < 0) {
+            perror("Dropping privileges failed");
+            reporting.store(false);
+            reporter.join();
+            return EXIT_FAILURE;
         }
-        
-
-        std::cout 
-            << "Dist: " << distance 
-            << " | ΔAvg: " << delta_avg
-            << " cm | TTC: " << ttc 
-            << " | Vrel_avg: " << vrel_avg
-            << " | voltage: " << voltage
-            << " s | raw: " << thr_raw 
-            << " % | cmd: " << thr_cmd 
-            << " % | delta_thr_raw: " << delta_thr_raw 
-            << " | misop_flag: " << misop_flag
-            << "%\n"
-            << "=========================="
-            << "%\n";
-
-        logFile 
-        << distance << ","
-        << ttc << ","
-        << vrel_avg << ","
-        << voltage << ","
-        << thr_raw << ","
-        << thr_cmd << ","
-        << delta_thr_raw << ","
-        << scenario_id << ","
-        << accel_detected << ","      
-        << brake_detected << "," 
-        << latency << ","     
-        << misop_flag << "\n";
-
-        logFile.flush();
-        // if (brakeFile.good()) system("rm /tmp/brake_detected.flag");
-
-        
-        // if (accelFile.good()) std::system("rm /tmp/accel_detected.flag");
-
-        prev_thr_raw = thr_raw;
-
-        delay(500); // 100 ms
     }
 
+    sched.run();
+
+    reporting.store(false);
+    reporter.join();
+    EventLog::instance().stop();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,475 @@
+// 기록된 trace 를 실제 제어 코드(MispedalController)에 가상 시간으로 재생
+// 하드웨어 / wiringPi 없이 일반 Linux 에서 빌드되며, CPU 가 허락하는 만큼 빠르게 돈다.
+//
+// 사용: mispedal_replay <trace.csv | log.csv> [-o replay_log.csv] [--compare ref_log.csv] [--legacy] [--verbose]
+//   trace.csv   : mispedal_main --record 로 남긴 native trace (페달은 1kHz 샘플 모두)
+//   log.csv     : 기존 log.csv (20Hz 행 단위로 거리/전압/검출을 재생, 페달 전압은 행 사이를 선형 보간)
+//   --legacy    : log.csv 를 제어 루프 없이 행마다 기존 판단으로 다시 계산 (log 를 남긴 코드와 비교할 때)
+//   --compare   : 결과 log 의 misop_flag / cmd_percent 를 ref 와 행 단위로 비교
+//
+// log.csv 를 제어 루프로 재생하면 기록과 다르게 나오는 것이 정상이다:
+// - 기존 코드는 행마다 "이전 행과의 전압 차 >= 70%" 로 stomp 를 보고 잠금을 다음 행까지 끌고 가지 않았지만
+//   지금은 1kHz 샘플러의 slope + 200ms 변화량으로 stomp 를 보고 LOCKOUT 을 3초 유지한다.
+// - 20Hz 행에는 그 사이 페달 모양이 없으므로 보간해도 빠른 밟기 / 짧은 밟기를 구분할 수 없다.
+// 기록과 행 단위로 맞춰 보려면 --legacy (build1 의 log.csv / log2.csv / log_test.csv 는 모두 일치,
+// accel 열이 없는 log0.csv / log1.csv 는 cap 곡선이 지금과 달라 cmd_percent 만 다름).
+#include "control/mispedal_controller.hpp"
+#include "control/sim_devices.hpp"
+#include "core/clock.hpp"
+#include "core/csv_logger.hpp"
+#include "core/detection_channel.hpp"
+#include "core/event_log.hpp"
+#include "core/latency_trace.hpp"
+#include "core/mono_clock.hpp"
+#include "core/scheduler.hpp"
+#include "core/trace.hpp"
+#include "sensors/buzzer_sequencer.hpp"
+#include "sensors/hall_sensor.hpp"
+#include "sensors/pedal_sampler.hpp"
+#include "sensors/spi_bus.hpp"
+#include "sensors/ultrasonic.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+
+// mispedal_main 과 같은 값
+constexpr int ADC_CHANNEL = 0;
+constexpr float V_MIN = 1.7;
+constexpr float V_MAX = 2.2;
+constexpr int TRIG = 29;
+constexpr int ECHO = 28;
+
+constexpr uint64_t LEGACY_START_NS  = 1000000000ull;   // 0 은 "잠금 아님" 과 겹치므로 1초에서 시작
+constexpr uint64_t LEGACY_PERIOD_NS = 50000000ull;     // log.csv 는 20Hz
+constexpr double   BUZZER_STEP_HZ   = 1000.0;          // pattern 경계를 1ms 단위로
+constexpr float    LEGACY_STOMP     = 70.0f;           // 기존 판단: 이전 행보다 70% 이상 올라가면 stomp
+constexpr float    LEGACY_TTC_WARN  = 1.86f;           // 기존 판단: TTC 경고 기준 (MispedalController 와 같은 값)
+
+
+namespace {
+
+// 시각 순 trace 를 종류별 커서로 읽는다. 모두 "현재 시각까지 도착한 이벤트" 만 본다.
+class TraceCursor {
+public:
+    TraceCursor(const std::vector<TraceEvent>& events, char kind, Clock& clock)
+        : events_(events), kind_(kind), clock_(clock) {}
+
+    // 다음 도착 이벤트 하나
+    bool next(TraceEvent& ev)
+    {
+        uint64_t now = clock_.nowNs();
+        while (pos_ < events_.size() && events_[pos_].t_ns <= now) {
+            const TraceEvent& e = events_[pos_++];
+            if (e.kind == kind_) {
+                ev = e;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // 도착한 것 중 가장 최근 이벤트 (앞의 것은 버림)
+    bool latest(TraceEvent& ev)
+    {
+        bool found = false;
+        TraceEvent e;
+        while (next(e)) {
+            ev = e;
+            found = true;
+        }
+        return found;
+    }
+
+private:
+    const std::vector<TraceEvent>& events_;
+    char   kind_;
+    Clock& clock_;
+    size_t pos_ = 0;
+};
+
+// log.csv 의 20Hz 전압을 1kHz 샘플러에 넣을 때 행 사이를 선형 보간
+// (그대로 넣으면 50ms 마다 계단이 생겨 slope 가 stomp 처럼 튄다)
+class PedalInterpolator {
+public:
+    explicit PedalInterpolator(const std::vector<TraceEvent>& events)
+    {
+        for (size_t i = 0; i < events.size(); i++)
+            if (events[i].kind == TRACE_PEDAL)
+                points_.push_back(events[i]);
+    }
+
+    bool empty() const { return points_.empty(); }
+
+    float at(uint64_t t_ns)
+    {
+        while (pos_ + 1 < points_.size() && points_[pos_ + 1].t_ns <= t_ns)
+            pos_++;
+        const TraceEvent& a = points_[pos_];
+        if (t_ns <= a.t_ns || pos_ + 1 == points_.size())
+            return a.value;
+        const TraceEvent& b = points_[pos_ + 1];
+        float f = static_cast<float>(t_ns - a.t_ns) / static_cast<float>(b.t_ns - a.t_ns);
+        return a.value + (b.value - a.value) * f;
+    }
+
+private:
+    std::vector<TraceEvent> points_;
+    size_t pos_ = 0;
+};
+
+class TraceRangeSource : public RangeSource {
+public:
+    TraceRangeSource(const std::vector<TraceEvent>& events, Clock& clock)
+        : cursor_(events, TRACE_RANGE, clock) {}
+
+    bool poll(float& distance_cm, uint64_t& t_ns) override
+    {
+        TraceEvent ev;
+        if (!cursor_.latest(ev))
+            return false;
+        distance_cm = ev.value;
+        t_ns = ev.t_ns;
+        return true;
+    }
+
+private:
+    TraceCursor cursor_;
+};
+
+class TraceDetectionSource : public DetectionSource {
+public:
+    TraceDetectionSource(const std::vector<TraceEvent>& events, Clock& clock)
+        : cursor_(events, TRACE_DETECT, clock) {}
+
+    bool poll(DetectionEvent& event) override
+    {
+        TraceEvent ev;
+        if (!cursor_.next(ev))
+            return false;
+        memset(&event, 0, sizeof(event));
+        event.cls = static_cast<uint32_t>(ev.value);
+        event.timestamp_ns = ev.t_ns;
+        event.seq = ++seq_;
+        return true;
+    }
+
+private:
+    TraceCursor cursor_;
+    uint64_t seq_ = 0;
+};
+
+// 파일로 쓰면서 비교용으로 cmd / misop 도 보관
+class ReplayLog : public LogSink {
+public:
+    bool open(const std::string& path) { return file_.open(path); }
+
+    bool log(const LogRecord& rec) override
+    {
+        cmd.push_back(rec.cmd_percent);
+        misop.push_back(rec.misop_flag);
+        return file_.log(rec);
+    }
+
+    std::vector<float> cmd;
+    std::vector<int>   misop;
+
+private:
+    CsvFileWriter file_;
+};
+
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+bool loadLogColumns(const std::string& path, std::vector<float>& cmd, std::vector<int>& misop)
+{
+    std::ifstream in(path.c_str());
+    if (!in) {
+        std::cerr << "compare log open failed: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    std::vector<std::string> header, cols;
+    std::getline(in, line);
+    splitCsvLine(line, header);
+    int col_cmd   = csvColumn(header, "cmd_percent");
+    int col_misop = csvColumn(header, "misop_flag");
+    if (col_cmd < 0 || col_misop < 0) {
+        std::cerr << "compare log has no cmd_percent/misop_flag: " << path << std::endl;
+        return false;
+    }
+
+    while (std::getline(in, line)) {
+        splitCsvLine(line, cols);
+        if (cols.size() < header.size())
+            continue;
+        cmd.push_back(strtof(cols[col_cmd].c_str(), nullptr));
+        misop.push_back(atoi(cols[col_misop].c_str()));
+    }
+    return true;
+}
+
+// misop_flag 는 정확히, cmd_percent 는 log 출력 정밀도(%g) 안에서 비교
+int compareLogs(const ReplayLog& out, const std::string& ref_path)
+{
+    std::vector<float> ref_cmd;
+    std::vector<int>   ref_misop;
+    if (!loadLogColumns(ref_path, ref_cmd, ref_misop))
+        return -1;
+
+    size_t rows = std::min(out.cmd.size(), ref_cmd.size());
+    size_t misop_diff = 0, cmd_diff = 0, shown = 0;
+    for (size_t i = 0; i < rows; i++) {
+        bool m = out.misop[i] != ref_misop[i];
+        bool c = std::fabs(out.cmd[i] - ref_cmd[i]) > 1e-4f * std::max(1.0f, std::fabs(ref_cmd[i]));
+        misop_diff += m;
+        cmd_diff   += c;
+        if ((m || c) && shown < 10) {
+            std::cerr << "  row " << i + 1
+                      << ": misop " << ref_misop[i] << " -> " << out.misop[i]
+                      << ", cmd " << ref_cmd[i] << " -> " << out.cmd[i] << "\n";
+            shown++;
+        }
+    }
+
+    std::cerr << "compare " << ref_path << ": rows " << rows
+              << " (replay " << out.cmd.size() << ", ref " << ref_cmd.size() << ")"
+              << ", misop_flag diff " << misop_diff
+              << ", cmd_percent diff " << cmd_diff << "\n";
+    return (misop_diff || cmd_diff || out.cmd.size() != ref_cmd.size()) ? 1 : 0;
+}
+
+// --legacy: log.csv 의 각 행을 그 행의 열 (delta_thr_raw, ttc, accel/brake_detected) 로 다시 판단
+// 판단 표는 MisopFsm 의 것을 그대로 쓰고, 기존 코드에는 잠금 유지가 없었으므로 매 행 NORMAL 에서 본다.
+// accel_detected 열이 없는 log (YOLO 연동 전) 는 항상 ACCEL 로 본다.
+bool replayLegacy(const std::string& path, MCP3208& hall, ReplayLog& out)
+{
+    std::ifstream in(path.c_str());
+    if (!in) {
+        std::cerr << "trace open failed: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    std::vector<std::string> header, cols;
+    std::getline(in, line);
+    splitCsvLine(line, header);
+    int col_distance = csvColumn(header, "distance_cm");
+    int col_ttc      = csvColumn(header, "ttc");
+    int col_vrel     = csvColumn(header, "v_rel");
+    int col_voltage  = csvColumn(header, "voltage");
+    int col_raw      = csvColumn(header, "raw_percent");
+    int col_delta    = csvColumn(header, "delta_thr_raw");
+    int col_scenario = csvColumn(header, "scenario");
+    int col_accel    = csvColumn(header, "accel_detected");
+    int col_brake    = csvColumn(header, "brake_detected");
+    if (col_ttc < 0 || col_raw < 0 || col_delta < 0) {
+        std::cerr << "--legacy needs ttc/raw_percent/delta_thr_raw columns: " << path << std::endl;
+        return false;
+    }
+
+    auto column = [&](int col) { return col >= 0 ? strtof(cols[col].c_str(), nullptr) : 0.0f; };
+
+    while (std::getline(in, line)) {
+        splitCsvLine(line, cols);
+        if (cols.size() < header.size())
+            continue;
+
+        LogRecord rec;
+        memset(&rec, 0, sizeof(rec));
+        rec.distance_cm    = column(col_distance);
+        rec.ttc            = column(col_ttc);
+        rec.v_rel          = column(col_vrel);
+        rec.voltage        = column(col_voltage);
+        rec.raw_percent    = column(col_raw);
+        rec.delta_thr_raw  = column(col_delta);
+        rec.scenario       = col_scenario >= 0 ? atoi(cols[col_scenario].c_str()) : 0;
+        rec.accel_detected = col_accel < 0 || atoi(cols[col_accel].c_str()) != 0;
+        rec.brake_detected = col_brake >= 0 && atoi(cols[col_brake].c_str()) != 0;
+        rec.accel_latency  = -1;
+
+        uint8_t inputs = 0;
+        if (rec.accel_detected)                  inputs |= MISOP_IN_ACCEL;
+        if (rec.brake_detected)                  inputs |= MISOP_IN_BRAKE;
+        if (rec.delta_thr_raw >= LEGACY_STOMP)   inputs |= MISOP_IN_STOMP;
+        if (rec.delta_thr_raw > 0.0f)            inputs |= MISOP_IN_RISING;
+        if (rec.ttc <= LEGACY_TTC_WARN)          inputs |= MISOP_IN_TTC_LOW;
+        const MisopFsm::Cell& cell = MisopFsm::cell(MISOP_NORMAL, inputs);
+
+        rec.cmd_percent = rec.raw_percent;
+        if (cell.actions & MISOP_ACT_THROTTLE_ZERO)
+            rec.cmd_percent = 0.0f;
+        else if (cell.actions & MISOP_ACT_THROTTLE_CAP)
+            rec.cmd_percent = hall.computeThrottleCmd(rec.raw_percent, hall.computeCap(rec.ttc));
+        rec.misop_flag  = (cell.actions & MISOP_ACT_MISOP) ? 1 : 0;
+        rec.misop_state = cell.next;
+        out.log(rec);
+    }
+    return true;
+}
+
+void usage()
+{
+    std::cerr << "usage: mispedal_replay <trace.csv|log.csv> [-o replay_log.csv] [--compare ref_log.csv] [--legacy] [--verbose]\n";
+}
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+    std::string trace_path, out_path = "replay_log.csv", compare_path;
+    bool verbose = false;
+    bool legacy = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            out_path = argv[++i];
+        else if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc)
+            compare_path = argv[++i];
+        else if (strcmp(argv[i], "--verbose") == 0)
+            verbose = true;
+        else if (strcmp(argv[i], "--legacy") == 0)
+            legacy = true;
+        else if (argv[i][0] != '-' && trace_path.empty())
+            trace_path = argv[i];
+        else {
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+    if (trace_path.empty()) {
+        usage();
+        return EXIT_FAILURE;
+    }
+
+    std::vector<TraceEvent> events;
+    TraceInfo info;
+    if (!loadTrace(trace_path, events, info, LEGACY_START_NS, LEGACY_PERIOD_NS))
+        return EXIT_FAILURE;
+    if (events.empty()) {
+        std::cerr << "empty trace: " << trace_path << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    if (legacy) {
+        if (!info.legacy_log) {
+            std::cerr << "--legacy needs a log.csv: " << trace_path << std::endl;
+            return EXIT_FAILURE;
+        }
+        MockMcp3208Bus legacy_bus;
+        MCP3208 legacy_hall(&legacy_bus);     // computeCap / computeThrottleCmd 만 사용
+        ReplayLog legacy_log;
+        if (!legacy_log.open(out_path) || !replayLegacy(trace_path, legacy_hall, legacy_log))
+            return EXIT_FAILURE;
+        std::cerr << "replayed " << trace_path << " (log.csv, legacy rows): rows " << legacy_log.cmd.size()
+                  << " -> " << out_path << "\n";
+        if (!compare_path.empty())
+            return compareLogs(legacy_log, compare_path) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+        return EXIT_SUCCESS;
+    }
+
+    // 제어 코드의 출력은 기본으로 끔 (수 시간 분량이면 출력이 병목)
+    NullBuffer null_buffer;
+    std::streambuf* cout_buffer = std::cout.rdbuf();
+    if (!verbose) {
+        std::cout.rdbuf(&null_buffer);
+        EventLog::setLevel(LogLevel::Off);
+    }
+
+    SimClock clock(events.front().t_ns);
+    // 메시지 시각 / rate limit 은 가상 시간으로, formatter 스레드 없이 주기마다 직접 비움 (실시간보다 빨리 돌아도 버리지 않음)
+    EventLog::instance().setClock(&clock);
+    PeriodicScheduler sched(&clock);
+
+    // 페달: 실제 PedalSampler 를 가상 ADC 로 1kHz 구동 (필터 / stomp 감지 포함)
+    MockMcp3208Bus adc_bus;
+    MCP3208 hall(&adc_bus);
+    PedalSampler::Config pedal_cfg;
+    pedal_cfg.channel = ADC_CHANNEL;
+    pedal_cfg.v_min   = V_MIN;
+    pedal_cfg.v_max   = V_MAX;
+    PedalSampler pedal(hall, pedal_cfg, &clock);
+    TraceCursor pedal_cursor(events, TRACE_PEDAL, clock);
+    PedalInterpolator pedal_interp(events);
+
+    Ultrasonic ultra(TRIG, ECHO);   // computeTTC 만 사용
+    TraceRangeSource range(events, clock);
+    TraceDetectionSource detections(events, clock);
+    // 부저: 실제 BuzzerSequencer 를 가상 시간으로 구동, 울린 시각은 SimTone 에 남음
+    SimTone tone(clock);
+    BuzzerSequencer buzzer(tone, BuzzerSequencer::Config(), &clock);
+    CountingDisplay display;
+    CountingBrake brake;
+
+    LatencyTracer tracer;   // 가상 시간 기준 (capture → consume 은 control 주기 양자화만큼)
+
+    ReplayLog replay_log;
+    if (!replay_log.open(out_path))
+        return EXIT_FAILURE;
+
+    MispedalController::Devices dev;
+    dev.range      = &range;
+    dev.detections = &detections;
+    dev.pedal      = &pedal;
+    dev.ultra      = &ultra;
+    dev.hall       = &hall;
+    dev.buzzer     = &buzzer;
+    dev.display    = &display;
+    dev.brake      = &brake;
+    dev.log        = &replay_log;
+    dev.tracer     = &tracer;
+    dev.clock      = &clock;
+    MispedalController ctl(dev, info.scenario);
+
+    // native trace 는 기록된 샘플을 그대로 (sample-and-hold), log.csv 는 행 사이를 보간
+    auto setPedalVoltage = [&](float voltage) {
+        int raw = static_cast<int>(voltage / 3.3f * 4095.0f + 0.5f);
+        adc_bus.setChannelValue(ADC_CHANNEL, std::max(0, std::min(4095, raw)));
+    };
+    sched.addTask("pedal", pedal_cfg.rate_hz, [&](uint64_t now_ns) {
+        TraceEvent ev;
+        if (info.legacy_log && !pedal_interp.empty())
+            setPedalVoltage(pedal_interp.at(now_ns));
+        else if (pedal_cursor.latest(ev))
+            setPedalVoltage(ev.value);
+        pedal.step(now_ns);
+    });
+    sched.addTask("buzzer", BUZZER_STEP_HZ, [&](uint64_t now_ns) { buzzer.step(now_ns); });
+    ctl.addTasks(sched);
+
+    uint64_t end_ns = events.back().t_ns;   // log.csv 면 입력과 같은 행 수
+    uint64_t wall_start = monoNowNs();
+    while (clock.nowNs() <= end_ns) {
+        sched.runOnce();
+        if (verbose)
+            EventLog::instance().flush();
+    }
+    double wall_s = (monoNowNs() - wall_start) / 1e9;
+    double sim_s  = (end_ns - events.front().t_ns) / 1e9;
+
+    std::cout.rdbuf(cout_buffer);
+
+    std::cerr << "replayed " << trace_path << (info.legacy_log ? " (log.csv)" : " (trace)")
+              << ": " << events.size() << " events, " << sim_s << " s simulated in " << wall_s << " s"
+              << " (x" << (wall_s > 0 ? sim_s / wall_s : 0.0) << ")\n"
+              << "  rows " << replay_log.cmd.size() << " -> " << out_path
+              << ", beeps " << tone.beeps() << " (" << tone.onNs(clock.nowNs()) / 1e9 << " s, "
+              << buzzer.requests() << " requests), lcd " << display.shows
+              << ", brake requests " << brake.stops << "\n";
+    if (verbose)
+        tracer.dump(std::cerr);
+
+    if (!compare_path.empty())
+        return compareLogs(replay_log, compare_path) == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
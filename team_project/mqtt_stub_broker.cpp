@@ -0,0 +1,200 @@
+// MqttClient 확인용 최소 MQTT 3.1.1 broker (mosquitto 없이)
+// CONNECT → CONNACK, QoS1 PUBLISH → PUBACK, PINGREQ → PINGRESP 만 처리. 한 번에 client 하나.
+//
+// 사용: mqtt_stub_broker [--port 1883] [--ack-delay-ms N] [--drop-every N] [--close-every N] [--quiet]
+//   --drop-every  : N 번째 PUBLISH 마다 PUBACK 을 보내지 않음 (client 재전송 확인)
+//   --close-every : PUBLISH N 개마다 연결을 끊음 (재접속 / backoff 확인)
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+
+namespace {
+
+struct Options {
+    int port = 1883;
+    int ack_delay_ms = 0;
+    int drop_every = 0;
+    int close_every = 0;
+    bool quiet = false;
+};
+
+bool readFull(int fd, uint8_t* buf, size_t len)
+{
+    while (len > 0) {
+        ssize_t r = recv(fd, buf, len, 0);
+        if (r <= 0)
+            return false;
+        buf += r;
+        len -= static_cast<size_t>(r);
+    }
+    return true;
+}
+
+bool writeFull(int fd, const uint8_t* buf, size_t len)
+{
+    while (len > 0) {
+        ssize_t w = send(fd, buf, len, MSG_NOSIGNAL);
+        if (w <= 0)
+            return false;
+        buf += w;
+        len -= static_cast<size_t>(w);
+    }
+    return true;
+}
+
+// fixed header 하나 읽기 (type, remaining length)
+bool readHeader(int fd, uint8_t& type, size_t& len)
+{
+    if (!readFull(fd, &type, 1))
+        return false;
+    len = 0;
+    for (int i = 0; i < 4; i++) {
+        uint8_t b;
+        if (!readFull(fd, &b, 1))
+            return false;
+        len |= static_cast<size_t>(b & 0x7F) << (7 * i);
+        if (!(b & 0x80))
+            return true;
+    }
+    return false;
+}
+
+// client 하나가 끊길 때까지, 받은 PUBLISH 수를 이어서 센다
+void serveClient(int fd, const Options& opt, unsigned long& publishes)
+{
+    uint8_t type;
+    size_t len;
+    std::string body;
+
+    unsigned long session = 0;
+    while (readHeader(fd, type, len)) {
+        body.resize(len);
+        if (len && !readFull(fd, reinterpret_cast<uint8_t*>(&body[0]), len))
+            break;
+        const uint8_t* p = reinterpret_cast<const uint8_t*>(body.data());
+
+        switch (type & 0xF0) {
+        case 0x10: {   // CONNECT
+            size_t id_len = len >= 12 ? (p[10] << 8 | p[11]) : 0;
+            if (!opt.quiet)
+                std::cout << "CONNECT client_id=" << body.substr(12, id_len)
+                          << " keepalive=" << (len >= 10 ? (p[8] << 8 | p[9]) : 0) << "s" << std::endl;
+            const uint8_t ack[4] = { 0x20, 0x02, 0x00, 0x00 };
+            if (!writeFull(fd, ack, sizeof(ack)))
+                return;
+            break;
+        }
+        case 0x30: {   // PUBLISH
+            if (len < 2)
+                return;
+            size_t topic_len = p[0] << 8 | p[1];
+            unsigned qos = (type >> 1) & 0x03;
+            size_t pos = 2 + topic_len;
+            uint16_t id = 0;
+            if (qos > 0 && pos + 2 <= len) {
+                id = static_cast<uint16_t>(p[pos] << 8 | p[pos + 1]);
+                pos += 2;
+            }
+            publishes++;
+            session++;
+            if (!opt.quiet)
+                std::cout << "PUBLISH #" << publishes << " id=" << id << ((type & 0x08) ? " dup" : "")
+                          << " " << body.substr(2, topic_len) << " " << body.substr(std::min(pos, len)) << std::endl;
+
+            bool drop = opt.drop_every > 0 && publishes % opt.drop_every == 0;
+            if (qos == 1 && !drop) {
+                if (opt.ack_delay_ms > 0)
+                    usleep(opt.ack_delay_ms * 1000);
+                const uint8_t ack[4] = { 0x40, 0x02, static_cast<uint8_t>(id >> 8), static_cast<uint8_t>(id) };
+                if (!writeFull(fd, ack, sizeof(ack)))
+                    return;
+            }
+            if (opt.close_every > 0 && session % opt.close_every == 0) {
+                if (!opt.quiet)
+                    std::cout << "closing connection" << std::endl;
+                return;
+            }
+            break;
+        }
+        case 0xC0: {   // PINGREQ
+            const uint8_t resp[2] = { 0xD0, 0x00 };
+            if (!writeFull(fd, resp, sizeof(resp)))
+                return;
+            break;
+        }
+        case 0xE0:     // DISCONNECT
+            if (!opt.quiet)
+                std::cout << "DISCONNECT" << std::endl;
+            return;
+        default:
+            break;
+        }
+    }
+}
+
+void usage()
+{
+    std::cerr << "usage: mqtt_stub_broker [--port 1883] [--ack-delay-ms N] [--drop-every N] [--close-every N] [--quiet]\n";
+}
+
+} // namespace
+
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--port") == 0 && i + 1 < argc)
+            opt.port = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--ack-delay-ms") == 0 && i + 1 < argc)
+            opt.ack_delay_ms = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--drop-every") == 0 && i + 1 < argc)
+            opt.drop_every = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--close-every") == 0 && i + 1 < argc)
+            opt.close_every = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--quiet") == 0)
+            opt.quiet = true;
+        else {
+            usage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    int server = socket(AF_INET, SOCK_STREAM, 0);
+    int one = 1;
+    setsockopt(server, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons(static_cast<uint16_t>(opt.port));
+    if (bind(server, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0 || listen(server, 4) < 0) {
+        perror("mqtt_stub_broker");
+        return EXIT_FAILURE;
+    }
+    std::cout << "listening on " << opt.port << std::endl;
+
+    unsigned long publishes = 0;
+    for (;;) {
+        int fd = accept(server, nullptr, nullptr);
+        if (fd < 0) {
+            if (errno == EINTR)
+                continue;
+            perror("accept");
+            return EXIT_FAILURE;
+        }
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        serveClient(fd, opt, publishes);
+        close(fd);
+    }
+}
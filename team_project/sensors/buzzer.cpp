@@ -1,4 +1,6 @@
 #include "buzzer.hpp"
+#include <wiringPi.h>
+#include <softTone.h>
 #include <iostream>
 #include <cstdlib>
 
@@ -26,3 +28,8 @@ void stopBuzzer()
     softToneWrite(SPKR, 0);
 }
 
+void playTone(int hz)
+{
+    softToneWrite(SPKR, hz);
+}
+
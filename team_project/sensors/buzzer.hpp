@@ -1,8 +1,7 @@
 #ifndef BUZZER_H
 #define BUZZER_H
 
-#include <wiringPi.h>
-#include <softTone.h>
+#include "../core/hal.hpp"
 
 constexpr int SPKR = 25;    //GPIO26
 constexpr int NOTE = 440;   //440Hz(A4, 라)
@@ -10,6 +9,16 @@ constexpr int NOTE = 440;   //440Hz(A4, 라)
 void initBuzzer();
 void playBuzzer();
 void stopBuzzer();
+void playTone(int hz);      // 0: 끔
 
+// softTone 부저를 ToneOutput 으로 (생성 시 initBuzzer)
+// softToneCreate 의 wiringPi 스레드가 계속 돌므로 하드웨어 PWM (SysfsPwmTone) 을 쓸 수 없을 때만
+class SoftToneOutput : public ToneOutput {
+public:
+    SoftToneOutput() { initBuzzer(); }
 
-#endif
\ No newline at end of file
+    void tone(int hz) override { playTone(hz); }
+};
+
+
+#endif
@@ -0,0 +1,218 @@
+#include "buzzer_sequencer.hpp"
+#include <algorithm>
+#include <cstring>
+
+
+BuzzerSequencer::BuzzerSequencer(ToneOutput& output)
+    : BuzzerSequencer(output, Config())
+{
+}
+
+BuzzerSequencer::BuzzerSequencer(ToneOutput& output, const Config& config, Clock* clock)
+    : out_(output), cfg_(config), clock_(clock ? clock : &systemClock())
+{
+    memset(&cur_, 0, sizeof(cur_));
+    memset(&pending_, 0, sizeof(pending_));
+}
+
+BuzzerSequencer::~BuzzerSequencer()
+{
+    halt();
+}
+
+BuzzerSequencer::Request BuzzerSequencer::pendingOrEmpty() const
+{
+    // slot 은 마지막 요청만 남으므로 반영 전의 요청 (높은 priority / cancel / stop) 을 잃지 않게 합쳐서 보냄
+    if (applied_.load(std::memory_order_acquire) != serial_)
+        return pending_;
+    Request r;
+    memset(&r, 0, sizeof(r));
+    return r;
+}
+
+void BuzzerSequencer::publish(Request& r)
+{
+    r.serial = ++serial_;
+    pending_ = r;
+    request_.write(r);
+}
+
+void BuzzerSequencer::play(const BeepPattern& pattern)
+{
+    // 한 주기 길이가 0 이면 step() 이 같은 시각에서 끝없이 돔 (repeat 0) → 받지 않음
+    if (pattern.on_ms == 0 && pattern.off_ms == 0)
+        return;
+
+    Request r = pendingOrEmpty();
+    // 반영된 뒤 울리고 있을 priority 보다 높을 때만 보냄 (같은 경고를 매 주기 요청해도 slot 을 다시 쓰지 않음)
+    int floor = priority_.load(std::memory_order_relaxed);
+    if (r.stop || (floor >= 0 && floor <= MAX_PRIORITY && (r.cancel_mask >> floor) & 1u))
+        floor = -1;
+    for (int i = 0; i < r.count; i++)
+        floor = std::max(floor, r.patterns[i].priority);
+    if (pattern.priority <= floor)
+        return;
+
+    if (r.count < MAX_REQUESTED)
+        r.count++;
+    r.patterns[r.count - 1] = pattern;
+    publish(r);
+}
+
+void BuzzerSequencer::cancel(int priority)
+{
+    if (priority < 0 || priority > MAX_PRIORITY)
+        return;
+    Request r = pendingOrEmpty();
+    r.cancel_mask |= 1u << priority;
+    // 아직 반영되지 않은 같은 priority 의 play() 도 없앰 (cancel 이 pattern 보다 먼저 반영되므로)
+    int kept = 0;
+    for (int i = 0; i < r.count; i++)
+        if (r.patterns[i].priority != priority)
+            r.patterns[kept++] = r.patterns[i];
+    r.count = static_cast<uint8_t>(kept);
+    publish(r);
+}
+
+void BuzzerSequencer::stop()
+{
+    Request r;
+    memset(&r, 0, sizeof(r));
+    r.stop = true;
+    publish(r);
+}
+
+void BuzzerSequencer::load(const BeepPattern& pattern, uint64_t now_ns)
+{
+    cur_      = pattern;
+    active_   = true;
+    sounding_ = true;
+    done_     = 0;
+    edge_ns_  = now_ns + pattern.on_ms * 1000000ull;
+    priority_.store(pattern.priority, std::memory_order_relaxed);
+}
+
+void BuzzerSequencer::begin(const BeepPattern& pattern, uint64_t now_ns)
+{
+    load(pattern, now_ns);
+    out_.tone(pattern.tone_hz);
+}
+
+void BuzzerSequencer::preempt()
+{
+    // 남은 횟수만 (울리던 on 구간은 다시 울림), 가득 차면 가장 오래된 것을 버림
+    BeepPattern rest = cur_;
+    if (rest.repeat != 0)
+        rest.repeat -= done_;
+    if (preempted_count_ == MAX_PREEMPTED) {
+        std::copy(preempted_ + 1, preempted_ + MAX_PREEMPTED, preempted_);
+        preempted_count_--;
+    }
+    preempted_[preempted_count_++] = rest;
+}
+
+void BuzzerSequencer::finish(uint64_t now_ns)
+{
+    silence();
+    if (preempted_count_ > 0)
+        begin(preempted_[--preempted_count_], now_ns);
+}
+
+void BuzzerSequencer::drop(uint32_t mask)
+{
+    int kept = 0;
+    for (int i = 0; i < preempted_count_; i++) {
+        int p = preempted_[i].priority;
+        if (p < 0 || p > MAX_PRIORITY || !((mask >> p) & 1u))
+            preempted_[kept++] = preempted_[i];
+    }
+    preempted_count_ = kept;
+}
+
+void BuzzerSequencer::silence()
+{
+    if (sounding_)
+        out_.tone(0);
+    active_   = false;
+    sounding_ = false;
+    priority_.store(-1, std::memory_order_relaxed);
+}
+
+uint64_t BuzzerSequencer::step(uint64_t now_ns)
+{
+    Request r = request_.read();
+    if (r.serial != applied_.load(std::memory_order_relaxed)) {
+        if (r.stop) {
+            preempted_count_ = 0;
+            silence();
+        }
+        if (r.cancel_mask) {
+            drop(r.cancel_mask);
+            if (active_ && cur_.priority >= 0 && cur_.priority <= MAX_PRIORITY && ((r.cancel_mask >> cur_.priority) & 1u))
+                finish(now_ns);
+        }
+        // 같이 온 것끼리 바로 밀려나면 소리는 마지막 것만 냄
+        bool loaded = false;
+        for (int i = 0; i < r.count; i++) {
+            const BeepPattern& p = r.patterns[i];
+            if (active_ && p.priority <= cur_.priority)
+                continue;
+            if (active_)
+                preempt();
+            load(p, now_ns);
+            loaded = true;
+        }
+        if (loaded)
+            out_.tone(cur_.tone_hz);
+        applied_.store(r.serial, std::memory_order_release);
+    }
+
+    // 늦게 불려도 (replay 주기) 지난 경계를 모두 진행, 위상은 pattern 시작 기준 유지
+    while (active_ && now_ns >= edge_ns_) {
+        if (sounding_) {
+            out_.tone(0);
+            sounding_ = false;
+            edge_ns_ += cur_.off_ms * 1000000ull;
+        }
+        else if (cur_.repeat != 0 && ++done_ >= cur_.repeat) {
+            finish(edge_ns_);       // 밀려난 것이 있으면 이 경계부터 이어서
+        }
+        else {
+            out_.tone(cur_.tone_hz);
+            sounding_ = true;
+            edge_ns_ += cur_.on_ms * 1000000ull;
+        }
+    }
+    return active_ ? edge_ns_ : 0;
+}
+
+bool BuzzerSequencer::start()
+{
+    if (running_)
+        return true;
+    running_ = true;
+    thread_ = std::thread(&BuzzerSequencer::loop, this);
+    return true;
+}
+
+void BuzzerSequencer::halt()
+{
+    running_ = false;
+    if (thread_.joinable())
+        thread_.join();
+    preempted_count_ = 0;
+    silence();
+}
+
+void BuzzerSequencer::loop()
+{
+    uint64_t poll_ns = cfg_.poll_ms * 1000000ull;
+    while (running_) {
+        uint64_t now  = clock_->nowNs();
+        uint64_t edge = step(now);
+        uint64_t wake = now + poll_ns;
+        if (edge != 0)
+            wake = std::min(wake, edge);
+        clock_->sleepUntil(wake);
+    }
+}
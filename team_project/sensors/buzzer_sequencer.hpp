@@ -0,0 +1,89 @@
+#ifndef BUZZER_SEQUENCER_HPP
+#define BUZZER_SEQUENCER_HPP
+
+#include "../core/clock.hpp"
+#include "../core/hal.hpp"
+#include "../core/seqlock.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// BeepPattern 을 시간에 맞춰 ToneOutput 으로 울림
+// - play() / cancel() / stop() 은 요청을 seqlock slot 에 쓰고 바로 반환 (제어 루프가 delay 로 멈추지 않음, 할당 / syscall 없음)
+// - step(now) 이 요청을 반영하고 on / off 경계를 지난 만큼 진행 (replay / bench 는 scheduler task 로 직접 호출)
+// - start() 하면 전용 스레드가 다음 경계까지 (최대 poll_ms) 잠들며 step() 을 부름
+// - 밀려난 pattern 은 MAX_PREEMPTED 개까지 쌓아 두고, 위의 것이 끝나거나 cancel 되면 남은 횟수부터 다시 울림
+// - on_ms 와 off_ms 가 모두 0 인 pattern 은 play() 가 무시
+// play() / cancel() / stop() 은 한 스레드 (제어) 에서만 호출
+class BuzzerSequencer : public BuzzerDevice {
+public:
+    struct Config {
+        uint32_t poll_ms = 5;     // 울리지 않을 때 새 요청을 확인하는 간격 (요청 → 소리 최대 지연)
+    };
+
+    explicit BuzzerSequencer(ToneOutput& output);
+    BuzzerSequencer(ToneOutput& output, const Config& config, Clock* clock = nullptr);
+    ~BuzzerSequencer();
+
+    static constexpr int MAX_PREEMPTED = 4;
+    static constexpr int MAX_REQUESTED = 3;      // 한 번 반영되기 전에 쌓일 수 있는 play() 수 (넘으면 마지막 것을 바꿈)
+    static constexpr int MAX_PRIORITY  = 31;     // cancel 은 priority 0..31 bit mask 로 전달
+
+    void play(const BeepPattern& pattern) override;
+    void cancel(int priority) override;
+    void stop() override;
+
+    bool start();
+    void halt();      // 스레드 종료 + 소리 끔
+
+    // 반환값: 다음 on / off 경계 시각 (울리는 중이 아니면 0)
+    uint64_t step(uint64_t now_ns);
+
+    bool     playing()  const { return priority_.load(std::memory_order_relaxed) >= 0; }
+    uint64_t requests() const { return serial_; }
+
+private:
+    // 반영 순서: stop → cancel → patterns (play() 순서, 같은 주기에 잠금 + 급제동이 오면 잠금이 밀려난 채로 남음)
+    struct Request {
+        uint64_t    serial;
+        BeepPattern patterns[MAX_REQUESTED];
+        uint8_t     count;
+        uint32_t    cancel_mask;     // 이 priority 들의 pattern 을 없앰 (울리는 중 / 밀려난 것 모두)
+        bool        stop;            // 모두 끔 (밀려난 것 포함)
+    };
+
+    ToneOutput& out_;
+    Config cfg_;
+    Clock* clock_;
+
+    // 제어 스레드 → 시퀀서
+    Seqlock<Request> request_;
+    uint64_t serial_ = 0;
+    Request  pending_;                          // 마지막으로 보낸 요청 (반영 전이면 다음 요청에 합침)
+    std::atomic<uint64_t> applied_{0};          // 시퀀서가 반영한 serial
+    std::atomic<int> priority_{-1};             // 울리는 pattern 의 priority (-1: 조용함)
+
+    // 시퀀서 전용
+    BeepPattern cur_;
+    bool     active_   = false;
+    bool     sounding_ = false;
+    uint32_t done_     = 0;          // 끝낸 on/off 횟수
+    uint64_t edge_ns_  = 0;
+    BeepPattern preempted_[MAX_PREEMPTED];   // 밀려난 pattern (남은 횟수로 줄여 둠), 뒤가 가장 최근
+    int         preempted_count_ = 0;
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    Request pendingOrEmpty() const;
+    void publish(Request& r);
+    void load(const BeepPattern& pattern, uint64_t now_ns);     // 상태만 (소리는 호출한 쪽이)
+    void begin(const BeepPattern& pattern, uint64_t now_ns);
+    void preempt();
+    void finish(uint64_t now_ns);
+    void drop(uint32_t mask);
+    void silence();
+    void loop();
+};
+
+#endif
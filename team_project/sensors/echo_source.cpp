@@ -0,0 +1,182 @@
+#include "echo_source.hpp"
+#include "../core/mono_clock.hpp"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <linux/gpio.h>
+
+
+// ================= EchoEdgeSource =================
+
+bool EchoEdgeSource::waitEdge(EchoEdge& edge, int timeout_us)
+{
+    // 기본 구현: 100us 간격으로 확인 (busy-poll 보다는 CPU 를 덜 씀)
+    uint64_t deadline = monoNowUs() + static_cast<uint64_t>(timeout_us);
+    while (true) {
+        if (readEdge(edge))
+            return true;
+        if (monoNowUs() >= deadline)
+            return false;
+        usleep(100);
+    }
+}
+
+void EchoEdgeSource::flush()
+{
+    EchoEdge e;
+    while (readEdge(e)) {}
+}
+
+
+// ================= GpioCdevEdgeSource =================
+
+GpioCdevEdgeSource::GpioCdevEdgeSource(const char* chip_path, int trig_gpio, int echo_gpio)
+{
+    chip_fd_ = open(chip_path, O_RDWR | O_CLOEXEC);
+    if (chip_fd_ < 0) {
+        std::cerr << "gpiochip open failed: " << chip_path << " (" << strerror(errno) << ")" << std::endl;
+        return;
+    }
+
+    // TRIG: 출력 라인 (초기값 LOW)
+    struct gpiohandle_request hreq;
+    memset(&hreq, 0, sizeof(hreq));
+    hreq.lineoffsets[0]    = static_cast<__u32>(trig_gpio);
+    hreq.lines             = 1;
+    hreq.flags             = GPIOHANDLE_REQUEST_OUTPUT;
+    hreq.default_values[0] = 0;
+    strncpy(hreq.consumer_label, "ultrasonic-trig", sizeof(hreq.consumer_label) - 1);
+    if (ioctl(chip_fd_, GPIO_GET_LINEHANDLE_IOCTL, &hreq) < 0) {
+        std::cerr << "TRIG line request failed (" << strerror(errno) << ")" << std::endl;
+        return;
+    }
+    trig_fd_ = hreq.fd;
+
+    // ECHO: 양쪽 edge 이벤트
+    struct gpioevent_request ereq;
+    memset(&ereq, 0, sizeof(ereq));
+    ereq.lineoffset  = static_cast<__u32>(echo_gpio);
+    ereq.handleflags = GPIOHANDLE_REQUEST_INPUT;
+    ereq.eventflags  = GPIOEVENT_REQUEST_BOTH_EDGES;
+    strncpy(ereq.consumer_label, "ultrasonic-echo", sizeof(ereq.consumer_label) - 1);
+    if (ioctl(chip_fd_, GPIO_GET_LINEEVENT_IOCTL, &ereq) < 0) {
+        std::cerr << "ECHO event request failed (" << strerror(errno) << ")" << std::endl;
+        return;
+    }
+    event_fd_ = ereq.fd;
+
+    int flags = fcntl(event_fd_, F_GETFL);
+    fcntl(event_fd_, F_SETFL, flags | O_NONBLOCK);
+}
+
+GpioCdevEdgeSource::~GpioCdevEdgeSource()
+{
+    if (event_fd_ >= 0) close(event_fd_);
+    if (trig_fd_ >= 0)  close(trig_fd_);
+    if (chip_fd_ >= 0)  close(chip_fd_);
+}
+
+bool GpioCdevEdgeSource::setTrig(int value)
+{
+    struct gpiohandle_data data;
+    memset(&data, 0, sizeof(data));
+    data.values[0] = static_cast<__u8>(value);
+    return ioctl(trig_fd_, GPIOHANDLE_SET_LINE_VALUES_IOCTL, &data) == 0;
+}
+
+bool GpioCdevEdgeSource::trigger()
+{
+    if (!isOpen())
+        return false;
+
+    // 10us 이상 HIGH 이면 되므로 sleep 이 길어져도 문제 없음
+    struct timespec ts = {0, 10000};
+    if (!setTrig(1))
+        return false;
+    nanosleep(&ts, nullptr);
+    return setTrig(0);
+}
+
+bool GpioCdevEdgeSource::readEdge(EchoEdge& edge)
+{
+    if (event_fd_ < 0)
+        return false;
+
+    struct gpioevent_data ev;
+    ssize_t n = read(event_fd_, &ev, sizeof(ev));
+    if (n != static_cast<ssize_t>(sizeof(ev)))
+        return false;
+
+    // 커널 5.7 이후 timestamp 는 CLOCK_MONOTONIC (이전은 REALTIME) → 펄스 폭 계산에는 차이만 사용
+    edge.rising       = (ev.id == GPIOEVENT_EVENT_RISING_EDGE);
+    edge.timestamp_ns = ev.timestamp;
+    return true;
+}
+
+bool GpioCdevEdgeSource::waitEdge(EchoEdge& edge, int timeout_us)
+{
+    if (readEdge(edge))
+        return true;
+
+    struct pollfd pfd;
+    pfd.fd      = event_fd_;
+    pfd.events  = POLLIN | POLLPRI;
+    pfd.revents = 0;
+
+    int timeout_ms = (timeout_us + 999) / 1000;
+    if (poll(&pfd, 1, timeout_ms) <= 0)
+        return false;
+
+    return readEdge(edge);
+}
+
+
+// ================= SimulatedEdgeSource =================
+
+bool SimulatedEdgeSource::trigger()
+{
+    trigger_count_++;
+    pending_count_ = 0;
+    pending_next_  = 0;
+
+    if (drop_echo_)
+        return true;    // echo 가 돌아오지 않음 → timeout
+
+    uint64_t t_rise  = clock_->nowNs() + static_cast<uint64_t>(echo_delay_us_) * 1000ull;
+    uint64_t width_ns = static_cast<uint64_t>(distance_cm_ / 0.017f * 1000.0f);
+
+    pending_[0].rising       = true;
+    pending_[0].timestamp_ns = t_rise;
+    pending_[1].rising       = false;
+    pending_[1].timestamp_ns = t_rise + width_ns;
+    pending_count_ = 2;
+    return true;
+}
+
+bool SimulatedEdgeSource::readEdge(EchoEdge& edge)
+{
+    if (pending_next_ >= pending_count_)
+        return false;
+    if (clock_->nowNs() < pending_[pending_next_].timestamp_ns)
+        return false;
+
+    edge = pending_[pending_next_++];
+    return true;
+}
+
+bool SimulatedEdgeSource::waitEdge(EchoEdge& edge, int timeout_us)
+{
+    if (readEdge(edge))
+        return true;
+
+    uint64_t wake = clock_->nowNs() + static_cast<uint64_t>(timeout_us) * 1000ull;
+    if (pending_next_ < pending_count_ && pending_[pending_next_].timestamp_ns < wake)
+        wake = pending_[pending_next_].timestamp_ns;
+    clock_->sleepUntil(wake);
+    return readEdge(edge);
+}
@@ -0,0 +1,91 @@
+#ifndef ECHO_SOURCE_HPP
+#define ECHO_SOURCE_HPP
+
+#include "../core/clock.hpp"
+#include "../core/spsc_ring.hpp"
+#include <cstdint>
+
+// 초음파 ECHO 핀의 edge 이벤트 (timestamp 는 ns 단위)
+struct EchoEdge {
+    bool     rising;
+    uint64_t timestamp_ns;
+};
+
+// Ultrasonic 이 사용하는 TRIG 출력 + ECHO edge 입력 backend
+// - trigger()  : 10us TRIG 펄스 출력
+// - readEdge() : 대기 중인 edge 하나를 non-blocking 으로 꺼냄
+// - waitEdge() : edge 가 올 때까지 최대 timeout_us 동안 대기
+class EchoEdgeSource {
+public:
+    virtual ~EchoEdgeSource() {}
+
+    virtual bool trigger() = 0;
+    virtual bool readEdge(EchoEdge& edge) = 0;
+    virtual bool waitEdge(EchoEdge& edge, int timeout_us);
+
+    // 이전 ping 의 남은 edge 버리기
+    void flush();
+};
+
+
+// Linux GPIO character device (/dev/gpiochipN) backend
+// 커널이 edge 시점에 timestamp 를 찍어주므로 스케줄링 지연과 무관하게 펄스 폭을 잰다.
+// 핀 번호는 BCM GPIO 번호 (wiringPi 번호 아님)
+class GpioCdevEdgeSource : public EchoEdgeSource {
+public:
+    GpioCdevEdgeSource(const char* chip_path, int trig_gpio, int echo_gpio);
+    ~GpioCdevEdgeSource();
+
+    bool isOpen() const { return event_fd_ >= 0 && trig_fd_ >= 0; }
+
+    bool trigger() override;
+    bool readEdge(EchoEdge& edge) override;
+    bool waitEdge(EchoEdge& edge, int timeout_us) override;
+
+private:
+    int chip_fd_  = -1;
+    int trig_fd_  = -1;
+    int event_fd_ = -1;
+
+    bool setTrig(int value);
+
+    GpioCdevEdgeSource(const GpioCdevEdgeSource&) = delete;
+    GpioCdevEdgeSource& operator=(const GpioCdevEdgeSource&) = delete;
+};
+
+
+// ISR 에서 채우고 polling 쪽에서 꺼내는 edge 큐 (가득 차면 edge 버림 → 해당 ping 은 timeout)
+typedef SpscRing<EchoEdge, 16> EdgeQueue;
+
+
+// 하드웨어 없이 시험하기 위한 가상 핀
+// trigger() 시점 기준으로 setDistance() 거리에 해당하는 echo 펄스를 만든다.
+// edge 는 clock 이 그 시점을 지나야 보인다. (기본은 실제 monotonic 시간, 단일 스레드 전용)
+// waitEdge() 는 다음 edge 또는 timeout 까지 clock 으로 잠듦 (SimClock 이면 바로 그 시각으로)
+class SimulatedEdgeSource : public EchoEdgeSource {
+public:
+    explicit SimulatedEdgeSource(Clock* clock = nullptr) : clock_(clock ? clock : &systemClock()) {}
+
+    void setDistance(float distance_cm) { distance_cm_ = distance_cm; }
+    void setEchoDelayUs(int delay_us)   { echo_delay_us_ = delay_us; }
+    void setDropEcho(bool drop)         { drop_echo_ = drop; }
+
+    int triggerCount() const { return trigger_count_; }
+
+    bool trigger() override;
+    bool readEdge(EchoEdge& edge) override;
+    bool waitEdge(EchoEdge& edge, int timeout_us) override;
+
+private:
+    Clock* clock_;
+    float distance_cm_   = 100.0f;
+    int   echo_delay_us_ = 450;     // HC-SR04: TRIG 이후 burst 송신까지 약 450us
+    bool  drop_echo_     = false;
+    int   trigger_count_ = 0;
+
+    EchoEdge pending_[2];
+    int pending_count_ = 0;
+    int pending_next_  = 0;
+};
+
+#endif
@@ -1,7 +1,7 @@
 #include "hall_sensor.hpp"
 #include <iostream>
-#include <wiringPi.h>
-#include <wiringPiSPI.h>
+#include <string>
+#include <algorithm>
 
 using namespace std;
 
@@ -15,42 +15,91 @@ MCP3208::MCP3208(int spi_channel, int spi_speed, int cs_pin)
     : spi_channel_(spi_channel), cs_pin_(cs_pin)
 
 {
-    // SPI 초기화
-    if (wiringPiSPISetup(spi_channel_, spi_speed) == -1) {
+    // SPI 초기화 (/dev/spidev0.N, CS 는 드라이버가 토글)
+    std::string dev = "/dev/spidev0." + std::to_string(spi_channel_);
+    LinuxSpiBus* bus = new LinuxSpiBus(dev.c_str(), static_cast<uint32_t>(spi_speed));
+    if (!bus->isOpen()) {
         cerr << "SPI setup failed." << endl;
     }
+    owned_bus_.reset(bus);
+    bus_ = bus;
+}
+
+MCP3208::MCP3208(SpiBus* bus)
+    : spi_channel_(-1), cs_pin_(-1), bus_(bus)
+{
+}
 
-    pinMode(cs_pin_, OUTPUT);
-    digitalWrite(cs_pin_, HIGH);    // CS 핀을 비활성(HIGH) 상태로 시작
+
+// MCP3208 데이터시트에 따른 SPI 통신 명령어 구성
+void MCP3208::encodeCommand(uint8_t* frame, unsigned char adc_channel)
+{
+    frame[0] = 0x06 | ((adc_channel & 0x07) >> 2);  // Start + SGL/DIFF + D2
+    frame[1] = (adc_channel & 0x07) << 6;           // D1, D0
+    frame[2] = 0x00;
 }
 
+int MCP3208::decodeResult(const uint8_t* frame)
+{
+    return ((frame[1] & 0x0F) << 8) | frame[2];     // 12bit 값 (0~4095)
+}
 
 // ADC 값 읽기
 int  MCP3208::readadc(unsigned char adc_channel)
 {
-    unsigned char buff[3];
+    encodeCommand(tx_, adc_channel);
 
-    // MCP3208 데이터시트에 따른 SPI 통신 명령어 구성
-    buff[0] = 0x06 | ((adc_channel & 0x07) >> 2);  // Start + SGL/DIFF + D2
-    buff[1] = (adc_channel & 0x07) << 6;           // D1, D0
-    buff[2] = 0x00;
-
-    digitalWrite(cs_pin_, LOW);            // Chip Select Active (Low)
-    
     // 3바이트 데이터 전송 및 수신
-    wiringPiSPIDataRW(spi_channel_, buff, 3);  // SPI 통신
-    
-    digitalWrite(cs_pin_, HIGH);    // CS Inactive
+    if (!bus_->transferFrames(tx_, rx_, 3, 1))
+        return 0;
 
-    buff[1] = buff[1] & 0x0F;
-    int adcValue = (buff[1] << 8) | buff[2]; // 12bit 값 (0~4095), CH0 입력 읽기
-    
-    return adcValue;
+    return decodeResult(rx_);
+}
+
+Span<const float> MCP3208::readChannels(const unsigned char* channels, unsigned n, unsigned oversample)
+{
+    if (n == 0 || n > MAX_CHANNELS || oversample == 0)
+        return Span<const float>();
+
+    for (unsigned c = 0; c < n; c++)
+        sum_[c] = 0;
+
+    // frame 순서: [ch0 ch1 ... chN-1] x oversample (채널을 번갈아 읽어 시간차를 줄임)
+    unsigned total = n * oversample;
+    unsigned per_msg = (SpiBus::MAX_FRAMES / n) * n;
+    unsigned done = 0;
+
+    while (done < total) {
+        unsigned frames = total - done < per_msg ? total - done : per_msg;
+
+        for (unsigned i = 0; i < frames; i++)
+            encodeCommand(tx_ + i * 3, channels[(done + i) % n]);
+
+        if (!bus_->transferFrames(tx_, rx_, 3, frames))
+            return Span<const float>();
+
+        for (unsigned i = 0; i < frames; i++)
+            sum_[(done + i) % n] += static_cast<uint32_t>(decodeResult(rx_ + i * 3));
+
+        done += frames;
+    }
+
+    for (unsigned c = 0; c < n; c++)
+        result_[c] = static_cast<float>(sum_[c]) / oversample;
+
+    return Span<const float>(result_, n);
+}
+
+float MCP3208::readAveraged(unsigned char adc_channel, unsigned oversample)
+{
+    Span<const float> r = readChannels(&adc_channel, 1, oversample);
+    return r.empty() ? 0.0f : r[0];
 }
 
 float MCP3208::readRawThrottle(unsigned char adc_channel)
 {
-    int adc_val = readadc(adc_channel);
+    // 여러 번 읽어 평균 (ioctl 한 번)
+    float adc_val = readAveraged(adc_channel, THROTTLE_OVERSAMPLE);
     
     float voltage = (adc_val / 4095.0f) * 3.3f;      // 전압으로 변환
     
@@ -61,14 +110,11 @@ float MCP3208::computeCap(float TTC)
 {
     // 1) 위험 영역: TTC <= T_low → 최소 토크
     if (TTC <= T_low) {
-        std::cout << "TTC <= " << T_low << std::endl;
         return cap_min;        
     }
 
     // 2) 완화 영역: T_low < TTC <= T_high 
     else if (TTC <= T_high) {
-        std::cout << "TTC <= " << T_high << std::endl;
-
         // 선형 보간 (linear interpolation)
         float cap = cap_min + (cap_max - cap_min) * (TTC - T_low) / (T_high - T_low);
 
@@ -1,17 +1,30 @@
 #ifndef MCP3208_HPP
 #define MCP3208_HPP
 
+#include "spi_bus.hpp"
+#include "../core/span.hpp"
+#include <memory>
 
 
 constexpr float V_MIN_CALIBRATED = 1.7f; 
 constexpr float V_MAX_CALIBRATED = 2.2f; 
 
+constexpr unsigned THROTTLE_OVERSAMPLE = 8;   // readRawThrottle 평균 샘플 수
+
 class MCP3208{
     public:
+        // CS 는 spidev 드라이버가 처리 (cs_pin 은 배선 정보로만 보관)
         MCP3208(int spi_channel, int spi_speed, int cs_pin);
+        explicit MCP3208(SpiBus* bus);   // MockMcp3208Bus 등
 
         int readadc(unsigned char adc_channel);
 
+        // channels[0..n) 각각을 oversample 번 읽어 평균한 raw 값(0~4095)
+        // SPI frame 수가 SpiBus::MAX_FRAMES 이하면 ioctl 한 번, 넘으면 나눠서 보냄
+        // 반환된 span 은 다음 read 호출 전까지 유효
+        Span<const float> readChannels(const unsigned char* channels, unsigned n, unsigned oversample = 1);
+        float readAveraged(unsigned char adc_channel, unsigned oversample);
+
         float readRawThrottle(unsigned char adc_channel);
 
         float getRaw() const { return throttle_raw_; }
@@ -25,6 +38,18 @@ class MCP3208{
         int spi_channel_;
         int cs_pin_;
 
+        std::unique_ptr<SpiBus> owned_bus_;
+        SpiBus* bus_;
+
+        static constexpr unsigned MAX_CHANNELS = 8;
+        uint8_t tx_[SpiBus::MAX_FRAMES * 3];
+        uint8_t rx_[SpiBus::MAX_FRAMES * 3];
+        float   result_[MAX_CHANNELS];
+        uint32_t sum_[MAX_CHANNELS];
+
+        static void encodeCommand(uint8_t* frame, unsigned char adc_channel);
+        static int  decodeResult(const uint8_t* frame);
+
         float throttle_raw_ = 0.0f;
         float throttle_cmd_ = 0.0f;
 };
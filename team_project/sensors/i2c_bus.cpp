@@ -0,0 +1,110 @@
+#include "i2c_bus.hpp"
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <linux/i2c-dev.h>
+
+
+void I2CBus::delayUs(unsigned us)
+{
+    usleep(us);
+}
+
+
+namespace {
+
+// /dev/i2c-N → device tree clock-frequency (big-endian u32), 없으면 0
+uint32_t readBusHz(const char* dev_path)
+{
+    int adapter = -1;
+    if (sscanf(dev_path, "/dev/i2c-%d", &adapter) != 1 || adapter < 0)
+        return 0;
+
+    char path[96];
+    snprintf(path, sizeof(path), "/sys/bus/i2c/devices/i2c-%d/of_node/clock-frequency", adapter);
+    FILE* fp = fopen(path, "rb");
+    if (fp == nullptr)
+        return 0;
+    uint8_t be[4];
+    size_t n = fread(be, 1, sizeof(be), fp);
+    fclose(fp);
+    if (n != sizeof(be))
+        return 0;
+    return (static_cast<uint32_t>(be[0]) << 24) | (static_cast<uint32_t>(be[1]) << 16) |
+           (static_cast<uint32_t>(be[2]) << 8)  |  static_cast<uint32_t>(be[3]);
+}
+
+} // namespace
+
+
+// ================= LinuxI2CBus =================
+
+constexpr uint32_t LinuxI2CBus::ASSUMED_BUS_HZ;
+
+LinuxI2CBus::LinuxI2CBus(const char* dev_path, int addr)
+    : addr_(addr)
+{
+    uint32_t hz = readBusHz(dev_path);
+    if (hz > 0)
+        bus_hz_ = hz;
+    else
+        std::cerr << "I2C bus speed unknown for " << dev_path << ", assuming "
+                  << ASSUMED_BUS_HZ / 1000 << " kHz" << std::endl;
+
+    fd_ = open(dev_path, O_RDWR | O_CLOEXEC);
+    if (fd_ < 0) {
+        std::cerr << "I2C open failed: " << dev_path << " (" << strerror(errno) << ")" << std::endl;
+        return;
+    }
+
+    if (ioctl(fd_, I2C_SLAVE, addr_) < 0) {
+        std::cerr << "I2C_SLAVE 0x" << std::hex << addr_ << std::dec
+                  << " failed (" << strerror(errno) << ")" << std::endl;
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+LinuxI2CBus::~LinuxI2CBus()
+{
+    if (fd_ >= 0)
+        close(fd_);
+}
+
+bool LinuxI2CBus::write(const uint8_t* data, size_t len)
+{
+    if (fd_ < 0)
+        return false;
+
+    // i2c-dev 의 write() 는 버퍼 전체를 하나의 I2C 메시지로 보냄
+    ssize_t n = ::write(fd_, data, len);
+    return n == static_cast<ssize_t>(len);
+}
+
+
+// ================= MockI2CBus =================
+
+bool MockI2CBus::write(const uint8_t* data, size_t len)
+{
+    Transaction t;
+    t.offset = bytes_.size();
+    t.len    = len;
+    t.bus_ns = (len + 1) * 9ull * 1000000000ull / bus_hz_;
+
+    bytes_.insert(bytes_.end(), data, data + len);
+    transactions_.push_back(t);
+    bus_ns_ += t.bus_ns;
+    return true;
+}
+
+void MockI2CBus::reset()
+{
+    bus_ns_   = 0;
+    delay_ns_ = 0;
+    transactions_.clear();
+    bytes_.clear();
+}
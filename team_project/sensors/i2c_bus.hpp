@@ -0,0 +1,82 @@
+#ifndef I2C_BUS_HPP
+#define I2C_BUS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 한 slave 주소로 보내는 I2C write 트랜잭션 단위 backend
+class I2CBus {
+public:
+    virtual ~I2CBus() {}
+
+    // data 전체를 START ... STOP 한 번으로 전송
+    virtual bool write(const uint8_t* data, size_t len) = 0;
+
+    // 장치 쪽 실행 시간 대기 (mock 은 실제로 자지 않고 기록만 함)
+    virtual void delayUs(unsigned us);
+
+    // SCL 주파수 (LcdTransport 가 byte 시간으로 대기 시간을 맞출 때 사용)
+    virtual uint32_t busHz() const = 0;
+};
+
+
+// /dev/i2c-N (i2c-dev) backend
+// 버스 속도는 device tree (/sys/bus/i2c/devices/i2c-N/of_node/clock-frequency) 에서 읽음
+// (Pi: config.txt 의 dtparam=i2c_arm_baudrate), 읽지 못하면 ASSUMED_BUS_HZ
+class LinuxI2CBus : public I2CBus {
+public:
+    // 모르면 빠른 쪽으로 가정: 실제보다 느리게 잡으면 LCD 대기 byte 가 모자라 글자가 깨짐 (반대는 조금 느려질 뿐)
+    static constexpr uint32_t ASSUMED_BUS_HZ = 400000;
+
+    LinuxI2CBus(const char* dev_path, int addr);
+    ~LinuxI2CBus();
+
+    bool isOpen() const { return fd_ >= 0; }
+    bool write(const uint8_t* data, size_t len) override;
+    uint32_t busHz() const override { return bus_hz_; }
+
+private:
+    int fd_ = -1;
+    int addr_;
+    uint32_t bus_hz_ = ASSUMED_BUS_HZ;
+
+    LinuxI2CBus(const LinuxI2CBus&) = delete;
+    LinuxI2CBus& operator=(const LinuxI2CBus&) = delete;
+};
+
+
+// 하드웨어 없이 트랜잭션과 소요 시간을 기록하는 mock
+// 버스 시간은 (주소 1byte + data) * 9bit / bus_hz 로 계산
+class MockI2CBus : public I2CBus {
+public:
+    struct Transaction {
+        size_t offset;      // bytes() 안의 시작 위치
+        size_t len;
+        uint64_t bus_ns;    // 이 트랜잭션의 버스 점유 시간 (모델)
+    };
+
+    explicit MockI2CBus(uint32_t bus_hz = 100000) : bus_hz_(bus_hz) {}
+
+    bool write(const uint8_t* data, size_t len) override;
+    void delayUs(unsigned us) override { delay_ns_ += us * 1000ull; }
+    uint32_t busHz() const override { return bus_hz_; }
+
+    const std::vector<Transaction>& transactions() const { return transactions_; }
+    const std::vector<uint8_t>& bytes() const { return bytes_; }
+
+    uint64_t busNs()   const { return bus_ns_; }
+    uint64_t delayNs() const { return delay_ns_; }
+    uint64_t totalNs() const { return bus_ns_ + delay_ns_; }   // 실제 패널이었을 때 걸렸을 시간
+
+    void reset();
+
+private:
+    uint32_t bus_hz_;
+    uint64_t bus_ns_   = 0;
+    uint64_t delay_ns_ = 0;
+    std::vector<Transaction> transactions_;
+    std::vector<uint8_t> bytes_;
+};
+
+#endif
@@ -1,73 +1,174 @@
 #include "lcd.hpp"
-#include <wiringPiI2C.h>
-#include <unistd.h>
+#include <chrono>
+#include <cstring>
 
-#define LCD_CHR  1
-#define LCD_CMD  0
+#define LCD_LINE_1 0x00
+#define LCD_LINE_2 0x40
 
-#define LCD_LINE_1 0x80
-#define LCD_LINE_2 0xC0
+constexpr int LCD::RETRY_MS;
 
-#define ENABLE 0b00000100
 
+LCD::LCD(int addr)
+    : owned_bus_(new LinuxI2CBus("/dev/i2c-1", addr)), transport_(owned_bus_.get()) {
+    lcd_init();
+}
 
-LCD::LCD(int addr) {
-    fd = wiringPiI2CSetup(addr);
+LCD::LCD(I2CBus* bus)
+    : transport_(bus) {
     lcd_init();
 }
 
-void LCD::lcd_toggle_enable(int bits) {
-    usleep(500);
-    wiringPiI2CWrite(fd, bits | ENABLE);
-    usleep(500);
-    wiringPiI2CWrite(fd, bits & ~ENABLE);
-    usleep(500);
+void LCD::lcd_init() {
+    transport_.init();
+
+    // 초기화의 clear 이후 화면은 공백
+    memset(shown_.cells, ' ', sizeof(shown_.cells));
+    shown_.backlight = true;
+    pending_ = shown_;
+
+    worker_ = std::thread(&LCD::workerLoop, this);
 }
 
-void LCD::lcd_byte(int bits, int mode) {
-    int high = mode | (bits & 0xF0) | 0x08;  
-    int low  = mode | ((bits << 4) & 0xF0) | 0x08;
+LCD::~LCD() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        running_ = false;
+    }
+    cv_.notify_one();
+    if (worker_.joinable())
+        worker_.join();
+}
 
-    wiringPiI2CWrite(fd, high);
-    lcd_toggle_enable(high);
+// ================= 요청 쪽 (호출 스레드) =================
 
-    wiringPiI2CWrite(fd, low);
-    lcd_toggle_enable(low);
+void LCD::setLine(Frame& frame, int line, const std::string& text) {
+    if (line < 1 || line > LCD_ROWS)
+        return;
+
+    // 16칸 넘는 부분은 잘리고 나머지는 공백으로 채움
+    char* row = frame.cells[line - 1];
+    size_t n = text.size() < static_cast<size_t>(LCD_COLS) ? text.size() : LCD_COLS;
+    memcpy(row, text.data(), n);
+    memset(row + n, ' ', LCD_COLS - n);
 }
 
-void LCD::lcd_init() {
-    lcd_byte(0x33, LCD_CMD);
-    lcd_byte(0x32, LCD_CMD);
-    lcd_byte(0x06, LCD_CMD);
-    lcd_byte(0x0C, LCD_CMD);
-    lcd_byte(0x28, LCD_CMD);
-    lcd_byte(0x01, LCD_CMD);
-    usleep(5000);
+void LCD::submit() {
+    // mutex_ 를 잡은 상태에서 호출
+    pending_seq_++;
+    cv_.notify_one();
 }
 
 void LCD::lcd_clear() {
-    lcd_byte(0x01, LCD_CMD);
-    usleep(2000);
+    std::lock_guard<std::mutex> lock(mutex_);
+    memset(pending_.cells, ' ', sizeof(pending_.cells));
+    submit();
 }
 
 void LCD::lcd_display_string(const std::string& text, int line) {
-    if (line == 1)
-        lcd_byte(LCD_LINE_1, LCD_CMD);
-    else if (line == 2)
-        lcd_byte(LCD_LINE_2, LCD_CMD);
-
-    for (char c : text) {
-        lcd_byte(c, LCD_CHR);
-    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    setLine(pending_, line, text);
+    submit();
 }
 
 void LCD::displayStatus(const std::string& line1, const std::string& line2) {
-    lcd_clear();
-    lcd_display_string(line1, 1);
-    lcd_display_string(line2, 2);
+    std::lock_guard<std::mutex> lock(mutex_);
+    setLine(pending_, 1, line1);
+    setLine(pending_, 2, line2);
+    submit();
 }
 
 void LCD::backlight(int on) {
-    if (on) wiringPiI2CWrite(fd, 0x08);
-    else    wiringPiI2CWrite(fd, 0x00);
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_.backlight = (on != 0);
+    submit();
+}
+
+uint32_t LCD::framesRequested() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return pending_seq_;
+}
+
+uint32_t LCD::framesDrawn() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return frames_drawn_;
+}
+
+uint32_t LCD::writeFailures() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return write_failures_;
+}
+
+// ================= worker 스레드 =================
+
+bool LCD::render(const Frame& frame) {
+    int failed = 0;
+    if (frame.backlight != shown_.backlight) {
+        if (transport_.setBacklight(frame.backlight))
+            shown_.backlight = frame.backlight;
+        else
+            failed++;
+    }
+
+    for (int r = 0; r < LCD_ROWS; r++) {
+        const char* want = frame.cells[r];
+        char* have = shown_.cells[r];
+        int c = 0;
+
+        while (c < LCD_COLS) {
+            if (want[c] == have[c]) {
+                c++;
+                continue;
+            }
+
+            // 바뀐 구간 [start, end) — 1칸짜리 틈은 cursor 명령(1 byte)과 비용이 같으므로 이어서 씀
+            int start = c;
+            int end = c + 1;
+            while (end < LCD_COLS &&
+                   (want[end] != have[end] ||
+                    (end + 1 < LCD_COLS && want[end + 1] != have[end + 1])))
+                end++;
+
+            // cursor 이동 + 문자들을 I2C 트랜잭션 한 번으로
+            int addr = (r == 0 ? LCD_LINE_1 : LCD_LINE_2) + start;
+            // 실패한 구간은 shadow 를 그대로 두어 다음 render 에서 다시 다른 칸으로 잡히게 함
+            if (transport_.writeAt(static_cast<uint8_t>(addr), want + start, end - start))
+                memcpy(have + start, want + start, end - start);
+            else
+                failed++;
+            c = end;
+        }
+    }
+
+    if (failed > 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        write_failures_ += failed;
+    }
+    return failed == 0;
+}
+
+void LCD::workerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool retry = false;     // 지난 render 에서 못 쓴 칸이 있음
+    while (true) {
+        auto wake = [this] { return !running_ || pending_seq_ != drawn_seq_; };
+        if (retry)
+            cv_.wait_for(lock, std::chrono::milliseconds(RETRY_MS), wake);
+        else
+            cv_.wait(lock, wake);
+        if (!running_)
+            break;
+
+        // 가장 최근 요청만 그림 (그리는 동안 들어온 요청은 다음 차례에 합쳐짐)
+        Frame frame = pending_;
+        uint32_t seq = pending_seq_;
+        lock.unlock();
+
+        bool ok = render(frame);
+
+        lock.lock();
+        drawn_seq_ = seq;
+        if (ok)
+            frames_drawn_++;
+        retry = !ok;
+    }
 }
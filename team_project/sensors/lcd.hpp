@@ -1,18 +1,63 @@
 #ifndef LCD_HPP
 #define LCD_HPP
 
+#include "lcd_transport.hpp"
 #include <string>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
 
+constexpr int LCD_ROWS = 2;
+constexpr int LCD_COLS = 16;
+
+// 16x2 HD44780 (PCF8574 I2C backpack)
+// 화면 내용은 shadow framebuffer 로 관리하고, 실제 I2C 전송은 worker 스레드가 한다.
+// - displayStatus / lcd_display_string / lcd_clear / backlight 는 요청만 남기고 바로 반환
+// - worker 는 이전 화면과 비교해서 바뀐 칸만 cursor 주소 지정 후 다시 씀
+// - 그리는 동안 들어온 요청은 최신 것 하나로 합쳐짐 (coalesce)
+// - I2C 쓰기가 실패한 칸은 shadow 에 반영하지 않음 → 새 요청이 없어도 RETRY_MS 뒤 다시 씀
 class LCD {
 private:
-    int fd;
+    struct Frame {
+        char cells[LCD_ROWS][LCD_COLS];
+        bool backlight;
+    };
+
+    std::unique_ptr<I2CBus> owned_bus_;
+    LcdTransport transport_;
 
-    void lcd_toggle_enable(int bits);
-    void lcd_byte(int bits, int mode);
     void lcd_init();
 
+    // worker 스레드 전용
+    Frame shown_;                   // 유리에 실제로 나가 있는 내용 (쓰기에 성공한 것만)
+    bool render(const Frame& frame);    // 모두 썼으면 true
+    void workerLoop();
+
+    // 요청 (mutex_ 보호)
+    Frame pending_;
+    uint32_t pending_seq_ = 0;
+    uint32_t drawn_seq_   = 0;
+    uint32_t frames_drawn_ = 0;
+    uint32_t write_failures_ = 0;
+    bool running_ = true;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::thread worker_;
+
+    void setLine(Frame& frame, int line, const std::string& text);
+    void submit();
+
+    LCD(const LCD&) = delete;
+    LCD& operator=(const LCD&) = delete;
+
 public:
-    explicit LCD(int addr = 0x27);
+    static constexpr int RETRY_MS = 100;     // 쓰기 실패 뒤 다시 시도하는 간격
+
+    explicit LCD(int addr = 0x27);           // /dev/i2c-1
+    explicit LCD(I2CBus* bus);               // 외부 bus (MockI2CBus 등)
+    ~LCD();
 
     void lcd_clear();
     void lcd_display_string(const std::string& text, int line);
@@ -20,6 +65,13 @@ public:
     void displayStatus(const std::string& line1, const std::string& line2);
 
     void backlight(int on);
+
+    // 요청 수 대비 실제로 그린 횟수 (차이 = coalesce 된 요청)
+    uint32_t framesRequested();
+    uint32_t framesDrawn();
+    uint32_t writeFailures();       // 실패한 I2C 쓰기 (backlight / 구간) 수
+
+    uint64_t i2cBytesSent() const { return transport_.bytesSent(); }
 };
 
 #endif
@@ -0,0 +1,117 @@
+#include "lcd_transport.hpp"
+
+#define PCF_RS     0x01
+#define PCF_EN     0x04
+#define PCF_BL     0x08
+
+#define LCD_CMD    0x00
+#define LCD_CHR    PCF_RS
+
+
+LcdTransport::LcdTransport(I2CBus* bus, uint32_t bus_hz)
+    : bus_(bus)
+{
+    if (bus_hz == 0)
+        bus_hz = bus_->busHz();
+
+    // byte 하나 = 9 clock (data 8 + ACK)
+    unsigned byte_ns = static_cast<unsigned>(9ull * 1000000000ull / bus_hz);
+    unsigned need = (EXEC_NS + byte_ns - 1) / byte_ns;    // EN fall 이후 필요한 byte 수
+    pad_bytes_ = need > 1 ? need - 1 : 0;
+}
+
+void LcdTransport::put(uint8_t b)
+{
+    if (len_ >= MAX_BUF)
+        flush();
+    buf_[len_++] = b;
+}
+
+void LcdTransport::putNibble(uint8_t high_nibble, uint8_t rs)
+{
+    uint8_t base = static_cast<uint8_t>((high_nibble & 0xF0) | backlight_ | rs);
+
+    // RS 가 바뀔 때만 EN 올리기 전에 한 byte 먼저 (address setup time)
+    if (last_rs_ != rs) {
+        put(base);
+        last_rs_ = rs;
+    }
+    put(base | PCF_EN);
+    put(base);
+}
+
+void LcdTransport::putByte(uint8_t value, uint8_t rs)
+{
+    putNibble(value, rs);
+    putNibble(static_cast<uint8_t>(value << 4), rs);
+
+    uint8_t idle = static_cast<uint8_t>(((value << 4) & 0xF0) | backlight_ | rs);
+    for (unsigned i = 0; i < pad_bytes_; i++)
+        put(idle);
+}
+
+bool LcdTransport::flush()
+{
+    if (len_ == 0)
+        return true;
+
+    bool ok = bus_->write(buf_, len_);
+    bytes_sent_ += len_;
+    transactions_++;
+    len_ = 0;
+    return ok;
+}
+
+void LcdTransport::init()
+{
+    // 8bit 모드로 세 번 0x3 → 4bit 모드 전환 (0x2)
+    last_rs_ = -1;
+    putNibble(0x30, LCD_CMD);
+    flush();
+    bus_->delayUs(4100);
+
+    putNibble(0x30, LCD_CMD);
+    flush();
+    bus_->delayUs(100);
+
+    putNibble(0x30, LCD_CMD);
+    putNibble(0x20, LCD_CMD);
+    flush();
+    bus_->delayUs(40);
+
+    putByte(0x28, LCD_CMD);     // 4bit, 2 line, 5x8
+    putByte(0x0C, LCD_CMD);     // display on, cursor off
+    putByte(0x06, LCD_CMD);     // entry mode: 증가
+    flush();
+
+    command(0x01);              // clear
+}
+
+bool LcdTransport::command(uint8_t cmd)
+{
+    putByte(cmd, LCD_CMD);
+    bool ok = flush();
+
+    if (cmd == 0x01 || cmd == 0x02 || cmd == 0x03)
+        bus_->delayUs(CLEAR_HOME_US);
+    return ok;
+}
+
+bool LcdTransport::writeAt(uint8_t ddram_addr, const char* text, size_t n)
+{
+    putByte(static_cast<uint8_t>(0x80 | ddram_addr), LCD_CMD);
+    for (size_t i = 0; i < n; i++)
+        putByte(static_cast<uint8_t>(text[i]), LCD_CHR);
+    return flush();
+}
+
+bool LcdTransport::setBacklight(bool on)
+{
+    backlight_ = on ? PCF_BL : 0x00;
+    uint8_t b = backlight_;
+    last_rs_ = LCD_CMD;
+    bool ok = bus_->write(&b, 1);
+    bytes_sent_ += 1;
+    transactions_++;
+    return ok;
+}
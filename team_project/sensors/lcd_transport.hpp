@@ -0,0 +1,53 @@
+#ifndef LCD_TRANSPORT_HPP
+#define LCD_TRANSPORT_HPP
+
+#include "i2c_bus.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// HD44780 4bit 모드 ↔ PCF8574 I2C backpack 인코더
+// PCF8574 핀: P0=RS, P1=RW, P2=EN, P3=Backlight, P4~P7=D4~D7
+//
+// 문자열 전체(cursor 명령 + 문자들)를 nibble/EN strobe byte 열로 만들어 I2C 트랜잭션 한 번으로 보낸다.
+// usleep 대신 I2C byte 전송 시간 자체를 대기 시간으로 사용 (byte 시간은 bus->busHz() 로 계산):
+//   - EN pulse 폭(>=450ns), cycle(>=1us) : byte 하나(100kHz 에서 90us, 400kHz 에서 22.5us) 로 충분
+//   - 명령 실행 37us                    : 버스가 빠르면 EN low byte 를 반복해 채움 (400kHz: 1, 1MHz: 4)
+//   - clear/home 1.52ms, 초기화 4.1ms   : 트랜잭션 사이에 delayUs
+class LcdTransport {
+public:
+    // bus_hz 0: bus->busHz()
+    explicit LcdTransport(I2CBus* bus, uint32_t bus_hz = 0);
+
+    void init();                                   // 4bit 초기화 시퀀스 (datasheet Figure 24)
+    bool command(uint8_t cmd);
+    bool writeAt(uint8_t ddram_addr, const char* text, size_t n);   // set DDRAM addr + 문자열
+    bool setBacklight(bool on);
+
+    uint64_t bytesSent()    const { return bytes_sent_; }
+    uint64_t transactions() const { return transactions_; }
+    unsigned padBytes()     const { return pad_bytes_; }
+
+private:
+    static constexpr size_t MAX_BUF = 512;
+    static constexpr unsigned EXEC_NS       = 37000;     // 일반 명령/데이터 실행 시간
+    static constexpr unsigned CLEAR_HOME_US = 1520;      // clear(0x01) / home(0x02)
+
+    I2CBus*  bus_;
+    unsigned pad_bytes_;        // 실행 시간 확보용 추가 byte 수
+    uint8_t  backlight_ = 0x08;
+    int      last_rs_   = -1;
+
+    uint8_t  buf_[MAX_BUF];
+    size_t   len_ = 0;
+
+    std::atomic<uint64_t> bytes_sent_{0};       // 다른 스레드에서 통계로 읽음
+    std::atomic<uint64_t> transactions_{0};
+
+    void put(uint8_t b);
+    void putNibble(uint8_t high_nibble, uint8_t rs);
+    void putByte(uint8_t value, uint8_t rs);
+    bool flush();
+};
+
+#endif
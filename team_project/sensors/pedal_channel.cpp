@@ -0,0 +1,111 @@
+#include "pedal_channel.hpp"
+#include "../core/mono_clock.hpp"
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace {
+
+constexpr uint32_t CHANNEL_MAGIC   = 0x50454431;   // "PED1"
+constexpr uint32_t CHANNEL_VERSION = 1;
+constexpr uint64_t INIT_TIMEOUT_NS = 1000000000ull;   // 다른 프로세스가 초기화 중 죽었으면 1초 뒤 실패
+
+enum : uint32_t { INIT_NONE = 0, INIT_BUSY = 1, INIT_DONE = 2 };
+
+} // namespace
+
+
+// 0 으로 채운 메모리가 곧 초기 상태 (Seqlock 의 seq / word 가 모두 0)
+struct PedalChannel::Shared {
+    std::atomic<uint32_t> init_state;
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size;
+
+    alignas(64) Seqlock<PedalState> state;
+};
+
+
+PedalChannel::~PedalChannel()
+{
+    close();
+}
+
+bool PedalChannel::open(const char* name)
+{
+    if (shm_ != nullptr)
+        return true;
+
+    int fd = shm_open(name, O_RDWR | O_CREAT, 0666);
+    if (fd < 0) {
+        std::cerr << "shm_open failed: " << name << " (" << strerror(errno) << ")" << std::endl;
+        return false;
+    }
+    if (ftruncate(fd, sizeof(Shared)) < 0) {
+        std::cerr << "ftruncate failed (" << strerror(errno) << ")" << std::endl;
+        ::close(fd);
+        return false;
+    }
+    void* p = mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        std::cerr << "mmap failed (" << strerror(errno) << ")" << std::endl;
+        return false;
+    }
+
+    Shared* shm = static_cast<Shared*>(p);
+    uint32_t state = INIT_NONE;
+    if (shm->init_state.compare_exchange_strong(state, INIT_BUSY)) {
+        shm->magic   = CHANNEL_MAGIC;
+        shm->version = CHANNEL_VERSION;
+        shm->size    = sizeof(PedalState);
+        shm->init_state.store(INIT_DONE, std::memory_order_release);
+    }
+    else {
+        uint64_t deadline = monoNowNs() + INIT_TIMEOUT_NS;
+        while (shm->init_state.load(std::memory_order_acquire) != INIT_DONE) {
+            if (monoNowNs() > deadline) {
+                std::cerr << "pedal channel init never finished (creator died?): " << name << std::endl;
+                munmap(p, sizeof(Shared));
+                return false;
+            }
+            usleep(100);
+        }
+    }
+
+    if (shm->magic != CHANNEL_MAGIC || shm->version != CHANNEL_VERSION || shm->size != sizeof(PedalState)) {
+        std::cerr << "pedal channel layout mismatch: " << name << std::endl;
+        munmap(p, sizeof(Shared));
+        return false;
+    }
+
+    shm_ = shm;
+    return true;
+}
+
+void PedalChannel::close()
+{
+    if (shm_ != nullptr) {
+        munmap(shm_, sizeof(Shared));
+        shm_ = nullptr;
+    }
+}
+
+void PedalChannel::publish(const PedalState& state)
+{
+    shm_->state.write(state);
+}
+
+bool PedalChannel::latest(PedalState& state) const
+{
+    if (shm_ == nullptr || shm_->state.version() == 0)
+        return false;
+    state = shm_->state.read();
+    return true;
+}
@@ -0,0 +1,36 @@
+#ifndef PEDAL_CHANNEL_HPP
+#define PEDAL_CHANNEL_HPP
+
+#include "pedal_sampler.hpp"
+#include "../core/seqlock.hpp"
+
+// 제어 프로세스 → 검출 프로세스 페달 상태 (검출 빈도 조절용)
+// POSIX shared memory 위의 seqlock 최신값 하나 (writer 는 제어 프로세스 하나)
+// - publish / latest 는 syscall 없음, 검출 쪽은 프레임마다 읽어도 된다
+
+constexpr const char* PEDAL_CHANNEL_NAME = "/mispedal_pedal";
+
+class PedalChannel {
+public:
+    PedalChannel() {}
+    ~PedalChannel();
+
+    // 어느 쪽이 먼저 실행되든 같은 함수로 연다 (없으면 생성 + 초기화)
+    bool open(const char* name = PEDAL_CHANNEL_NAME);
+    void close();
+    bool isOpen() const { return shm_ != nullptr; }
+
+    void publish(const PedalState& state);
+
+    // 한 번도 publish 되지 않았거나 닫혀 있으면 false
+    bool latest(PedalState& state) const;
+
+private:
+    struct Shared;
+    Shared* shm_ = nullptr;
+
+    PedalChannel(const PedalChannel&) = delete;
+    PedalChannel& operator=(const PedalChannel&) = delete;
+};
+
+#endif
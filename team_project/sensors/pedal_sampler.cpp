@@ -0,0 +1,135 @@
+#include "pedal_sampler.hpp"
+#include "../core/thread_affinity.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+
+namespace {
+
+// 1차 IIR low-pass 계수 (샘플 주기 dt 기준)
+float lpfAlpha(float cutoff_hz, float dt)
+{
+    return 1.0f - std::exp(-2.0f * static_cast<float>(M_PI) * cutoff_hz * dt);
+}
+
+} // namespace
+
+constexpr int PedalSampler::MAX_WINDOW;
+constexpr uint32_t PedalSampler::SAMPLE_RING;
+
+
+PedalSampler::PedalSampler(MCP3208& adc)
+    : PedalSampler(adc, Config())
+{
+}
+
+PedalSampler::PedalSampler(MCP3208& adc, const Config& config, Clock* clock)
+    : adc_(adc), cfg_(config), clock_(clock ? clock : &systemClock())
+{
+    memset(&cur_, 0, sizeof(cur_));
+    history_len_ = static_cast<int>(cfg_.rate_hz * cfg_.window_ms / 1000.0);
+    history_len_ = std::max(1, std::min(history_len_, MAX_WINDOW));
+}
+
+PedalSampler::~PedalSampler()
+{
+    stop();
+}
+
+bool PedalSampler::start()
+{
+    if (running_)
+        return true;
+
+    running_ = true;
+    thread_ = std::thread(&PedalSampler::loop, this);
+    if (!pinThread(thread_, cfg_.cpu))
+        std::cerr << "pedal sampler: cannot pin to cpu " << cfg_.cpu << std::endl;
+    if (!setThreadFifo(thread_, cfg_.rt_priority))
+        std::cerr << "pedal sampler: cannot set SCHED_FIFO " << cfg_.rt_priority << std::endl;
+    return true;
+}
+
+void PedalSampler::stop()
+{
+    running_ = false;
+    if (thread_.joinable())
+        thread_.join();
+}
+
+void PedalSampler::step(uint64_t now_ns)
+{
+    float adc_val = adc_.readAveraged(cfg_.channel, cfg_.oversample);
+    float voltage = (adc_val / 4095.0f) * 3.3f;
+    float thr     = std::max(0.0f, (voltage - cfg_.v_min) / (cfg_.v_max - cfg_.v_min) * 100);
+
+    if (!primed_) {
+        cur_.thr_filtered = thr;
+        cur_.slope = 0.0f;
+        for (int i = 0; i < history_len_; i++)
+            history_[i] = thr;
+        primed_ = true;
+    }
+    else {
+        float dt = (now_ns - cur_.timestamp_ns) / 1e9f;
+        if (dt <= 0.0f)
+            dt = static_cast<float>(1.0 / cfg_.rate_hz);
+
+        float prev = cur_.thr_filtered;
+        cur_.thr_filtered += lpfAlpha(cfg_.lpf_hz, dt) * (thr - prev);
+
+        float raw_slope = (cur_.thr_filtered - prev) / dt;
+        cur_.slope += lpfAlpha(cfg_.slope_lpf_hz, dt) * (raw_slope - cur_.slope);
+    }
+
+    // window 변화량 (window_ms 전 샘플과 비교)
+    float oldest = history_[history_index_];
+    history_[history_index_] = thr;
+    history_index_ = (history_index_ + 1) % history_len_;
+
+    cur_.timestamp_ns = now_ns;
+    cur_.sample_count++;
+    cur_.voltage      = voltage;
+    cur_.thr_raw      = thr;
+    cur_.delta_window = thr - oldest;
+
+    // stomp: 빠르게 밟기 시작한 뒤 변화량이 기준에 닿는 첫 샘플 (hysteresis 로 한 번만)
+    // 변화량이 닿을 때는 filter 된 slope 가 이미 내려가 있을 수 있으므로 시작만 slope 로 봄
+    if (armed_ && cur_.slope >= cfg_.stomp_slope)
+        onset_ = true;
+    if (armed_ && onset_ && cur_.delta_window >= cfg_.stomp_delta) {
+        cur_.stomp_count++;
+        cur_.stomp_ns = now_ns;
+        armed_ = false;
+    }
+    if (cur_.slope < cfg_.rearm_slope) {
+        onset_ = false;
+        armed_ = true;
+    }
+
+    state_.write(cur_);
+
+    if (cfg_.record) {
+        PedalSample sample = { now_ns, voltage };
+        if (!samples_.push(sample))
+            record_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void PedalSampler::loop()
+{
+    const uint64_t period_ns = static_cast<uint64_t>(1e9 / cfg_.rate_hz);
+    uint64_t next = clock_->nowNs();
+
+    while (running_) {
+        step(clock_->nowNs());
+
+        next += period_ns;
+        uint64_t now = clock_->nowNs();
+        if (now > next + period_ns)
+            next = now;     // 크게 밀리면 따라잡지 않고 다시 시작
+        clock_->sleepUntil(next);
+    }
+}
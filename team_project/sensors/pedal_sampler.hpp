@@ -0,0 +1,101 @@
+#ifndef PEDAL_SAMPLER_HPP
+#define PEDAL_SAMPLER_HPP
+
+#include "hall_sensor.hpp"
+#include "../core/clock.hpp"
+#include "../core/seqlock.hpp"
+#include "../core/spsc_ring.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// 페달(hall sensor) 최신 상태. 제어 쪽은 PedalSampler::latest() 로 읽는다.
+struct PedalState {
+    uint64_t timestamp_ns;    // 샘플 시각 (CLOCK_MONOTONIC)
+    uint64_t sample_count;
+    float    voltage;
+    float    thr_raw;         // %
+    float    thr_filtered;    // low-pass 후 %
+    float    slope;           // 필터된 d(throttle)/dt (%/s)
+    float    delta_window;    // 최근 window_ms 동안의 변화량 (%), 기존 delta_thr_raw 와 같은 의미
+    uint32_t stomp_count;     // 지금까지 감지된 stomp 수
+    uint64_t stomp_ns;        // 마지막 stomp 가 감지된 샘플 시각 (없으면 0)
+};
+
+// 기록용 샘플 하나 (trace 의 'P' 이벤트)
+struct PedalSample {
+    uint64_t timestamp_ns;
+    float    voltage;
+};
+
+// 전용 스레드에서 MCP3208 을 고속(기본 1kHz)으로 샘플링하고 페달 급변(stomp)을 감지
+// - 절대 시각 기준 주기 (Clock::sleepUntil, 기본은 CLOCK_MONOTONIC)
+// - throttle 을 1차 low-pass 한 뒤 미분, 미분값도 한 번 더 low-pass
+// - stomp: slope 가 stomp_slope 를 넘은 뒤 (빠르게 밟기 시작) window 변화량이 stomp_delta 에 닿는 첫 샘플
+//   (기존 기준 delta_thr_raw >= 70 도 함께 → 빠르지만 짧게 밟은 것은 stomp 아님)
+//   slope 가 rearm_slope 아래로 내려가면 다시 감지 가능
+// - cpu 를 지정하면 그 core 에 고정
+class PedalSampler {
+public:
+    struct Config {
+        double   rate_hz      = 1000.0;
+        unsigned oversample   = 4;
+        unsigned char channel = 0;
+        float    v_min        = V_MIN_CALIBRATED;
+        float    v_max        = V_MAX_CALIBRATED;
+        float    lpf_hz       = 40.0f;     // throttle low-pass 차단 주파수
+        float    slope_lpf_hz = 20.0f;     // 미분값 low-pass 차단 주파수
+        float    stomp_slope  = 350.0f;    // %/s (기존 기준: 200ms 안에 70%)
+        float    stomp_delta  = 70.0f;     // % (window_ms 동안의 변화량, 기존 delta_thr_raw >= 70)
+        float    rearm_slope  = 50.0f;     // %/s
+        int      window_ms    = 200;       // delta_window 계산 구간
+        int      cpu          = -1;        // 고정할 core (-1: 고정 안 함)
+        int      rt_priority  = 0;         // SCHED_FIFO 우선순위 (0: 일반 스케줄링)
+        bool     record       = false;     // 모든 샘플을 popSample() 로 내보냄 (--record, replay 가 1kHz 로 재생)
+    };
+
+    explicit PedalSampler(MCP3208& adc);
+    PedalSampler(MCP3208& adc, const Config& config, Clock* clock = nullptr);
+    ~PedalSampler();
+
+    bool start();
+    void stop();
+
+    PedalState latest() const { return state_.read(); }
+
+    // Config::record 일 때 샘플링 순서대로 하나씩 (소비자 스레드 하나만)
+    // 소비자가 SAMPLE_RING 개 (1kHz 에서 256ms) 안에 가져가지 못하면 그 샘플은 버리고 recordDropped() 로 셈
+    bool popSample(PedalSample& sample) { return samples_.pop(sample); }
+    uint64_t recordDropped() const { return record_dropped_.load(std::memory_order_relaxed); }
+
+    // 한 샘플 처리 (스레드 루프에서 호출, 시뮬레이션에서는 직접 호출 가능)
+    void step(uint64_t now_ns);
+
+private:
+    static constexpr int MAX_WINDOW = 1024;
+    static constexpr uint32_t SAMPLE_RING = 256;
+
+    MCP3208& adc_;
+    Config   cfg_;
+    Clock*   clock_;
+
+    Seqlock<PedalState> state_;
+    SpscRing<PedalSample, SAMPLE_RING> samples_;
+    std::atomic<uint64_t> record_dropped_{0};
+
+    // 샘플링 스레드 전용 상태
+    PedalState cur_;
+    bool     primed_ = false;
+    bool     armed_  = true;
+    bool     onset_  = false;   // slope 가 stomp_slope 를 넘었고 아직 rearm_slope 아래로 내려가지 않음
+    float    history_[MAX_WINDOW];
+    int      history_len_   = 1;
+    int      history_index_ = 0;
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    void loop();
+};
+
+#endif
@@ -0,0 +1,98 @@
+#include "pwm_tone.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+
+
+namespace {
+
+bool writeValue(int fd, unsigned long long value)
+{
+    char buf[24];
+    int n = snprintf(buf, sizeof(buf), "%llu", value);
+    return pwrite(fd, buf, static_cast<size_t>(n), 0) == n;
+}
+
+int openAttr(const char* dir, const char* name)
+{
+    char path[96];
+    snprintf(path, sizeof(path), "%s/%s", dir, name);
+    return open(path, O_WRONLY | O_CLOEXEC);
+}
+
+} // namespace
+
+
+SysfsPwmTone::SysfsPwmTone(int chip, int channel)
+{
+    char dir[64];
+    snprintf(dir, sizeof(dir), "/sys/class/pwm/pwmchip%d/pwm%d", chip, channel);
+    if (access(dir, F_OK) != 0) {
+        char export_path[64];
+        snprintf(export_path, sizeof(export_path), "/sys/class/pwm/pwmchip%d/export", chip);
+        int fd = open(export_path, O_WRONLY | O_CLOEXEC);
+        if (fd < 0 || !writeValue(fd, static_cast<unsigned long long>(channel))) {
+            std::cerr << "PWM export failed: " << export_path << " (" << strerror(errno) << ")" << std::endl;
+            if (fd >= 0)
+                close(fd);
+            return;
+        }
+        close(fd);
+        // udev 가 속성 파일 권한을 바꿀 때까지 잠깐 기다림
+        for (int i = 0; i < 50 && access(dir, W_OK) != 0; i++)
+            usleep(10000);
+    }
+
+    period_fd_ = openAttr(dir, "period");
+    duty_fd_   = openAttr(dir, "duty_cycle");
+    enable_fd_ = openAttr(dir, "enable");
+    if (period_fd_ < 0 || duty_fd_ < 0 || enable_fd_ < 0) {
+        std::cerr << "PWM open failed: " << dir << " (" << strerror(errno) << ")" << std::endl;
+        closeAll();
+        return;
+    }
+    writeValue(enable_fd_, 0);
+}
+
+SysfsPwmTone::~SysfsPwmTone()
+{
+    if (isOpen())
+        writeValue(enable_fd_, 0);
+    closeAll();
+}
+
+void SysfsPwmTone::closeAll()
+{
+    int* fds[] = { &period_fd_, &duty_fd_, &enable_fd_ };
+    for (int i = 0; i < 3; i++)
+        if (*fds[i] >= 0) {
+            close(*fds[i]);
+            *fds[i] = -1;
+        }
+}
+
+void SysfsPwmTone::tone(int hz)
+{
+    if (!isOpen())
+        return;
+    if (hz <= 0) {
+        if (enabled_)
+            writeValue(enable_fd_, 0);
+        enabled_ = false;
+        return;
+    }
+    if (hz != hz_) {
+        // duty_cycle <= period 여야 하므로 duty 를 먼저 0 으로
+        unsigned long long period = 1000000000ull / static_cast<unsigned>(hz);
+        writeValue(duty_fd_, 0);
+        writeValue(period_fd_, period);
+        writeValue(duty_fd_, period / 2);
+        hz_ = hz;
+    }
+    if (!enabled_)
+        writeValue(enable_fd_, 1);
+    enabled_ = true;
+}
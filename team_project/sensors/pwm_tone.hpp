@@ -0,0 +1,31 @@
+#ifndef PWM_TONE_HPP
+#define PWM_TONE_HPP
+
+#include "../core/hal.hpp"
+
+// /sys/class/pwm 하드웨어 PWM 으로 부저 tone (duty 50%)
+// softTone 은 wiringPi 스레드가 계속 GPIO 를 토글하지만 이쪽은 PWM 블록이 파형을 만들어 CPU 를 쓰지 않음
+// Pi: config.txt 에 dtoverlay=pwm (PWM0 = GPIO18) 등, 부저를 그 핀에 연결해야 함
+// period / duty_cycle / enable 파일은 생성할 때 열어 두고 tone() 은 write 만 (주파수가 같으면 enable 만)
+class SysfsPwmTone : public ToneOutput {
+public:
+    SysfsPwmTone(int chip, int channel);
+    ~SysfsPwmTone();
+
+    bool isOpen() const { return enable_fd_ >= 0; }
+    void tone(int hz) override;
+
+private:
+    int period_fd_ = -1;
+    int duty_fd_   = -1;
+    int enable_fd_ = -1;
+    int hz_        = 0;      // 설정된 주파수
+    bool enabled_  = false;
+
+    void closeAll();
+
+    SysfsPwmTone(const SysfsPwmTone&) = delete;
+    SysfsPwmTone& operator=(const SysfsPwmTone&) = delete;
+};
+
+#endif
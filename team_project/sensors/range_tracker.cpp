@@ -0,0 +1,137 @@
+#include "range_tracker.hpp"
+#include <cmath>
+
+
+RangeTracker::RangeTracker()
+    : RangeTracker(Config())
+{
+}
+
+RangeTracker::RangeTracker(const Config& config)
+    : cfg_(config)
+{
+}
+
+void RangeTracker::reset()
+{
+    initialized_ = false;
+    updates_ = 0;
+    consecutive_outliers_ = 0;
+}
+
+void RangeTracker::init(float distance_m, uint64_t t_ns)
+{
+    d_ = distance_m;
+    v_ = 0.0f;
+    p_dd_ = cfg_.meas_sigma_m * cfg_.meas_sigma_m;
+    p_dv_ = 0.0f;
+    p_vv_ = cfg_.init_v_sigma * cfg_.init_v_sigma;
+
+    last_ns_ = t_ns;
+    updates_ = 1;
+    consecutive_outliers_ = 0;
+    initialized_ = true;
+}
+
+void RangeTracker::predict(float dt)
+{
+    // x = F x,  P = F P F' + Q   (F = [1 dt; 0 1], Q = 백색 가속도 잡음)
+    d_ += v_ * dt;
+
+    float q   = cfg_.accel_sigma * cfg_.accel_sigma;
+    float dt2 = dt * dt;
+    float dt3 = dt2 * dt;
+
+    p_dd_ += 2.0f * dt * p_dv_ + dt2 * p_vv_ + q * dt3 * dt / 4.0f;
+    p_dv_ += dt * p_vv_ + q * dt3 / 2.0f;
+    p_vv_ += q * dt2;
+}
+
+bool RangeTracker::update(float distance_m, uint64_t t_ns)
+{
+    if (!initialized_) {
+        init(distance_m, t_ns);
+        return true;
+    }
+
+    float dt = static_cast<float>(static_cast<int64_t>(t_ns - last_ns_)) / 1e9f;
+    if (dt <= 0.0f)
+        return false;
+
+    // 예측은 상태를 바꾸므로 gate 판정 전에 복사본으로 계산
+    float d0 = d_, v0 = v_, pdd0 = p_dd_, pdv0 = p_dv_, pvv0 = p_vv_;
+    predict(dt);
+
+    float r     = cfg_.meas_sigma_m * cfg_.meas_sigma_m;
+    float innov = distance_m - d_;
+    float s     = p_dd_ + r;
+
+    if (innov * innov / s > cfg_.gate_chi2) {
+        outliers_++;
+        consecutive_outliers_++;
+
+        // 물체가 바뀐 것으로 보고 새로 시작
+        if (consecutive_outliers_ >= cfg_.reset_after) {
+            init(distance_m, t_ns);
+            return true;
+        }
+
+        // 측정은 버리고 시간도 진행하지 않음 (다음 측정에서 dt 를 합쳐 예측)
+        d_ = d0; v_ = v0; p_dd_ = pdd0; p_dv_ = pdv0; p_vv_ = pvv0;
+        return false;
+    }
+
+    float k_d = p_dd_ / s;
+    float k_v = p_dv_ / s;
+
+    d_ += k_d * innov;
+    v_ += k_v * innov;
+
+    float pdd = p_dd_, pdv = p_dv_;
+    p_dd_ -= k_d * pdd;
+    p_dv_ -= k_d * pdv;
+    p_vv_ -= k_v * pdv;
+
+    last_ns_ = t_ns;
+    updates_++;
+    consecutive_outliers_ = 0;
+    return true;
+}
+
+float RangeTracker::ttc() const
+{
+    float vc = -v_;
+    if (!initialized_ || updates_ < 2 || vc <= cfg_.min_closing)
+        return INFINITY;
+    return d_ / vc;
+}
+
+float RangeTracker::ttcAt(uint64_t t_ns) const
+{
+    float t = ttc();
+    if (std::isinf(t) || t_ns <= last_ns_)
+        return t;
+    // d(t) = d + v dt → TTC 는 지난 시간만큼 줄어듦, 0 아래로는 내리지 않음
+    float elapsed = static_cast<float>(t_ns - last_ns_) / 1e9f;
+    return t > elapsed ? t - elapsed : 0.0f;
+}
+
+float RangeTracker::ttcSigma() const
+{
+    float vc = -v_;
+    if (!initialized_ || updates_ < 2 || vc <= cfg_.min_closing)
+        return INFINITY;
+
+    // TTC = d / vc,  dTTC/dd = 1/vc,  dTTC/dv = d/vc^2
+    float a = 1.0f / vc;
+    float b = d_ / (vc * vc);
+    float var = a * a * p_dd_ + b * b * p_vv_ + 2.0f * a * b * p_dv_;
+    return std::sqrt(var > 0.0f ? var : 0.0f);
+}
+
+float RangeTracker::confidence() const
+{
+    if (!initialized_ || updates_ < 2)
+        return 0.0f;
+    return 1.0f / (1.0f + std::sqrt(p_vv_) / cfg_.conf_v_sigma);
+}
@@ -0,0 +1,60 @@
+#ifndef RANGE_TRACKER_HPP
+#define RANGE_TRACKER_HPP
+
+#include <cstdint>
+
+// 거리/접근속도 추정기 (등속 모델 2-state Kalman filter)
+// state: d (m), v = dd/dt (m/s, 가까워지면 음수)
+// - 호출마다 상수 시간 (반복문 없음)
+// - innovation 이 gate 를 넘는 측정은 outlier 로 버림, 연속으로 reset_after 번 넘으면 재초기화
+// - TTC 와 그 표준편차는 필터 상태와 공분산에서 1차 오차전파로 계산
+class RangeTracker {
+public:
+    struct Config {
+        float meas_sigma_m   = 0.01f;   // 초음파 측정 잡음 (1cm)
+        float accel_sigma    = 0.5f;    // 모델에 없는 가속도 (m/s^2)
+        float init_v_sigma   = 1.0f;    // 첫 측정 후 속도 불확실성 (m/s)
+        float gate_chi2      = 9.0f;    // 3 sigma
+        int   reset_after    = 3;       // 연속 outlier 수
+        float conf_v_sigma   = 0.1f;    // confidence 0.5 가 되는 속도 표준편차 (m/s)
+        float min_closing    = 0.00001f;
+    };
+
+    RangeTracker();
+    explicit RangeTracker(const Config& config);
+
+    // 측정 반영, outlier 로 버려지면 false
+    bool update(float distance_m, uint64_t t_ns);
+    void reset();
+
+    bool  initialized()  const { return initialized_; }
+    float distance()     const { return d_; }
+    float velocity()     const { return v_; }
+    float closingSpeed() const { return -v_; }     // 접근 속도 (m/s, 가까워지면 양수)
+
+    float ttc() const;         // s, 접근하지 않으면 INFINITY
+    // 마지막 update 이후 t_ns 까지 등속으로 진행했다고 본 TTC (측정이 빠진 동안 coast)
+    float ttcAt(uint64_t t_ns) const;
+    float ttcSigma() const;    // s
+    float confidence() const;  // 0~1
+
+    uint32_t outliers() const { return outliers_; }
+    uint64_t lastUpdateNs() const { return last_ns_; }
+
+private:
+    Config cfg_;
+
+    bool     initialized_ = false;
+    int      updates_     = 0;
+    int      consecutive_outliers_ = 0;
+    uint32_t outliers_    = 0;
+    uint64_t last_ns_     = 0;
+
+    float d_ = 0.0f, v_ = 0.0f;
+    float p_dd_ = 0.0f, p_dv_ = 0.0f, p_vv_ = 0.0f;
+
+    void init(float distance_m, uint64_t t_ns);
+    void predict(float dt);
+};
+
+#endif
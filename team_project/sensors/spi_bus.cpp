@@ -0,0 +1,128 @@
+#include "spi_bus.hpp"
+#include <iostream>
+#include <cstring>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+
+
+// ================= LinuxSpiBus =================
+
+LinuxSpiBus::LinuxSpiBus(const char* dev_path, uint32_t speed_hz)
+{
+    memset(xfer_, 0, sizeof(xfer_));
+
+    fd_ = open(dev_path, O_RDWR | O_CLOEXEC);
+    if (fd_ < 0) {
+        std::cerr << "SPI open failed: " << dev_path << " (" << strerror(errno) << ")" << std::endl;
+        return;
+    }
+
+    uint8_t mode = SPI_MODE_0;
+    uint8_t bits = 8;
+    if (ioctl(fd_, SPI_IOC_WR_MODE, &mode) < 0 ||
+        ioctl(fd_, SPI_IOC_WR_BITS_PER_WORD, &bits) < 0 ||
+        ioctl(fd_, SPI_IOC_WR_MAX_SPEED_HZ, &speed_hz) < 0) {
+        std::cerr << "SPI setup failed (" << strerror(errno) << ")" << std::endl;
+        close(fd_);
+        fd_ = -1;
+        return;
+    }
+
+    for (unsigned i = 0; i < MAX_FRAMES; i++) {
+        xfer_[i].speed_hz      = speed_hz;
+        xfer_[i].bits_per_word = bits;
+        xfer_[i].cs_change     = 1;      // frame 사이마다 CS 를 풀어 변환을 다시 시작
+    }
+}
+
+LinuxSpiBus::~LinuxSpiBus()
+{
+    if (fd_ >= 0)
+        close(fd_);
+}
+
+bool LinuxSpiBus::transferFrames(const uint8_t* tx, uint8_t* rx, unsigned frame_len, unsigned frames)
+{
+    if (fd_ < 0 || frames == 0 || frames > MAX_FRAMES)
+        return false;
+
+    for (unsigned i = 0; i < frames; i++) {
+        xfer_[i].tx_buf = reinterpret_cast<uintptr_t>(tx + i * frame_len);
+        xfer_[i].rx_buf = reinterpret_cast<uintptr_t>(rx + i * frame_len);
+        xfer_[i].len    = frame_len;
+    }
+
+    // 마지막 transfer 의 cs_change=1 은 "메시지 끝난 뒤에도 CS 유지" 라는 뜻이므로 잠시 0 으로
+    xfer_[frames - 1].cs_change = 0;
+    int ret = ioctl(fd_, SPI_IOC_MESSAGE(frames), xfer_);
+    xfer_[frames - 1].cs_change = 1;
+
+    return ret >= 0;
+}
+
+
+// ================= MockMcp3208Bus =================
+
+MockMcp3208Bus::MockMcp3208Bus()
+{
+    for (int i = 0; i < 8; i++)
+        value_[i].store(0);
+}
+
+bool MockMcp3208Bus::transferFrames(const uint8_t* tx, uint8_t* rx, unsigned frame_len, unsigned frames)
+{
+    if (frame_len != 3 || frames == 0 || frames > MAX_FRAMES)
+        return false;
+
+    ioctls_++;
+    frames_ += frames;
+
+    for (unsigned i = 0; i < frames; i++)
+        respond(tx + i * 3, rx + i * 3, frame_len);
+    return true;
+}
+
+void MockMcp3208Bus::respond(const uint8_t* tx, uint8_t* rx, unsigned frame_len)
+{
+    const unsigned bits = frame_len * 8;
+    memset(rx, 0xFF, frame_len);        // 변환 결과 전까지 DOUT 은 hi-Z
+
+    // start bit (DIN 의 첫 1) 찾기
+    unsigned pos = 0;
+    while (pos < bits && !((tx[pos / 8] >> (7 - pos % 8)) & 1))
+        pos++;
+    if (pos + 4 >= bits) {
+        bad_frames_++;
+        return;
+    }
+
+    unsigned cfg = 0;   // SGL/DIFF, D2, D1, D0
+    for (unsigned k = 1; k <= 4; k++)
+        cfg = (cfg << 1) | ((tx[(pos + k) / 8] >> (7 - (pos + k) % 8)) & 1);
+    if (!(cfg & 0x8)) {
+        bad_frames_++;      // 차동 입력은 흉내내지 않음
+        return;
+    }
+    unsigned ch = cfg & 0x7;
+
+    int v = value_[ch].load(std::memory_order_relaxed);
+    if (noise_lsb_ > 0) {
+        rng_ = rng_ * 1103515245u + 12345u;
+        v += static_cast<int>((rng_ >> 16) % (2 * noise_lsb_ + 1)) - noise_lsb_;
+    }
+    if (v < 0)    v = 0;
+    if (v > 4095) v = 4095;
+
+    // D0 다음 clock 은 sample, 그 다음 null bit, 이어서 B11..B0 (clock 이 모자라면 잘림)
+    unsigned out = pos + 6;
+    for (int b = -1; b < 12 && out < bits; b++, out++) {
+        unsigned bit = b < 0 ? 0u : static_cast<unsigned>((v >> (11 - b)) & 1);
+        uint8_t mask = static_cast<uint8_t>(1u << (7 - out % 8));
+        if (bit)
+            rx[out / 8] |= mask;
+        else
+            rx[out / 8] &= static_cast<uint8_t>(~mask);
+    }
+}
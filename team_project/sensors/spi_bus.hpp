@@ -0,0 +1,72 @@
+#ifndef SPI_BUS_HPP
+#define SPI_BUS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <linux/spi/spidev.h>
+
+// 여러 SPI frame 을 한 번에 주고받는 backend
+// frame 하나 = CS assert ~ deassert 한 번 (frame_len byte 전이중)
+class SpiBus {
+public:
+    static constexpr unsigned MAX_FRAMES = 64;
+
+    virtual ~SpiBus() {}
+
+    // tx/rx 는 frame_len * frames byte, frames <= MAX_FRAMES
+    virtual bool transferFrames(const uint8_t* tx, uint8_t* rx, unsigned frame_len, unsigned frames) = 0;
+};
+
+
+// /dev/spidevB.C backend
+// spi_ioc_transfer 배열을 미리 만들어 두고, 호출마다 버퍼 포인터만 바꿔 SPI_IOC_MESSAGE ioctl 한 번으로 보냄
+// CS 는 spidev 드라이버가 frame 마다 직접 토글한다.
+class LinuxSpiBus : public SpiBus {
+public:
+    LinuxSpiBus(const char* dev_path, uint32_t speed_hz);
+    ~LinuxSpiBus();
+
+    bool isOpen() const { return fd_ >= 0; }
+    bool transferFrames(const uint8_t* tx, uint8_t* rx, unsigned frame_len, unsigned frames) override;
+
+private:
+    int fd_ = -1;
+    struct spi_ioc_transfer xfer_[MAX_FRAMES];
+
+    LinuxSpiBus(const LinuxSpiBus&) = delete;
+    LinuxSpiBus& operator=(const LinuxSpiBus&) = delete;
+};
+
+
+// 하드웨어 없이 MCP3208 응답을 흉내내는 mock
+// 채널별 값 + 결정적인 의사 난수 잡음(±noise_lsb)을 돌려주고 ioctl/frame 수를 센다.
+// frame 은 데이터시트 (Figure 6-1) 대로 bit 단위로 해석: 앞의 0 들 → start bit → SGL/DIFF, D2, D1, D0
+// → sample 1 clock → null bit → B11..B0 (MSB first). 그 전 출력은 hi-Z (1 로 읽힘).
+// start bit 가 없거나 차동 입력 (SGL=0) 이면 badFrames() 로 셈 → framing 이 틀리면 값이 달라지거나 잘림
+// 채널 값은 다른 스레드(시험 코드)에서 바꿔도 된다.
+class MockMcp3208Bus : public SpiBus {
+public:
+    MockMcp3208Bus();
+
+    void setChannelValue(unsigned channel, int raw) { value_[channel & 7].store(raw); }
+    void setNoise(int noise_lsb) { noise_lsb_ = noise_lsb; }
+
+    bool transferFrames(const uint8_t* tx, uint8_t* rx, unsigned frame_len, unsigned frames) override;
+
+    uint64_t ioctls() const { return ioctls_; }
+    uint64_t frames() const { return frames_; }
+    uint64_t badFrames() const { return bad_frames_; }
+
+private:
+    std::atomic<int> value_[8];
+    int      noise_lsb_ = 0;
+    uint32_t rng_ = 12345;
+    uint64_t ioctls_ = 0;
+    uint64_t frames_ = 0;
+    uint64_t bad_frames_ = 0;
+
+    void respond(const uint8_t* tx, uint8_t* rx, unsigned frame_len);
+};
+
+#endif
@@ -1,143 +1,214 @@
 #include "ultrasonic.hpp"
-#include <iostream>
+#include "../core/event_log.hpp"
 #include <algorithm>
 #include <cmath>
 
 
-Ultrasonic::Ultrasonic(int trig_pin, int echo_pin)
-    :trig_(trig_pin), echo_(echo_pin)
+namespace {
+
+// 앞에 아무것도 없으면 매 측정마다 timeout 이므로 같은 메시지는 1초에 한 번
+constexpr uint32_t RANGE_WARN_INTERVAL_MS = 1000;
+
+} // namespace
+
+
+Ultrasonic::Ultrasonic(int trig_pin, int echo_pin, EchoEdgeSource* edge_source, GpioPins* gpio, Clock* clock)
+    :trig_(trig_pin), echo_(echo_pin), edge_source_(edge_source), gpio_(gpio),
+     clock_(clock ? clock : &systemClock())
 {
-    pinMode(trig_, OUTPUT);
-    pinMode(echo_, INPUT);
-    digitalWrite(trig_, LOW);
+    // edge backend 가 핀을 직접 잡고 있는 경우 GPIO 를 건드리지 않는다.
+    if (edge_source_ == nullptr && gpio_ != nullptr) {
+        gpio_->setOutput(trig_);
+        gpio_->setInput(echo_);
+        gpio_->write(trig_, false);
+    }
 
     // v_rel 초기화
     vrel_min = 9999.0f;
     vrel_max = -9999.0f;
     vrel_avg = 0.0f;
-
-    for (int i = 0; i < VREL_WINDOW; i++)
-        vrel_buffer[i] = 0.0f;
-}
-
-float Ultrasonic::dtSeconds(unsigned long now, unsigned long prev)
-{
-    return (now - prev) / 1e6f;
 }
 
 
 float Ultrasonic::getDistance()
 {
-    unsigned long TX_time = 0, RX_time = 0;
+    if (edge_source_ != nullptr)
+        return getDistanceEdge();
+    if (gpio_ == nullptr)
+        return 0.0f;
+
+    uint64_t TX_time = 0, RX_time = 0;
     float distance = 0.0f;
-    const unsigned long timeout = 50000000; // 0.5 sec (약 171m)
-    unsigned long start_time = micros();  //측정 시작 순간
+    const uint64_t timeout = 40000;    // us, 40ms: 물체 없음 펄스(약 38ms) 포함 (ECHO_TIMEOUT_NS 와 같음)
 
 
     // Ensure trigger is LOW
-    digitalWrite(trig_, LOW);
-    delay(50);
+    gpio_->write(trig_, false);
+    clock_->sleepFor(50000000ull);
 
     // Send trigger pulse (10us)
-    digitalWrite(trig_, HIGH);  
-    delayMicroseconds(10);
-    digitalWrite(trig_, LOW);
+    gpio_->write(trig_, true);
+    clock_->sleepFor(10000ull);
+    gpio_->write(trig_, false);
+
+    // timeout 은 trigger 뒤부터 (앞의 50ms 대기를 넣으면 항상 timeout)
+    uint64_t start_time = clock_->nowUs();  //측정 시작 순간
 
     // Wait for ECHO to go HIGH (start of echo)
-    while (digitalRead(echo_) == LOW && (micros() - start_time) < timeout)
+    while (!gpio_->read(echo_))
     {
-        if (digitalRead(echo_) == HIGH)    //초음파 나감
-            break;
+        if (clock_->nowUs() - start_time > timeout)
+        {
+            LOG_WARN_EVERY(RANGE_WARN_INTERVAL_MS, "0. Out of range. micros={} start_time={}",
+                           clock_->nowUs(), start_time);
+            return 0.0f;
+        }
     }
 
-    // Timeout check
-    if ((micros() - start_time) > timeout)
+    TX_time = clock_->nowUs();   //초음파 나간 시점
+
+    // Wait for ECHO to go LOW (end of echo), 펄스 폭도 따로 40ms 까지
+    while (gpio_->read(echo_))
     {
-        std::cout << "0. Out of range. micros=" << micros()
-                  << " start_time=" << start_time << std::endl;
+        if (clock_->nowUs() - TX_time > timeout)
+        {
+            LOG_WARN_EVERY(RANGE_WARN_INTERVAL_MS, "1. Out of range.");
+            return 0.0f;
+        }
+    }
+
+    RX_time = clock_->nowUs();   //초음파 들어온 시점
+
+    // Calculate distance in cm
+    distance = static_cast<float>(RX_time - TX_time) * 0.017f;
+
+    return distance;
+}
+
+bool Ultrasonic::startPing()
+{
+    if (edge_source_ == nullptr)
         return false;
+
+    edge_source_->flush();      // 이전 ping 의 늦은 edge 제거
+    have_rise_     = false;
+    ping_start_ns_ = clock_->nowNs();
+    ping_active_   = edge_source_->trigger();
+    return ping_active_;
+}
+
+Ultrasonic::EchoStatus Ultrasonic::handleEdge(const EchoEdge& edge, float& distance_cm)
+{
+    if (edge.rising) {
+        rise_ns_   = edge.timestamp_ns;   //초음파 나간 시점
+        have_rise_ = true;
+        return EchoStatus::Pending;
     }
 
-    TX_time = micros();   //초음파 나간 시점
+    // rising 없이 들어온 falling 은 무시
+    if (!have_rise_)
+        return EchoStatus::Pending;
 
-    // Wait for ECHO to go LOW (end of echo)
-    while (digitalRead(echo_) == HIGH && (micros() - start_time) < timeout)
-    {
-        if (digitalRead(echo_) == LOW)   //초음파 들어옴
-            break;
+    //초음파 들어온 시점 - 나간 시점 (us) * 0.017 = cm
+    uint64_t width_ns = edge.timestamp_ns - rise_ns_;
+    distance_cm  = static_cast<float>(width_ns) * 0.000017f;
+    ping_active_ = false;
+    return EchoStatus::Ready;
+}
+
+Ultrasonic::EchoStatus Ultrasonic::pollEcho(float& distance_cm)
+{
+    if (!ping_active_)
+        return EchoStatus::Idle;
+
+    EchoEdge edge;
+    while (edge_source_->readEdge(edge)) {
+        if (handleEdge(edge, distance_cm) == EchoStatus::Ready)
+            return EchoStatus::Ready;
     }
 
-    // Timeout check
-    if ((micros() - start_time) > timeout)
-    {
-        std::cout << "1. Out of range." << std::endl;
-        return false;
+    if (clock_->nowNs() - ping_start_ns_ > ECHO_TIMEOUT_NS) {
+        ping_active_ = false;
+        distance_cm  = 0.0f;
+        return EchoStatus::Timeout;
     }
- 
-    RX_time = micros();   //초음파 들어온 시점
+    return EchoStatus::Pending;
+}
 
-    // Calculate distance in cm
-    distance = static_cast<float>(RX_time - TX_time) * 0.017f;
+float Ultrasonic::getDistanceEdge()
+{
+    if (!startPing())
+        return 0.0f;
 
-    return distance;
+    float distance = 0.0f;
+    while (true)
+    {
+        uint64_t elapsed = clock_->nowNs() - ping_start_ns_;
+        if (elapsed >= ECHO_TIMEOUT_NS) {
+            ping_active_ = false;
+            LOG_WARN_EVERY(RANGE_WARN_INTERVAL_MS, "Out of range (edge timeout).");
+            return 0.0f;
+        }
+
+        // busy-poll 대신 edge 가 올 때까지 잠듦
+        EchoEdge edge;
+        int remaining_us = static_cast<int>((ECHO_TIMEOUT_NS - elapsed) / 1000ull) + 1;
+        if (edge_source_->waitEdge(edge, remaining_us)
+            && handleEdge(edge, distance) == EchoStatus::Ready)
+            return distance;
+    }
 }
 
 float Ultrasonic::computeTTC(float distance_cm)
+{
+    return computeTTC(distance_cm, clock_->nowNs());
+}
+
+float Ultrasonic::computeTTC(float distance_cm, uint64_t t_ns)
 {
     if (distance_cm <= 0){
-        std::cout << "distance_cm <= 0" << std::endl;
-        return INFINITY;
-    }   
+        LOG_WARN_EVERY(RANGE_WARN_INTERVAL_MS, "distance_cm <= 0");
+        // 측정 실패: 잠깐은 예측으로 이어가고, 오래 실패하면 기존처럼 INF (짧은 TTC 가 남아 있지 않게)
+        if (!tracker_.initialized() || t_ns - tracker_.lastUpdateNs() > TTC_COAST_NS)
+            return INFINITY;
+        return tracker_.ttcAt(t_ns);
+    }
 
     float D_now = distance_cm / 100.0f;     //m 단위
-    unsigned long now = micros();
 
-    if (prev_distance_m < 0){
-        prev_distance_m = D_now;
-        prev_time_us = now;
-        std::cout << "prev_distance_m <= 0" << std::endl;
-        return INFINITY;
+    if (!tracker_.update(D_now, t_ns)) {
+        LOG_WARN_EVERY(RANGE_WARN_INTERVAL_MS, "outlier rejected: {} cm", distance_cm);
     }
 
-    float dt = dtSeconds(now, prev_time_us);
-    if (dt <= 0){
-        std::cout << "dt <= 0" << std::endl;
-        return INFINITY;
-    }       
-
-    float v_rel = (prev_distance_m - D_now) / dt;   //ms (접근속도)
-    // v_rel = std::max(0.0f, v_rel);
+    // ===== v_rel 통계 업데이트 (최근 VREL_WINDOW 개, O(1)) =====
+    float v_rel = tracker_.closingSpeed();   //m/s (접근속도)
+    vrel_window.push(v_rel);
+    vrel_avg = static_cast<float>(vrel_window.mean());
+    vrel_min = vrel_window.min();
+    vrel_max = vrel_window.max();
 
-    // ===== v_rel 통계 업데이트 =====
-    vrel_buffer[vrel_index] = v_rel;
-    vrel_index = (vrel_index + 1) % VREL_WINDOW;
+    return tracker_.ttc();
+}
 
-    float sum = 0;
-    for (int i = 0; i < VREL_WINDOW; i++)
-        sum += vrel_buffer[i];
 
-    vrel_avg = sum / VREL_WINDOW;
-    vrel_min = std::min(vrel_min, v_rel);
-    vrel_max = std::max(vrel_max, v_rel);
+constexpr uint64_t Ultrasonic::TTC_COAST_NS;
 
-    // 출력(테스트용)
-    // std::cout << "[Ultrasonic] v_rel=" << v_rel
-    //           << " | avg=" << vrel_avg
-    //           << " | min=" << vrel_min
-    //           << " | max=" << vrel_max << "\n";
-    // ==============================
 
-    
-    prev_distance_m = D_now;
-    prev_time_us = now;
-    std::cout << "v_rel: " << v_rel << "\n";
+// ================= UltrasonicRangeSource =================
 
-    if (v_rel <= 0.00001f){
-        std::cout << "v_rel <= 0.00001f" << std::endl;
-        return INFINITY;
-    }       
+bool UltrasonicRangeSource::poll(float& distance_cm, uint64_t& t_ns)
+{
+    if (!ultra_.hasEdgeSource()) {
+        distance_cm = ultra_.getDistance();
+        t_ns = ultra_.nowNs();
+        return true;
+    }
 
-    float TTC = D_now / v_rel;
+    Ultrasonic::EchoStatus st = ultra_.pollEcho(distance_cm);
+    if (st == Ultrasonic::EchoStatus::Pending)
+        return false;
 
-    return TTC;
+    t_ns = ultra_.lastPingTimeNs();   // 다음 ping 전에 측정 시각 보관
+    ultra_.startPing();
+    return st != Ultrasonic::EchoStatus::Idle;
 }
@@ -1,22 +1,50 @@
 #pragma once
-#include <wiringPi.h>
 #include <iostream>
 #include <cmath>
 #include <cstdlib>
 #include <cstdint>
 #include <unistd.h>
 #include <sys/types.h>
+#include "echo_source.hpp"
+#include "range_tracker.hpp"
+#include "../core/clock.hpp"
+#include "../core/hal.hpp"
+#include "../core/sliding_window.hpp"
 #ifndef ULTRASONIC_H
 #define ULTRASONIC_H
 
 
 class Ultrasonic{
 public:
-    Ultrasonic(int trig_pin, int echo_pin);
+    enum class EchoStatus { Idle, Pending, Ready, Timeout };
+
+    // edge_source 가 있으면 edge timestamp 로 측정, 없으면 gpio 로 기존 polling
+    // 둘 다 없으면 computeTTC() 만 쓰는 용도 (replay)
+    Ultrasonic(int trig_pin, int echo_pin, EchoEdgeSource* edge_source = nullptr,
+               GpioPins* gpio = nullptr, Clock* clock = nullptr);
 
     float getDistance();  //cm
+
+    // 비동기 측정: startPing() 후 pollEcho() 가 Ready 를 돌려줄 때 distance_cm 이 유효
+    // HC-SR04 는 ping 간격을 60ms 이상 두어야 이전 잔향을 받지 않는다. (호출자 책임)
+    bool startPing();
+    EchoStatus pollEcho(float& distance_cm);
+    bool hasEdgeSource() const { return edge_source_ != nullptr; }
+    uint64_t lastPingTimeNs() const { return ping_start_ns_; }   // 측정 시각으로 사용 (주입된 clock 기준)
+    uint64_t nowNs() const { return clock_->nowNs(); }
+
+    // 거리 측정을 RangeTracker 에 반영하고 필터 상태로 TTC(s) 계산
+    // 측정 실패 (distance_cm <= 0) 면 마지막 유효 측정 후 TTC_COAST_NS 까지는 예측값, 그 뒤로는 INFINITY
+    static constexpr uint64_t TTC_COAST_NS = 200000000ull;    // 200ms: 15Hz ping 3번 연속 실패
     float computeTTC(float distance_cm);
+    float computeTTC(float distance_cm, uint64_t t_ns);
 
+    float getTTCSigma() const    { return tracker_.ttcSigma(); }
+    float getConfidence() const  { return tracker_.confidence(); }
+    const RangeTracker& tracker() const { return tracker_; }
+
+    // 필터된 접근속도 (m/s) 와 최근 VREL_WINDOW 개에 대한 통계
+    float getVrel() const    { return tracker_.closingSpeed(); }
     float getVrelAvg() const { return vrel_avg; }
     float getVrelMin() const { return vrel_min; }
     float getVrelMax() const { return vrel_max; }
@@ -25,21 +53,42 @@ private:
     int trig_;
     int echo_;
 
-    float prev_distance_m = -1.0f;
-    unsigned long prev_time_us = 0;
+    EchoEdgeSource* edge_source_ = nullptr;
+    GpioPins*       gpio_        = nullptr;
+    Clock*          clock_;
+    static constexpr uint64_t ECHO_TIMEOUT_NS = 40000000ull;   // 40ms: 물체 없음 펄스(약 38ms) 포함
+
+    bool     ping_active_   = false;
+    bool     have_rise_     = false;
+    uint64_t ping_start_ns_ = 0;
+    uint64_t rise_ns_       = 0;
+
+    EchoStatus handleEdge(const EchoEdge& edge, float& distance_cm);
+    float getDistanceEdge();
 
-    float dtSeconds(unsigned long now, unsigned long prev);
+    RangeTracker tracker_;
 
     float vrel_min = 9999.0f;
     float vrel_max = -9999.0f;
     float vrel_avg = 0.0f;
 
     static constexpr int VREL_WINDOW = 10;
-    float vrel_buffer[VREL_WINDOW] = {0};
-    int vrel_index = 0;
+    SlidingWindow<float, VREL_WINDOW> vrel_window;
 
 };
 
 
+// Ultrasonic 을 제어 루프의 RangeSource 로 사용 (scheduler task 에서 주기적으로 poll)
+// edge backend 면 이전 ping 결과를 수집한 뒤 다음 ping 을 시작하고 (blocking 없음),
+// 아니면 기존 blocking 측정을 한다.
+class UltrasonicRangeSource : public RangeSource {
+public:
+    explicit UltrasonicRangeSource(Ultrasonic& ultra) : ultra_(ultra) {}
+
+    bool poll(float& distance_cm, uint64_t& t_ns) override;
+
+private:
+    Ultrasonic& ultra_;
+};
 
 #endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "ultrasonic_sampler.hpp"
+#include "../core/thread_affinity.hpp"
+#include <cstring>
+#include <iostream>
+
+
+UltrasonicSampler::UltrasonicSampler(Ultrasonic& ultra)
+    : UltrasonicSampler(ultra, Config())
+{
+}
+
+UltrasonicSampler::UltrasonicSampler(Ultrasonic& ultra, const Config& config, Clock* clock)
+    : ultra_(ultra), cfg_(config), clock_(clock ? clock : &systemClock())
+{
+    memset(&cur_, 0, sizeof(cur_));
+}
+
+UltrasonicSampler::~UltrasonicSampler()
+{
+    stop();
+}
+
+bool UltrasonicSampler::start()
+{
+    if (running_)
+        return true;
+
+    running_ = true;
+    thread_ = std::thread(&UltrasonicSampler::loop, this);
+    if (!pinThread(thread_, cfg_.cpu))
+        std::cerr << "ultrasonic sampler: cannot pin to cpu " << cfg_.cpu << std::endl;
+    if (!setThreadFifo(thread_, cfg_.rt_priority))
+        std::cerr << "ultrasonic sampler: cannot set SCHED_FIFO " << cfg_.rt_priority << std::endl;
+    return true;
+}
+
+void UltrasonicSampler::stop()
+{
+    running_ = false;
+    if (thread_.joinable())
+        thread_.join();
+}
+
+void UltrasonicSampler::step()
+{
+    float distance = ultra_.getDistance();
+    // edge 측정은 ping 시작 시각, polling 은 시작 시각을 모르므로 끝난 시각 (기존 UltrasonicRangeSource 와 같음)
+    // 둘 다 Ultrasonic 에 주입된 clock 기준
+    cur_.timestamp_ns = ultra_.hasEdgeSource() ? ultra_.lastPingTimeNs() : ultra_.nowNs();
+    cur_.sample_count++;
+    cur_.distance_cm = distance;
+    if (distance <= 0.0f)
+        cur_.timeouts++;
+    state_.write(cur_);
+}
+
+bool UltrasonicSampler::poll(float& distance_cm, uint64_t& t_ns)
+{
+    RangeSample s = state_.read();
+    if (s.sample_count == consumed_)
+        return false;
+    consumed_ = s.sample_count;
+    distance_cm = s.distance_cm;
+    t_ns = s.timestamp_ns;
+    return true;
+}
+
+void UltrasonicSampler::loop()
+{
+    const uint64_t period_ns = static_cast<uint64_t>(1e9 / cfg_.rate_hz);
+    uint64_t next = clock_->nowNs();
+
+    while (running_) {
+        step();
+
+        next += period_ns;
+        uint64_t now = clock_->nowNs();
+        if (now > next)
+            next = now;     // 측정이 주기보다 길었으면 바로 다음 측정
+        clock_->sleepUntil(next);
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef ULTRASONIC_SAMPLER_HPP
+#define ULTRASONIC_SAMPLER_HPP
+
+#include "ultrasonic.hpp"
+#include "../core/clock.hpp"
+#include "../core/hal.hpp"
+#include "../core/seqlock.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// 초음파 최신 측정. 제어 쪽은 UltrasonicSampler::latest() / poll() 로 읽는다.
+struct RangeSample {
+    uint64_t timestamp_ns;    // 측정 시각 (Ultrasonic 의 clock, edge: ping 시작 / polling: 측정 끝)
+    uint64_t sample_count;
+    float    distance_cm;     // 0: echo 없음 (timeout)
+    uint32_t timeouts;        // 지금까지 echo 가 없던 측정 수
+};
+
+// 전용 스레드에서 초음파를 측정하고 최신값을 seqlock slot 에 씀
+// - echo 를 기다리는 동안 (polling 은 50ms 이상) 잠드는 것은 이 스레드뿐, 제어 루프는 최신값만 읽음
+// - 절대 시각 기준 주기 (Clock::sleepUntil), 측정이 주기보다 길면 끝나자마자 다음 측정
+// - cpu 를 지정하면 그 core 에 고정
+class UltrasonicSampler : public RangeSource {
+public:
+    struct Config {
+        double rate_hz = 15.0;   // 66ms: HC-SR04 ping 간격 60ms 이상 (edge 측정은 echo timeout 40ms 뒤 잠듦)
+        int    cpu     = -1;     // 고정할 core (-1: 고정 안 함)
+        int    rt_priority = 0;  // SCHED_FIFO 우선순위 (0: 일반 스케줄링)
+    };
+
+    explicit UltrasonicSampler(Ultrasonic& ultra);
+    UltrasonicSampler(Ultrasonic& ultra, const Config& config, Clock* clock = nullptr);
+    ~UltrasonicSampler();
+
+    bool start();
+    void stop();
+
+    RangeSample latest() const { return state_.read(); }
+
+    // 지난 poll 이후 새 측정이 있으면 true (제어 스레드 하나에서만 호출)
+    bool poll(float& distance_cm, uint64_t& t_ns) override;
+
+    // 측정 한 번 (스레드 루프에서 호출, echo 가 올 때까지 block)
+    void step();
+
+private:
+    Ultrasonic& ultra_;
+    Config cfg_;
+    Clock* clock_;
+
+    Seqlock<RangeSample> state_;
+    RangeSample cur_;                 // 측정 스레드 전용
+    uint64_t consumed_ = 0;           // poll 이 마지막으로 넘긴 sample_count
+
+    std::thread thread_;
+    std::atomic<bool> running_{false};
+
+    void loop();
+};
+
+#endif
@@ -0,0 +1,93 @@
+#include "wiringpi_gpio.hpp"
+#include "../core/mono_clock.hpp"
+#include <wiringPi.h>
+#include <iostream>
+
+
+// ================= WiringPiGpio =================
+
+void WiringPiGpio::setOutput(int pin)
+{
+    pinMode(pin, OUTPUT);
+}
+
+void WiringPiGpio::setInput(int pin)
+{
+    pinMode(pin, INPUT);
+}
+
+void WiringPiGpio::write(int pin, bool high)
+{
+    digitalWrite(pin, high ? HIGH : LOW);
+}
+
+bool WiringPiGpio::read(int pin)
+{
+    return digitalRead(pin) == HIGH;
+}
+
+
+// ================= WiringPiIsrEdgeSource =================
+
+WiringPiIsrEdgeSource* WiringPiIsrEdgeSource::instance_ = nullptr;
+
+WiringPiIsrEdgeSource::WiringPiIsrEdgeSource(int trig_pin, int echo_pin)
+    : trig_(trig_pin), echo_(echo_pin)
+{
+    if (instance_ != nullptr) {
+        std::cerr << "WiringPiIsrEdgeSource: only one instance allowed" << std::endl;
+        return;
+    }
+
+    pinMode(trig_, OUTPUT);
+    pinMode(echo_, INPUT);
+    digitalWrite(trig_, LOW);
+
+    instance_ = this;
+    if (wiringPiISR(echo_, INT_EDGE_BOTH, &WiringPiIsrEdgeSource::onEdge) < 0) {
+        std::cerr << "wiringPiISR setup failed on pin " << echo_ << std::endl;
+        instance_ = nullptr;
+        return;
+    }
+    ok_ = true;
+}
+
+WiringPiIsrEdgeSource::~WiringPiIsrEdgeSource()
+{
+    // wiringPi 에는 ISR 해제 API 가 없으므로 콜백만 무시하게 만든다.
+    if (instance_ == this)
+        instance_ = nullptr;
+}
+
+void WiringPiIsrEdgeSource::onEdge()
+{
+    // wiringPi ISR 스레드에서 호출됨: 가능한 빨리 시각부터 찍는다.
+    uint64_t now = monoNowNs();
+    WiringPiIsrEdgeSource* self = instance_;
+    if (self == nullptr)
+        return;
+
+    EchoEdge edge;
+    edge.rising       = self->next_rising_.load(std::memory_order_relaxed);
+    edge.timestamp_ns = now;
+    self->next_rising_.store(!edge.rising, std::memory_order_relaxed);
+    self->queue_.push(edge);
+}
+
+bool WiringPiIsrEdgeSource::trigger()
+{
+    if (!ok_)
+        return false;
+
+    // 이전 ping 의 edge 는 startPing() 에서 버렸으므로 이번 ping 의 첫 edge 는 rising
+    next_rising_.store(true, std::memory_order_relaxed);
+    digitalWrite(trig_, HIGH);
+    delayMicroseconds(10);
+    digitalWrite(trig_, LOW);
+    return true;
+}
+
+bool WiringPiIsrEdgeSource::readEdge(EchoEdge& edge)
+{
+    return queue_.pop(edge);
+}
@@ -0,0 +1,48 @@
+#ifndef WIRINGPI_GPIO_HPP
+#define WIRINGPI_GPIO_HPP
+
+#include "echo_source.hpp"
+#include "../core/hal.hpp"
+#include <atomic>
+
+// wiringPi 에 의존하는 구현은 이 파일(과 buzzer)에만 둔다.
+// 나머지 sensors/core 코드는 wiringPi 없이 빌드되므로 replay 를 일반 Linux 에서 돌릴 수 있다.
+
+// wiringPi 핀 번호 기반 GpioPins (wiringPiSetup() 이후 사용)
+class WiringPiGpio : public GpioPins {
+public:
+    void setOutput(int pin) override;
+    void setInput(int pin) override;
+    void write(int pin, bool high) override;
+    bool read(int pin) override;
+};
+
+
+// wiringPiISR 기반 backend (gpiochip 을 쓸 수 없는 커널용)
+// wiringPi ISR 콜백은 인자가 없으므로 인스턴스는 하나만 만들 수 있다.
+// wiringPi 는 핀 하나에 edge 모드 하나만 등록되므로 (rising / falling 콜백을 따로 둘 수 없음)
+// 방향은 ISR 에서 digitalRead 로 읽지 않고 (짧은 echo 면 이미 다음 level) trigger() 이후 edge 순서로 정함:
+// TRIG 직후 ECHO 는 LOW 이므로 rising, falling 이 번갈아 옴
+// 핀 번호는 wiringPi 번호
+class WiringPiIsrEdgeSource : public EchoEdgeSource {
+public:
+    WiringPiIsrEdgeSource(int trig_pin, int echo_pin);
+    ~WiringPiIsrEdgeSource();
+
+    bool isOpen() const { return ok_; }
+
+    bool trigger() override;
+    bool readEdge(EchoEdge& edge) override;
+
+private:
+    int  trig_;
+    int  echo_;
+    bool ok_ = false;
+    EdgeQueue queue_;
+    std::atomic<bool> next_rising_{true};   // ISR 스레드만 뒤집고, trigger() 가 ping 마다 되돌림
+
+    static WiringPiIsrEdgeSource* instance_;
+    static void onEdge();
+};
+
+#endif
@@ -0,0 +1,163 @@
+// BuzzerSequencer: 밀려난 pattern 이어 울리기, cancel(priority) 가 그 pattern 만 끄는지
+// SimClock 을 1ms 씩 옮기며 step() 을 직접 부르고 SimTone 의 on / off 시각으로 확인
+#include "check.hpp"
+#include "../control/sim_devices.hpp"
+#include "../core/clock.hpp"
+#include "../sensors/buzzer_sequencer.hpp"
+
+namespace {
+
+constexpr uint64_t MS = 1000000ull;
+
+// mispedal_controller 의 경고음과 같은 모양
+const BeepPattern LOCKOUT = { 440, 200, 100, 10, 2 };   // 3초
+const BeepPattern BRAKE   = { 880, 100, 50, 3, 3 };     // 450ms
+
+struct Rig {
+    SimClock clock;
+    SimTone tone;
+    BuzzerSequencer seq;
+
+    Rig() : clock(0), tone(clock), seq(tone, BuzzerSequencer::Config(), &clock) {}
+
+    // t_ms 까지 1ms 씩
+    void runTo(uint64_t t_ms)
+    {
+        while (clock.nowNs() < t_ms * MS) {
+            seq.step(clock.nowNs());
+            clock.advance(MS);
+        }
+        seq.step(clock.nowNs());
+    }
+
+    int hzAt(uint64_t t_ms) const
+    {
+        int hz = 0;
+        for (size_t i = 0; i < tone.edges.size() && tone.edges[i].t_ns <= t_ms * MS; i++)
+            hz = tone.edges[i].hz;
+        return hz;
+    }
+
+    // hz 로 바뀐 횟수 (선점은 off 없이 바로 바뀌므로 SimTone::beeps() 대신 주파수별로 셈)
+    int starts(int hz) const
+    {
+        int n = 0;
+        for (size_t i = 0; i < tone.edges.size(); i++)
+            n += tone.edges[i].hz == hz;
+        return n;
+    }
+};
+
+// 잠금 경고 도중 급제동 경고 → 급제동이 끝나면 잠금 경고가 남은 횟수만큼 이어서
+void testResumeAfterPreempt()
+{
+    Rig rig;
+    rig.seq.play(LOCKOUT);
+    rig.runTo(350);                 // 두 번째 on (300..500) 중
+    rig.seq.play(BRAKE);
+    rig.runTo(4000);
+
+    CHECK(rig.hzAt(360) == 880);
+    CHECK(rig.hzAt(790) == 0);      // 급제동 마지막 off (750..800)
+    CHECK(rig.hzAt(810) == 440);    // 800 에서 잠금 경고 재개
+    // 잠금 2 (선점 전) + 나머지 9, 급제동 3
+    CHECK(rig.starts(440) == 2 + 9);
+    CHECK(rig.starts(880) == 3);
+    CHECK(rig.hzAt(800 + 9 * 300) == 0);
+    CHECK(!rig.seq.playing());
+}
+
+// 잠금 해제 (cancel 잠금 priority) 는 울리는 중인 급제동 경고를 끊지 않고, 밀려난 잠금 경고만 없앰
+void testCancelKeepsHigherPattern()
+{
+    Rig rig;
+    rig.seq.play(LOCKOUT);
+    rig.runTo(350);
+    rig.seq.play(BRAKE);
+    rig.runTo(500);
+    rig.seq.cancel(LOCKOUT.priority);
+    rig.runTo(2000);
+
+    CHECK(rig.hzAt(510) == 880);
+    CHECK(rig.hzAt(710) == 880);    // 세 번째 급제동 on (600..700) 다음, 700..750 off
+    CHECK(rig.hzAt(760) == 0);
+    CHECK(rig.hzAt(1000) == 0);     // 잠금 경고는 이어지지 않음
+    CHECK(rig.starts(440) == 2);
+    CHECK(rig.starts(880) == 3);
+}
+
+// 잠금 경고만 울릴 때 cancel → 바로 끔, 다른 priority 의 cancel 은 영향 없음
+void testCancelCurrent()
+{
+    Rig rig;
+    rig.seq.play(LOCKOUT);
+    rig.runTo(100);
+    rig.seq.cancel(BRAKE.priority);
+    rig.runTo(150);
+    CHECK(rig.hzAt(150) == 440);
+    rig.seq.cancel(LOCKOUT.priority);
+    rig.runTo(151);
+    CHECK(rig.hzAt(151) == 0);
+    CHECK(!rig.seq.playing());
+}
+
+// 한 번 반영되기 전에 잠금 + 급제동을 같이 요청 → 급제동 먼저, 그 뒤 잠금 (처음부터)
+void testSameCycleRequests()
+{
+    Rig rig;
+    rig.seq.play(LOCKOUT);
+    rig.seq.play(BRAKE);
+    rig.runTo(4000);
+
+    CHECK(rig.hzAt(0) == 880);
+    CHECK(rig.hzAt(460) == 440);
+    CHECK(rig.starts(880) == 3);
+    CHECK(rig.starts(440) == 10);
+}
+
+// stop() 은 밀려난 것까지 모두
+void testStopClearsAll()
+{
+    Rig rig;
+    rig.seq.play(LOCKOUT);
+    rig.runTo(100);
+    rig.seq.play(BRAKE);
+    rig.runTo(200);
+    rig.seq.stop();
+    rig.runTo(2000);
+
+    CHECK(rig.hzAt(201) == 0);
+    CHECK(rig.starts(440) == 1);
+    CHECK(rig.starts(880) == 1);
+    CHECK(!rig.seq.playing());
+}
+
+// 길이 0 인 pattern 은 받지 않음 (step() 이 한 시각에서 멈추지 않고 돌던 것), 다른 경고를 막지도 않음
+void testZeroLengthPatternRejected()
+{
+    Rig rig;
+    const BeepPattern empty = { 1000, 0, 0, 0, 5 };
+    rig.seq.play(empty);
+    rig.runTo(10);
+    CHECK(!rig.seq.playing());
+    CHECK(rig.tone.edges.empty());
+
+    rig.seq.play(LOCKOUT);
+    rig.seq.play(empty);
+    rig.runTo(100);
+    CHECK(rig.hzAt(100) == 440);
+    CHECK(rig.starts(1000) == 0);
+}
+
+} // namespace
+
+int main()
+{
+    testResumeAfterPreempt();
+    testCancelKeepsHigherPattern();
+    testCancelCurrent();
+    testSameCycleRequests();
+    testStopClearsAll();
+    testZeroLengthPatternRejected();
+    return CHECK_RESULT();
+}
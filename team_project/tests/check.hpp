@@ -0,0 +1,38 @@
+#ifndef TESTS_CHECK_HPP
+#define TESTS_CHECK_HPP
+
+#include <cmath>
+#include <cstdio>
+
+// 테스트 실행 파일 공용: 실패한 조건을 출력하고 수만 셈, main 은 CHECK_RESULT() 로 끝냄
+// (외부 테스트 framework 없이 ctest 로 실행)
+namespace check {
+
+inline int& failures()
+{
+    static int n = 0;
+    return n;
+}
+
+inline void fail(const char* file, int line, const char* expr)
+{
+    std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", file, line, expr);
+    failures()++;
+}
+
+} // namespace check
+
+#define CHECK(cond)                                                  \
+    do {                                                             \
+        if (!(cond))                                                 \
+            check::fail(__FILE__, __LINE__, #cond);                  \
+    } while (0)
+
+#define CHECK_NEAR(a, b, tol) CHECK(std::fabs(static_cast<double>(a) - static_cast<double>(b)) <= (tol))
+
+#define CHECK_RESULT()                                               \
+    (check::failures() == 0                                          \
+        ? (std::fprintf(stderr, "ok\n"), 0)                          \
+        : (std::fprintf(stderr, "%d check(s) failed\n", check::failures()), 1))
+
+#endif
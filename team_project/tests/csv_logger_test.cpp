@@ -0,0 +1,115 @@
+// CsvLogger: 쓰기 실패 (파일 크기 제한 → EFBIG) 때 행을 조용히 잃지 않고 dropped 로 세는지
+#include "check.hpp"
+#include "../core/csv_logger.hpp"
+#include <csignal>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <sys/resource.h>
+#include <unistd.h>
+
+namespace {
+
+LogRecord makeRecord(int i)
+{
+    LogRecord rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.distance_cm = 100.0f + i;
+    rec.ttc         = 1.5f;
+    rec.scenario    = i;
+    return rec;
+}
+
+std::string tempPath(const char* tag)
+{
+    char path[128];
+    snprintf(path, sizeof(path), "/tmp/csv_logger_test_%s_%d.csv", tag, static_cast<int>(getpid()));
+    return path;
+}
+
+size_t countLines(const std::string& path)
+{
+    FILE* fp = fopen(path.c_str(), "r");
+    if (fp == nullptr)
+        return 0;
+    size_t lines = 0;
+    int c;
+    while ((c = fgetc(fp)) != EOF)
+        if (c == '\n')
+            lines++;
+    fclose(fp);
+    return lines;
+}
+
+void testAllRowsWritten()
+{
+    std::string path = tempPath("ok");
+    {
+        CsvLogger logger;
+        CHECK(logger.open(path));
+        for (int i = 0; i < 500; i++)
+            CHECK(logger.log(makeRecord(i)));
+        logger.close();
+        CHECK(!logger.failed());
+        CHECK(logger.written() == 500);
+        CHECK(logger.dropped() == 0);
+    }
+    CHECK(countLines(path) == 501);     // header + 500
+    unlink(path.c_str());
+}
+
+// 파일이 RLIMIT_FSIZE 를 넘으면 write() 가 EFBIG: 쓴 행 + 버린 행 = 넣은 행, 이후 쓰기 중단
+void testWriteFailureCounted()
+{
+    std::string path = tempPath("full");
+    signal(SIGXFSZ, SIG_IGN);
+
+    struct rlimit old_limit;
+    getrlimit(RLIMIT_FSIZE, &old_limit);
+    struct rlimit limit = old_limit;
+    limit.rlim_cur = 4096;
+    CHECK(setrlimit(RLIMIT_FSIZE, &limit) == 0);
+
+    const uint64_t rows = 2000;
+    uint64_t accepted = 0;
+    {
+        CsvLogger::Policy policy;
+        policy.poll_interval_ms = 1;
+        CsvLogger logger;
+        CHECK(logger.open(path, policy));
+        for (uint64_t i = 0; i < rows; i++) {
+            if (logger.log(makeRecord(static_cast<int>(i))))
+                accepted++;
+            if (i % 100 == 0)
+                usleep(2000);
+        }
+        logger.close();
+
+        CHECK(logger.failed());
+        CHECK(logger.dropped() > 0);
+        CHECK(logger.written() + logger.dropped() == rows);
+        CHECK(logger.written() < rows);
+        // 실패한 버퍼는 앞부분이 들어갔을 수 있지만 전부 dropped 로 셈 (파일 행 수 <= 넣은 행 + header)
+        CHECK(countLines(path) <= rows + 1);
+    }
+    CHECK(accepted <= rows);
+
+    setrlimit(RLIMIT_FSIZE, &old_limit);
+    unlink(path.c_str());
+}
+
+void testOpenFailsWhenHeaderCannotBeWritten()
+{
+    CsvLogger logger;
+    CHECK(!logger.open("/dev/full"));
+}
+
+} // namespace
+
+int main()
+{
+    testAllRowsWritten();
+    testWriteFailureCounted();
+    testOpenFailsWhenHeaderCannotBeWritten();
+    return CHECK_RESULT();
+}
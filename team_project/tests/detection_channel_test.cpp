@@ -0,0 +1,162 @@
+// 검출 채널: 소비자가 열 때 남은 이벤트를 버리는지, poll() 이 오래된 이벤트를 건너뛰는지,
+// 두 스레드로 동시에 넣고 빼도 순서대로 빠짐없이 오는지, 초기화하다 죽은 segment 에서 멈추지 않는지
+#include "check.hpp"
+#include "../core/detection_channel.hpp"
+#include "../core/mono_clock.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <thread>
+
+namespace {
+
+DetectionEvent makeEvent(uint32_t cls, uint64_t timestamp_ns)
+{
+    DetectionEvent ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.cls          = cls;
+    ev.timestamp_ns = timestamp_ns;
+    return ev;
+}
+
+// 이전 실행의 생산자가 남긴 이벤트는 새 소비자에게 보이지 않음
+void testConsumerDiscardsLeftovers(const char* name)
+{
+    DetectionChannel producer;
+    CHECK(producer.open(name, DetectionChannel::PRODUCER));
+    for (int i = 0; i < 5; i++) {
+        DetectionEvent ev = makeEvent(DET_BRAKE, monoNowNs());
+        CHECK(producer.publish(ev));
+    }
+
+    DetectionChannel consumer;
+    CHECK(consumer.open(name, DetectionChannel::CONSUMER));
+    CHECK(consumer.size() == 0);
+    CHECK(consumer.stale() == 5);
+
+    DetectionEvent out;
+    CHECK(!consumer.poll(out));
+
+    DetectionEvent ev = makeEvent(DET_ACCEL, monoNowNs());
+    CHECK(producer.publish(ev));
+    CHECK(consumer.poll(out));
+    CHECK(out.cls == DET_ACCEL);
+}
+
+// max_age 보다 오래된 이벤트는 버리고 다음 것을 돌려줌
+void testPollDropsStale(const char* name)
+{
+    DetectionChannel producer;
+    DetectionChannel consumer;
+    CHECK(consumer.open(name, DetectionChannel::CONSUMER));
+    CHECK(producer.open(name));
+
+    uint64_t now = monoNowNs();
+    DetectionEvent old1 = makeEvent(DET_BRAKE, now - 2000000000ull);
+    DetectionEvent old2 = makeEvent(DET_BRAKE, now - DetectionChannel::DEFAULT_MAX_AGE_NS - 1000000ull);
+    DetectionEvent fresh = makeEvent(DET_ACCEL, now);
+    CHECK(producer.publish(old1));
+    CHECK(producer.publish(old2));
+    CHECK(producer.publish(fresh));
+
+    DetectionEvent out;
+    CHECK(consumer.poll(out));
+    CHECK(out.cls == DET_ACCEL);
+    CHECK(consumer.stale() == 2);
+    CHECK(!consumer.poll(out));
+
+    // 기준을 바꾸면 같은 나이도 통과
+    consumer.setMaxAgeNs(5000000000ull);
+    DetectionEvent old3 = makeEvent(DET_BRAKE, monoNowNs() - 1000000000ull);
+    CHECK(producer.publish(old3));
+    CHECK(consumer.poll(out));
+    CHECK(out.cls == DET_BRAKE);
+}
+
+// 생산자 스레드가 가득 차면 다시 시도하며 N 개를 넣고, 소비자 스레드가 tryPop 으로 빼며 seq 순서 확인
+void testTwoThreads(const char* name)
+{
+    const uint64_t N = 20000;
+    DetectionChannel producer;
+    DetectionChannel consumer;
+    CHECK(consumer.open(name, DetectionChannel::CONSUMER));
+    CHECK(producer.open(name));
+
+    uint64_t first_seq = 0, received = 0, out_of_order = 0, bad_payload = 0;
+    std::thread reader([&]() {
+        DetectionEvent ev;
+        uint64_t deadline = monoNowNs() + 10000000000ull;
+        while (received < N && monoNowNs() < deadline) {
+            if (!consumer.tryPop(ev)) {
+                std::this_thread::yield();      // core 가 하나뿐이어도 생산자가 돌게
+                continue;
+            }
+            if (received == 0)
+                first_seq = ev.seq;
+            else if (ev.seq != first_seq + received)
+                out_of_order++;
+            if (ev.label != static_cast<uint32_t>(ev.seq - first_seq))
+                bad_payload++;
+            received++;
+        }
+    });
+
+    uint64_t deadline = monoNowNs() + 10000000000ull;
+    for (uint64_t i = 0; i < N && monoNowNs() < deadline; i++) {
+        DetectionEvent ev = makeEvent(DET_ACCEL, monoNowNs());
+        ev.label = static_cast<uint32_t>(i);
+        while (!producer.publish(ev) && monoNowNs() < deadline)
+            std::this_thread::yield();
+    }
+    reader.join();
+
+    CHECK(received == N);
+    CHECK(out_of_order == 0);
+    CHECK(bad_payload == 0);
+    CHECK(consumer.size() == 0);
+}
+
+// 만든 프로세스가 초기화 도중 죽어 INIT_BUSY 로 남은 segment: 기다리다 실패로 돌아와야 함
+void testStuckInit(const char* name)
+{
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    CHECK(fd >= 0);
+    if (fd < 0)
+        return;
+    CHECK(ftruncate(fd, 4096) == 0);
+    uint32_t busy = 1;      // INIT_BUSY (Shared 의 첫 필드)
+    CHECK(pwrite(fd, &busy, sizeof(busy), 0) == static_cast<ssize_t>(sizeof(busy)));
+    close(fd);
+
+    DetectionChannel ch;
+    uint64_t t0 = monoNowNs();
+    CHECK(!ch.open(name, DetectionChannel::CONSUMER));
+    uint64_t waited_ms = (monoNowNs() - t0) / 1000000;
+    CHECK(waited_ms >= static_cast<uint64_t>(DetectionChannel::INIT_TIMEOUT_MS));
+    CHECK(waited_ms < static_cast<uint64_t>(DetectionChannel::INIT_TIMEOUT_MS) + 1000);
+    CHECK(!ch.isOpen());
+}
+
+} // namespace
+
+int main()
+{
+    char name1[64], name2[64], name3[64], name4[64];
+    snprintf(name1, sizeof(name1), "/mispedal_test_leftover_%d", static_cast<int>(getpid()));
+    snprintf(name2, sizeof(name2), "/mispedal_test_stale_%d", static_cast<int>(getpid()));
+    snprintf(name3, sizeof(name3), "/mispedal_test_threads_%d", static_cast<int>(getpid()));
+    snprintf(name4, sizeof(name4), "/mispedal_test_stuck_%d", static_cast<int>(getpid()));
+
+    testConsumerDiscardsLeftovers(name1);
+    testPollDropsStale(name2);
+    testTwoThreads(name3);
+    testStuckInit(name4);
+
+    shm_unlink(name1);
+    shm_unlink(name2);
+    shm_unlink(name3);
+    shm_unlink(name4);
+    return CHECK_RESULT();
+}
@@ -0,0 +1,217 @@
+// 하드웨어 없이 가상 핀 (SimulatedEdgeSource) 으로 Ultrasonic 의 edge 측정 경로 확인,
+// /dev/gpiochip0 을 못 열 때 쓰는 gpio polling 경로는 SimClock + 가상 GpioPins 로
+#include "check.hpp"
+#include "../sensors/echo_source.hpp"
+#include "../sensors/ultrasonic.hpp"
+#include "../core/clock.hpp"
+#include "../core/mono_clock.hpp"
+
+namespace {
+
+constexpr int TRIG = 4;
+constexpr int ECHO = 5;
+
+// HC-SR04 처럼: TRIG 가 내려간 뒤 450us 에 ECHO HIGH, 거리만큼 HIGH 유지
+// read() 한 번에 가상 시간 1us (polling loop 가 SimClock 위에서도 끝나도록)
+class SimGpio : public GpioPins {
+public:
+    explicit SimGpio(SimClock& clock) : clock_(clock) {}
+
+    void setDistance(float cm)  { distance_cm_ = cm; }
+    void setDropEcho(bool drop) { drop_ = drop; }
+    void setStuckHigh(bool on)  { stuck_high_ = on; }
+    int  triggers() const       { return triggers_; }
+
+    void setOutput(int) override {}
+    void setInput(int) override {}
+    void write(int pin, bool high) override
+    {
+        if (pin != TRIG)
+            return;
+        if (trig_high_ && !high) {
+            triggers_++;
+            rise_ns_ = clock_.nowNs() + 450000ull;
+            fall_ns_ = rise_ns_ + static_cast<uint64_t>(distance_cm_ / 0.017f * 1000.0f);
+        }
+        trig_high_ = high;
+    }
+    bool read(int pin) override
+    {
+        clock_.advance(1000);
+        if (pin != ECHO || triggers_ == 0 || drop_)
+            return false;
+        uint64_t now = clock_.nowNs();
+        return now >= rise_ns_ && (stuck_high_ || now < fall_ns_);
+    }
+
+private:
+    SimClock& clock_;
+    float    distance_cm_ = 100.0f;
+    bool     drop_        = false;
+    bool     stuck_high_  = false;
+    bool     trig_high_   = false;
+    int      triggers_    = 0;
+    uint64_t rise_ns_ = 0, fall_ns_ = 0;
+};
+
+void testEdgeQueue()
+{
+    EdgeQueue q;
+    EchoEdge e;
+    CHECK(!q.pop(e));
+
+    for (uint32_t i = 0; i < EdgeQueue::CAPACITY; i++) {
+        e.rising       = (i % 2 == 0);
+        e.timestamp_ns = i;
+        CHECK(q.push(e));
+    }
+    CHECK(!q.push(e));      // 가득 참 → 버림
+
+    for (uint32_t i = 0; i < EdgeQueue::CAPACITY; i++) {
+        CHECK(q.pop(e));
+        CHECK(e.timestamp_ns == i);
+        CHECK(e.rising == (i % 2 == 0));
+    }
+    CHECK(!q.pop(e));
+}
+
+// startPing / pollEcho: 거리별 펄스 폭 → cm
+void testAsyncPing()
+{
+    const float distances[] = { 5.0f, 30.0f, 100.0f, 250.0f };
+    for (float d : distances) {
+        SimulatedEdgeSource pin;
+        pin.setDistance(d);
+        Ultrasonic ultra(0, 0, &pin);
+
+        CHECK(ultra.startPing());
+        float cm = -1.0f;
+        Ultrasonic::EchoStatus st = Ultrasonic::EchoStatus::Pending;
+        while (st == Ultrasonic::EchoStatus::Pending)
+            st = ultra.pollEcho(cm);
+
+        CHECK(st == Ultrasonic::EchoStatus::Ready);
+        CHECK_NEAR(cm, d, 0.01 * d);
+        CHECK(ultra.pollEcho(cm) == Ultrasonic::EchoStatus::Idle);
+        CHECK(pin.triggerCount() == 1);
+    }
+}
+
+// getDistance(): edge backend 면 waitEdge 로 잠들며 기다림
+void testBlockingDistance()
+{
+    SimulatedEdgeSource pin;
+    pin.setDistance(42.0f);
+    Ultrasonic ultra(0, 0, &pin);
+    CHECK_NEAR(ultra.getDistance(), 42.0f, 0.5);
+}
+
+// echo 가 없으면 40ms 뒤 Timeout, 거리 0
+void testDroppedEcho()
+{
+    SimulatedEdgeSource pin;
+    pin.setDropEcho(true);
+    Ultrasonic ultra(0, 0, &pin);
+
+    uint64_t t0 = monoNowNs();
+    CHECK(ultra.startPing());
+    float cm = -1.0f;
+    Ultrasonic::EchoStatus st = Ultrasonic::EchoStatus::Pending;
+    while (st == Ultrasonic::EchoStatus::Pending)
+        st = ultra.pollEcho(cm);
+    uint64_t waited_ms = (monoNowNs() - t0) / 1000000ull;
+
+    CHECK(st == Ultrasonic::EchoStatus::Timeout);
+    CHECK(cm == 0.0f);
+    CHECK(waited_ms >= 40 && waited_ms < 200);
+
+    CHECK(ultra.getDistance() == 0.0f);
+}
+
+// 가상 핀: trigger 후 echo 지연만큼 지나 rising, 펄스 폭 뒤 falling
+void testEdgeOrder()
+{
+    SimulatedEdgeSource pin;
+    pin.setDistance(80.0f);
+    Ultrasonic ultra(0, 0, &pin);
+    CHECK(ultra.startPing());
+
+    EchoEdge rise, fall;
+    while (!pin.readEdge(rise)) {}
+    while (!pin.readEdge(fall)) {}
+    CHECK(rise.rising && !fall.rising);
+    CHECK_NEAR((fall.timestamp_ns - rise.timestamp_ns) * 0.000017, 80.0, 0.1);
+}
+
+// scheduler 에서 쓰는 RangeSource: poll 마다 이전 결과를 받고 다음 ping 시작
+void testRangeSource()
+{
+    SimulatedEdgeSource pin;
+    pin.setDistance(60.0f);
+    Ultrasonic ultra(0, 0, &pin);
+    UltrasonicRangeSource source(ultra);
+
+    float cm = 0.0f;
+    uint64_t t_ns = 0;
+    CHECK(!source.poll(cm, t_ns));      // 첫 poll: 측정 없이 ping 시작
+
+    int got = 0;
+    uint64_t deadline = monoNowNs() + 500000000ull;
+    while (got < 3 && monoNowNs() < deadline) {
+        if (source.poll(cm, t_ns)) {
+            CHECK_NEAR(cm, 60.0f, 0.6);
+            CHECK(t_ns != 0);
+            got++;
+        }
+    }
+    CHECK(got == 3);
+    CHECK(pin.triggerCount() == 4);
+}
+
+// gpio polling: trigger 전 50ms 대기는 echo timeout 에 들어가지 않음, 17cm 는 약 1ms 펄스
+void testPollingDistance()
+{
+    SimClock clock(1000000000ull);
+    SimGpio gpio(clock);
+    Ultrasonic ultra(TRIG, ECHO, nullptr, &gpio, &clock);
+
+    gpio.setDistance(17.0f);
+    uint64_t t0 = clock.nowNs();
+    CHECK_NEAR(ultra.getDistance(), 17.0f, 0.1);
+    CHECK(gpio.triggers() == 1);
+    uint64_t took_ms = (clock.nowNs() - t0) / 1000000ull;
+    CHECK(took_ms >= 51 && took_ms <= 52);
+
+    // 거의 최대 거리 (약 23.5ms 펄스) 도 40ms 안
+    gpio.setDistance(400.0f);
+    CHECK_NEAR(ultra.getDistance(), 400.0f, 0.5);
+
+    // echo 없음 / HIGH 에서 안 내려옴: 40ms 뒤 0
+    gpio.setDropEcho(true);
+    t0 = clock.nowNs();
+    CHECK(ultra.getDistance() == 0.0f);
+    took_ms = (clock.nowNs() - t0) / 1000000ull;
+    CHECK(took_ms >= 90 && took_ms <= 91);
+
+    gpio.setDropEcho(false);
+    gpio.setStuckHigh(true);
+    CHECK(ultra.getDistance() == 0.0f);
+
+    // gpio 도 edge source 도 없으면 측정 없이 0
+    Ultrasonic none(TRIG, ECHO, nullptr, nullptr, &clock);
+    CHECK(none.getDistance() == 0.0f);
+}
+
+} // namespace
+
+int main()
+{
+    testEdgeQueue();
+    testAsyncPing();
+    testBlockingDistance();
+    testDroppedEcho();
+    testEdgeOrder();
+    testRangeSource();
+    testPollingDistance();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,88 @@
+// EventLog 스레드별 ring 재사용: 끝난 스레드의 ring 은 formatter 가 비운 뒤 다음 스레드가 씀
+// (MAX_THREADS 는 동시에 기록하는 스레드 수 제한이지, 프로세스 전체에서 만든 스레드 수 제한이 아님)
+#include "check.hpp"
+#include "../core/event_log.hpp"
+#include "../core/mono_clock.hpp"
+#include <fcntl.h>
+#include <unistd.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+bool waitWritten(uint64_t n)
+{
+    uint64_t deadline = monoNowNs() + 5000000000ull;
+    while (monoNowNs() < deadline) {
+        if (EventLog::instance().written() >= n)
+            return true;
+        usleep(1000);
+    }
+    return false;
+}
+
+// 한 번에 하나씩 MAX_THREADS 의 세 배만큼 스레드를 만들고 끝냄
+void testSequentialThreads()
+{
+    uint64_t base = EventLog::instance().written();
+    const int n = EventLog::MAX_THREADS * 3;
+    for (int i = 0; i < n; i++) {
+        std::thread t([i]() { LOG_INFO("thread {}", i); });
+        t.join();
+        CHECK(waitWritten(base + i + 1));
+    }
+    CHECK(EventLog::instance().written() == base + n);
+    CHECK(EventLog::instance().dropped() == 0);
+}
+
+// MAX_THREADS 개가 동시에 살아 있으면 하나 더는 ring 을 못 받음, 그 스레드들이 끝나면 다시 받음
+void testConcurrentLimit()
+{
+    uint64_t base = EventLog::instance().written();
+    std::atomic<int>  logged{0};
+    std::atomic<bool> release{false};
+    std::vector<std::thread> threads;
+    for (int i = 0; i < EventLog::MAX_THREADS; i++)
+        threads.push_back(std::thread([&, i]() {
+            LOG_INFO("holder {}", i);
+            logged.fetch_add(1);
+            while (!release.load())
+                usleep(1000);
+        }));
+    while (logged.load() < EventLog::MAX_THREADS)
+        usleep(1000);
+
+    std::thread extra([]() { LOG_INFO("one too many"); });
+    extra.join();
+    CHECK(EventLog::instance().dropped() == 1);
+
+    release.store(true);
+    for (size_t i = 0; i < threads.size(); i++)
+        threads[i].join();
+    CHECK(waitWritten(base + EventLog::MAX_THREADS));
+
+    // 돌려받은 ring 이 FREE 가 될 때까지 (formatter 한두 주기)
+    usleep(50000);
+    std::thread again([]() { LOG_INFO("after release"); });
+    again.join();
+    CHECK(waitWritten(base + EventLog::MAX_THREADS + 1));
+    CHECK(EventLog::instance().dropped() == 1);
+}
+
+} // namespace
+
+int main()
+{
+    EventLog::Config cfg;
+    cfg.fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    cfg.poll_interval_ms = 1;
+    EventLog::instance().start(cfg);
+
+    testSequentialThreads();
+    testConcurrentLimit();
+
+    EventLog::instance().stop();
+    close(cfg.fd);
+    return CHECK_RESULT();
+}
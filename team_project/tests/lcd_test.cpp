@@ -0,0 +1,255 @@
+// LCD shadow framebuffer: 바뀐 칸만 쓰는지, 1칸 틈은 이어 쓰는지, 요청이 합쳐지는지,
+// I2C 쓰기가 실패한 칸은 shadow 에 남지 않고 다시 쓰이는지
+// bus 가 PCF8574 byte 를 HD44780 (4bit) 처럼 해석해 "유리" 에 보이는 글자를 들고 있음
+#include "check.hpp"
+#include "../core/mono_clock.hpp"
+#include "../sensors/i2c_bus.hpp"
+#include "../sensors/lcd.hpp"
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint8_t PCF_RS = 0x01;
+constexpr uint8_t PCF_EN = 0x04;
+
+class GlassBus : public MockI2CBus {
+public:
+    GlassBus()
+    {
+        memset(glass_, ' ', sizeof(glass_));
+    }
+
+    bool write(const uint8_t* data, size_t len) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (fail_) {
+            failed_++;
+            return false;
+        }
+        if (slow_us_)
+            usleep(slow_us_);
+        writes_++;
+        for (size_t i = 0; i < len; i++) {
+            if ((prev_ & PCF_EN) && !(data[i] & PCF_EN))
+                latch(prev_);
+            prev_ = data[i];
+        }
+        return MockI2CBus::write(data, len);
+    }
+
+    std::string row(int r)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return std::string(glass_[r], LCD_COLS);
+    }
+
+    int writes()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return writes_;
+    }
+
+    // 마지막 트랜잭션들이 쓴 DDRAM 구간 (cursor 주소, 글자 수)
+    struct Span { int addr, len; };
+    int spans(Span* out, int max)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        int n = std::min(span_count_, max);
+        for (int i = 0; i < n; i++)
+            out[i] = spans_[i];
+        return n;
+    }
+    void clearSpans()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        span_count_ = 0;
+    }
+
+    void setFail(bool fail)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fail_ = fail;
+    }
+    void setSlowUs(unsigned us)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        slow_us_ = us;
+    }
+    int failed()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return failed_;
+    }
+
+private:
+    std::mutex mutex_;
+    char glass_[LCD_ROWS][LCD_COLS];
+    uint8_t prev_ = 0;
+    int  init_nibbles_ = 4;      // 8bit 모드 초기화 (0x3 x3, 0x2)
+    bool have_high_ = false;
+    uint8_t high_ = 0;
+    int  addr_ = 0;
+    bool fail_ = false;
+    unsigned slow_us_ = 0;
+    int  failed_ = 0;
+    int  writes_ = 0;
+    Span spans_[64];
+    int  span_count_ = 0;
+
+    void latch(uint8_t b)
+    {
+        uint8_t nibble = b & 0xF0;
+        if (init_nibbles_ > 0) {
+            init_nibbles_--;
+            return;
+        }
+        if (!have_high_) {
+            high_ = nibble;
+            have_high_ = true;
+            return;
+        }
+        have_high_ = false;
+        uint8_t value = static_cast<uint8_t>(high_ | (nibble >> 4));
+        if (!(b & PCF_RS)) {
+            if (value & 0x80) {
+                addr_ = value & 0x7F;
+                if (span_count_ < 64)
+                    spans_[span_count_++] = Span{ addr_, 0 };
+            }
+            else if (value == 0x01) {
+                memset(glass_, ' ', sizeof(glass_));
+                addr_ = 0;
+            }
+            return;
+        }
+        int r = addr_ >= 0x40 ? 1 : 0;
+        int c = addr_ - (r ? 0x40 : 0);
+        if (c >= 0 && c < LCD_COLS)
+            glass_[r][c] = static_cast<char>(value);
+        addr_++;
+        if (span_count_ > 0)
+            spans_[span_count_ - 1].len++;
+    }
+};
+
+// 유리가 l1 / l2 가 될 때까지 (settled: 요청마다 한 번씩 그려 worker 가 쉬는 중일 때까지)
+bool waitFor(LCD& lcd, GlassBus& bus, const std::string& l1, const std::string& l2, bool settled = true)
+{
+    uint64_t deadline = monoNowNs() + 3000000000ull;
+    while (monoNowNs() < deadline) {
+        if (bus.row(0) == l1 && bus.row(1) == l2 && (!settled || lcd.framesDrawn() == lcd.framesRequested()))
+            return true;
+        usleep(1000);
+    }
+    return false;
+}
+
+std::string pad(const char* s)
+{
+    std::string out(s);
+    out.resize(LCD_COLS, ' ');
+    return out;
+}
+
+// 한 칸만 바꾸면 그 칸 하나만 (cursor + 1 글자)
+void testOnlyChangedCells()
+{
+    GlassBus bus;
+    LCD lcd(&bus);
+    lcd.displayStatus("Hello", "World");
+    CHECK(waitFor(lcd, bus, pad("Hello"), pad("World")));
+
+    bus.clearSpans();
+    lcd.displayStatus("Hello", "Wxrld");
+    CHECK(waitFor(lcd, bus, pad("Hello"), pad("Wxrld")));
+    GlassBus::Span s[8];
+    int n = bus.spans(s, 8);
+    CHECK(n == 1);
+    if (n == 1)
+        CHECK(s[0].addr == 0x41 && s[0].len == 1);
+
+    // 같은 내용은 아무것도 보내지 않음
+    int writes = bus.writes();
+    lcd.displayStatus("Hello", "Wxrld");
+    CHECK(waitFor(lcd, bus, pad("Hello"), pad("Wxrld")));
+    CHECK(bus.writes() == writes);
+}
+
+// 1칸 틈은 이어서 한 구간, 2칸 이상 틈은 따로
+void testGapMerge()
+{
+    GlassBus bus;
+    LCD lcd(&bus);
+    lcd.displayStatus("abcdef", "");
+    CHECK(waitFor(lcd, bus, pad("abcdef"), pad("")));
+
+    bus.clearSpans();
+    lcd.displayStatus("XbXdef", "");            // 0, 2 바뀜 (틈 1)
+    CHECK(waitFor(lcd, bus, pad("XbXdef"), pad("")));
+    GlassBus::Span s[8];
+    int n = bus.spans(s, 8);
+    CHECK(n == 1);
+    if (n == 1)
+        CHECK(s[0].addr == 0x00 && s[0].len == 3);
+
+    bus.clearSpans();
+    lcd.displayStatus("YbXZef", "");            // 0, 3 바뀜 (틈 2)
+    CHECK(waitFor(lcd, bus, pad("YbXZef"), pad("")));
+    n = bus.spans(s, 8);
+    CHECK(n == 2);
+    if (n == 2) {
+        CHECK(s[0].addr == 0x00 && s[0].len == 1);
+        CHECK(s[1].addr == 0x03 && s[1].len == 1);
+    }
+}
+
+// 그리는 동안 들어온 요청은 마지막 것 하나로
+void testCoalesce()
+{
+    GlassBus bus;
+    LCD lcd(&bus);
+    bus.setSlowUs(20000);       // 트랜잭션마다 20ms
+    char line[32];
+    for (int i = 0; i < 20; i++) {
+        snprintf(line, sizeof(line), "count %d", i);
+        lcd.displayStatus(line, "");
+    }
+    CHECK(waitFor(lcd, bus, pad("count 19"), pad(""), false));
+    CHECK(lcd.framesRequested() == 20);
+    CHECK(lcd.framesDrawn() < 20);
+}
+
+// 쓰기가 실패하면 그 칸은 유리에 없는 것으로 남고, 새 요청이 없어도 다시 씀
+void testWriteFailureRetried()
+{
+    GlassBus bus;
+    LCD lcd(&bus);
+    lcd.displayStatus("before", "");
+    CHECK(waitFor(lcd, bus, pad("before"), pad("")));
+
+    bus.setFail(true);
+    lcd.displayStatus("after", "");
+    uint64_t deadline = monoNowNs() + 3000000000ull;
+    while (lcd.writeFailures() == 0 && monoNowNs() < deadline)
+        usleep(1000);
+    CHECK(lcd.writeFailures() > 0);
+    CHECK(bus.row(0) == pad("before"));
+    CHECK(lcd.framesDrawn() < lcd.framesRequested());
+
+    bus.setFail(false);
+    CHECK(waitFor(lcd, bus, pad("after"), pad("")));
+}
+
+} // namespace
+
+int main()
+{
+    testOnlyChangedCells();
+    testGapMerge();
+    testCoalesce();
+    testWriteFailureRetried();
+    return CHECK_RESULT();
+}
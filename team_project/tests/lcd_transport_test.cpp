@@ -0,0 +1,141 @@
+// LcdTransport → MockI2CBus: 트랜잭션 묶음, HD44780 nibble 인코딩, 버스 속도별 대기 byte
+#include "check.hpp"
+#include "../sensors/lcd_transport.hpp"
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr uint8_t PCF_RS = 0x01;
+constexpr uint8_t PCF_EN = 0x04;
+
+struct Latched {
+    uint8_t value;
+    bool    rs;
+    size_t  en_fall;    // 낮은 nibble 의 EN falling 이 있는 byte 위치
+};
+
+// PCF8574 출력 byte 열을 HD44780 (4bit 모드) 입장에서 읽음: EN falling 마다 D4~D7 latch
+// 처음 4 nibble (0x3, 0x3, 0x3, 0x2) 은 8bit 모드 초기화라 따로 셈
+std::vector<Latched> decode(const std::vector<uint8_t>& bytes, int init_nibbles)
+{
+    std::vector<Latched> out;
+    bool have_high = false;
+    uint8_t high = 0;
+    for (size_t i = 1; i < bytes.size(); i++) {
+        if (!(bytes[i - 1] & PCF_EN) || (bytes[i] & PCF_EN))
+            continue;
+        uint8_t nibble = bytes[i - 1] & 0xF0;
+        if (init_nibbles > 0) {
+            init_nibbles--;
+            continue;
+        }
+        if (!have_high) {
+            high = nibble;
+            have_high = true;
+        }
+        else {
+            Latched l;
+            l.value   = static_cast<uint8_t>(high | (nibble >> 4));
+            l.rs      = (bytes[i - 1] & PCF_RS) != 0;
+            l.en_fall = i;
+            out.push_back(l);
+            have_high = false;
+        }
+    }
+    return out;
+}
+
+void testSingleTransactionPerRun()
+{
+    MockI2CBus bus(100000);
+    LcdTransport lcd(&bus);
+    bus.reset();
+
+    const char* text = "Dist: 123.4 cm  ";
+    CHECK(lcd.writeAt(0x40, text, 16));
+    CHECK(bus.transactions().size() == 1);
+
+    std::vector<Latched> got = decode(bus.bytes(), 0);
+    CHECK(got.size() == 17);
+    if (got.size() == 17) {
+        CHECK(got[0].value == (0x80 | 0x40) && !got[0].rs);
+        for (size_t i = 0; i < 16; i++)
+            CHECK(got[i + 1].value == static_cast<uint8_t>(text[i]) && got[i + 1].rs);
+    }
+}
+
+// 초기화 시퀀스: 0x3 x3, 0x2 다음 function set / display on / entry mode / clear
+void testInitSequence()
+{
+    MockI2CBus bus(100000);
+    LcdTransport lcd(&bus);
+    lcd.init();
+
+    std::vector<Latched> got = decode(bus.bytes(), 4);
+    const uint8_t expect[] = { 0x28, 0x0C, 0x06, 0x01 };
+    CHECK(got.size() == 4);
+    for (size_t i = 0; i < got.size() && i < 4; i++)
+        CHECK(got[i].value == expect[i] && !got[i].rs);
+
+    // 4.1ms + 100us + 40us + clear 1.52ms
+    CHECK(bus.delayNs() == (4100 + 100 + 40 + 1520) * 1000ull);
+}
+
+// 대기 byte 수는 bus 의 속도로 정해짐: 명령 실행 37us 를 byte 시간으로 채움
+void testPaddingFollowsBusSpeed()
+{
+    struct Case { uint32_t hz; unsigned pad; };
+    const Case cases[] = { { 100000, 0 }, { 400000, 1 }, { 1000000, 4 } };
+    for (const Case& c : cases) {
+        MockI2CBus bus(c.hz);
+        LcdTransport lcd(&bus);
+        CHECK(lcd.padBytes() == c.pad);
+
+        // 한 글자의 마지막 EN falling 부터 다음 글자의 첫 EN rising 까지 >= 37us
+        bus.reset();
+        CHECK(lcd.writeAt(0x00, "ABCDEFGH", 8));
+        std::vector<Latched> got = decode(bus.bytes(), 0);
+        CHECK(got.size() == 9);
+        double byte_ns = 9e9 / c.hz;
+        const std::vector<uint8_t>& b = bus.bytes();
+        for (size_t k = 0; k + 1 < got.size(); k++) {
+            size_t next_rise = got[k].en_fall;
+            while (next_rise < b.size() && !(b[next_rise] & PCF_EN))
+                next_rise++;
+            CHECK((next_rise - got[k].en_fall) * byte_ns >= 37000.0);
+        }
+    }
+}
+
+// bus_hz 를 직접 주면 bus 속도보다 우선
+void testExplicitBusHz()
+{
+    MockI2CBus bus(100000);
+    LcdTransport lcd(&bus, 1000000);
+    CHECK(lcd.padBytes() == 4);
+}
+
+void testClearWaits()
+{
+    MockI2CBus bus(400000);
+    LcdTransport lcd(&bus);
+    bus.reset();
+    CHECK(lcd.command(0x01));
+    CHECK(bus.delayNs() == 1520000ull);
+    CHECK(lcd.command(0x0C));
+    CHECK(bus.delayNs() == 1520000ull);
+}
+
+} // namespace
+
+int main()
+{
+    testSingleTransactionPerRun();
+    testInitSequence();
+    testPaddingFollowsBusSpeed();
+    testExplicitBusHz();
+    testClearWaits();
+    return CHECK_RESULT();
+}
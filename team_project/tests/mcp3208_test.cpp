@@ -0,0 +1,121 @@
+// MCP3208 SPI frame 구성 / 결과 해석: bit 단위로 흉내낸 MockMcp3208Bus 와 주고받아 확인
+#include "check.hpp"
+#include "../sensors/hall_sensor.hpp"
+#include "../sensors/spi_bus.hpp"
+
+namespace {
+
+// 채널마다 다른 값 → readadc 가 그 채널 값을 그대로 돌려줌 (채널 bit D2 D1 D0 와 결과 12bit 위치)
+void testChannelDecoding()
+{
+    MockMcp3208Bus bus;
+    const int values[8] = { 0, 4095, 0x800, 0x7FF, 0xA5A, 0x5A5, 1, 4094 };
+    for (unsigned ch = 0; ch < 8; ch++)
+        bus.setChannelValue(ch, values[ch]);
+
+    MCP3208 adc(&bus);
+    for (unsigned ch = 0; ch < 8; ch++)
+        CHECK(adc.readadc(static_cast<unsigned char>(ch)) == values[ch]);
+    CHECK(bus.badFrames() == 0);
+    CHECK(bus.ioctls() == 8);
+}
+
+// 결과 앞의 hi-Z / null bit 는 버려야 함 (mock 은 hi-Z 를 1 로 돌려줌)
+void testFrameLayout()
+{
+    MockMcp3208Bus bus;
+    bus.setChannelValue(5, 0xFFF);
+
+    // 0000 0 1 1 D2 | D1 D0 xxxxxx | xxxxxxxx (channel 5 = 101)
+    const uint8_t tx[3] = { 0x07, 0x40, 0x00 };
+    uint8_t rx[3] = { 0, 0, 0 };
+    CHECK(bus.transferFrames(tx, rx, 3, 1));
+    CHECK(rx[0] == 0xFF);                   // 아직 출력 없음
+    CHECK((rx[1] & 0x10) == 0);             // null bit
+    CHECK((rx[1] & 0x0F) == 0x0F && rx[2] == 0xFF);
+
+    bus.setChannelValue(5, 0x123);
+    CHECK(bus.transferFrames(tx, rx, 3, 1));
+    CHECK((rx[1] & 0x0F) == 0x01 && rx[2] == 0x23);
+    CHECK(bus.badFrames() == 0);
+}
+
+// framing 이 틀리면 mock 이 알아챔: start bit 없음 / 차동 입력 / 한 bit 늦은 명령 (결과가 잘림)
+void testBadFraming()
+{
+    MockMcp3208Bus bus;
+    bus.setChannelValue(0, 0xABC);
+    uint8_t rx[3];
+
+    const uint8_t no_start[3] = { 0x00, 0x00, 0x00 };
+    CHECK(bus.transferFrames(no_start, rx, 3, 1));
+    CHECK(bus.badFrames() == 1);
+
+    const uint8_t diff[3] = { 0x04, 0x00, 0x00 };
+    CHECK(bus.transferFrames(diff, rx, 3, 1));
+    CHECK(bus.badFrames() == 2);
+
+    // start bit 를 한 칸 뒤로: 마지막 B0 가 frame 밖으로 밀려 값이 달라짐
+    const uint8_t late[3] = { 0x03, 0x00, 0x00 };
+    CHECK(bus.transferFrames(late, rx, 3, 1));
+    CHECK(((rx[1] & 0x0F) << 8 | rx[2]) != 0xABC);
+
+    CHECK(!bus.transferFrames(no_start, rx, 2, 1));     // MCP3208 frame 은 3byte
+}
+
+// 여러 채널 x oversample: 채널을 번갈아 넣고, MAX_FRAMES 를 넘으면 ioctl 을 나눔
+void testBatchedChannels()
+{
+    MockMcp3208Bus bus;
+    bus.setChannelValue(0, 1000);
+    bus.setChannelValue(3, 2000);
+    bus.setChannelValue(7, 3000);
+
+    MCP3208 adc(&bus);
+    const unsigned char channels[3] = { 0, 3, 7 };
+
+    Span<const float> r = adc.readChannels(channels, 3, 8);
+    CHECK(r.size() == 3);
+    if (r.size() == 3) {
+        CHECK(r[0] == 1000.0f && r[1] == 2000.0f && r[2] == 3000.0f);
+    }
+    CHECK(bus.ioctls() == 1);
+    CHECK(bus.frames() == 24);
+
+    // 3 x 30 = 90 frame → 63 + 27
+    r = adc.readChannels(channels, 3, 30);
+    CHECK(r.size() == 3);
+    CHECK(bus.ioctls() == 3);
+    CHECK(bus.frames() == 24 + 90);
+    CHECK(bus.badFrames() == 0);
+
+    // 잡음 ±8 LSB 는 평균이 값 근처
+    bus.setNoise(8);
+    r = adc.readChannels(channels, 3, 32);
+    if (r.size() == 3) {
+        CHECK_NEAR(r[0], 1000.0, 8.0);
+        CHECK_NEAR(r[1], 2000.0, 8.0);
+        CHECK_NEAR(r[2], 3000.0, 8.0);
+    }
+}
+
+void testThrottleVoltage()
+{
+    MockMcp3208Bus bus;
+    bus.setChannelValue(0, 4095);
+    MCP3208 adc(&bus);
+    CHECK_NEAR(adc.readRawThrottle(0), 3.3, 1e-5);
+    CHECK(bus.frames() == THROTTLE_OVERSAMPLE);
+}
+
+} // namespace
+
+int main()
+{
+    testChannelDecoding();
+    testFrameLayout();
+    testBadFraming();
+    testBatchedChannels();
+    testThrottleVoltage();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,153 @@
+// MisopFsm: 모든 [상태][입력 조합] 칸을 cell() 로 읽어 규칙을 따로 적은 기대값과 비교,
+// 그리고 step() 의 잠금 시간 (3000ms) / 진입 시각 / 전이 기록
+#include "check.hpp"
+#include "../control/misop_fsm.hpp"
+#include <cstdio>
+
+namespace {
+
+constexpr uint64_t MS = 1000000ull;
+
+struct Expect {
+    int      next;
+    uint16_t actions;
+};
+
+bool has(uint8_t inputs, uint8_t bits)
+{
+    return (inputs & bits) == bits;
+}
+
+// 기존 main 의 판단 순서를 그대로 풀어 쓴 것 (misop_fsm.cpp 의 RULES 를 쓰지 않음)
+Expect expected(int state, uint8_t in)
+{
+    Expect e;
+    if (state == MISOP_LOCKOUT) {
+        if (in & MISOP_IN_EXPIRED) {
+            e.next    = MISOP_NORMAL;
+            e.actions = MISOP_ACT_MISOP | MISOP_ACT_BUZZER_STOP | MISOP_ACT_DISPLAY_OFF;
+        }
+        else {
+            e.next    = MISOP_LOCKOUT;
+            e.actions = MISOP_ACT_MISOP | MISOP_ACT_THROTTLE_ZERO | MISOP_ACT_SHOW_LOCKOUT;
+        }
+    }
+    else if (has(in, MISOP_IN_ACCEL | MISOP_IN_STOMP)) {
+        e.next    = MISOP_LOCKOUT;
+        e.actions = MISOP_ACT_MISOP | MISOP_ACT_CONSUME_STOMP | MISOP_ACT_THROTTLE_ZERO | MISOP_ACT_BEEP_LOCKOUT;
+    }
+    else if (has(in, MISOP_IN_ACCEL | MISOP_IN_RISING)) {
+        e.next    = MISOP_TTC_LIMITED;
+        e.actions = MISOP_ACT_THROTTLE_CAP;
+        if (in & MISOP_IN_TTC_LOW)
+            e.actions |= MISOP_ACT_MISOP | MISOP_ACT_BEEP_TTC;
+    }
+    else {
+        e.next    = MISOP_NORMAL;
+        e.actions = 0;
+    }
+
+    // BRAKE + stomp: 급제동 보조는 어느 상태에서나, 잠금이면 상태는 잠금 유지
+    if (has(in, MISOP_IN_BRAKE | MISOP_IN_STOMP)) {
+        e.actions |= MISOP_ACT_CONSUME_STOMP | MISOP_ACT_REQUEST_STOP | MISOP_ACT_BEEP_BRAKE | MISOP_ACT_SHOW_BRAKE;
+        if (e.next != MISOP_LOCKOUT)
+            e.next = MISOP_BRAKE_ASSIST;
+    }
+    return e;
+}
+
+void testEveryCell()
+{
+    int checked = 0;
+    for (int s = 0; s < MISOP_STATE_COUNT; s++)
+        for (int in = 0; in < MISOP_INPUT_COMBOS; in++) {
+            MisopState state = static_cast<MisopState>(s);
+            const MisopFsm::Cell& c = MisopFsm::cell(state, static_cast<uint8_t>(in));
+            Expect e = expected(s, static_cast<uint8_t>(in));
+            if (c.next != e.next || c.actions != e.actions) {
+                fprintf(stderr, "cell [%s][0x%02x]: next %s actions 0x%03x, expected %s 0x%03x\n",
+                        MisopFsm::stateName(state), in,
+                        MisopFsm::stateName(static_cast<MisopState>(c.next)), c.actions,
+                        MisopFsm::stateName(static_cast<MisopState>(e.next)), e.actions);
+                CHECK(c.next == e.next && c.actions == e.actions);
+            }
+            checked++;
+        }
+    CHECK(checked == MISOP_STATE_COUNT * MISOP_INPUT_COMBOS);
+
+    // 입력의 위 bit 는 무시
+    CHECK(&MisopFsm::cell(MISOP_NORMAL, 0xC0 | MISOP_IN_ACCEL) == &MisopFsm::cell(MISOP_NORMAL, MISOP_IN_ACCEL));
+}
+
+// 잠금은 진입 후 정확히 lockout_ms 에 풀림, 호출한 쪽이 넣은 EXPIRED 는 무시
+void testLockoutExpiry()
+{
+    MisopFsm fsm;
+    uint64_t t0 = 1000 * MS;
+    uint16_t act = fsm.step(t0, MISOP_IN_ACCEL | MISOP_IN_STOMP);
+    CHECK(fsm.state() == MISOP_LOCKOUT);
+    CHECK(act & MISOP_ACT_BEEP_LOCKOUT);
+    CHECK(fsm.enteredNs() == t0);
+
+    act = fsm.step(t0 + 50 * MS, MISOP_IN_EXPIRED);
+    CHECK(fsm.state() == MISOP_LOCKOUT);
+    CHECK(act & MISOP_ACT_THROTTLE_ZERO);
+
+    // 잠금 중 BRAKE + stomp: 보조 동작은 하지만 잠금 유지, 잠금 시각도 그대로 (연장 안 됨)
+    act = fsm.step(t0 + 100 * MS, MISOP_IN_BRAKE | MISOP_IN_STOMP);
+    CHECK(fsm.state() == MISOP_LOCKOUT);
+    CHECK(act & MISOP_ACT_REQUEST_STOP);
+    CHECK(act & MISOP_ACT_THROTTLE_ZERO);
+    CHECK(fsm.enteredNs() == t0);
+
+    act = fsm.step(t0 + 2999 * MS, 0);
+    CHECK(fsm.state() == MISOP_LOCKOUT);
+
+    act = fsm.step(t0 + 3000 * MS, MISOP_IN_ACCEL | MISOP_IN_RISING);
+    CHECK(fsm.state() == MISOP_NORMAL);
+    CHECK(act == (MISOP_ACT_MISOP | MISOP_ACT_BUZZER_STOP | MISOP_ACT_DISPLAY_OFF));
+    CHECK(fsm.enteredNs() == t0 + 3000 * MS);
+
+    // 다음 주기부터 다시 입력대로
+    fsm.step(t0 + 3050 * MS, MISOP_IN_ACCEL | MISOP_IN_RISING);
+    CHECK(fsm.state() == MISOP_TTC_LIMITED);
+
+    MisopTransition h[MisopFsm::HISTORY];
+    int n = fsm.history(h, MisopFsm::HISTORY);
+    CHECK(n == 3);
+    CHECK(fsm.transitions() == 3);
+    if (n == 3) {
+        CHECK(h[0].from == MISOP_NORMAL && h[0].to == MISOP_LOCKOUT && h[0].t_ns == t0);
+        CHECK(h[1].from == MISOP_LOCKOUT && h[1].to == MISOP_NORMAL);
+        CHECK(h[1].inputs & MISOP_IN_EXPIRED);
+        CHECK(h[2].to == MISOP_TTC_LIMITED && h[2].t_ns == t0 + 3050 * MS);
+    }
+}
+
+// lockout_ms 설정과 같은 상태로 머무는 주기는 전이로 세지 않음
+void testConfigAndSelfLoops()
+{
+    MisopFsm::Config cfg;
+    cfg.lockout_ms = 500;
+    MisopFsm fsm(cfg);
+    for (int i = 0; i < 10; i++)
+        fsm.step(i * 50 * MS, 0);
+    CHECK(fsm.transitions() == 0);
+
+    fsm.step(1000 * MS, MISOP_IN_ACCEL | MISOP_IN_STOMP);
+    fsm.step(1499 * MS, 0);
+    CHECK(fsm.state() == MISOP_LOCKOUT);
+    fsm.step(1500 * MS, 0);
+    CHECK(fsm.state() == MISOP_NORMAL);
+    CHECK(fsm.transitions() == 2);
+}
+
+} // namespace
+
+int main()
+{
+    testEveryCell();
+    testLockoutExpiry();
+    testConfigAndSelfLoops();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,191 @@
+// MqttClient 재접속 후 재전송 순서: 같은 프로세스의 가짜 broker (127.0.0.1) 로 확인
+// A, B, C 를 보내고 B 만 PUBACK → D 는 B 가 쓰던 inflight slot 으로 들어감 → 연결을 끊음
+// 재접속 뒤 DUP 재전송은 slot 순서 (A, D, C) 가 아니라 publish 순서 (A, C, D) 여야 한다.
+#include "check.hpp"
+#include "../core/mqtt_client.hpp"
+#include "../core/mono_clock.hpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Packet {
+    uint8_t type;
+    std::vector<uint8_t> body;
+};
+
+bool readAll(int fd, uint8_t* buf, size_t len)
+{
+    while (len > 0) {
+        ssize_t r = recv(fd, buf, len, 0);
+        if (r <= 0)
+            return false;
+        buf += r;
+        len -= static_cast<size_t>(r);
+    }
+    return true;
+}
+
+bool readPacket(int fd, Packet& pkt)
+{
+    uint8_t b;
+    if (!readAll(fd, &pkt.type, 1))
+        return false;
+    size_t len = 0;
+    for (int shift = 0; shift < 28; shift += 7) {
+        if (!readAll(fd, &b, 1))
+            return false;
+        len |= static_cast<size_t>(b & 0x7F) << shift;
+        if (!(b & 0x80))
+            break;
+    }
+    pkt.body.resize(len);
+    return len == 0 || readAll(fd, pkt.body.data(), len);
+}
+
+// PUBLISH (QoS1) body: topic, packet id, payload
+struct Publish {
+    bool        dup;
+    uint16_t    id;
+    std::string payload;
+};
+
+bool readPublish(int fd, Publish& pub)
+{
+    Packet pkt;
+    if (!readPacket(fd, pkt) || (pkt.type & 0xF0) != 0x30 || pkt.body.size() < 4)
+        return false;
+    size_t topic_len = (pkt.body[0] << 8) | pkt.body[1];
+    size_t pos = 2 + topic_len;
+    pub.dup = (pkt.type & 0x08) != 0;
+    pub.id  = static_cast<uint16_t>((pkt.body[pos] << 8) | pkt.body[pos + 1]);
+    pub.payload.assign(pkt.body.begin() + pos + 2, pkt.body.end());
+    return true;
+}
+
+void puback(int fd, uint16_t id)
+{
+    const uint8_t pkt[4] = { 0x40, 2, static_cast<uint8_t>(id >> 8), static_cast<uint8_t>(id) };
+    send(fd, pkt, sizeof(pkt), MSG_NOSIGNAL);
+}
+
+int acceptSession(int listen_fd)
+{
+    int fd = accept(listen_fd, nullptr, nullptr);
+    if (fd < 0)
+        return -1;
+    struct timeval tv = { 3, 0 };     // 테스트가 멈추지 않게
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    Packet connect_pkt;
+    if (!readPacket(fd, connect_pkt) || connect_pkt.type != 0x10) {
+        close(fd);
+        return -1;
+    }
+    const uint8_t connack[4] = { 0x20, 2, 0, 0 };
+    send(fd, connack, sizeof(connack), MSG_NOSIGNAL);
+    return fd;
+}
+
+bool waitFor(MqttClient& client, uint64_t acked, uint64_t connects)
+{
+    uint64_t deadline = monoNowNs() + 5000000000ull;
+    while (monoNowNs() < deadline) {
+        MqttClient::Stats s = client.stats();
+        if (s.acked >= acked && s.reconnects >= connects)
+            return true;
+        usleep(1000);
+    }
+    return false;
+}
+
+void testResendInPublishOrder()
+{
+    int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port        = 0;
+    CHECK(bind(listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0);
+    CHECK(listen(listen_fd, 2) == 0);
+    socklen_t addr_len = sizeof(addr);
+    getsockname(listen_fd, reinterpret_cast<sockaddr*>(&addr), &addr_len);
+
+    std::vector<Publish> first, resent;
+    bool broker_ok = false;
+    std::thread broker([&]() {
+        int fd = acceptSession(listen_fd);
+        if (fd < 0)
+            return;
+        Publish p;
+        for (int i = 0; i < 3 && readPublish(fd, p); i++)
+            first.push_back(p);
+        if (first.size() != 3) {
+            close(fd);
+            return;
+        }
+        puback(fd, first[1].id);            // B 만 ack
+        if (readPublish(fd, p))              // D (B 의 slot 을 씀)
+            first.push_back(p);
+        close(fd);                           // A, C, D 가 inflight 인 채로 끊김
+
+        fd = acceptSession(listen_fd);
+        if (fd < 0)
+            return;
+        for (int i = 0; i < 3 && readPublish(fd, p); i++) {
+            resent.push_back(p);
+            puback(fd, p.id);
+        }
+        broker_ok = true;
+        Packet rest;
+        while (readPacket(fd, rest)) {}      // DISCONNECT / close 까지
+        close(fd);
+    });
+
+    MqttClient::Config cfg;
+    cfg.port     = ntohs(addr.sin_port);
+    cfg.retry_ms = 60000;                    // 연결 중 재전송은 없게 (재접속 재전송만 봄)
+    MqttClient client(cfg);
+    CHECK(client.start());
+
+    const char* topic = "car/speed";
+    client.publish(topic, "A", 1);
+    client.publish(topic, "B", 1);
+    client.publish(topic, "C", 1);
+    CHECK(waitFor(client, 1, 1));
+    client.publish(topic, "D", 1);
+    CHECK(waitFor(client, 4, 2));
+    client.stop();
+    broker.join();
+    close(listen_fd);
+
+    CHECK(broker_ok);
+    CHECK(first.size() == 4);
+    CHECK(resent.size() == 3);
+    if (resent.size() == 3) {
+        CHECK(resent[0].payload == "A");
+        CHECK(resent[1].payload == "C");
+        CHECK(resent[2].payload == "D");
+        for (size_t i = 0; i < resent.size(); i++)
+            CHECK(resent[i].dup);
+    }
+    MqttClient::Stats s = client.stats();
+    CHECK(s.retransmits == 3);
+    CHECK(s.acked == 4);
+}
+
+} // namespace
+
+int main()
+{
+    testResendInPublishOrder();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,177 @@
+// PedalSampler stomp 감지: MockMcp3208Bus 에 페달 궤적을 넣고 SimClock 1kHz 로 step()
+// 밟기 시작부터 stomp 까지의 지연과, stomp 가 아니어야 하는 입력 (짧고 빠른 밟기 / 천천히 / 잡음) 확인
+#include "check.hpp"
+#include "../sensors/pedal_sampler.hpp"
+#include "../sensors/spi_bus.hpp"
+#include <cstdio>
+
+namespace {
+
+constexpr uint64_t MS = 1000000ull;
+
+// throttle % → ADC raw (PedalSampler 의 voltage → % 변환의 역)
+int rawFor(float percent)
+{
+    float v = V_MIN_CALIBRATED + percent / 100.0f * (V_MAX_CALIBRATED - V_MIN_CALIBRATED);
+    return static_cast<int>(v / 3.3f * 4095.0f + 0.5f);
+}
+
+// from → to 를 ramp_ms 동안 선형으로, 그 전 hold_ms / 그 뒤 tail_ms 는 유지
+struct Press {
+    float from, to;
+    int   hold_ms, ramp_ms, tail_ms;
+};
+
+struct Result {
+    uint32_t stomps;
+    double   latency_ms;    // ramp 시작 → 첫 stomp (없으면 -1)
+};
+
+Result run(const Press& p, int noise_lsb = 0)
+{
+    MockMcp3208Bus bus;
+    bus.setNoise(noise_lsb);
+    MCP3208 adc(&bus);
+    SimClock clock(1000 * MS);
+    PedalSampler sampler(adc, PedalSampler::Config(), &clock);
+
+    uint64_t t = clock.nowNs();
+    uint64_t ramp_start = t + static_cast<uint64_t>(p.hold_ms) * MS;
+    int total = p.hold_ms + p.ramp_ms + p.tail_ms;
+    for (int i = 0; i < total; i++) {
+        float pct;
+        if (i < p.hold_ms)
+            pct = p.from;
+        else if (i < p.hold_ms + p.ramp_ms)
+            pct = p.from + (p.to - p.from) * (i - p.hold_ms) / p.ramp_ms;
+        else
+            pct = p.to;
+        bus.setChannelValue(0, rawFor(pct));
+        sampler.step(t);
+        t += MS;
+    }
+
+    PedalState st = sampler.latest();
+    Result r;
+    r.stomps = st.stomp_count;
+    r.latency_ms = st.stomp_count ? (static_cast<double>(st.stomp_ns) - ramp_start) / 1e6 : -1.0;
+    return r;
+}
+
+void testFullStompLatency()
+{
+    // 0 → 100% 를 43ms 에 (실제 stomp 기록과 비슷한 속도)
+    Result r = run({ 0.0f, 100.0f, 100, 43, 300 });
+    fprintf(stderr, "0->100%% in 43 ms: stomps=%u latency=%.1f ms\n", r.stomps, r.latency_ms);
+    CHECK(r.stomps == 1);
+    // 70% 변화에 닿는 것은 raw 기준 30ms, filter 지연은 없음 (window 는 raw 값)
+    CHECK(r.latency_ms >= 29.0 && r.latency_ms <= 35.0);
+
+    // 0 → 80% 를 100ms 에 (기존 200ms / 70% 기준 안)
+    r = run({ 0.0f, 80.0f, 100, 100, 300 });
+    fprintf(stderr, "0->80%% in 100 ms: stomps=%u latency=%.1f ms\n", r.stomps, r.latency_ms);
+    CHECK(r.stomps == 1);
+    CHECK(r.latency_ms >= 87.0 && r.latency_ms <= 92.0);
+}
+
+// 빠르지만 크기가 작은 밟기: slope 는 기준을 넘지만 변화량 < 70%
+void testFastSmallPressIgnored()
+{
+    Result r = run({ 0.0f, 30.0f, 100, 10, 300 });
+    CHECK(r.stomps == 0);
+    r = run({ 70.0f, 100.0f, 100, 43, 300 });
+    CHECK(r.stomps == 0);
+    r = run({ 10.0f, 75.0f, 100, 20, 300 });
+    CHECK(r.stomps == 0);
+}
+
+// 천천히 끝까지 밟기: 변화량은 크지만 slope 가 기준 아래
+void testSlowPressIgnored()
+{
+    Result r = run({ 0.0f, 100.0f, 100, 2000, 300 });
+    CHECK(r.stomps == 0);
+    r = run({ 0.0f, 100.0f, 100, 400, 300 });     // 250 %/s
+    CHECK(r.stomps == 0);
+}
+
+void testNoiseIgnored()
+{
+    Result r = run({ 40.0f, 40.0f, 3000, 1, 0 }, 4);
+    CHECK(r.stomps == 0);
+}
+
+// 놓았다가 다시 밟으면 다시 감지 (hysteresis)
+void testRearm()
+{
+    MockMcp3208Bus bus;
+    MCP3208 adc(&bus);
+    SimClock clock(1000 * MS);
+    PedalSampler sampler(adc, PedalSampler::Config(), &clock);
+
+    uint64_t t = clock.nowNs();
+    auto hold = [&](float pct, int ms) {
+        for (int i = 0; i < ms; i++) {
+            bus.setChannelValue(0, rawFor(pct));
+            sampler.step(t);
+            t += MS;
+        }
+    };
+    hold(0.0f, 100);
+    hold(100.0f, 300);      // 계단: 한 샘플에 100%
+    CHECK(sampler.latest().stomp_count == 1);
+    hold(100.0f, 300);      // 유지하는 동안 다시 세지 않음
+    CHECK(sampler.latest().stomp_count == 1);
+    hold(0.0f, 300);
+    hold(100.0f, 300);
+    CHECK(sampler.latest().stomp_count == 2);
+}
+
+// Config::record: 샘플마다 하나씩 순서대로, 소비자가 늦으면 버린 수만 셈
+void testRecordSamples()
+{
+    MockMcp3208Bus bus;
+    MCP3208 adc(&bus);
+    SimClock clock(1000 * MS);
+    PedalSampler::Config cfg;
+    cfg.record = true;
+    PedalSampler sampler(adc, cfg, &clock);
+
+    uint64_t t = clock.nowNs();
+    for (int i = 0; i < 10; i++) {
+        bus.setChannelValue(0, rawFor(i * 10.0f));
+        sampler.step(t + i * MS);
+    }
+    PedalSample s;
+    int n = 0;
+    while (sampler.popSample(s)) {
+        CHECK(s.timestamp_ns == t + n * MS);
+        n++;
+    }
+    CHECK(n == 10);
+
+    for (int i = 0; i < 300; i++)
+        sampler.step(t + (10 + i) * MS);
+    n = 0;
+    while (sampler.popSample(s))
+        n++;
+    CHECK(n == 256);
+    CHECK(sampler.recordDropped() == 300 - 256);
+
+    // 기본값은 기록하지 않음
+    PedalSampler quiet(adc, PedalSampler::Config(), &clock);
+    quiet.step(t);
+    CHECK(!quiet.popSample(s));
+}
+
+} // namespace
+
+int main()
+{
+    testFullStompLatency();
+    testFastSmallPressIgnored();
+    testSlowPressIgnored();
+    testNoiseIgnored();
+    testRearm();
+    testRecordSamples();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,201 @@
+// 검출기 입력 전처리: Preprocessor (scalar / SIMD) 가 기준 두 단계 경로 (resizeBilinear + normalizeToFloat)
+// 와 0~255 단위로 1 이하 차이인지
+// 줄이기 / 늘리기 / 나눠떨어지지 않는 크기, 행 끝 padding 이 있는 view, RGB 입력 / RGB 모델, uint8 / int8, letterbox
+#include "check.hpp"
+#include "../vision/preprocess.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// preprocess_bench 와 같은 gradient + 잡음
+void synthesize(Image& img, int width, int height)
+{
+    img.resize(width, height);
+    uint32_t seed = 12345;
+    for (int y = 0; y < height; y++) {
+        uint8_t* p = img.row(y);
+        for (int x = 0; x < width; x++, p += 3) {
+            seed = seed * 1664525u + 1013904223u;
+            int noise = static_cast<int>(seed >> 28) - 8;
+            p[0] = static_cast<uint8_t>(std::min(255, std::max(0, x * 255 / width + noise)));
+            p[1] = static_cast<uint8_t>(std::min(255, std::max(0, y * 255 / height + noise)));
+            p[2] = static_cast<uint8_t>(std::min(255, std::max(0, (x + y) * 255 / (width + height) + noise)));
+        }
+    }
+}
+
+// 기준 경로 값 (0~1), size x size x 3
+std::vector<float> reference(const Image& frame, int width, int height)
+{
+    Image resized;
+    resizeBilinear(frame, resized, width, height);
+    std::vector<float> ref(static_cast<size_t>(width) * height * 3);
+    normalizeToFloat(resized, &ref[0]);
+    return ref;
+}
+
+// 출력 i 번째 값을 0~255 로
+float value255(const Preprocessor& pre, const std::vector<uint8_t>& out, size_t i)
+{
+    const Preprocessor::Config& cfg = pre.config();
+    switch (cfg.type) {
+    case INPUT_UINT8: return (out[i] - cfg.q_zero) * cfg.q_scale * 255.0f;
+    case INPUT_INT8:  return (static_cast<int8_t>(out[i]) - cfg.q_zero) * cfg.q_scale * 255.0f;
+    default: {
+        float v;
+        memcpy(&v, &out[i * sizeof(float)], sizeof(float));
+        return v * 255.0f;
+    }
+    }
+}
+
+// 기준 경로와의 최대 차이 (swap_rb / RGB 입력이면 채널을 바꿔 비교)
+float maxDiff(Preprocessor& pre, const ImageView& src, const Image& frame)
+{
+    const int size = pre.config().size;
+    std::vector<float> ref = reference(frame, size, size);
+    std::vector<uint8_t> out(pre.outputBytes());
+    pre.run(src, &out[0]);
+
+    bool swap = pre.config().swap_rb != src.rgb;
+    float diff = 0;
+    for (size_t i = 0; i < ref.size(); i++) {
+        size_t r = swap ? i - i % 3 + (2 - i % 3) : i;
+        diff = std::max(diff, std::fabs(value255(pre, out, i) - ref[r] * 255.0f));
+    }
+    return diff;
+}
+
+Preprocessor::Config config(int size, bool simd)
+{
+    Preprocessor::Config cfg;
+    cfg.size = size;
+    cfg.use_simd = simd;
+    return cfg;
+}
+
+// 한 단계 (1/255 을 곱했다 다시 255 를 곱한 float 오차만큼 여유)
+void check(const char* what, float diff)
+{
+    if (diff > 1.001f)
+        fprintf(stderr, "%s: max diff %.3f\n", what, diff);
+    CHECK(diff <= 1.001f);
+}
+
+// 카메라 640x480 → 416, 늘리기, 홀수 크기
+void testSizes()
+{
+    struct Case { int w, h, size; };
+    const Case cases[] = { { 640, 480, 416 }, { 320, 240, 416 }, { 333, 251, 224 }, { 97, 61, 160 }, { 416, 416, 416 } };
+    for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        Image frame;
+        synthesize(frame, cases[c].w, cases[c].h);
+        for (int simd = 0; simd < 2; simd++) {
+            Preprocessor pre(config(cases[c].size, simd != 0));
+            char what[64];
+            snprintf(what, sizeof(what), "%dx%d -> %d %s", cases[c].w, cases[c].h, cases[c].size,
+                     simdName(pre.simdLevel()));
+            check(what, maxDiff(pre, frame.view(), frame));
+            // 두 번째 run 은 표를 다시 계산하지 않는 경로
+            check(what, maxDiff(pre, frame.view(), frame));
+        }
+    }
+}
+
+// V4L2 bytesperline 처럼 행 끝에 padding, RGB24 입력, RGB 모델
+void testViewsAndChannels()
+{
+    Image frame;
+    synthesize(frame, 640, 480);
+
+    const int stride = frame.stride() + 64;
+    std::vector<uint8_t> padded(static_cast<size_t>(stride) * frame.height, 0xEE);
+    for (int y = 0; y < frame.height; y++)
+        memcpy(&padded[static_cast<size_t>(y) * stride], frame.row(y), frame.stride());
+    ImageView view = frame.view();
+    view.data = &padded[0];
+    view.stride = stride;
+
+    // 같은 byte 를 RGB 로 읽으면 모델 (BGR) 쪽은 채널이 바뀐 것
+    ImageView rgb = frame.view();
+    rgb.rgb = true;
+
+    for (int simd = 0; simd < 2; simd++) {
+        Preprocessor pre(config(416, simd != 0));
+        check("stride", maxDiff(pre, view, frame));
+        check("rgb input", maxDiff(pre, rgb, frame));
+
+        Preprocessor::Config cfg = config(416, simd != 0);
+        cfg.swap_rb = true;
+        Preprocessor swap(cfg);
+        check("swap_rb", maxDiff(swap, frame.view(), frame));
+        check("rgb input + swap_rb", maxDiff(swap, rgb, frame));
+    }
+}
+
+// 양자화 출력 (round 한 번이라 한 단계 q_scale 까지)
+void testQuantized()
+{
+    Image frame;
+    synthesize(frame, 640, 480);
+    for (int simd = 0; simd < 2; simd++) {
+        Preprocessor::Config cfg = config(416, simd != 0);
+        cfg.type = INPUT_UINT8;
+        Preprocessor u8(cfg);
+        check("uint8", maxDiff(u8, frame.view(), frame));
+
+        cfg.type = INPUT_INT8;
+        cfg.q_zero = -128;
+        Preprocessor i8(cfg);
+        check("int8", maxDiff(i8, frame.view(), frame));
+    }
+}
+
+// letterbox: 가운데는 content 크기로 줄인 기준 경로와 같고 나머지는 pad_value
+void testLetterbox()
+{
+    Image frame;
+    synthesize(frame, 640, 480);
+    for (int simd = 0; simd < 2; simd++) {
+        Preprocessor::Config cfg = config(416, simd != 0);
+        cfg.letterbox = true;
+        Preprocessor pre(cfg);
+        std::vector<uint8_t> out(pre.outputBytes());
+        pre.run(frame, &out[0]);
+
+        const InputGeometry& g = pre.geometry();
+        CHECK(g.content_w == 416 && g.content_h == 312);
+        CHECK(g.pad_x == 0 && g.pad_y == 52);
+
+        std::vector<float> ref = reference(frame, g.content_w, g.content_h);
+        float diff = 0, pad_diff = 0;
+        for (int y = 0; y < g.size; y++)
+            for (int x = 0; x < g.size; x++)
+                for (int c = 0; c < 3; c++) {
+                    size_t i = (static_cast<size_t>(y) * g.size + x) * 3 + c;
+                    float v = value255(pre, out, i);
+                    int cy = y - g.pad_y, cx = x - g.pad_x;
+                    if (cy < 0 || cy >= g.content_h || cx < 0 || cx >= g.content_w)
+                        pad_diff = std::max(pad_diff, std::fabs(v - cfg.pad_value));
+                    else
+                        diff = std::max(diff, std::fabs(v - ref[(static_cast<size_t>(cy) * g.content_w + cx) * 3 + c] * 255.0f));
+                }
+        check("letterbox content", diff);
+        check("letterbox pad", pad_diff);
+    }
+}
+
+} // namespace
+
+int main()
+{
+    testSizes();
+    testViewsAndChannels();
+    testQuantized();
+    testLetterbox();
+    return CHECK_RESULT();
+}
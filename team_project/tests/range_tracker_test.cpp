@@ -0,0 +1,114 @@
+// RangeTracker / Ultrasonic::computeTTC: 접근 시나리오 수렴, outlier gate, 측정 실패 때 TTC coast → INF
+#include "check.hpp"
+#include "../sensors/range_tracker.hpp"
+#include "../sensors/ultrasonic.hpp"
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+constexpr uint64_t MS = 1000000ull;
+
+float noise(uint32_t& rng, float amplitude)
+{
+    rng = rng * 1664525u + 1013904223u;
+    return (static_cast<float>(rng >> 8) / 16777216.0f * 2.0f - 1.0f) * amplitude;
+}
+
+// 2m 에서 0.3 m/s 로 접근, ±1.5cm 잡음, 20Hz
+// 처음 10% 안에 드는 샘플, 그 뒤 (0.5s 이후) 평균 / 최대 상대 오차
+void testApproachConverges()
+{
+    RangeTracker tracker;
+    uint32_t rng = 11;
+    int first_within = -1;
+    double err_sum = 0.0, err_max = 0.0;
+    int err_n = 0;
+    for (int i = 0; i < 60; i++) {
+        uint64_t t = i * 50 * MS;
+        float d_true = 2.0f - 0.3f * i * 0.05f;
+        tracker.update(d_true + noise(rng, 0.015f), t);
+
+        float ttc_true = d_true / 0.3f;
+        double err = std::fabs(tracker.ttc() - ttc_true) / ttc_true;
+        if (err <= 0.1 && first_within < 0)
+            first_within = i + 1;
+        if (i >= 10) {
+            err_sum += err;
+            err_max = err > err_max ? err : err_max;
+            err_n++;
+        }
+    }
+    double err_avg = err_sum / err_n;
+    fprintf(stderr, "0.3 m/s approach: within 10%% at sample %d, after 0.5 s mean err %.1f%% max %.1f%%\n",
+            first_within, err_avg * 100, err_max * 100);
+    CHECK(first_within > 0 && first_within <= 8);
+    CHECK(err_avg <= 0.08);
+    CHECK(err_max <= 0.25);
+    CHECK(tracker.outliers() == 0);
+    CHECK(tracker.confidence() > 0.5f);
+    CHECK(std::isfinite(tracker.ttcSigma()));
+}
+
+// 한 번 튄 2m 측정은 버림, 세 번 연속이면 새 물체로 재초기화
+void testOutlierGate()
+{
+    RangeTracker tracker;
+    for (int i = 0; i < 20; i++)
+        tracker.update(1.0f, i * 50 * MS);
+    CHECK(!tracker.update(3.0f, 20 * 50 * MS));
+    CHECK(tracker.outliers() == 1);
+    CHECK_NEAR(tracker.distance(), 1.0, 0.01);
+    CHECK(tracker.update(1.0f, 21 * 50 * MS));
+
+    CHECK(!tracker.update(3.0f, 22 * 50 * MS));
+    CHECK(!tracker.update(3.0f, 23 * 50 * MS));
+    CHECK(tracker.update(3.0f, 24 * 50 * MS));
+    CHECK_NEAR(tracker.distance(), 3.0, 1e-6);
+}
+
+void testStationaryIsInfinite()
+{
+    RangeTracker tracker;
+    CHECK(std::isinf(tracker.ttc()));
+    for (int i = 0; i < 20; i++)
+        tracker.update(1.5f, i * 50 * MS);
+    CHECK(std::isinf(tracker.ttc()) || tracker.ttc() > 100.0f);
+}
+
+// 측정 실패: TTC_COAST_NS 까지는 지난 시간만큼 줄어든 예측, 그 뒤로는 INF (마지막 짧은 TTC 를 붙잡지 않음)
+void testFailedEchoAgesOut()
+{
+    Ultrasonic ultra(0, 0);
+    uint64_t t = 1000 * MS;
+    CHECK(std::isinf(ultra.computeTTC(0.0f, t)));      // 추정 전 실패
+
+    float ttc = INFINITY;
+    for (int i = 0; i < 40; i++, t += 50 * MS)
+        ttc = ultra.computeTTC(300.0f - 2.5f * i, t);  // 0.5 m/s 접근
+    CHECK(std::isfinite(ttc));
+    uint64_t last = t - 50 * MS;
+
+    float coast = ultra.computeTTC(0.0f, last + 100 * MS);
+    CHECK(std::isfinite(coast));
+    CHECK_NEAR(coast, ttc - 0.1f, 0.01);
+
+    CHECK(std::isfinite(ultra.computeTTC(-1.0f, last + Ultrasonic::TTC_COAST_NS)));
+    CHECK(std::isinf(ultra.computeTTC(0.0f, last + Ultrasonic::TTC_COAST_NS + MS)));
+    CHECK(std::isinf(ultra.computeTTC(0.0f, last + 5000 * MS)));
+
+    // 다시 측정되면 그 측정부터 추정 재개 (5s 동안 예측이 벌어져 gate 안이면 update, 아니면 outlier)
+    ultra.computeTTC(150.0f, last + 5000 * MS);
+    CHECK(ultra.tracker().lastUpdateNs() == last + 5000 * MS || ultra.tracker().outliers() > 0);
+}
+
+} // namespace
+
+int main()
+{
+    testApproachConverges();
+    testOutlierGate();
+    testStationaryIsInfinite();
+    testFailedEchoAgesOut();
+    return CHECK_RESULT();
+}
@@ -0,0 +1,176 @@
+// SyscallCounter 가 read/write 외의 syscall 도 세는지, 그리고 제어 한 주기 (scheduler → range / control / log task)
+// 가 평상시에 syscall 과 heap 할당을 하지 않는지 확인
+// perf / seccomp 둘 다 안 되는 커널이면 건너뜀 (ctest SKIP, exit 77)
+#include "check.hpp"
+#include "../control/mispedal_controller.hpp"
+#include "../control/sim_devices.hpp"
+#include "../core/alloc_counter.hpp"
+#include "../core/clock.hpp"
+#include "../core/detection_channel.hpp"
+#include "../core/scheduler.hpp"
+#include "../core/syscall_counter.hpp"
+#include "../sensors/pedal_sampler.hpp"
+#include "../sensors/spi_bus.hpp"
+#include "../sensors/ultrasonic.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+namespace {
+
+constexpr uint64_t MS = 1000000ull;
+constexpr int SKIPPED = 77;
+
+// 120cm 에서 천천히 다가왔다 멀어지는 앞차 (20Hz)
+class SineRange : public RangeSource {
+public:
+    explicit SineRange(Clock& clock) : clock_(clock) {}
+
+    bool poll(float& distance_cm, uint64_t& t_ns) override
+    {
+        t_ns = clock_.nowNs();
+        distance_cm = 120.0f + 40.0f * static_cast<float>(std::sin(t_ns / 2e9));
+        return true;
+    }
+
+private:
+    Clock& clock_;
+};
+
+// 100ms 마다 ACCEL 하나 (검출 10fps, stomp 와 겹쳐 잠금 / 경고음 / lcd 경로도 지나가게)
+class PeriodicDetections : public DetectionSource {
+public:
+    explicit PeriodicDetections(Clock& clock) : clock_(clock) {}
+
+    bool poll(DetectionEvent& event) override
+    {
+        uint64_t now = clock_.nowNs();
+        if (now < next_ns_)
+            return false;
+        next_ns_ = now + 100 * MS;
+        memset(&event, 0, sizeof(event));
+        event.cls = DET_ACCEL;
+        event.timestamp_ns = now;
+        event.seq = ++seq_;
+        return true;
+    }
+
+private:
+    Clock& clock_;
+    uint64_t next_ns_ = 0, seq_ = 0;
+};
+
+class CountingLog : public LogSink {
+public:
+    bool log(const LogRecord&) override
+    {
+        rows++;
+        return true;
+    }
+    uint64_t rows = 0;
+};
+
+// 알려진 수의 syscall (getppid 는 glibc 가 값을 캐시하지 않도록 syscall() 로)
+void testCountsAllSyscalls(SyscallCounter& sc)
+{
+    uint64_t overhead = sc.overhead();
+    uint64_t a = sc.read();
+    for (int i = 0; i < 10; i++)
+        syscall(SYS_getppid);
+    uint64_t b = sc.read();
+    CHECK(b - a - overhead == 10);
+}
+
+// 페달을 밟았다 떼는 3초 주기 (stomp 포함)
+int pedalRaw(uint64_t t_ns)
+{
+    uint64_t ms = (t_ns / MS) % 3000;
+    float thr = ms < 2000 ? 30.0f : ms < 2100 ? 30.0f + 70.0f * (ms - 2000) / 100.0f : ms < 2500 ? 100.0f : 30.0f;
+    return static_cast<int>((1.7f + thr / 100.0f * 0.5f) / 3.3f * 4095.0f);
+}
+
+void testControlLoopQuiet(SyscallCounter& sc)
+{
+    SimClock clock(1000 * MS);
+    MockMcp3208Bus bus;
+    MCP3208 hall(&bus);
+    PedalSampler::Config pedal_cfg;
+    PedalSampler pedal(hall, pedal_cfg, &clock);
+    Ultrasonic ultra(29, 28);
+    SineRange range(clock);
+    PeriodicDetections detections(clock);
+    CountingBuzzer buzzer;
+    CountingDisplay display;
+    CountingBrake brake;
+    CountingLog log;
+
+    MispedalController::Devices dev;
+    dev.range      = &range;
+    dev.detections = &detections;
+    dev.pedal      = &pedal;
+    dev.ultra      = &ultra;
+    dev.hall       = &hall;
+    dev.buzzer     = &buzzer;
+    dev.display    = &display;
+    dev.brake      = &brake;
+    dev.log        = &log;
+    dev.clock      = &clock;
+    MispedalController ctl(dev, 0);
+
+    PeriodicScheduler sched(&clock);
+    sched.addTask("pedal", pedal_cfg.rate_hz, [&](uint64_t now_ns) {
+        bus.setChannelValue(pedal_cfg.channel, pedalRaw(now_ns));
+        pedal.step(now_ns);
+    });
+    ctl.addTasks(sched);
+
+    // 처음 한 번씩 (static 초기화, 표 만들기) 은 빼고 잼
+    uint64_t warm_end = clock.nowNs() + 2000 * MS;
+    while (clock.nowNs() < warm_end)
+        sched.runOnce();
+
+    uint64_t overhead = sc.overhead();
+    uint64_t sys0   = sc.read();
+    uint64_t alloc0 = threadAllocCount();
+    uint64_t end = clock.nowNs() + 10000 * MS;     // 10초: 잠금 / 해제 / 경고가 여러 번
+    while (clock.nowNs() < end)
+        sched.runOnce();
+    uint64_t allocs   = threadAllocCount() - alloc0;
+    uint64_t syscalls = sc.read() - sys0 - overhead;
+
+    CHECK(log.rows >= 190);
+    CHECK(ctl.fsm().transitions() > 0);
+    CHECK(allocs == 0);
+    CHECK(syscalls == 0);
+    if (syscalls || allocs)
+        fprintf(stderr, "control loop: %llu syscall(s), %llu alloc(s) in 10 s simulated\n",
+                static_cast<unsigned long long>(syscalls), static_cast<unsigned long long>(allocs));
+}
+
+} // namespace
+
+int main()
+{
+    // 측정은 전용 스레드에서 (seccomp filter 는 그 스레드와 함께 사라짐)
+    SyscallCounter sc;
+    bool exact = false;
+    std::thread worker([&]() {
+        sc.attach();
+        exact = sc.exact();
+        if (!exact)
+            return;
+        testCountsAllSyscalls(sc);
+        testControlLoopQuiet(sc);
+    });
+    worker.join();
+
+    if (!exact) {
+        fprintf(stderr, "skipped: no exact syscall counter (%s)\n", sc.source());
+        return SKIPPED;
+    }
+    fprintf(stderr, "syscalls counted with %s\n", sc.source());
+    return CHECK_RESULT();
+}
@@ -0,0 +1,141 @@
+// Tracker: 검출을 한 번 놓쳐도 (추론 건너뜀 / 검출 실패) 같은 ID 로 이어지는지, 예측 box 가 움직임을 따라가는지,
+// max_age_ms 동안 못 보면 지우고 다시 나타나면 새 ID 인지
+#include "check.hpp"
+#include "../vision/tracker.hpp"
+#include <cmath>
+
+namespace {
+
+constexpr uint64_t MS = 1000000ull;
+constexpr int MAX_OUT = 16;
+
+// 가속 페달 영역 안에서 +x 로 100 px/s 움직이는 발 (60 x 60)
+Detection footAt(uint64_t t_ms)
+{
+    float cx = 120.0f + 0.1f * t_ms, cy = 330.0f;
+    Detection d = { cy - 30, cx - 30, cy + 30, cx + 30, 0.8f, 0 };
+    return d;
+}
+
+float centerX(const Detection& d)
+{
+    return (d.xmin + d.xmax) / 2;
+}
+
+// min_hits (2) 번 맞춘 뒤부터 출력, 놓친 프레임에도 같은 ID 로 예측 box
+void testKeepsIdAcrossMiss()
+{
+    Tracker tracker;
+    Track out[MAX_OUT];
+    Detection d = footAt(0);
+    CHECK(tracker.update(0, &d, 1, out, MAX_OUT) == 0);
+    uint32_t id = 0;
+    for (uint64_t t = 100; t <= 500; t += 100) {
+        d = footAt(t);
+        int n = tracker.update(t * MS, &d, 1, out, MAX_OUT);
+        CHECK(n == 1);
+        if (n == 1) {
+            if (t == 100)
+                id = out[0].id;
+            CHECK(out[0].id == id);
+            CHECK(out[0].detected);
+            CHECK(out[0].cls == DET_ACCEL);
+        }
+    }
+
+    // 600: 추론은 했지만 검출 없음
+    int n = tracker.update(600 * MS, nullptr, 0, out, MAX_OUT);
+    CHECK(n == 1);
+    if (n == 1) {
+        CHECK(out[0].id == id);
+        CHECK(!out[0].detected);
+        CHECK(out[0].last_seen_ns == 500 * MS);
+        CHECK(std::fabs(centerX(out[0].box) - centerX(footAt(600))) < 3.0f);
+        CHECK(out[0].confidence < 0.8f);
+    }
+
+    // 650: 추론하지 않은 프레임, 예측만
+    n = tracker.predict(650 * MS, out, MAX_OUT);
+    CHECK(n == 1);
+    if (n == 1) {
+        CHECK(out[0].id == id);
+        CHECK(!out[0].detected);
+        CHECK(std::fabs(centerX(out[0].box) - centerX(footAt(650))) < 3.0f);
+    }
+
+    // 700: 다시 검출 → 같은 track
+    d = footAt(700);
+    n = tracker.update(700 * MS, &d, 1, out, MAX_OUT);
+    CHECK(n == 1);
+    if (n == 1) {
+        CHECK(out[0].id == id);
+        CHECK(out[0].detected);
+        CHECK(out[0].hits == 7);
+    }
+    CHECK(tracker.created() == 1);
+    CHECK(tracker.size() == 1);
+}
+
+// 마지막 검출 뒤 max_age_ms 까지는 남고, 넘으면 지움, 다시 나타나면 새 ID
+void testDropsAfterMaxAge()
+{
+    Tracker::Config cfg;
+    cfg.max_age_ms = 300;
+    Tracker tracker(cfg);
+    Track out[MAX_OUT];
+    Detection d = footAt(0);
+    tracker.update(0, &d, 1, out, MAX_OUT);
+    d = footAt(100);
+    CHECK(tracker.update(100 * MS, &d, 1, out, MAX_OUT) == 1);
+    uint32_t id = out[0].id;
+
+    CHECK(tracker.update(300 * MS, nullptr, 0, out, MAX_OUT) == 1);
+    CHECK(tracker.update(400 * MS, nullptr, 0, out, MAX_OUT) == 1);   // 정확히 max_age
+    CHECK(out[0].id == id);
+    CHECK(tracker.predict(401 * MS, out, MAX_OUT) == 0);               // 예측도 max_age 를 넘으면 내지 않음
+    CHECK(tracker.update(450 * MS, nullptr, 0, out, MAX_OUT) == 0);
+    CHECK(tracker.size() == 0);
+
+    // 같은 자리에 다시: 새 track (min_hits 부터 다시)
+    d = footAt(500);
+    CHECK(tracker.update(500 * MS, &d, 1, out, MAX_OUT) == 0);
+    d = footAt(600);
+    CHECK(tracker.update(600 * MS, &d, 1, out, MAX_OUT) == 1);
+    CHECK(out[0].id != id);
+    CHECK(tracker.created() == 2);
+}
+
+// 떨어진 두 발: 한쪽만 놓쳐도 ID 가 바뀌지 않음
+void testTwoTracks()
+{
+    Tracker tracker;
+    Track out[MAX_OUT];
+    Detection brake = { 100, 140, 160, 200, 0.7f, 0 };   // 브레이크 영역
+    Detection dets[2];
+    uint32_t accel_id = 0, brake_id = 0;
+    for (uint64_t t = 0; t <= 400; t += 100) {
+        dets[0] = footAt(t);
+        dets[1] = brake;
+        int n = tracker.update(t * MS, dets, t == 300 ? 1 : 2, out, MAX_OUT);
+        for (int i = 0; i < n; i++) {
+            uint32_t& id = out[i].cls == DET_ACCEL ? accel_id : brake_id;
+            if (id == 0)
+                id = out[i].id;
+            CHECK(out[i].id == id);
+        }
+        if (t >= 100)
+            CHECK(n == 2);
+    }
+    CHECK(accel_id != 0 && brake_id != 0 && accel_id != brake_id);
+    CHECK(tracker.created() == 2);
+}
+
+} // namespace
+
+int main()
+{
+    testKeepsIdAcrossMiss();
+    testDropsAfterMaxAge();
+    testTwoTracks();
+    return CHECK_RESULT();
+}
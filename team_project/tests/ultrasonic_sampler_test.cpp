@@ -0,0 +1,86 @@
+// UltrasonicSampler: SimClock 위의 가상 핀 (SimulatedEdgeSource) 으로 step() → poll() 값과 측정 시각
+// 시각은 모두 주입한 clock 기준 (edge: ping 시작, edge 없음: 측정 끝)
+#include "check.hpp"
+#include "../core/clock.hpp"
+#include "../sensors/echo_source.hpp"
+#include "../sensors/ultrasonic.hpp"
+#include "../sensors/ultrasonic_sampler.hpp"
+
+namespace {
+
+constexpr uint64_t MS = 1000000ull;
+
+// 기본 주기는 HC-SR04 ping 간격 60ms 이상
+void testDefaultRate()
+{
+    UltrasonicSampler::Config cfg;
+    CHECK(1e3 / cfg.rate_hz >= 60.0);
+}
+
+void testEdgeSamples()
+{
+    SimClock clock(1000 * MS);
+    SimulatedEdgeSource pin(&clock);
+    pin.setDistance(17.0f);
+    Ultrasonic ultra(0, 0, &pin, nullptr, &clock);
+    UltrasonicSampler sampler(ultra, UltrasonicSampler::Config(), &clock);
+
+    float cm = -1.0f;
+    uint64_t t_ns = 0;
+    CHECK(!sampler.poll(cm, t_ns));
+
+    sampler.step();
+    CHECK(sampler.poll(cm, t_ns));
+    CHECK_NEAR(cm, 17.0f, 0.05);
+    CHECK(t_ns == 1000 * MS);                   // ping 시작 (echo 끝난 시각이 아님)
+    CHECK(clock.nowNs() > 1001 * MS);           // 450us + 1ms 펄스만큼 가상 시간으로 기다림
+    CHECK(!sampler.poll(cm, t_ns));             // 같은 측정은 한 번만
+
+    // 다음 ping: 거리 바뀜
+    clock.set(1066 * MS);
+    pin.setDistance(34.0f);
+    sampler.step();
+    CHECK(sampler.poll(cm, t_ns));
+    CHECK_NEAR(cm, 34.0f, 0.1);
+    CHECK(t_ns == 1066 * MS);
+
+    // echo 없음: 40ms 가상 시간 뒤 0, timeout 으로 셈
+    clock.set(1133 * MS);
+    pin.setDropEcho(true);
+    sampler.step();
+    CHECK(sampler.poll(cm, t_ns));
+    CHECK(cm == 0.0f);
+    CHECK(t_ns == 1133 * MS);
+    CHECK(clock.nowNs() >= 1173 * MS && clock.nowNs() < 1180 * MS);
+
+    RangeSample s = sampler.latest();
+    CHECK(s.sample_count == 3);
+    CHECK(s.timeouts == 1);
+    CHECK(pin.triggerCount() == 3);
+}
+
+// edge source 가 없으면 끝난 시각을 주입한 clock 에서 (gpio 도 없으면 측정 없이 0)
+void testNoEdgeSourceUsesClock()
+{
+    SimClock clock(5000 * MS);
+    Ultrasonic ultra(0, 0, nullptr, nullptr, &clock);
+    UltrasonicSampler sampler(ultra, UltrasonicSampler::Config(), &clock);
+
+    sampler.step();
+    float cm = -1.0f;
+    uint64_t t_ns = 0;
+    CHECK(sampler.poll(cm, t_ns));
+    CHECK(cm == 0.0f);
+    CHECK(t_ns == 5000 * MS);
+    CHECK(sampler.latest().timeouts == 1);
+}
+
+} // namespace
+
+int main()
+{
+    testDefaultRate();
+    testEdgeSamples();
+    testNoEdgeSourceUsesClock();
+    return CHECK_RESULT();
+}
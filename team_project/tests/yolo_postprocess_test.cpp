@@ -0,0 +1,239 @@
+// YOLO 후처리: SIMD kernel (rowMax / suppressOverlaps) 이 scalar 와 같은 값을 내는지,
+// YoloPostprocessor 의 scalar / SIMD 경로가 Python filter_boxes + nms 와 같은 검출을 내는지 (불일치 0)
+// 이 CPU 에서 쓸 수 있는 SIMD 종류를 모두 (x86: SSE2 + AVX2, ARM: NEON)
+#include "check.hpp"
+#include "../vision/yolo_postprocess.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+constexpr int MAX_OUT = 64;
+
+uint32_t g_seed = 12345;
+
+float rnd()
+{
+    g_seed = g_seed * 1664525u + 1013904223u;
+    return (g_seed >> 8) / 16777216.0f;
+}
+
+std::vector<SimdLevel> simdLevels()
+{
+    std::vector<SimdLevel> levels;
+    SimdLevel best = bestSimdLevel();
+    if (best == SIMD_SSE2 || best == SIMD_AVX2)
+        levels.push_back(SIMD_SSE2);
+    if (best != SIMD_SCALAR && best != SIMD_SSE2)
+        levels.push_back(best);
+    return levels;
+}
+
+// 길이마다 (vector 폭의 나머지 포함) 최대값 위치를 옮겨 가며
+void testRowMax()
+{
+    std::vector<SimdLevel> levels = simdLevels();
+    float row[80];
+    int mismatches = 0;
+    for (int n = 1; n <= 80; n++) {
+        for (int at = 0; at < n; at++) {
+            for (int i = 0; i < n; i++)
+                row[i] = rnd() * 0.5f - 0.25f;
+            row[at] = 0.75f;
+            for (size_t k = 0; k < levels.size(); k++)
+                mismatches += rowMax(row, n, levels[k]) != rowMax(row, n, SIMD_SCALAR);
+        }
+    }
+    CHECK(rowMax(row, 80, SIMD_SCALAR) == 0.75f);
+    CHECK(mismatches == 0);
+}
+
+// box 수 / 시작 위치가 vector 폭으로 나눠떨어지지 않을 때도 같은 removed
+void testSuppressOverlaps()
+{
+    std::vector<SimdLevel> levels = simdLevels();
+    const int max_count = 45;
+    std::vector<float> x1(max_count + 8), y1(max_count + 8), x2(max_count + 8), y2(max_count + 8), area(max_count + 8);
+    std::vector<int32_t> label(max_count + 8, -1);
+    int mismatches = 0, hits = 0;
+
+    for (int count = 1; count <= max_count; count++) {
+        for (int j = 0; j < count; j++) {
+            float cx = 100 + rnd() * 40, cy = 100 + rnd() * 40, w = 20 + rnd() * 60, h = 20 + rnd() * 60;
+            x1[j] = cx - w / 2;
+            y1[j] = cy - h / 2;
+            x2[j] = cx + w / 2;
+            y2[j] = cy + h / 2;
+            area[j] = w * h;
+            label[j] = static_cast<int32_t>(rnd() * 3);
+        }
+        for (int j = count; j < max_count + 8; j++)
+            label[j] = -1;
+        BoxSoA soa = { &x1[0], &y1[0], &x2[0], &y2[0], &area[0], &label[0], count };
+
+        for (int i = 0; i < count; i++) {
+            uint8_t ref[max_count + 8] = {};
+            suppressOverlaps(soa, i, i + 1, 0.3f, ref, SIMD_SCALAR);
+            for (int j = 0; j < count; j++)
+                hits += ref[j];
+            for (size_t k = 0; k < levels.size(); k++) {
+                uint8_t out[max_count + 8] = {};
+                suppressOverlaps(soa, i, i + 1, 0.3f, out, levels[k]);
+                mismatches += !std::equal(ref, ref + max_count + 8, out);
+            }
+        }
+    }
+    CHECK(hits > 0);
+    CHECK(mismatches == 0);
+}
+
+// yolo_post_bench 와 같은 분포 (낮은 score 배경 + 물체 주변 겹치는 box 묶음), 크기는 줄여서
+void synthesize(std::vector<float>& loc, std::vector<float>& cls, int num_boxes, int num_classes, int objects)
+{
+    loc.assign(static_cast<size_t>(num_boxes) * 4, 0.0f);
+    cls.assign(static_cast<size_t>(num_boxes) * num_classes, 0.0f);
+    for (int i = 0; i < num_boxes; i++) {
+        loc[i * 4 + 0] = rnd() * 416;
+        loc[i * 4 + 1] = rnd() * 416;
+        loc[i * 4 + 2] = 10 + rnd() * 100;
+        loc[i * 4 + 3] = 10 + rnd() * 100;
+        for (int c = 0; c < num_classes; c++)
+            cls[i * num_classes + c] = rnd() * 0.05f;
+    }
+    for (int o = 0; o < objects; o++) {
+        float cx = 40 + rnd() * 336, cy = 40 + rnd() * 336, w = 30 + rnd() * 120, h = 30 + rnd() * 120;
+        int label = static_cast<int>(rnd() * 10);
+        for (int k = 0; k < 25; k++) {
+            int i = static_cast<int>(rnd() * num_boxes);
+            loc[i * 4 + 0] = cx + (rnd() - 0.5f) * 20;
+            loc[i * 4 + 1] = cy + (rnd() - 0.5f) * 20;
+            loc[i * 4 + 2] = w * (0.8f + rnd() * 0.4f);
+            loc[i * 4 + 3] = h * (0.8f + rnd() * 0.4f);
+            cls[i * num_classes + label] = 0.15f + rnd() * 0.8f;
+        }
+    }
+}
+
+// tflite_yolo_picam.py filter_boxes + nms 를 그대로 (yolo_post_bench 의 reference 와 같음)
+int referencePostprocess(const float* boxes, const float* scores, int n, int classes, Detection* out, int max_out)
+{
+    std::vector<Detection> cand;
+    for (int i = 0; i < n; i++) {
+        const float* s = scores + static_cast<size_t>(i) * classes;
+        int best = static_cast<int>(std::max_element(s, s + classes) - s);
+        if (s[best] < 0.2f)
+            continue;
+        const float* b = boxes + i * 4;
+        Detection d = { b[1] - b[3] / 2, b[0] - b[2] / 2, b[1] + b[3] / 2, b[0] + b[2] / 2, s[best], best };
+        cand.push_back(d);
+    }
+    std::vector<int> idxs(cand.size());
+    for (size_t i = 0; i < idxs.size(); i++)
+        idxs[i] = static_cast<int>(i);
+    std::stable_sort(idxs.begin(), idxs.end(), [&](int a, int b) { return cand[a].score > cand[b].score; });
+
+    int kept = 0;
+    while (!idxs.empty() && kept < max_out) {
+        int i = idxs[0];
+        out[kept++] = cand[i];
+        std::vector<int> rest;
+        for (size_t k = 1; k < idxs.size(); k++) {
+            int j = idxs[k];
+            if (!(cand[j].label == cand[i].label && iou(cand[i], cand[j]) > 0.3f))
+                rest.push_back(j);
+        }
+        idxs.swap(rest);
+    }
+    return kept;
+}
+
+bool sameDetections(const Detection* a, int na, const Detection* b, int nb, float tol)
+{
+    if (na != nb)
+        return false;
+    for (int i = 0; i < na; i++) {
+        if (a[i].label != b[i].label || a[i].score != b[i].score ||
+            std::fabs(a[i].xmin - b[i].xmin) > tol || std::fabs(a[i].ymin - b[i].ymin) > tol ||
+            std::fabs(a[i].xmax - b[i].xmax) > tol || std::fabs(a[i].ymax - b[i].ymax) > tol)
+            return false;
+    }
+    return true;
+}
+
+// scalar 와 SIMD 는 같은 식이라 bit 까지 같아야 하고, Python 경로와는 IoU 식 (나눗셈 없음) 차이만큼
+void testPostprocessMatches()
+{
+    const int num_boxes = 2535, num_classes = 80, frames = 20;
+    YoloPostprocessor::Config scalar_cfg;
+    scalar_cfg.use_simd = false;
+    YoloPostprocessor scalar(num_boxes, num_classes, scalar_cfg);
+    YoloPostprocessor simd(num_boxes, num_classes);
+    CHECK(scalar.simdLevel() == SIMD_SCALAR);
+
+    std::vector<float> loc, cls;
+    Detection ref[MAX_OUT], a[MAX_OUT], b[MAX_OUT];
+    int simd_mismatches = 0, ref_mismatches = 0, detections = 0;
+    for (int f = 0; f < frames; f++) {
+        synthesize(loc, cls, num_boxes, num_classes, 3 + f % 5);
+        int nref = referencePostprocess(&loc[0], &cls[0], num_boxes, num_classes, ref, MAX_OUT);
+        int na = scalar.run(&loc[0], &cls[0], a, MAX_OUT);
+        int nb = simd.run(&loc[0], &cls[0], b, MAX_OUT);
+        simd_mismatches += !sameDetections(a, na, b, nb, 0.0f);
+        ref_mismatches  += !sameDetections(ref, nref, b, nb, 1e-3f);
+        CHECK(scalar.candidates() == simd.candidates());
+        detections += nb;
+    }
+    if (simd_mismatches || ref_mismatches)
+        fprintf(stderr, "simd=%s: %d scalar/simd, %d reference mismatches\n",
+                simdName(simd.simdLevel()), simd_mismatches, ref_mismatches);
+    CHECK(detections >= frames * 3);
+    CHECK(simd_mismatches == 0);
+    CHECK(ref_mismatches == 0);
+}
+
+// threshold 와 같은 score 는 통과 (Python: score >= thresh), 다른 class 는 겹쳐도 남음
+void testThresholdAndClasses()
+{
+    const int num_boxes = 3, num_classes = 4;
+    float loc[num_boxes * 4] = { 100, 100, 50, 50,
+                                 102, 101, 50, 50,
+                                 300, 300, 40, 40 };
+    float cls[num_boxes * num_classes] = { 0.9f, 0.0f, 0.0f, 0.0f,
+                                           0.0f, 0.8f, 0.0f, 0.0f,
+                                           0.0f, 0.0f, 0.2f, 0.0f };
+    YoloPostprocessor::Config scalar_cfg;
+    scalar_cfg.use_simd = false;
+    YoloPostprocessor scalar(num_boxes, num_classes, scalar_cfg);
+    YoloPostprocessor simd(num_boxes, num_classes);
+    Detection a[MAX_OUT], b[MAX_OUT];
+    int na = scalar.run(loc, cls, a, MAX_OUT);
+    int nb = simd.run(loc, cls, b, MAX_OUT);
+    CHECK(na == 3);
+    CHECK(sameDetections(a, na, b, nb, 0.0f));
+    if (nb == 3) {
+        CHECK(b[0].label == 0 && b[1].label == 1 && b[2].label == 2);
+        CHECK(b[2].score == 0.2f);
+        CHECK(b[0].xmin == 75.0f && b[0].ymax == 125.0f);
+    }
+
+    // 같은 class 로 바꾸면 겹치는 쪽은 빠짐
+    cls[1 * num_classes + 1] = 0.0f;
+    cls[1 * num_classes + 0] = 0.8f;
+    na = scalar.run(loc, cls, a, MAX_OUT);
+    nb = simd.run(loc, cls, b, MAX_OUT);
+    CHECK(na == 2);
+    CHECK(sameDetections(a, na, b, nb, 0.0f));
+}
+
+} // namespace
+
+int main()
+{
+    testRowMax();
+    testSuppressOverlaps();
+    testPostprocessMatches();
+    testThresholdAndClasses();
+    return CHECK_RESULT();
+}
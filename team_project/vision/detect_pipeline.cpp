@@ -0,0 +1,366 @@
+#include "detect_pipeline.hpp"
+#include "../core/mono_clock.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <string>
+#include <thread>
+
+
+namespace {
+
+const char* const STAGE_NAMES[] = { "capture", "preprocess", "inference", "postprocess", "queue wait", "end-to-end",
+                                    "track", "track e2e" };
+
+void printRow(std::ostream& os, const char* name, const HdrHistogram& h)
+{
+    os << std::setw(12) << std::left << name << std::right
+       << std::setw(10) << h.count()
+       << std::setw(11) << h.percentile(0.50) / 1e3
+       << std::setw(11) << h.percentile(0.90) / 1e3
+       << std::setw(11) << h.percentile(0.99) / 1e3
+       << std::setw(11) << h.max() / 1e3
+       << std::setw(11) << h.mean() / 1e3 << "\n";
+}
+
+Preprocessor::Config preprocessConfig(const Detector& detector, const DetectPipeline::Config& config)
+{
+    Preprocessor::Config pc;
+    pc.size      = detector.inputSize();
+    pc.type      = detector.inputType();
+    pc.letterbox = config.letterbox;
+    pc.swap_rb   = config.swap_rb;
+    detector.inputQuantization(pc.q_scale, pc.q_zero);
+    return pc;
+}
+
+// letterbox 입력 좌표 → 늘려 맞춘 입력 좌표 (pedal 영역이 그 좌표계)
+void unletterbox(const InputGeometry& g, Detection* d, int n)
+{
+    float sx = static_cast<float>(g.size) / g.content_w;
+    float sy = static_cast<float>(g.size) / g.content_h;
+    for (int i = 0; i < n; i++) {
+        d[i].xmin = (d[i].xmin - g.pad_x) * sx;
+        d[i].xmax = (d[i].xmax - g.pad_x) * sx;
+        d[i].ymin = (d[i].ymin - g.pad_y) * sy;
+        d[i].ymax = (d[i].ymax - g.pad_y) * sy;
+    }
+}
+
+// ROI 입력 좌표 → 전체 프레임 입력 좌표
+void uncrop(const CropWindow& c, int size, Detection* d, int n)
+{
+    float ax = static_cast<float>(c.width) / c.src_width, bx = static_cast<float>(c.x) * size / c.src_width;
+    float ay = static_cast<float>(c.height) / c.src_height, by = static_cast<float>(c.y) * size / c.src_height;
+    for (int i = 0; i < n; i++) {
+        d[i].xmin = d[i].xmin * ax + bx;
+        d[i].xmax = d[i].xmax * ax + bx;
+        d[i].ymin = d[i].ymin * ay + by;
+        d[i].ymax = d[i].ymax * ay + by;
+    }
+}
+
+} // namespace
+
+
+DetectPipeline::DetectPipeline(FrameSource& source, Detector& detector, const Config& config)
+    : source_(source), detector_(detector), cfg_(config),
+      pre_(preprocessConfig(detector, config)),
+      post_(detector.numBoxes(), detector.numClasses(), config.post),
+      slots_(config.slots),
+      free_q_(config.slots), pre_q_(config.slots), infer_q_(config.slots), post_q_(config.slots)
+{
+    size_t box_count   = static_cast<size_t>(detector.numBoxes());
+    for (size_t i = 0; i < slots_.size(); i++) {
+        Slot& s = slots_[i];
+        s.input.resize(pre_.outputBytes());
+        s.boxes.resize(box_count * 4);
+        s.scores.resize(box_count * detector.numClasses());
+        s.detections.resize(config.max_detections);
+    }
+}
+
+void DetectPipeline::setTracker(Tracker* tracker)
+{
+    tracker_ = tracker;
+    for (size_t i = 0; i < slots_.size(); i++)
+        slots_[i].tracks.resize(tracker ? tracker->capacity() : 0);
+}
+
+bool DetectPipeline::capture(Slot& slot)
+{
+    if (stop_.load() || (cfg_.max_frames && next_seq_ >= cfg_.max_frames))
+        return false;
+
+    slot.t_capture_start = monoNowNs();
+    for (;;) {
+        if (!source_.acquire(slot.frame))
+            return false;
+        // tracker 가 있으면 검출하지 않는 프레임도 예측 결과를 내야 하므로 버리지 않음
+        bool due = !tracker_ || next_seq_ == 0 || ++since_infer_ >= cfg_.detect_every;
+        slot.infer = due && admit(slot.frame);
+        if (slot.infer || tracker_)
+            break;
+        source_.release(slot.frame);
+        gated_++;
+        if (stop_.load())
+            return false;
+    }
+    if (slot.infer)
+        since_infer_ = 0;
+    slot.t_capture = monoNowNs();
+    slot.seq = ++next_seq_;
+    return true;
+}
+
+// gate 가 없으면 모든 프레임
+bool DetectPipeline::admit(const Frame& frame)
+{
+    if (!gate_)
+        return true;
+    PedalState pedal;
+    bool known = pedal_ && pedal_->latest(pedal);
+    return gate_->shouldRun(std::max(frame.timestamp_ns, monoNowNs()), known ? &pedal : nullptr);
+}
+
+void DetectPipeline::preprocess(Slot& slot, void* input)
+{
+    slot.t_pre_start = monoNowNs();
+    slot.cropped = false;
+    if (!slot.infer) {
+        source_.release(slot.frame);
+        slot.frame.buffer = -1;
+        slot.t_pre = slot.t_pre_start;
+        return;
+    }
+
+    // ROI: 학습한 영역 (입력 좌표) 을 source pixel 로 바꿔 그 부분만 (buffer 안을 가리키는 view, 복사 없음)
+    ImageView view = slot.frame.image;
+    PedalRegion roi;
+    if (gate_ && gate_->roi(roi)) {
+        float sx = static_cast<float>(view.width) / pre_.config().size;
+        float sy = static_cast<float>(view.height) / pre_.config().size;
+        int x0 = std::max(0, static_cast<int>(roi.xmin * sx)) & ~7;   // 8 pixel 단위 (크기가 덜 바뀌게)
+        int y0 = std::max(0, static_cast<int>(roi.ymin * sy)) & ~7;
+        int x1 = std::min(view.width, (static_cast<int>(roi.xmax * sx) + 7) & ~7);
+        int y1 = std::min(view.height, (static_cast<int>(roi.ymax * sy) + 7) & ~7);
+        if (x1 - x0 >= 16 && y1 - y0 >= 16) {
+            CropWindow& c = slot.crop;
+            c.x = x0;
+            c.y = y0;
+            c.width  = x1 - x0;
+            c.height = y1 - y0;
+            c.src_width  = view.width;
+            c.src_height = view.height;
+            slot.cropped = true;
+            view.data  += static_cast<size_t>(y0) * view.stride + x0 * 3;
+            view.width  = c.width;
+            view.height = c.height;
+        }
+    }
+    pre_.run(view, input);
+    slot.geometry = pre_.geometry();
+    // 더 읽을 일이 없으므로 바로 돌려줌 (카메라 buffer 가 driver 로 빨리 돌아가야 프레임을 안 버림)
+    source_.release(slot.frame);
+    slot.frame.buffer = -1;
+    slot.t_pre = monoNowNs();
+}
+
+void DetectPipeline::postprocess(Slot& slot, const float* boxes, const float* scores)
+{
+    slot.t_post_start = monoNowNs();
+    slot.num_tracks = 0;
+    uint64_t frame_ns = std::min(slot.t_capture, slot.frame.timestamp_ns);
+    if (!slot.infer) {
+        slot.num_detections = 0;
+        slot.num_tracks = tracker_->predict(frame_ns, &slot.tracks[0], static_cast<int>(slot.tracks.size()));
+        slot.t_post = monoNowNs();
+        return;
+    }
+
+    slot.num_detections = post_.run(boxes, scores, &slot.detections[0], cfg_.max_detections);
+    if (cfg_.letterbox)
+        unletterbox(slot.geometry, &slot.detections[0], slot.num_detections);
+    if (slot.cropped)
+        uncrop(slot.crop, pre_.config().size, &slot.detections[0], slot.num_detections);
+    if (gate_)
+        gate_->learn(&slot.detections[0], slot.num_detections);
+    if (tracker_)
+        slot.num_tracks = tracker_->update(frame_ns, &slot.detections[0], slot.num_detections,
+                                           &slot.tracks[0], static_cast<int>(slot.tracks.size()));
+    slot.t_post = monoNowNs();
+}
+
+// postprocess 스레드 (serial 이면 호출 스레드) 에서만 호출
+void DetectPipeline::finish(Slot& slot)
+{
+    uint64_t capture = slot.t_capture - slot.t_capture_start;
+    uint64_t pre     = slot.t_pre - slot.t_pre_start;
+    uint64_t infer   = slot.t_infer - slot.t_infer_start;
+    uint64_t post    = slot.t_post - slot.t_post_start;
+    uint64_t total   = slot.t_post - std::min(slot.t_capture, slot.frame.timestamp_ns);
+    stage_[ST_CAPTURE].record(capture);
+    if (slot.infer) {
+        stage_[ST_PREPROCESS].record(pre);
+        stage_[ST_INFER].record(infer);
+        stage_[ST_POSTPROCESS].record(post);
+        stage_[ST_WAIT].record(total - pre - infer - post);
+        stage_[ST_TOTAL].record(total);
+    }
+    else {
+        stage_[ST_TRACK].record(post);
+        stage_[ST_TRACK_TOTAL].record(total);
+        tracked_++;
+    }
+    frames_++;
+
+    if (callback_) {
+        FrameResult result;
+        result.seq            = slot.seq;
+        result.capture_ns     = std::min(slot.t_capture, slot.frame.timestamp_ns);
+        result.infer_ns       = slot.t_post;
+        result.inferred       = slot.infer;
+        result.num_detections = slot.num_detections;
+        result.detections     = &slot.detections[0];
+        result.num_tracks     = slot.num_tracks;
+        result.tracks         = slot.num_tracks ? &slot.tracks[0] : nullptr;
+        callback_(result);
+    }
+}
+
+
+uint64_t DetectPipeline::runSerial()
+{
+    uint64_t start = monoNowNs();
+    Slot& slot = slots_[0];
+
+    // Python loop 와 같이 interpreter 입력 / 출력 버퍼를 바로 사용
+    while (capture(slot)) {
+        preprocess(slot, detector_.input());
+        slot.t_infer_start = monoNowNs();
+        if (slot.infer)
+            detector_.invoke();
+        slot.t_infer = monoNowNs();
+        postprocess(slot, detector_.boxes(), detector_.scores());
+        finish(slot);
+    }
+
+    elapsed_ns_ = monoNowNs() - start;
+    return frames_;
+}
+
+uint64_t DetectPipeline::runPipelined()
+{
+    uint64_t start = monoNowNs();
+    for (int i = 0; i < cfg_.slots; i++)
+        free_q_.push(i);
+
+    std::thread pre(&DetectPipeline::preprocessLoop, this);
+    std::thread infer(&DetectPipeline::inferLoop, this);
+    std::thread post(&DetectPipeline::postprocessLoop, this);
+    captureLoop();   // 호출 스레드가 capture stage
+
+    pre.join();
+    infer.join();
+    post.join();
+    elapsed_ns_ = monoNowNs() - start;
+    return frames_;
+}
+
+void DetectPipeline::captureLoop()
+{
+    for (;;) {
+        int idx;
+        if (cfg_.drop_when_busy) {
+            // 뒤 stage 가 밀려 있으면 지금 프레임은 버리고 다음 프레임으로 (latency 우선)
+            while (!free_q_.tryPop(idx)) {
+                if (stop_.load() || !source_.acquire(scratch_)) {
+                    pre_q_.close();
+                    return;
+                }
+                source_.release(scratch_);
+                dropped_++;
+            }
+        }
+        else if (!free_q_.pop(idx))
+            break;
+
+        if (!capture(slots_[idx]) || !pre_q_.push(idx))
+            break;
+    }
+    pre_q_.close();
+}
+
+void DetectPipeline::preprocessLoop()
+{
+    int idx;
+    while (pre_q_.pop(idx)) {
+        Slot& slot = slots_[idx];
+        preprocess(slot, &slot.input[0]);
+        infer_q_.push(idx);
+    }
+    infer_q_.close();
+}
+
+void DetectPipeline::inferLoop()
+{
+    size_t input_bytes = slots_[0].input.size();
+    size_t box_bytes   = slots_[0].boxes.size() * sizeof(float);
+    size_t score_bytes = slots_[0].scores.size() * sizeof(float);
+
+    int idx;
+    while (infer_q_.pop(idx)) {
+        Slot& slot = slots_[idx];
+        slot.t_infer_start = monoNowNs();
+        if (!slot.infer) {
+            slot.t_infer = slot.t_infer_start;
+            post_q_.push(idx);
+            continue;
+        }
+        // interpreter 는 하나뿐이므로 입력 / 출력을 slot 과 주고받음 (다음 추론 중에 후처리 가능)
+        memcpy(detector_.input(), &slot.input[0], input_bytes);
+        detector_.invoke();
+        memcpy(&slot.boxes[0], detector_.boxes(), box_bytes);
+        memcpy(&slot.scores[0], detector_.scores(), score_bytes);
+        slot.t_infer = monoNowNs();
+        post_q_.push(idx);
+    }
+    post_q_.close();
+}
+
+void DetectPipeline::postprocessLoop()
+{
+    int idx;
+    while (post_q_.pop(idx)) {
+        Slot& slot = slots_[idx];
+        postprocess(slot, &slot.boxes[0], &slot.scores[0]);
+        finish(slot);
+        free_q_.push(idx);
+    }
+}
+
+void DetectPipeline::printStats(std::ostream& os) const
+{
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+
+    double secs = elapsedSeconds();
+    os << std::fixed << std::setprecision(1)
+       << "frames " << frames_ << " in " << secs << " s, "
+       << (secs > 0 ? frames_ / secs : 0.0) << " fps";
+    if (dropped_)
+        os << ", dropped " << dropped_;
+    if (gated_)
+        os << ", gated " << gated_;
+    if (tracked_)
+        os << ", tracked only " << tracked_;
+    os << "\n";
+
+    os << "stage (us)       count        p50        p90        p99        max       mean\n";
+    for (int i = 0; i < ST_COUNT; i++)
+        if (i < ST_TRACK || stage_[i].count())
+            printRow(os, STAGE_NAMES[i], stage_[i]);
+
+    os.flags(flags);
+    os.precision(precision);
+}
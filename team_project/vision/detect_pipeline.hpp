@@ -0,0 +1,143 @@
+#ifndef DETECT_PIPELINE_HPP
+#define DETECT_PIPELINE_HPP
+
+#include "detector.hpp"
+#include "frame_source.hpp"
+#include "image.hpp"
+#include "inference_gate.hpp"
+#include "preprocess.hpp"
+#include "tracker.hpp"
+#include "yolo_postprocess.hpp"
+#include "../core/bounded_queue.hpp"
+#include "../core/hdr_histogram.hpp"
+#include "../sensors/pedal_channel.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+// 한 프레임 처리 결과 (callback 안에서만 유효)
+struct FrameResult {
+    uint64_t seq;
+    uint64_t capture_ns;       // 프레임이 만들어진 시각 (CLOCK_MONOTONIC, V4L2 driver timestamp, latency trace 의 CAPTURE)
+    uint64_t infer_ns;         // 후처리까지 끝난 시각 (INFER)
+    bool     inferred;         // false: 검출하지 않고 tracker 예측만 (detections 없음)
+    int      num_detections;
+    const Detection* detections;
+    int      num_tracks;       // setTracker 했을 때만 (아니면 0)
+    const Track* tracks;
+};
+
+// capture → preprocess → inference → postprocess 를 stage 별 스레드로 돌리는 검출 pipeline
+// - stage 사이는 크기 고정 BoundedQueue (slot 번호만 오감), slot 버퍼는 시작할 때 모두 할당
+// - 프레임은 source buffer 를 빌린 채로 (복사 없음) 전처리까지 가고, 전처리가 읽자마자 release 로 돌려줌
+// - 전처리는 Preprocessor 한 번에 (source 프레임 → 입력 tensor 형식), serial 은 interpreter 입력에 바로 씀
+// - 추론 중에 다음 프레임 캡처 / 전처리와 이전 프레임 후처리가 같이 진행된다
+// - 결과 callback 은 postprocess 스레드에서 프레임 순서대로 호출
+// - setGate 면 페달 상태에 따라 검출할 프레임만 골라 넘기고 (나머지는 바로 release), ROI 만 잘라 검출할 수 있음
+// - setTracker 면 detect_every 프레임에 한 번만 검출하고, 나머지 프레임은 전처리 / 추론 없이 tracker 예측으로 결과를 냄
+//   (tracker 는 postprocess 스레드에서만 쓰므로 프레임 순서대로, 검출 결과가 나온 뒤의 예측)
+// runSerial() 은 같은 단계를 한 스레드에서 차례로 (기존 Python loop 와 같은 구조, 비교용)
+class DetectPipeline {
+public:
+    struct Config {
+        int      slots          = 4;       // 동시에 처리 중인 프레임 수 (queue 깊이)
+        int      max_detections = 32;
+        uint64_t max_frames     = 0;       // 0: source 끝까지
+        bool     drop_when_busy = false;   // 카메라: slot 이 없으면 새 프레임을 버림 (오래된 프레임 대신)
+        bool     letterbox      = false;   // 비율 유지 resize (검출 좌표는 늘려 맞춘 입력 좌표로 되돌림)
+        bool     swap_rb        = false;   // BGR → RGB
+        int      detect_every   = 1;       // tracker 가 있을 때 N 프레임에 한 번 검출
+        YoloPostprocessor::Config post;
+    };
+
+    typedef std::function<void(const FrameResult&)> ResultCallback;
+
+    DetectPipeline(FrameSource& source, Detector& detector, const Config& config);
+    DetectPipeline(FrameSource& source, Detector& detector) : DetectPipeline(source, detector, Config()) {}
+
+    void setCallback(const ResultCallback& callback) { callback_ = callback; }
+    // 실행 전에 설정, pedal 은 없어도 됨 (그러면 항상 검출)
+    void setGate(InferenceGate* gate, const PedalChannel* pedal) { gate_ = gate; pedal_ = pedal; }
+    void setTracker(Tracker* tracker);
+
+    // source 가 끝나거나 max_frames / requestStop 까지 실행, 처리한 프레임 수 반환
+    uint64_t runPipelined();
+    uint64_t runSerial();
+    void requestStop() { stop_.store(true); }
+
+    uint64_t frames()  const { return frames_; }
+    uint64_t dropped() const { return dropped_; }
+    uint64_t gated()   const { return gated_; }
+    uint64_t tracked() const { return tracked_; }
+    double   elapsedSeconds() const { return elapsed_ns_ / 1e9; }
+
+    // FPS + stage 별 처리 시간 / end-to-end latency (us)
+    void printStats(std::ostream& os) const;
+
+private:
+    struct Slot {
+        uint64_t seq;
+        uint64_t t_capture_start, t_capture;
+        uint64_t t_pre_start, t_pre;
+        uint64_t t_infer_start, t_infer;
+        uint64_t t_post_start, t_post;
+        Frame frame;                       // source 에서 빌린 buffer (전처리 후 release)
+        bool infer;                        // false: tracker 예측만
+        InputGeometry geometry;
+        bool cropped;                      // ROI 만 잘라 검출
+        CropWindow crop;
+        std::vector<uint8_t> input;        // 입력 tensor 형식 그대로 (float / uint8 / int8)
+        std::vector<float> boxes;
+        std::vector<float> scores;
+        std::vector<Detection> detections;
+        int num_detections;
+        std::vector<Track> tracks;
+        int num_tracks;
+    };
+
+    // ST_TRACK*: 검출하지 않은 프레임 (tracker 예측 / 캡처부터 결과까지)
+    enum Stage { ST_CAPTURE, ST_PREPROCESS, ST_INFER, ST_POSTPROCESS, ST_WAIT, ST_TOTAL, ST_TRACK, ST_TRACK_TOTAL,
+                 ST_COUNT };
+
+    FrameSource& source_;
+    Detector& detector_;
+    Config cfg_;
+    Preprocessor pre_;
+    YoloPostprocessor post_;
+    ResultCallback callback_;
+    InferenceGate* gate_ = nullptr;
+    const PedalChannel* pedal_ = nullptr;
+    Tracker* tracker_ = nullptr;
+
+    std::vector<Slot> slots_;
+    Frame scratch_;                        // drop_when_busy 때 버릴 프레임
+    BoundedQueue<int> free_q_, pre_q_, infer_q_, post_q_;
+
+    std::atomic<bool> stop_{false};
+    uint64_t next_seq_ = 0;
+    uint64_t frames_ = 0;
+    uint64_t dropped_ = 0;
+    uint64_t gated_ = 0;
+    uint64_t tracked_ = 0;
+    int since_infer_ = 0;                  // 마지막 검출 뒤 프레임 수 (capture 스레드)
+    uint64_t elapsed_ns_ = 0;
+    HdrHistogram stage_[ST_COUNT];
+
+    bool capture(Slot& slot);
+    bool admit(const Frame& frame);
+    void preprocess(Slot& slot, void* input);
+    void postprocess(Slot& slot, const float* boxes, const float* scores);
+    void finish(Slot& slot);
+
+    void captureLoop();
+    void preprocessLoop();
+    void inferLoop();
+    void postprocessLoop();
+
+    DetectPipeline(const DetectPipeline&) = delete;
+    DetectPipeline& operator=(const DetectPipeline&) = delete;
+};
+
+#endif
@@ -0,0 +1,74 @@
+#include "detector.hpp"
+#include "pedal_regions.hpp"
+#include "../core/mono_clock.hpp"
+#include <algorithm>
+
+
+namespace {
+
+constexpr int CLASS_CAR = 2;   // COCO "car"
+
+// 영역 평균 밝기 (0~1)
+float regionMean(const float* input, int size, const PedalRegion& r)
+{
+    int x0 = std::max(0, static_cast<int>(r.xmin)), x1 = std::min(size, static_cast<int>(r.xmax));
+    int y0 = std::max(0, static_cast<int>(r.ymin)), y1 = std::min(size, static_cast<int>(r.ymax));
+    double sum = 0;
+    for (int y = y0; y < y1; y += 2) {
+        const float* p = input + (static_cast<size_t>(y) * size + x0) * 3;
+        for (int x = x0; x < x1; x += 2, p += 6)
+            sum += p[0] + p[1] + p[2];
+    }
+    int n = ((y1 - y0 + 1) / 2) * ((x1 - x0 + 1) / 2) * 3;
+    return n > 0 ? static_cast<float>(sum / n) : 0.0f;
+}
+
+void setBox(float* box, const PedalRegion& r, float shift)
+{
+    box[0] = (r.xmin + r.xmax) / 2 + shift;
+    box[1] = (r.ymin + r.ymax) / 2 + shift;
+    box[2] = (r.xmax - r.xmin) / 2;
+    box[3] = (r.ymax - r.ymin) / 2;
+}
+
+} // namespace
+
+
+SimDetector::SimDetector(uint32_t invoke_us)
+    : invoke_us_(invoke_us),
+      input_(static_cast<size_t>(INPUT_SIZE) * INPUT_SIZE * 3),
+      boxes_(static_cast<size_t>(NUM_BOXES) * 4),
+      scores_(static_cast<size_t>(NUM_BOXES) * NUM_CLASSES)
+{
+    // 나머지 box 는 score 0 인 작은 격자 (후처리가 전부 훑어야 함)
+    for (int i = 0; i < NUM_BOXES; i++) {
+        boxes_[i * 4 + 0] = static_cast<float>((i * 16) % INPUT_SIZE);
+        boxes_[i * 4 + 1] = static_cast<float>((i * 16 / INPUT_SIZE * 16) % INPUT_SIZE);
+        boxes_[i * 4 + 2] = 16.0f;
+        boxes_[i * 4 + 3] = 16.0f;
+    }
+}
+
+bool SimDetector::invoke()
+{
+    uint64_t until = monoNowNs() + invoke_us_ * 1000ull;
+
+    float accel = regionMean(&input_[0], INPUT_SIZE, ACCEL_REGION);
+    float brake = regionMean(&input_[0], INPUT_SIZE, BRAKE_REGION);
+
+    // 영역마다 box 2개 (두 번째는 조금 밀리고 score 가 낮음 → NMS 로 지워져야 함)
+    std::fill(scores_.begin(), scores_.end(), 0.0f);
+    setBox(&boxes_[0], ACCEL_REGION, 0.0f);
+    setBox(&boxes_[4], ACCEL_REGION, 4.0f);
+    setBox(&boxes_[8], BRAKE_REGION, 0.0f);
+    setBox(&boxes_[12], BRAKE_REGION, 4.0f);
+    scores_[0 * NUM_CLASSES + CLASS_CAR] = accel;
+    scores_[1 * NUM_CLASSES + CLASS_CAR] = accel * 0.9f;
+    scores_[2 * NUM_CLASSES + CLASS_CAR] = brake;
+    scores_[3 * NUM_CLASSES + CLASS_CAR] = brake * 0.9f;
+
+    while (monoNowNs() < until) {
+        // 추론 시간 흉내 (busy wait, 실제 추론처럼 core 하나를 씀)
+    }
+    return true;
+}
@@ -0,0 +1,58 @@
+#ifndef DETECTOR_HPP
+#define DETECTOR_HPP
+
+#include "preprocess.hpp"
+#include <cstdint>
+#include <vector>
+
+// YOLO 추론 backend
+// 입력: inputSize x inputSize x 3 (NHWC), element 는 inputType()
+//       float 은 0~1 (tflite_yolo_picam.py 와 같이 BGR 그대로), 양자화 모델은 inputQuantization() 의 scale / zero point
+// 출력: boxes  [numBoxes][4]          cx, cy, w, h (입력 pixel 좌표)
+//       scores [numBoxes][numClasses]
+// 한 스레드에서만 호출 (pipeline 의 infer stage)
+class Detector {
+public:
+    virtual ~Detector() {}
+
+    virtual int inputSize() const = 0;
+    virtual InputType inputType() const { return INPUT_FLOAT32; }
+    virtual void inputQuantization(float& scale, int& zero_point) const { scale = 1.0f; zero_point = 0; }
+    virtual void* input() = 0;
+    virtual bool invoke() = 0;
+
+    virtual int numBoxes() const = 0;
+    virtual int numClasses() const = 0;
+    virtual const float* boxes() const = 0;
+    virtual const float* scores() const = 0;
+};
+
+// 모델 없이 pipeline / 전후처리를 돌려보기 위한 가짜 backend
+// - 출력 크기는 yolov4-tiny 416 과 같음 (2535 box, 80 class)
+// - ACCEL / BRAKE 영역의 평균 밝기를 그 영역 중앙의 "car" score 로 냄 (입력에 따라 결과가 바뀜)
+// - invoke_us 만큼 CPU 를 씀 (Pi 에서 잰 추론 시간을 흉내)
+class SimDetector : public Detector {
+public:
+    static constexpr int INPUT_SIZE  = 416;
+    static constexpr int NUM_BOXES   = 2535;   // (13*13 + 26*26) * 3
+    static constexpr int NUM_CLASSES = 80;
+
+    explicit SimDetector(uint32_t invoke_us);
+
+    int inputSize() const override { return INPUT_SIZE; }
+    void* input() override { return &input_[0]; }
+    bool invoke() override;
+
+    int numBoxes() const override { return NUM_BOXES; }
+    int numClasses() const override { return NUM_CLASSES; }
+    const float* boxes() const override { return &boxes_[0]; }
+    const float* scores() const override { return &scores_[0]; }
+
+private:
+    uint32_t invoke_us_;
+    std::vector<float> input_;
+    std::vector<float> boxes_;
+    std::vector<float> scores_;
+};
+
+#endif
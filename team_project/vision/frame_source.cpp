@@ -0,0 +1,275 @@
+#include "frame_source.hpp"
+#include "../core/mono_clock.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef MISPEDAL_HAVE_JPEG
+#include <jpeglib.h>
+#endif
+
+
+namespace {
+
+bool hasSuffix(const std::string& s, const char* suffix)
+{
+    size_t n = strlen(suffix);
+    if (s.size() < n)
+        return false;
+    for (size_t i = 0; i < n; i++) {
+        if (tolower(static_cast<unsigned char>(s[s.size() - n + i])) != suffix[i])
+            return false;
+    }
+    return true;
+}
+
+bool isJpeg(const std::string& path)
+{
+    return hasSuffix(path, ".jpg") || hasSuffix(path, ".jpeg");
+}
+
+// PPM header 의 다음 숫자 (주석 건너뜀)
+bool readPpmInt(FILE* fp, int& value)
+{
+    int c;
+    do {
+        c = fgetc(fp);
+        if (c == '#') {
+            while (c != '\n' && c != EOF)
+                c = fgetc(fp);
+        }
+    } while (c == ' ' || c == '\t' || c == '\r' || c == '\n');
+    if (c < '0' || c > '9')
+        return false;
+
+    value = 0;
+    while (c >= '0' && c <= '9') {
+        value = value * 10 + (c - '0');
+        c = fgetc(fp);
+    }
+    return true;   // 숫자 뒤 공백 하나는 이미 읽음
+}
+
+bool loadPpm(FILE* fp, Image& image)
+{
+    int w, h, maxval;
+    if (fgetc(fp) != 'P' || fgetc(fp) != '6' ||
+        !readPpmInt(fp, w) || !readPpmInt(fp, h) || !readPpmInt(fp, maxval) || maxval != 255)
+        return false;
+
+    image.resize(w, h);
+    // PPM 은 RGB → BGR
+    for (int y = 0; y < h; y++) {
+        uint8_t* row = image.row(y);
+        if (fread(row, 1, image.stride(), fp) != static_cast<size_t>(image.stride()))
+            return false;
+        for (int x = 0; x < w; x++)
+            std::swap(row[3 * x], row[3 * x + 2]);
+    }
+    return true;
+}
+
+#ifdef MISPEDAL_HAVE_JPEG
+bool loadJpeg(FILE* fp, Image& image)
+{
+    struct jpeg_decompress_struct cinfo;
+    struct jpeg_error_mgr jerr;
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_decompress(&cinfo);
+    jpeg_stdio_src(&cinfo, fp);
+    jpeg_read_header(&cinfo, TRUE);
+    cinfo.out_color_space = JCS_EXT_BGR;   // libjpeg-turbo: 바로 BGR 로
+    jpeg_start_decompress(&cinfo);
+
+    image.resize(cinfo.output_width, cinfo.output_height);
+    while (cinfo.output_scanline < cinfo.output_height) {
+        JSAMPROW row = image.row(cinfo.output_scanline);
+        jpeg_read_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_decompress(&cinfo);
+    jpeg_destroy_decompress(&cinfo);
+    return true;
+}
+#endif
+
+} // namespace
+
+
+bool loadImage(const std::string& path, Image& image)
+{
+    FILE* fp = fopen(path.c_str(), "rb");
+    if (!fp) {
+        std::cerr << "image open failed: " << path << std::endl;
+        return false;
+    }
+
+    bool ok = false;
+    if (isJpeg(path)) {
+#ifdef MISPEDAL_HAVE_JPEG
+        ok = loadJpeg(fp, image);
+#else
+        std::cerr << "JPEG support not built (libjpeg not found): " << path << std::endl;
+#endif
+    }
+    else {
+        ok = loadPpm(fp, image);
+        if (!ok)
+            std::cerr << "not a binary PPM (P6, maxval 255): " << path << std::endl;
+    }
+    fclose(fp);
+    return ok;
+}
+
+
+ImageDirSource::ImageDirSource(const std::string& dir, bool loop, int buffers)
+    : loop_(loop), pool_(std::max(1, buffers)), free_(pool_.size())
+{
+    for (size_t i = 0; i < pool_.size(); i++)
+        free_.push(static_cast<int>(i));
+
+    DIR* d = opendir(dir.c_str());
+    if (!d) {
+        std::cerr << "image directory open failed: " << dir << std::endl;
+        return;
+    }
+
+    while (struct dirent* ent = readdir(d)) {
+        std::string name = ent->d_name;
+        bool supported = hasSuffix(name, ".ppm");
+#ifdef MISPEDAL_HAVE_JPEG
+        supported = supported || isJpeg(name);
+#endif
+        if (supported)
+            files_.push_back(dir + "/" + name);
+    }
+    closedir(d);
+    std::sort(files_.begin(), files_.end());
+
+    if (files_.empty())
+        std::cerr << "no images in " << dir << std::endl;
+}
+
+bool ImageDirSource::acquire(Frame& frame)
+{
+    if (files_.empty())
+        return false;
+    if (next_ == files_.size()) {
+        if (!loop_)
+            return false;
+        next_ = 0;
+    }
+
+    int idx;
+    if (!free_.pop(idx))
+        return false;
+    Image& image = pool_[idx];
+    if (!loadImage(files_[next_++], image)) {
+        free_.push(idx);
+        return false;
+    }
+    frame.image        = image.view();
+    frame.buffer       = idx;
+    frame.dmabuf_fd    = -1;
+    frame.sequence     = sequence_++;
+    frame.timestamp_ns = monoNowNs();
+    return true;
+}
+
+void ImageDirSource::release(const Frame& frame)
+{
+    if (frame.buffer >= 0)
+        free_.push(frame.buffer);
+}
+
+
+RawVideoSource::RawVideoSource(const std::string& path, int width, int height, bool loop, double fps, int buffers)
+    : width_(width), height_(height), loop_(loop),
+      interval_ns_(fps > 0 ? static_cast<uint64_t>(1e9 / fps) : 0),
+      buffers_(std::max(1, buffers)), free_(buffers_)
+{
+    for (int i = 0; i < buffers_; i++)
+        free_.push(i);
+
+    if (width <= 0 || height <= 0) {
+        std::cerr << "raw video needs a frame size (--size WxH)" << std::endl;
+        return;
+    }
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "raw video open failed: " << path << std::endl;
+        return;
+    }
+    struct stat st;
+    size_t frame_bytes = static_cast<size_t>(width) * height * 3;
+    if (fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= frame_bytes) {
+        map_bytes_ = static_cast<size_t>(st.st_size);
+        void* p = mmap(nullptr, map_bytes_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED) {
+            map_ = static_cast<uint8_t*>(p);
+            frames_ = map_bytes_ / frame_bytes;
+            madvise(map_, map_bytes_, MADV_SEQUENTIAL);
+        }
+        else
+            std::cerr << "raw video mmap failed: " << strerror(errno) << std::endl;
+    }
+    else
+        std::cerr << "raw video shorter than one " << width << "x" << height << " frame: " << path << std::endl;
+    close(fd);
+}
+
+RawVideoSource::~RawVideoSource()
+{
+    if (map_)
+        munmap(map_, map_bytes_);
+}
+
+bool RawVideoSource::acquire(Frame& frame)
+{
+    if (!map_)
+        return false;
+    if (next_ == frames_) {
+        if (!loop_)
+            return false;
+        next_ = 0;
+    }
+
+    int idx;
+    if (!free_.pop(idx))
+        return false;
+
+    // 카메라 frame rate 흉내: 정해진 시각까지 기다림 (밀리면 바로)
+    if (interval_ns_) {
+        uint64_t now = monoNowNs();
+        if (next_ns_ == 0 || next_ns_ < now)
+            next_ns_ = now;
+        struct timespec ts;
+        ts.tv_sec  = static_cast<time_t>(next_ns_ / 1000000000ull);
+        ts.tv_nsec = static_cast<long>(next_ns_ % 1000000000ull);
+        while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+        next_ns_ += interval_ns_;
+    }
+
+    frame.image.data   = map_ + next_++ * static_cast<size_t>(width_) * height_ * 3;
+    frame.image.width  = width_;
+    frame.image.height = height_;
+    frame.image.stride = width_ * 3;
+    frame.image.rgb    = false;
+    frame.buffer       = idx;
+    frame.dmabuf_fd    = -1;
+    frame.sequence     = sequence_++;
+    frame.timestamp_ns = monoNowNs();
+    return true;
+}
+
+void RawVideoSource::release(const Frame& frame)
+{
+    if (frame.buffer >= 0)
+        free_.push(frame.buffer);
+}
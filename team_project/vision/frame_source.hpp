@@ -0,0 +1,89 @@
+#ifndef FRAME_SOURCE_HPP
+#define FRAME_SOURCE_HPP
+
+#include "image.hpp"
+#include "../core/bounded_queue.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// source 가 빌려주는 프레임 (복사 없음), release() 할 때까지 image 가 유효
+struct Frame {
+    ImageView image;
+    int       buffer       = -1;   // source 의 buffer 번호 (release 에 씀)
+    int       dmabuf_fd    = -1;   // V4L2 EXPBUF 로 내보낸 fd (다른 장치에 넘길 때), 없으면 -1
+    uint32_t  sequence     = 0;    // source 의 프레임 번호 (빠진 번호 = driver 가 버린 프레임)
+    uint64_t  timestamp_ns = 0;    // 프레임이 만들어진 시각 (CLOCK_MONOTONIC, V4L2 는 driver timestamp)
+};
+
+// 검출기 입력 프레임 (카메라 V4L2, 파일 재생 / benchmark)
+// - acquire() 는 다음 프레임의 buffer 를 빌려줌, 끝나거나 오류면 false (loop 면 처음으로)
+// - 빌린 buffer 는 release() 로 돌려줘야 다시 쓰임 (bufferCount() 개를 다 빌리면 acquire 가 기다림)
+// - acquire 는 한 스레드, release 는 다른 스레드에서 불러도 됨 (pipeline 은 전처리 stage 가 release)
+class FrameSource {
+public:
+    virtual ~FrameSource() {}
+    virtual bool acquire(Frame& frame) = 0;
+    virtual void release(const Frame& frame) = 0;
+    virtual int bufferCount() const = 0;
+};
+
+// 디렉터리의 이미지들을 이름 순서로 (.ppm, libjpeg 가 있으면 .jpg/.jpeg 도)
+// buffers 개의 Image 에 돌아가며 decode
+class ImageDirSource : public FrameSource {
+public:
+    ImageDirSource(const std::string& dir, bool loop, int buffers = 4);
+
+    bool isOpen() const { return !files_.empty(); }
+    size_t count() const { return files_.size(); }
+
+    bool acquire(Frame& frame) override;
+    void release(const Frame& frame) override;
+    int bufferCount() const override { return static_cast<int>(pool_.size()); }
+
+private:
+    std::vector<std::string> files_;
+    size_t next_ = 0;
+    bool loop_;
+    uint32_t sequence_ = 0;
+    std::vector<Image> pool_;
+    BoundedQueue<int> free_;
+};
+
+// raw BGR24 영상 파일 (크기 고정, header 없음)
+// ffmpeg -i drive.mp4 -f rawvideo -pix_fmt bgr24 drive.bgr 로 만든다.
+// 파일 전체를 mmap → 프레임은 mapping 을 그대로 가리킴 (read / 복사 없음)
+// fps > 0 이면 카메라처럼 그 간격으로 내보냄, buffers 는 V4L2 buffer 수 흉내 (동시에 빌릴 수 있는 수)
+class RawVideoSource : public FrameSource {
+public:
+    RawVideoSource(const std::string& path, int width, int height, bool loop, double fps = 0, int buffers = 4);
+    ~RawVideoSource();
+
+    bool isOpen() const { return map_ != nullptr; }
+    size_t count() const { return frames_; }
+
+    bool acquire(Frame& frame) override;
+    void release(const Frame& frame) override;
+    int bufferCount() const override { return buffers_; }
+
+private:
+    uint8_t* map_ = nullptr;
+    size_t map_bytes_ = 0;
+    size_t frames_ = 0;
+    size_t next_ = 0;
+    int width_, height_;
+    bool loop_;
+    uint64_t interval_ns_;
+    uint64_t next_ns_ = 0;
+    uint32_t sequence_ = 0;
+    int buffers_;
+    BoundedQueue<int> free_;
+
+    RawVideoSource(const RawVideoSource&) = delete;
+    RawVideoSource& operator=(const RawVideoSource&) = delete;
+};
+
+// 이미지 파일 하나 읽기 (PPM P6, libjpeg 가 있으면 JPEG)
+bool loadImage(const std::string& path, Image& image);
+
+#endif
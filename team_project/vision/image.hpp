@@ -0,0 +1,49 @@
+#ifndef IMAGE_HPP
+#define IMAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 다른 곳의 packed 24bit pixel (V4L2 buffer, mmap 한 파일 등) 을 복사 없이 가리킴
+// 행 끝에 padding 이 있을 수 있으므로 stride 로 (V4L2 bytesperline)
+struct ImageView {
+    const uint8_t* data = nullptr;
+    int  width  = 0;
+    int  height = 0;
+    int  stride = 0;
+    bool rgb    = false;   // true: RGB24, false: BGR24
+
+    const uint8_t* row(int y) const { return data + static_cast<size_t>(y) * stride; }
+};
+
+// packed BGR24 이미지 (OpenCV Mat 기본 순서와 같음)
+// pixels 는 처음 크기로 잡아 두고 재사용 (같은 크기면 resize 가 할당하지 않음)
+struct Image {
+    int width  = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+
+    void resize(int w, int h)
+    {
+        width  = w;
+        height = h;
+        pixels.resize(static_cast<size_t>(w) * h * 3);
+    }
+
+    int stride() const { return width * 3; }
+    uint8_t*       row(int y)       { return &pixels[static_cast<size_t>(y) * stride()]; }
+    const uint8_t* row(int y) const { return &pixels[static_cast<size_t>(y) * stride()]; }
+
+    ImageView view() const
+    {
+        ImageView v;
+        v.data   = pixels.empty() ? nullptr : &pixels[0];
+        v.width  = width;
+        v.height = height;
+        v.stride = stride();
+        return v;
+    }
+};
+
+#endif
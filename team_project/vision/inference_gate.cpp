@@ -0,0 +1,109 @@
+#include "inference_gate.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+
+
+InferenceGate::InferenceGate() : InferenceGate(Config()) {}
+
+InferenceGate::InferenceGate(const Config& config)
+    : cfg_(config),
+      idle_period_ns_(config.idle_hz > 0 ? static_cast<uint64_t>(1e9 / config.idle_hz) : UINT64_MAX)
+{
+    memset(&stats_, 0, sizeof(stats_));
+    learned_ = PedalRegion{ 0.0f, 0.0f, 0.0f, 0.0f };
+}
+
+bool InferenceGate::shouldRun(uint64_t now_ns, const PedalState* pedal)
+{
+    bool fresh = pedal && pedal->sample_count > 0 &&
+                 now_ns < pedal->timestamp_ns + cfg_.stale_ms * 1000000ull;
+    Mode mode = GATE_NO_PEDAL;
+    if (fresh) {
+        if (pedal->thr_filtered >= cfg_.active_percent || pedal->slope >= cfg_.rising_slope)
+            active_until_ns_ = now_ns + cfg_.hold_ms * 1000000ull;
+        mode = now_ns < active_until_ns_ ? GATE_ACTIVE : GATE_IDLE;
+    }
+    mode_.store(mode, std::memory_order_relaxed);
+
+    bool run = mode != GATE_IDLE || last_run_ns_ == 0 || now_ns - last_run_ns_ >= idle_period_ns_;
+    if (run)
+        last_run_ns_ = now_ns;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.frames++;
+    stats_.runs += run;
+    stats_.active_frames += mode != GATE_IDLE;
+    return run;
+}
+
+bool InferenceGate::roi(PedalRegion& region)
+{
+    if (!cfg_.roi)
+        return false;
+    std::lock_guard<std::mutex> lock(mutex_);
+    roi_calls_++;
+    if (samples_ < cfg_.roi_min_samples || (cfg_.roi_refresh > 0 && roi_calls_ % cfg_.roi_refresh == 0))
+        return false;
+
+    float mx = (learned_.xmax - learned_.xmin) * cfg_.roi_margin;
+    float my = (learned_.ymax - learned_.ymin) * cfg_.roi_margin;
+    region.xmin = learned_.xmin - mx;
+    region.ymin = learned_.ymin - my;
+    region.xmax = learned_.xmax + mx;
+    region.ymax = learned_.ymax + my;
+    stats_.roi_runs++;
+    return true;
+}
+
+void InferenceGate::learn(const Detection* detections, int count)
+{
+    if (!cfg_.roi)
+        return;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (int i = 0; i < count; i++) {
+        const Detection& d = detections[i];
+        if (!inRegion(d.xmin, d.ymin, d.xmax, d.ymax, ACCEL_REGION) &&
+            !inRegion(d.xmin, d.ymin, d.xmax, d.ymax, BRAKE_REGION))
+            continue;
+
+        if (samples_++ == 0) {
+            learned_ = PedalRegion{ d.xmin, d.ymin, d.xmax, d.ymax };
+            continue;
+        }
+        // 밖으로는 바로 넓히고, 안쪽으로는 조금씩 (한동안 안 나온 위치는 천천히 빠짐)
+        float a = cfg_.roi_shrink;
+        learned_.xmin = std::min(d.xmin, learned_.xmin + (d.xmin - learned_.xmin) * a);
+        learned_.ymin = std::min(d.ymin, learned_.ymin + (d.ymin - learned_.ymin) * a);
+        learned_.xmax = std::max(d.xmax, learned_.xmax + (d.xmax - learned_.xmax) * a);
+        learned_.ymax = std::max(d.ymax, learned_.ymax + (d.ymax - learned_.ymax) * a);
+    }
+}
+
+InferenceGate::Stats InferenceGate::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+const char* InferenceGate::modeName(Mode mode)
+{
+    switch (mode) {
+    case GATE_ACTIVE: return "active";
+    case GATE_IDLE:   return "idle";
+    default:          return "no-pedal";
+    }
+}
+
+void InferenceGate::printStats(std::ostream& os) const
+{
+    Stats s = stats();
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    double saved = s.frames ? 100.0 * (s.frames - s.runs) / s.frames : 0.0;
+    os << std::fixed << std::setprecision(1)
+       << "gate: frames " << s.frames << ", inferences " << s.runs << " (" << saved << "% skipped)"
+       << ", active " << s.active_frames << ", roi " << s.roi_runs << "\n";
+    os.flags(flags);
+    os.precision(precision);
+}
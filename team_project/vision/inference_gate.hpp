@@ -0,0 +1,77 @@
+#ifndef INFERENCE_GATE_HPP
+#define INFERENCE_GATE_HPP
+
+#include "pedal_regions.hpp"
+#include "yolo_postprocess.hpp"
+#include "../sensors/pedal_sampler.hpp"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+
+// 페달 상태에 따라 검출 빈도를 정함 (운전자가 페달을 안 밟을 때 CPU 를 제어 쪽에 양보)
+// - throttle 이 active_percent 이상이거나 rising_slope 이상으로 올라가는 중이면 ACTIVE: 모든 프레임 검출
+// - 그 뒤 hold_ms 동안은 ACTIVE 유지 (발을 떼는 중의 검출도 필요)
+// - 그 외 IDLE: idle_hz 로만 검출
+// - 페달 상태가 없거나 stale_ms 보다 오래되면 (제어 프로세스 없음) 항상 검출
+// 선택: 페달 검출이 나온 영역을 학습해서 그 부분만 잘라 검출 (ROI), roi_refresh 번에 한 번은 전체 프레임
+// shouldRun 은 capture 스레드, roi / learn 은 전처리 / 후처리 스레드에서 불러도 됨
+class InferenceGate {
+public:
+    struct Config {
+        float    active_percent  = 10.0f;   // %
+        float    rising_slope    = 30.0f;   // %/s (PedalState::slope, 필터된 미분)
+        uint32_t hold_ms         = 1000;
+        float    idle_hz         = 2.0f;
+        uint32_t stale_ms        = 200;
+        bool     roi             = false;
+        float    roi_margin      = 0.15f;   // 학습한 영역 크기 대비 여유 (각 방향)
+        int      roi_min_samples = 20;      // 이만큼 검출이 쌓여야 자르기 시작
+        int      roi_refresh     = 30;      // N 번째 검출마다 전체 프레임 (영역 밖 물체 / 재학습)
+        float    roi_shrink      = 0.02f;   // 검출마다 학습 영역이 안쪽으로 줄어드는 비율 (밖으로는 바로 넓힘)
+    };
+
+    enum Mode { GATE_ACTIVE, GATE_IDLE, GATE_NO_PEDAL };
+
+    struct Stats {
+        uint64_t frames;         // shouldRun 호출 수
+        uint64_t runs;           // 검출한 프레임
+        uint64_t active_frames;  // ACTIVE / NO_PEDAL 이었던 프레임
+        uint64_t roi_runs;       // 잘라서 검출한 프레임
+    };
+
+    InferenceGate();
+    explicit InferenceGate(const Config& config);
+
+    // pedal: 최신 페달 상태 (모르면 nullptr)
+    bool shouldRun(uint64_t now_ns, const PedalState* pedal);
+    Mode mode() const { return mode_.load(std::memory_order_relaxed); }   // 다른 스레드 (status 출력) 에서 읽어도 됨
+
+    // 이번 검출에 쓸 영역 (입력 좌표), 자르지 않을 때는 false
+    bool roi(PedalRegion& region);
+    // 검출 결과 (전체 프레임 입력 좌표) 중 페달 영역의 것으로 ROI 학습
+    void learn(const Detection* detections, int count);
+
+    Stats stats() const;
+    void printStats(std::ostream& os) const;
+
+    static const char* modeName(Mode mode);
+
+private:
+    Config cfg_;
+
+    std::atomic<Mode> mode_{GATE_NO_PEDAL};   // capture 스레드만 씀
+
+    // capture 스레드 전용
+    uint64_t active_until_ns_ = 0;
+    uint64_t last_run_ns_ = 0;
+    uint64_t idle_period_ns_;
+
+    mutable std::mutex mutex_;
+    Stats stats_;
+    PedalRegion learned_;
+    int samples_ = 0;
+    uint64_t roi_calls_ = 0;
+};
+
+#endif
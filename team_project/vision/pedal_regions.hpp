@@ -0,0 +1,20 @@
+#ifndef PEDAL_REGIONS_HPP
+#define PEDAL_REGIONS_HPP
+
+// 카메라 영상에서 페달 영역 (입력 이미지 IMG_SIZE=416 좌표, tflite_yolo_picam.py 와 같은 값)
+struct PedalRegion {
+    float xmin, ymin, xmax, ymax;
+};
+
+constexpr PedalRegion ACCEL_REGION = { 60.0f, 260.0f, 312.0f, 400.0f };
+constexpr PedalRegion BRAKE_REGION = { 63.0f,  41.0f, 278.0f, 211.0f };
+
+// box 중심이 영역 안에 있으면 true (is_in_region 과 같음)
+inline bool inRegion(float xmin, float ymin, float xmax, float ymax, const PedalRegion& r)
+{
+    float xc = (xmin + xmax) / 2;
+    float yc = (ymin + ymax) / 2;
+    return r.xmin <= xc && xc <= r.xmax && r.ymin <= yc && yc <= r.ymax;
+}
+
+#endif
@@ -0,0 +1,355 @@
+#include "preprocess.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#if defined(__SSE2__)
+#define PRE_SSE2 1
+#include <emmintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define PRE_NEON 1
+#include <arm_neon.h>
+#endif
+
+
+namespace {
+
+constexpr int WEIGHT_BITS = 7;
+constexpr int WEIGHT_ONE  = 1 << WEIGHT_BITS;                 // 128
+constexpr int SHIFT       = WEIGHT_BITS * 2;                  // 가로 * 세로 가중치
+constexpr int ROUND       = 1 << (SHIFT - 1);
+
+// out[i] = (r0[i] * (128 - wy) + r1[i] * wy) >> 14 (반올림), r0 / r1 은 가로 보간 결과 (값 * 128)
+void blendRowsScalar(const int16_t* r0, const int16_t* r1, int wy, uint8_t* out, int begin, int n)
+{
+    int w0 = WEIGHT_ONE - wy;
+    for (int i = begin; i < n; i++)
+        out[i] = static_cast<uint8_t>((r0[i] * w0 + r1[i] * wy + ROUND) >> SHIFT);
+}
+
+#ifdef PRE_SSE2
+void blendRowsSse2(const int16_t* r0, const int16_t* r1, int wy, uint8_t* out, int n)
+{
+    // madd: (r0, r1) 쌍 * (w0, wy) → int32
+    const __m128i w = _mm_set1_epi32((wy << 16) | (WEIGHT_ONE - wy));
+    const __m128i round = _mm_set1_epi32(ROUND);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + i));
+        __m128i lo = _mm_madd_epi16(_mm_unpacklo_epi16(a, b), w);
+        __m128i hi = _mm_madd_epi16(_mm_unpackhi_epi16(a, b), w);
+        lo = _mm_srai_epi32(_mm_add_epi32(lo, round), SHIFT);
+        hi = _mm_srai_epi32(_mm_add_epi32(hi, round), SHIFT);
+        __m128i v = _mm_packs_epi32(lo, hi);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(v, v));
+    }
+    blendRowsScalar(r0, r1, wy, out, i, n);
+}
+
+// float 출력은 표 대신 v * scale + bias 를 바로 (RGB 순서 그대로일 때)
+void convertRowSse2(const uint8_t* values, int n, float scale, float bias, float* out)
+{
+    const __m128 s = _mm_set1_ps(scale), b = _mm_set1_ps(bias);
+    const __m128i zero = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i v  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+        __m128i lo = _mm_unpacklo_epi8(v, zero), hi = _mm_unpackhi_epi8(v, zero);
+        __m128i q[4] = { _mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero),
+                         _mm_unpacklo_epi16(hi, zero), _mm_unpackhi_epi16(hi, zero) };
+        for (int k = 0; k < 4; k++)
+            _mm_storeu_ps(out + i + k * 4, _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(q[k]), s), b));
+    }
+    for (; i < n; i++)
+        out[i] = values[i] * scale + bias;
+}
+#endif
+
+#ifdef PRE_NEON
+void convertRowNeon(const uint8_t* values, int n, float scale, float bias, float* out)
+{
+    const float32x4_t s = vdupq_n_f32(scale), b = vdupq_n_f32(bias);
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        uint16x8_t v = vmovl_u8(vld1_u8(values + i));
+        float32x4_t lo = vcvtq_f32_u32(vmovl_u16(vget_low_u16(v)));
+        float32x4_t hi = vcvtq_f32_u32(vmovl_u16(vget_high_u16(v)));
+        vst1q_f32(out + i, vaddq_f32(vmulq_f32(lo, s), b));
+        vst1q_f32(out + i + 4, vaddq_f32(vmulq_f32(hi, s), b));
+    }
+    for (; i < n; i++)
+        out[i] = values[i] * scale + bias;
+}
+
+void blendRowsNeon(const int16_t* r0, const int16_t* r1, int wy, uint8_t* out, int n)
+{
+    const int16x4_t w0 = vdup_n_s16(static_cast<int16_t>(WEIGHT_ONE - wy));
+    const int16x4_t w1 = vdup_n_s16(static_cast<int16_t>(wy));
+    int i = 0;
+    for (; i + 8 <= n; i += 8) {
+        int16x8_t a = vld1q_s16(r0 + i);
+        int16x8_t b = vld1q_s16(r1 + i);
+        int32x4_t lo = vmlal_s16(vmull_s16(vget_low_s16(a), w0), vget_low_s16(b), w1);
+        int32x4_t hi = vmlal_s16(vmull_s16(vget_high_s16(a), w0), vget_high_s16(b), w1);
+        int16x8_t v = vcombine_s16(vrshrn_n_s32(lo, SHIFT), vrshrn_n_s32(hi, SHIFT));
+        vst1_u8(out + i, vqmovun_s16(v));
+    }
+    blendRowsScalar(r0, r1, wy, out, i, n);
+}
+#endif
+
+void blendRows(const int16_t* r0, const int16_t* r1, int wy, uint8_t* out, int n, SimdLevel level)
+{
+    switch (level) {
+#ifdef PRE_SSE2
+    case SIMD_SSE2:
+    case SIMD_AVX2: blendRowsSse2(r0, r1, wy, out, n); break;
+#endif
+#ifdef PRE_NEON
+    case SIMD_NEON: blendRowsNeon(r0, r1, wy, out, n); break;
+#endif
+    default:        blendRowsScalar(r0, r1, wy, out, 0, n); break;
+    }
+}
+
+// 출력 좌표 → source 좌표 (cv2.INTER_LINEAR 정렬), 왼쪽 index 와 오른쪽 가중치
+void mapAxis(int dst_len, int src_len, std::vector<int32_t>& index, std::vector<int16_t>& weight)
+{
+    index.resize(dst_len);
+    weight.resize(dst_len);
+    float scale = static_cast<float>(src_len) / dst_len;
+    for (int i = 0; i < dst_len; i++) {
+        float f = std::max(0.0f, (i + 0.5f) * scale - 0.5f);
+        int i0 = std::min(static_cast<int>(f), src_len - 1);
+        index[i] = i0;
+        weight[i] = static_cast<int16_t>(i0 < src_len - 1 ? std::lround((f - i0) * WEIGHT_ONE) : 0);
+    }
+}
+
+template <typename T>
+void writePixels(const uint8_t* values, int count, const T* lut, bool swap_rb, T* dst)
+{
+    if (swap_rb) {
+        for (int i = 0; i < count; i++, values += 3, dst += 3) {
+            dst[0] = lut[values[2]];
+            dst[1] = lut[values[1]];
+            dst[2] = lut[values[0]];
+        }
+    }
+    else {
+        for (int i = 0; i < count * 3; i++)
+            dst[i] = lut[values[i]];
+    }
+}
+
+} // namespace
+
+
+size_t inputTypeSize(InputType type)
+{
+    return type == INPUT_FLOAT32 ? sizeof(float) : 1;
+}
+
+const char* inputTypeName(InputType type)
+{
+    switch (type) {
+    case INPUT_UINT8: return "uint8";
+    case INPUT_INT8:  return "int8";
+    default:          return "float32";
+    }
+}
+
+// cv2.INTER_LINEAR 와 같은 pixel 중심 정렬 (src = (dst + 0.5) * scale - 0.5, 가장자리 clamp)
+void resizeBilinear(const Image& src, Image& dst, int width, int height)
+{
+    dst.resize(width, height);
+    float sx = static_cast<float>(src.width) / width;
+    float sy = static_cast<float>(src.height) / height;
+
+    for (int y = 0; y < height; y++) {
+        float fy = std::max(0.0f, (y + 0.5f) * sy - 0.5f);
+        int y0 = std::min(static_cast<int>(fy), src.height - 1);
+        int y1 = std::min(y0 + 1, src.height - 1);
+        float wy = fy - y0;
+        const uint8_t* r0 = src.row(y0);
+        const uint8_t* r1 = src.row(y1);
+        uint8_t* out = dst.row(y);
+
+        for (int x = 0; x < width; x++) {
+            float fx = std::max(0.0f, (x + 0.5f) * sx - 0.5f);
+            int x0 = std::min(static_cast<int>(fx), src.width - 1);
+            int x1 = std::min(x0 + 1, src.width - 1);
+            float wx = fx - x0;
+
+            for (int c = 0; c < 3; c++) {
+                float top = r0[x0 * 3 + c] + (r0[x1 * 3 + c] - r0[x0 * 3 + c]) * wx;
+                float bot = r1[x0 * 3 + c] + (r1[x1 * 3 + c] - r1[x0 * 3 + c]) * wx;
+                out[x * 3 + c] = static_cast<uint8_t>(std::lround(top + (bot - top) * wy));
+            }
+        }
+    }
+}
+
+void normalizeToFloat(const Image& src, float* out)
+{
+    const float scale = 1.0f / 255.0f;
+    size_t n = src.pixels.size();
+    for (size_t i = 0; i < n; i++)
+        out[i] = src.pixels[i] * scale;
+}
+
+
+Preprocessor::Preprocessor() : Preprocessor(Config()) {}
+
+Preprocessor::Preprocessor(const Config& config)
+    : cfg_(config), level_(config.use_simd ? bestSimdLevel() : SIMD_SCALAR)
+{
+    memset(&geom_, 0, sizeof(geom_));
+    geom_.size = cfg_.size;
+    hrow_y_[0] = hrow_y_[1] = -1;
+
+    for (int v = 0; v < 256; v++) {
+        float f = v * cfg_.scale + cfg_.bias;
+        long q = std::lround(f / cfg_.q_scale) + cfg_.q_zero;
+        lut_f32_[v] = f;
+        lut_u8_[v]  = static_cast<uint8_t>(std::min(255L, std::max(0L, q)));
+        lut_i8_[v]  = static_cast<int8_t>(std::min(127L, std::max(-128L, q)));
+    }
+}
+
+// 입력 크기가 바뀔 때만 (카메라는 처음 한 번)
+void Preprocessor::prepare(int src_w, int src_h)
+{
+    int size = cfg_.size;
+    int cw = size, ch = size;
+    if (cfg_.letterbox) {
+        float r = std::min(static_cast<float>(size) / src_w, static_cast<float>(size) / src_h);
+        cw = std::min(size, std::max(1, static_cast<int>(std::lround(src_w * r))));
+        ch = std::min(size, std::max(1, static_cast<int>(std::lround(src_h * r))));
+    }
+    geom_.content_w = cw;
+    geom_.content_h = ch;
+    geom_.pad_x = (size - cw) / 2;
+    geom_.pad_y = (size - ch) / 2;
+
+    mapAxis(cw, src_w, xofs_, xw_);
+    xofs1_.resize(cw);
+    for (int x = 0; x < cw; x++) {
+        xofs1_[x] = std::min(xofs_[x] + 1, src_w - 1) * 3;
+        xofs_[x] *= 3;
+    }
+    mapAxis(ch, src_h, yofs_, yw_);
+
+    hrow_[0].assign(static_cast<size_t>(cw) * 3, 0);
+    hrow_[1].assign(static_cast<size_t>(cw) * 3, 0);
+    hrow_y_[0] = hrow_y_[1] = -1;
+    line_.assign(static_cast<size_t>(cw) * 3, 0);
+
+    src_w_ = src_w;
+    src_h_ = src_h;
+}
+
+// source 행 y 의 가로 보간 (값 * 128), other 는 같이 쓸 행이라 덮어쓰지 않음
+const int16_t* Preprocessor::horizontalRow(const ImageView& src, int y, int other)
+{
+    for (int k = 0; k < 2; k++) {
+        if (hrow_y_[k] == y)
+            return &hrow_[k][0];
+    }
+    int k = hrow_y_[0] == other ? 1 : 0;
+    hrow_y_[k] = y;
+
+    const uint8_t* row = src.row(y);
+    int16_t* out = &hrow_[k][0];
+    int cw = geom_.content_w;
+    for (int x = 0; x < cw; x++, out += 3) {
+        const uint8_t* p0 = row + xofs_[x];
+        const uint8_t* p1 = row + xofs1_[x];
+        int w1 = xw_[x], w0 = WEIGHT_ONE - w1;
+        out[0] = static_cast<int16_t>(p0[0] * w0 + p1[0] * w1);
+        out[1] = static_cast<int16_t>(p0[1] * w0 + p1[1] * w1);
+        out[2] = static_cast<int16_t>(p0[2] * w0 + p1[2] * w1);
+    }
+    return &hrow_[k][0];
+}
+
+// offset: 출력 tensor 의 element index
+void Preprocessor::writeRow(const uint8_t* values, int count, bool swap_rb, void* out, size_t offset) const
+{
+    switch (cfg_.type) {
+    case INPUT_UINT8:
+        writePixels(values, count, lut_u8_, swap_rb, static_cast<uint8_t*>(out) + offset);
+        break;
+    case INPUT_INT8:
+        writePixels(values, count, lut_i8_, swap_rb, static_cast<int8_t*>(out) + offset);
+        break;
+    default:
+#ifdef PRE_SSE2
+        if (!swap_rb && level_ != SIMD_SCALAR) {
+            convertRowSse2(values, count * 3, cfg_.scale, cfg_.bias, static_cast<float*>(out) + offset);
+            break;
+        }
+#endif
+#ifdef PRE_NEON
+        if (!swap_rb && level_ != SIMD_SCALAR) {
+            convertRowNeon(values, count * 3, cfg_.scale, cfg_.bias, static_cast<float*>(out) + offset);
+            break;
+        }
+#endif
+        writePixels(values, count, lut_f32_, swap_rb, static_cast<float*>(out) + offset);
+        break;
+    }
+}
+
+void Preprocessor::writePad(void* out, size_t offset, int pixels) const
+{
+    size_t n = static_cast<size_t>(pixels) * 3;
+    switch (cfg_.type) {
+    case INPUT_UINT8:
+        std::fill_n(static_cast<uint8_t*>(out) + offset, n, lut_u8_[cfg_.pad_value]);
+        break;
+    case INPUT_INT8:
+        std::fill_n(static_cast<int8_t*>(out) + offset, n, lut_i8_[cfg_.pad_value]);
+        break;
+    default:
+        std::fill_n(static_cast<float*>(out) + offset, n, lut_f32_[cfg_.pad_value]);
+        break;
+    }
+}
+
+void Preprocessor::run(const ImageView& src, void* out)
+{
+    if (src.width != src_w_ || src.height != src_h_)
+        prepare(src.width, src.height);
+
+    const int size = cfg_.size;
+    const int cw = geom_.content_w, ch = geom_.content_h;
+    const int pad_x = geom_.pad_x, pad_y = geom_.pad_y;
+    const int right = size - pad_x - cw;
+    const size_t row_elems = static_cast<size_t>(size) * 3;
+    const bool swap_rb = cfg_.swap_rb != src.rgb;
+
+    // 새 프레임이면 캐시한 가로 보간 행은 무효
+    hrow_y_[0] = hrow_y_[1] = -1;
+
+    if (pad_y > 0)
+        writePad(out, 0, pad_y * size);
+    for (int y = 0; y < ch; y++) {
+        int y0 = yofs_[y];
+        int y1 = std::min(y0 + 1, src.height - 1);
+        const int16_t* r0 = horizontalRow(src, y0, y1);
+        const int16_t* r1 = horizontalRow(src, y1, y0);
+        blendRows(r0, r1, yw_[y], &line_[0], cw * 3, level_);
+
+        size_t base = (pad_y + y) * row_elems;
+        if (pad_x > 0)
+            writePad(out, base, pad_x);
+        writeRow(&line_[0], cw, swap_rb, out, base + pad_x * 3);
+        if (right > 0)
+            writePad(out, base + (pad_x + cw) * 3, right);
+    }
+    int bottom = size - pad_y - ch;
+    if (bottom > 0)
+        writePad(out, (pad_y + ch) * row_elems, bottom * size);
+}
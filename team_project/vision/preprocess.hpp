@@ -0,0 +1,100 @@
+#ifndef PREPROCESS_HPP
+#define PREPROCESS_HPP
+
+#include "image.hpp"
+#include "simd.hpp"
+#include <cstdint>
+#include <vector>
+
+// 검출기 입력 tensor 의 element type
+enum InputType {
+    INPUT_FLOAT32 = 0,
+    INPUT_UINT8,
+    INPUT_INT8,
+};
+
+size_t inputTypeSize(InputType type);
+const char* inputTypeName(InputType type);
+
+// 전처리 결과가 입력 tensor 의 어디에 들어갔는지 (letterbox 면 가운데 content_w x content_h, 나머지는 pad)
+// 입력 좌표 → 늘려 맞춘 (letterbox 없는) 좌표: (x - pad_x) * size / content_w
+struct InputGeometry {
+    int size;
+    int pad_x, pad_y;
+    int content_w, content_h;
+};
+
+// source 프레임 중 잘라서 전처리한 부분 (ROI, source pixel 좌표)
+// 잘라낸 입력 좌표 → 전체 프레임 입력 좌표: (x_crop + x * width / size) * size / src_width
+struct CropWindow {
+    int x, y, width, height;
+    int src_width, src_height;
+};
+
+// 기준 경로 (tflite_yolo_picam.py 와 같은 단계, 중간 이미지 + 두 번 훑음)
+//   cv2.resize(frame, (size, size))      → resizeBilinear
+//   img.astype(np.float32) / 255.0       → normalizeToFloat
+void resizeBilinear(const Image& src, Image& dst, int width, int height);
+void normalizeToFloat(const Image& src, float* out);
+
+// 한 번에 하는 전처리: BGR / RGB 입력 (→ 모델 순서) + resize / letterbox + 정규화 또는 int8/uint8 양자화
+// 출력 tensor 버퍼 (interpreter 입력) 에 바로 씀, 중간 이미지 없음
+// - bilinear 는 cv2.INTER_LINEAR 와 같은 정렬, 7bit 고정소수 가중치 (기준 경로와 pixel 값 차이 ±1 이하)
+// - 세로 보간은 SIMD (SSE2 / NEON), 가로 위치 / 가중치 표는 입력 크기가 바뀔 때만 다시 계산
+// - 보간 결과 (0~255) → 출력 값은 256칸 표: float = v * scale + bias, 양자화 = round(float / q_scale) + q_zero
+// 한 스레드에서만 사용 (내부 행 버퍼)
+class Preprocessor {
+public:
+    struct Config {
+        int       size       = 416;
+        InputType type       = INPUT_FLOAT32;
+        bool      letterbox  = false;          // 비율 유지, 남는 곳은 pad_value
+        bool      swap_rb    = false;          // 모델 입력을 RGB 순서로 (RGB 로 학습된 경우)
+        uint8_t   pad_value  = 128;
+        float     scale      = 1.0f / 255.0f;
+        float     bias       = 0.0f;
+        float     q_scale    = 1.0f / 255.0f;  // INPUT_UINT8 / INPUT_INT8
+        int       q_zero     = 0;
+        bool      use_simd   = true;
+    };
+
+    Preprocessor();
+    explicit Preprocessor(const Config& config);
+
+    // out: size x size x 3 (NHWC), Config::type 의 element
+    // src 는 capture buffer 를 그대로 (ImageView), 읽기만 한 번
+    void run(const ImageView& src, void* out);
+    void run(const Image& src, void* out) { run(src.view(), out); }
+
+    const Config& config() const { return cfg_; }
+    const InputGeometry& geometry() const { return geom_; }
+    size_t outputBytes() const { return static_cast<size_t>(cfg_.size) * cfg_.size * 3 * inputTypeSize(cfg_.type); }
+    SimdLevel simdLevel() const { return level_; }
+
+private:
+    Config cfg_;
+    SimdLevel level_;
+    InputGeometry geom_;
+    int src_w_ = 0, src_h_ = 0;
+
+    std::vector<int32_t> xofs_;      // 출력 x 마다 왼쪽 / 오른쪽 source byte offset
+    std::vector<int32_t> xofs1_;
+    std::vector<int16_t> xw_;        // 오른쪽 가중치 (0~128)
+    std::vector<int32_t> yofs_;      // 출력 y 마다 위쪽 source 행
+    std::vector<int16_t> yw_;        // 아래쪽 가중치 (0~128)
+
+    std::vector<int16_t> hrow_[2];   // 가로 보간한 source 행 (다음 출력 행에서 재사용)
+    int hrow_y_[2];
+    std::vector<uint8_t> line_;      // 세로 보간까지 끝난 출력 한 행
+
+    float   lut_f32_[256];
+    uint8_t lut_u8_[256];
+    int8_t  lut_i8_[256];
+
+    void prepare(int src_w, int src_h);
+    const int16_t* horizontalRow(const ImageView& src, int y, int other);
+    void writeRow(const uint8_t* values, int count, bool swap_rb, void* out, size_t offset) const;
+    void writePad(void* out, size_t offset, int pixels) const;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+// vision kernel 들이 고르는 SIMD 종류
+// - x86: SSE2 는 항상 (x86-64 기본), AVX2 는 CPU 가 지원하면 (실행 중 확인, -mavx2 없이 빌드)
+// - ARM: NEON (armhf 는 -mfpu=neon 으로 빌드할 때)
+// - 그 외: scalar
+enum SimdLevel {
+    SIMD_SCALAR = 0,
+    SIMD_SSE2,
+    SIMD_AVX2,
+    SIMD_NEON,
+};
+
+inline SimdLevel bestSimdLevel()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+        return SIMD_AVX2;
+#ifdef __SSE2__
+    return SIMD_SSE2;
+#endif
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    return SIMD_NEON;
+#endif
+    return SIMD_SCALAR;
+}
+
+inline const char* simdName(SimdLevel level)
+{
+    switch (level) {
+    case SIMD_SSE2: return "sse2";
+    case SIMD_AVX2: return "avx2";
+    case SIMD_NEON: return "neon";
+    default:        return "scalar";
+    }
+}
+
+#endif
@@ -0,0 +1,112 @@
+#include "tflite_detector.hpp"
+#include <iostream>
+#include "tensorflow/lite/delegates/xnnpack/xnnpack_delegate.h"
+#include "tensorflow/lite/interpreter.h"
+#include "tensorflow/lite/kernels/register.h"
+#include "tensorflow/lite/model.h"
+
+
+struct TfliteDetector::Impl {
+    std::unique_ptr<tflite::FlatBufferModel> model;
+    std::unique_ptr<tflite::Interpreter> interpreter;
+    TfLiteDelegate* xnnpack = nullptr;
+
+    ~Impl()
+    {
+        interpreter.reset();   // delegate 보다 먼저 해제
+        if (xnnpack)
+            TfLiteXNNPackDelegateDelete(xnnpack);
+    }
+};
+
+
+TfliteDetector::TfliteDetector() {}
+
+TfliteDetector::~TfliteDetector() {}
+
+bool TfliteDetector::load(const std::string& model_path, int num_threads)
+{
+    std::unique_ptr<Impl> impl(new Impl);
+
+    impl->model = tflite::FlatBufferModel::BuildFromFile(model_path.c_str());
+    if (!impl->model) {
+        std::cerr << "tflite model load failed: " << model_path << std::endl;
+        return false;
+    }
+
+    tflite::ops::builtin::BuiltinOpResolverWithoutDefaultDelegates resolver;
+    if (tflite::InterpreterBuilder(*impl->model, resolver)(&impl->interpreter) != kTfLiteOk || !impl->interpreter) {
+        std::cerr << "tflite interpreter build failed" << std::endl;
+        return false;
+    }
+    impl->interpreter->SetNumThreads(num_threads);
+
+    TfLiteXNNPackDelegateOptions options = TfLiteXNNPackDelegateOptionsDefault();
+    options.num_threads = num_threads;
+    impl->xnnpack = TfLiteXNNPackDelegateCreate(&options);
+    if (impl->interpreter->ModifyGraphWithDelegate(impl->xnnpack) != kTfLiteOk)
+        std::cerr << "XNNPACK delegate not applied, using builtin kernels" << std::endl;
+
+    if (impl->interpreter->AllocateTensors() != kTfLiteOk) {
+        std::cerr << "tflite AllocateTensors failed" << std::endl;
+        return false;
+    }
+
+    const TfLiteTensor* in = impl->interpreter->input_tensor(0);
+    if ((in->type != kTfLiteFloat32 && in->type != kTfLiteUInt8 && in->type != kTfLiteInt8) ||
+        in->dims->size != 4 || in->dims->data[1] != in->dims->data[2] || in->dims->data[3] != 3) {
+        std::cerr << "unexpected input tensor (need [1,S,S,3] float32 / uint8 / int8)" << std::endl;
+        return false;
+    }
+    if (impl->interpreter->outputs().size() < 2) {
+        std::cerr << "model needs box and score outputs" << std::endl;
+        return false;
+    }
+    const TfLiteTensor* loc = impl->interpreter->output_tensor(0);
+    const TfLiteTensor* cls = impl->interpreter->output_tensor(1);
+    if (loc->type != kTfLiteFloat32 || cls->type != kTfLiteFloat32 ||
+        loc->dims->size != 3 || cls->dims->size != 3 || loc->dims->data[2] != 4 ||
+        loc->dims->data[1] != cls->dims->data[1]) {
+        std::cerr << "unexpected output tensors (need [1,N,4] and [1,N,C] float32)" << std::endl;
+        return false;
+    }
+
+    input_size_  = in->dims->data[1];
+    input_type_  = in->type == kTfLiteUInt8 ? INPUT_UINT8 : in->type == kTfLiteInt8 ? INPUT_INT8 : INPUT_FLOAT32;
+    input_scale_ = in->type == kTfLiteFloat32 ? 1.0f : in->params.scale;
+    input_zero_  = in->type == kTfLiteFloat32 ? 0 : in->params.zero_point;
+    num_boxes_   = loc->dims->data[1];
+    num_classes_ = cls->dims->data[2];
+    impl_.swap(impl);
+
+    std::cout << "tflite model " << model_path << ": input " << input_size_ << "x" << input_size_
+              << " " << inputTypeName(input_type_) << ", " << num_boxes_ << " boxes, " << num_classes_ << " classes, "
+              << num_threads << " threads" << std::endl;
+    return true;
+}
+
+void TfliteDetector::inputQuantization(float& scale, int& zero_point) const
+{
+    scale = input_scale_;
+    zero_point = input_zero_;
+}
+
+void* TfliteDetector::input()
+{
+    return impl_->interpreter->input_tensor(0)->data.raw;
+}
+
+bool TfliteDetector::invoke()
+{
+    return impl_->interpreter->Invoke() == kTfLiteOk;
+}
+
+const float* TfliteDetector::boxes() const
+{
+    return impl_->interpreter->typed_output_tensor<float>(0);
+}
+
+const float* TfliteDetector::scores() const
+{
+    return impl_->interpreter->typed_output_tensor<float>(1);
+}
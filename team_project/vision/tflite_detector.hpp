@@ -0,0 +1,45 @@
+#ifndef TFLITE_DETECTOR_HPP
+#define TFLITE_DETECTOR_HPP
+
+#include "detector.hpp"
+#include <memory>
+#include <string>
+
+// TFLite C++ interpreter backend (XNNPACK delegate, 스레드 수 설정)
+// CMake -DMISPEDAL_WITH_TFLITE=ON 일 때만 빌드 (tensorflow-lite 헤더 / 라이브러리 필요)
+// 입력 0: [1, size, size, 3] float32 / uint8 / int8 (양자화 모델), 출력 0: [1, N, 4] box, 출력 1: [1, N, C] score (yolov4-tiny.tflite)
+// tflite 헤더는 .cpp 에만 include → 이 헤더를 쓰는 쪽은 C++11 그대로
+class TfliteDetector : public Detector {
+public:
+    TfliteDetector();
+    ~TfliteDetector();
+
+    bool load(const std::string& model_path, int num_threads);
+
+    int inputSize() const override { return input_size_; }
+    InputType inputType() const override { return input_type_; }
+    void inputQuantization(float& scale, int& zero_point) const override;
+    void* input() override;
+    bool invoke() override;
+
+    int numBoxes() const override { return num_boxes_; }
+    int numClasses() const override { return num_classes_; }
+    const float* boxes() const override;
+    const float* scores() const override;
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> impl_;
+
+    int input_size_  = 0;
+    InputType input_type_ = INPUT_FLOAT32;
+    float input_scale_ = 1.0f;
+    int input_zero_    = 0;
+    int num_boxes_   = 0;
+    int num_classes_ = 0;
+
+    TfliteDetector(const TfliteDetector&) = delete;
+    TfliteDetector& operator=(const TfliteDetector&) = delete;
+};
+
+#endif
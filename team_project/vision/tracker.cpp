@@ -0,0 +1,220 @@
+#include "tracker.hpp"
+#include <algorithm>
+
+
+namespace {
+
+constexpr float INITIAL_VELOCITY_VAR = 200.0f * 200.0f;   // (px/s)^2, 처음 본 box 의 속도는 모름
+
+float seconds(uint64_t from_ns, uint64_t to_ns)
+{
+    return to_ns > from_ns ? (to_ns - from_ns) / 1e9f : 0.0f;
+}
+
+} // namespace
+
+
+Tracker::Tracker() : Tracker(Config()) {}
+
+Tracker::Tracker(const Config& config) : cfg_(config)
+{
+    tracks_.reserve(config.max_tracks);
+    predicted_.resize(config.max_tracks);
+    iou_.resize(static_cast<size_t>(config.max_tracks) * config.max_detections);
+    det_track_.resize(config.max_detections);
+}
+
+void Tracker::reset()
+{
+    tracks_.clear();
+    next_id_ = 1;
+}
+
+uint32_t Tracker::pedalClass(const Detection& d)
+{
+    if (inRegion(d.xmin, d.ymin, d.xmax, d.ymax, ACCEL_REGION))
+        return DET_ACCEL;
+    if (inRegion(d.xmin, d.ymin, d.xmax, d.ymax, BRAKE_REGION))
+        return DET_BRAKE;
+    return DET_NONE;
+}
+
+void Tracker::predictAxis(Axis& a, float dt) const
+{
+    float q = cfg_.accel_noise * cfg_.accel_noise;
+    a.x   += a.v * dt;
+    a.p00 += 2 * dt * a.p01 + dt * dt * a.p11 + q * dt * dt * dt / 3;
+    a.p01 += dt * a.p11 + q * dt * dt / 2;
+    a.p11 += q * dt;
+}
+
+void Tracker::correctAxis(Axis& a, float z) const
+{
+    float s  = a.p00 + cfg_.measure_noise * cfg_.measure_noise;
+    float k0 = a.p00 / s;
+    float k1 = a.p01 / s;
+    float y  = z - a.x;
+    a.x += k0 * y;
+    a.v += k1 * y;
+    a.p11 -= k1 * a.p01;
+    a.p00 *= 1 - k0;
+    a.p01 *= 1 - k0;
+}
+
+Detection Tracker::boxAt(const Entry& e, uint64_t now_ns) const
+{
+    float dt = seconds(e.t_ns, now_ns);
+    float cx = e.axis[0].x + e.axis[0].v * dt;
+    float cy = e.axis[1].x + e.axis[1].v * dt;
+    float w  = std::max(1.0f, e.axis[2].x + e.axis[2].v * dt);
+    float h  = std::max(1.0f, e.axis[3].x + e.axis[3].v * dt);
+    Detection d;
+    d.xmin  = cx - w / 2;
+    d.xmax  = cx + w / 2;
+    d.ymin  = cy - h / 2;
+    d.ymax  = cy + h / 2;
+    d.score = e.confidence;
+    d.label = e.last.label;
+    return d;
+}
+
+void Tracker::vote(Entry& e, const Detection& d, bool first)
+{
+    uint32_t c = pedalClass(d);
+    if (first) {
+        for (int k = 0; k < 3; k++)
+            e.votes[k] = k == static_cast<int>(c) ? 1.0f : 0.0f;
+        e.cls = c;
+        return;
+    }
+    int best = 0;
+    for (int k = 0; k < 3; k++) {
+        e.votes[k] += cfg_.class_alpha * ((k == static_cast<int>(c) ? 1.0f : 0.0f) - e.votes[k]);
+        if (e.votes[k] > e.votes[best])
+            best = k;
+    }
+    if (static_cast<uint32_t>(best) != e.cls && e.votes[best] >= e.votes[e.cls] + cfg_.class_margin)
+        e.cls = best;
+}
+
+int Tracker::update(uint64_t now_ns, const Detection* detections, int count, Track* out, int max_out)
+{
+    int n_tracks = static_cast<int>(tracks_.size());
+
+    // 1. 예측
+    for (int t = 0; t < n_tracks; t++) {
+        Entry& e = tracks_[t];
+        float dt = seconds(e.t_ns, now_ns);
+        for (int k = 0; k < 4; k++)
+            predictAxis(e.axis[k], dt);
+        e.t_ns = now_ns;
+        e.detected = false;
+        predicted_[t] = boxAt(e, now_ns);
+    }
+
+    // 2. IoU 큰 순서로 greedy 연결
+    count = std::min(count, cfg_.max_detections);
+    for (int t = 0; t < n_tracks; t++)
+        for (int d = 0; d < count; d++)
+            iou_[t * count + d] = iou(predicted_[t], detections[d]);
+    for (int d = 0; d < count; d++)
+        det_track_[d] = -1;
+
+    for (;;) {
+        float best = cfg_.iou_threshold;
+        int bt = -1, bd = -1;
+        for (int t = 0; t < n_tracks; t++)
+            for (int d = 0; d < count; d++)
+                if (iou_[t * count + d] >= best) {
+                    best = iou_[t * count + d];
+                    bt = t;
+                    bd = d;
+                }
+        if (bt < 0)
+            break;
+        det_track_[bd] = bt;
+        for (int d = 0; d < count; d++)
+            iou_[bt * count + d] = -1.0f;
+        for (int t = 0; t < n_tracks; t++)
+            iou_[t * count + bd] = -1.0f;
+    }
+
+    // 3. 보정 / 새 track
+    for (int d = 0; d < count; d++) {
+        const Detection& det = detections[d];
+        float z[4] = { (det.xmin + det.xmax) / 2, (det.ymin + det.ymax) / 2,
+                       det.xmax - det.xmin, det.ymax - det.ymin };
+        int t = det_track_[d];
+        if (t >= 0) {
+            Entry& e = tracks_[t];
+            for (int k = 0; k < 4; k++)
+                correctAxis(e.axis[k], z[k]);
+            e.confidence += cfg_.score_alpha * (det.score - e.confidence);
+            e.hits++;
+            e.detected = true;
+            e.last = det;
+            e.last_seen_ns = now_ns;
+            vote(e, boxAt(e, now_ns), false);
+        }
+        else if (static_cast<int>(tracks_.size()) < cfg_.max_tracks) {
+            Entry e;
+            e.id = next_id_++;
+            for (int k = 0; k < 4; k++) {
+                Axis& a = e.axis[k];
+                a.x = z[k];
+                a.v = 0.0f;
+                a.p00 = cfg_.measure_noise * cfg_.measure_noise;
+                a.p01 = 0.0f;
+                a.p11 = INITIAL_VELOCITY_VAR;
+            }
+            e.t_ns = now_ns;
+            e.last = det;
+            e.confidence = det.score;
+            e.hits = 1;
+            e.last_seen_ns = now_ns;
+            e.detected = true;
+            vote(e, det, true);
+            tracks_.push_back(e);
+        }
+    }
+
+    // 4. 놓친 track 은 confidence 를 줄이고, 오래 못 본 track 은 지움
+    uint64_t max_age_ns = cfg_.max_age_ms * 1000000ull;
+    size_t keep = 0;
+    for (size_t t = 0; t < tracks_.size(); t++) {
+        Entry& e = tracks_[t];
+        if (!e.detected)
+            e.confidence *= cfg_.miss_decay;
+        if (now_ns > e.last_seen_ns && now_ns - e.last_seen_ns > max_age_ns)
+            continue;
+        tracks_[keep++] = e;
+    }
+    tracks_.resize(keep);
+
+    return output(now_ns, out, max_out, false);
+}
+
+int Tracker::predict(uint64_t now_ns, Track* out, int max_out) const
+{
+    return output(now_ns, out, max_out, true);
+}
+
+int Tracker::output(uint64_t now_ns, Track* out, int max_out, bool predicted_only) const
+{
+    uint64_t max_age_ns = cfg_.max_age_ms * 1000000ull;
+    int n = 0;
+    for (size_t t = 0; t < tracks_.size() && n < max_out; t++) {
+        const Entry& e = tracks_[t];
+        if (e.hits < cfg_.min_hits || (now_ns > e.last_seen_ns && now_ns - e.last_seen_ns > max_age_ns))
+            continue;
+        Track& o = out[n++];
+        o.id           = e.id;
+        o.box          = boxAt(e, now_ns);
+        o.cls          = e.cls;
+        o.confidence   = e.confidence;
+        o.hits         = e.hits;
+        o.last_seen_ns = e.last_seen_ns;
+        o.detected     = !predicted_only && e.detected;
+    }
+    return n;
+}
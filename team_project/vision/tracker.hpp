@@ -0,0 +1,93 @@
+#ifndef TRACKER_HPP
+#define TRACKER_HPP
+
+#include "pedal_regions.hpp"
+#include "yolo_postprocess.hpp"
+#include "../core/detection_channel.hpp"
+#include <cstdint>
+#include <vector>
+
+// 검출 사이 프레임에도 box / 페달 class 를 내기 위한 tracker (SORT 방식)
+struct Track {
+    uint32_t  id;
+    Detection box;            // 예측한 box (입력 좌표), label 은 마지막으로 맞춘 검출의 것
+    uint32_t  cls;            // DetectionClass, 시간으로 다듬은 페달 class
+    float     confidence;     // score 의 EMA (놓친 검출마다 줄어듦)
+    uint32_t  hits;           // 맞춘 검출 수
+    uint64_t  last_seen_ns;   // 마지막으로 검출과 맞춘 프레임 시각
+    bool      detected;       // 이 프레임의 검출과 맞췄는지 (false 면 예측만)
+};
+
+// SORT: box 마다 등속 Kalman filter + IoU 로 검출과 연결
+// - 상태는 중심 / 크기 (cx, cy, w, h) 와 각각의 속도, 축마다 따로인 2 x 2 filter (Q / R 이 대각이라 SORT 의 7 상태와 같음)
+// - 검출 간격이 일정하지 않으므로 (N 프레임마다 / gate) dt 는 프레임 시각으로
+// - 연결은 IoU 큰 순서로 greedy (페달 / 발 box 몇 개라 Hungarian 과 차이 없음)
+// - 페달 class 는 검출마다 (ACCEL / BRAKE / NONE 영역) 투표해 EMA, 다른 class 가 class_margin 이상 앞서야 바뀜 (깜빡임 방지)
+// - max_age_ms 동안 검출이 없으면 지움, min_hits 번 맞춰야 출력
+// track / scratch 는 생성할 때 잡아 두므로 update / predict 에서 할당 없음
+class Tracker {
+public:
+    struct Config {
+        int      max_tracks      = 16;
+        int      max_detections  = 32;       // 검출 프레임 하나에서 보는 최대 수 (나머지는 무시)
+        float    iou_threshold   = 0.3f;
+        uint32_t max_age_ms      = 600;
+        uint32_t min_hits        = 2;
+        float    accel_noise     = 400.0f;   // px/s^2 (process noise, 발이 움직이는 정도)
+        float    measure_noise   = 4.0f;     // px (검출 box 흔들림)
+        float    class_alpha     = 0.35f;    // 페달 class 투표 EMA
+        float    class_margin    = 0.2f;
+        float    score_alpha     = 0.4f;
+        float    miss_decay      = 0.8f;     // 검출 프레임에서 놓쳤을 때 confidence 배율
+    };
+
+    Tracker();
+    explicit Tracker(const Config& config);
+
+    // 검출한 프레임: 모든 track 을 now_ns 로 예측 → 연결 → 보정, 새 track 생성, 오래된 track 삭제
+    // 출력할 (min_hits 이상) track 을 out 에 max_out 개까지 쓰고 개수 반환
+    int update(uint64_t now_ns, const Detection* detections, int count, Track* out, int max_out);
+    // 검출하지 않은 프레임: now_ns 의 예측 box (상태는 바꾸지 않음)
+    int predict(uint64_t now_ns, Track* out, int max_out) const;
+
+    int      size() const { return static_cast<int>(tracks_.size()); }
+    int      capacity() const { return cfg_.max_tracks; }
+    uint64_t created() const { return next_id_ - 1; }
+    void reset();
+
+    static uint32_t pedalClass(const Detection& d);
+
+private:
+    // 한 축의 위치 / 속도 Kalman filter
+    struct Axis {
+        float x, v;
+        float p00, p01, p11;
+    };
+    struct Entry {
+        uint32_t  id;
+        Axis      axis[4];       // cx, cy, w, h
+        uint64_t  t_ns;          // axis 상태의 시각
+        Detection last;
+        float     votes[3];      // DET_NONE / DET_ACCEL / DET_BRAKE
+        uint32_t  cls;
+        float     confidence;
+        uint32_t  hits;
+        uint64_t  last_seen_ns;
+        bool      detected;
+    };
+
+    Config cfg_;
+    std::vector<Entry> tracks_;
+    std::vector<float> iou_;             // tracks x detections
+    std::vector<int>   det_track_;       // 검출 → track (-1: 새 track)
+    std::vector<Detection> predicted_;
+    uint32_t next_id_ = 1;
+
+    void predictAxis(Axis& a, float dt) const;
+    void correctAxis(Axis& a, float z) const;
+    Detection boxAt(const Entry& e, uint64_t now_ns) const;
+    void vote(Entry& e, const Detection& d, bool first);
+    int  output(uint64_t now_ns, Track* out, int max_out, bool predicted_only) const;
+};
+
+#endif
@@ -0,0 +1,243 @@
+#include "v4l2_source.hpp"
+#include "../core/mono_clock.hpp"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <linux/videodev2.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+namespace {
+
+constexpr int FRAME_TIMEOUT_MS = 2000;   // 이 시간 동안 프레임이 없으면 카메라 오류로 봄
+
+int xioctl(int fd, unsigned long request, void* arg)
+{
+    int r;
+    do {
+        r = ioctl(fd, request, arg);
+    } while (r < 0 && errno == EINTR);
+    return r;
+}
+
+void logError(const char* what)
+{
+    std::cerr << "v4l2 " << what << " failed: " << strerror(errno) << std::endl;
+}
+
+} // namespace
+
+
+V4l2Source::V4l2Source(const std::string& device, int width, int height, double fps, int buffers,
+                       bool export_dmabuf)
+{
+    if (!open(device, width, height, fps, buffers, export_dmabuf))
+        close();
+}
+
+V4l2Source::~V4l2Source()
+{
+    close();
+}
+
+bool V4l2Source::open(const std::string& device, int width, int height, double fps, int buffers,
+                      bool export_dmabuf)
+{
+    fd_ = ::open(device.c_str(), O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if (fd_ < 0) {
+        std::cerr << "camera open failed: " << device << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct v4l2_capability cap;
+    memset(&cap, 0, sizeof(cap));
+    if (xioctl(fd_, VIDIOC_QUERYCAP, &cap) < 0) {
+        logError("VIDIOC_QUERYCAP");
+        return false;
+    }
+    uint32_t caps = (cap.capabilities & V4L2_CAP_DEVICE_CAPS) ? cap.device_caps : cap.capabilities;
+    if (!(caps & V4L2_CAP_VIDEO_CAPTURE) || !(caps & V4L2_CAP_STREAMING)) {
+        std::cerr << device << ": not a streaming capture device" << std::endl;
+        return false;
+    }
+
+    // BGR24 우선 (OpenCV 순서), 안 되면 RGB24 (전처리에서 순서만 바꿈)
+    struct v4l2_format fmt;
+    const uint32_t formats[2] = { V4L2_PIX_FMT_BGR24, V4L2_PIX_FMT_RGB24 };
+    bool format_ok = false;
+    for (int i = 0; i < 2 && !format_ok; i++) {
+        memset(&fmt, 0, sizeof(fmt));
+        fmt.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        fmt.fmt.pix.width       = width;
+        fmt.fmt.pix.height      = height;
+        fmt.fmt.pix.pixelformat = formats[i];
+        fmt.fmt.pix.field       = V4L2_FIELD_NONE;
+        format_ok = xioctl(fd_, VIDIOC_S_FMT, &fmt) == 0 && fmt.fmt.pix.pixelformat == formats[i];
+    }
+    if (!format_ok) {
+        std::cerr << device << ": BGR24 / RGB24 not supported" << std::endl;
+        return false;
+    }
+    width_  = fmt.fmt.pix.width;
+    height_ = fmt.fmt.pix.height;
+    stride_ = fmt.fmt.pix.bytesperline ? static_cast<int>(fmt.fmt.pix.bytesperline) : width_ * 3;
+    rgb_    = fmt.fmt.pix.pixelformat == V4L2_PIX_FMT_RGB24;
+
+    if (fps > 0) {
+        struct v4l2_streamparm parm;
+        memset(&parm, 0, sizeof(parm));
+        parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        parm.parm.capture.timeperframe.numerator   = 1000;
+        parm.parm.capture.timeperframe.denominator = static_cast<uint32_t>(fps * 1000);
+        if (xioctl(fd_, VIDIOC_S_PARM, &parm) < 0)
+            logError("VIDIOC_S_PARM");   // frame rate 설정은 없어도 동작
+    }
+
+    struct v4l2_requestbuffers req;
+    memset(&req, 0, sizeof(req));
+    req.count  = buffers;
+    req.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    req.memory = V4L2_MEMORY_MMAP;
+    if (xioctl(fd_, VIDIOC_REQBUFS, &req) < 0 || req.count < 2) {
+        logError("VIDIOC_REQBUFS");
+        return false;
+    }
+
+    Buffer unmapped = { MAP_FAILED, 0, -1 };
+    buffers_.assign(req.count, unmapped);
+    for (uint32_t i = 0; i < req.count; i++) {
+        Buffer& b = buffers_[i];
+        struct v4l2_buffer buf;
+        memset(&buf, 0, sizeof(buf));
+        buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        buf.index  = i;
+        if (xioctl(fd_, VIDIOC_QUERYBUF, &buf) < 0) {
+            logError("VIDIOC_QUERYBUF");
+            return false;
+        }
+        b.length = buf.length;
+        b.start  = mmap(nullptr, buf.length, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, buf.m.offset);
+        if (b.start == MAP_FAILED) {
+            logError("mmap");
+            return false;
+        }
+
+        if (export_dmabuf) {
+            struct v4l2_exportbuffer exp;
+            memset(&exp, 0, sizeof(exp));
+            exp.type  = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            exp.index = i;
+            exp.flags = O_RDONLY | O_CLOEXEC;
+            if (xioctl(fd_, VIDIOC_EXPBUF, &exp) == 0)
+                b.dmabuf_fd = exp.fd;
+            else
+                logError("VIDIOC_EXPBUF");
+        }
+
+        if (xioctl(fd_, VIDIOC_QBUF, &buf) < 0) {
+            logError("VIDIOC_QBUF");
+            return false;
+        }
+    }
+
+    int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    if (xioctl(fd_, VIDIOC_STREAMON, &type) < 0) {
+        logError("VIDIOC_STREAMON");
+        return false;
+    }
+    streaming_ = true;
+
+    std::cout << "camera " << device << ": " << width_ << "x" << height_ << (rgb_ ? " RGB24" : " BGR24")
+              << ", " << buffers_.size() << " mmap buffers" << (export_dmabuf ? " (dmabuf exported)" : "")
+              << std::endl;
+    return true;
+}
+
+void V4l2Source::close()
+{
+    if (streaming_) {
+        int type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        xioctl(fd_, VIDIOC_STREAMOFF, &type);
+        streaming_ = false;
+    }
+    for (size_t i = 0; i < buffers_.size(); i++) {
+        if (buffers_[i].dmabuf_fd >= 0)
+            ::close(buffers_[i].dmabuf_fd);
+        if (buffers_[i].start != MAP_FAILED)
+            munmap(buffers_[i].start, buffers_[i].length);
+    }
+    buffers_.clear();
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+bool V4l2Source::acquire(Frame& frame)
+{
+    if (!streaming_)
+        return false;
+
+    struct v4l2_buffer buf;
+    for (;;) {
+        memset(&buf, 0, sizeof(buf));
+        buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+        buf.memory = V4L2_MEMORY_MMAP;
+        if (xioctl(fd_, VIDIOC_DQBUF, &buf) == 0)
+            break;
+        if (errno != EAGAIN) {
+            logError("VIDIOC_DQBUF");
+            return false;
+        }
+        // 모든 buffer 를 빌려준 상태면 release 될 때까지 여기서 기다림 (driver 는 그동안 프레임을 버림)
+        struct pollfd pfd = { fd_, POLLIN, 0 };
+        int r = poll(&pfd, 1, FRAME_TIMEOUT_MS);
+        if (r == 0) {
+            std::cerr << "camera: no frame for " << FRAME_TIMEOUT_MS << " ms" << std::endl;
+            return false;
+        }
+        if (r < 0 && errno != EINTR) {
+            logError("poll");
+            return false;
+        }
+    }
+
+    if (!first_ && buf.sequence > last_sequence_ + 1)
+        dropped_ += buf.sequence - last_sequence_ - 1;
+    first_ = false;
+    last_sequence_ = buf.sequence;
+
+    const Buffer& b = buffers_[buf.index];
+    frame.image.data   = static_cast<const uint8_t*>(b.start);
+    frame.image.width  = width_;
+    frame.image.height = height_;
+    frame.image.stride = stride_;
+    frame.image.rgb    = rgb_;
+    frame.buffer       = static_cast<int>(buf.index);
+    frame.dmabuf_fd    = b.dmabuf_fd;
+    frame.sequence     = buf.sequence;
+    if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) == V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC)
+        frame.timestamp_ns = static_cast<uint64_t>(buf.timestamp.tv_sec) * 1000000000ull +
+                             static_cast<uint64_t>(buf.timestamp.tv_usec) * 1000ull;
+    else
+        frame.timestamp_ns = monoNowNs();
+    return true;
+}
+
+void V4l2Source::release(const Frame& frame)
+{
+    if (!streaming_ || frame.buffer < 0)
+        return;
+    struct v4l2_buffer buf;
+    memset(&buf, 0, sizeof(buf));
+    buf.type   = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+    buf.memory = V4L2_MEMORY_MMAP;
+    buf.index  = frame.buffer;
+    if (xioctl(fd_, VIDIOC_QBUF, &buf) < 0)
+        logError("VIDIOC_QBUF");
+}
@@ -0,0 +1,53 @@
+#ifndef V4L2_SOURCE_HPP
+#define V4L2_SOURCE_HPP
+
+#include "frame_source.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// V4L2 streaming capture (mmap buffer), cv2.VideoCapture 대체
+// - driver 가 DMA 로 채운 buffer 를 그대로 빌려줌 (DQBUF), release() 에서 QBUF 로 돌려줌 → 프레임 복사 없음
+// - export_dmabuf 면 buffer 마다 VIDIOC_EXPBUF 로 DMABUF fd 도 만들어 Frame::dmabuf_fd 로 넘김
+// - 형식은 BGR24 (없으면 RGB24), Pi camera (bcm2835-v4l2 / libcamera v4l2 호환) 가 지원
+// - timestamp 는 driver 가 찍은 CLOCK_MONOTONIC (노출 시점 기준), sequence 가 빠지면 dropped 로 셈
+class V4l2Source : public FrameSource {
+public:
+    V4l2Source(const std::string& device, int width, int height, double fps, int buffers = 4,
+               bool export_dmabuf = false);
+    ~V4l2Source();
+
+    bool isOpen() const { return streaming_; }
+    int width() const { return width_; }
+    int height() const { return height_; }
+    uint64_t dropped() const { return dropped_; }
+
+    bool acquire(Frame& frame) override;
+    void release(const Frame& frame) override;
+    int bufferCount() const override { return static_cast<int>(buffers_.size()); }
+
+private:
+    struct Buffer {
+        void*  start;
+        size_t length;
+        int    dmabuf_fd;
+    };
+
+    int fd_ = -1;
+    int width_ = 0, height_ = 0, stride_ = 0;
+    bool rgb_ = false;
+    bool streaming_ = false;
+    std::vector<Buffer> buffers_;
+    uint32_t last_sequence_ = 0;
+    bool first_ = true;
+    std::atomic<uint64_t> dropped_{0};
+
+    bool open(const std::string& device, int width, int height, double fps, int buffers, bool export_dmabuf);
+    void close();
+
+    V4l2Source(const V4l2Source&) = delete;
+    V4l2Source& operator=(const V4l2Source&) = delete;
+};
+
+#endif
@@ -0,0 +1,217 @@
+#include "yolo_kernels.hpp"
+#include <algorithm>
+#include <cmath>
+#if defined(__x86_64__) || defined(__i386__)
+#define YOLO_X86 1
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define YOLO_NEON 1
+#include <arm_neon.h>
+#endif
+
+
+namespace {
+
+// ---------------- scalar
+
+float rowMaxScalar(const float* row, int n)
+{
+    float m = -INFINITY;
+    for (int i = 0; i < n; i++)
+        m = std::max(m, row[i]);
+    return m;
+}
+
+inline bool overlaps(const BoxSoA& s, int i, int j, float thresh)
+{
+    float w = std::max(0.0f, std::min(s.x2[i], s.x2[j]) - std::max(s.x1[i], s.x1[j]));
+    float h = std::max(0.0f, std::min(s.y2[i], s.y2[j]) - std::max(s.y1[i], s.y1[j]));
+    float inter = w * h;
+    float uni = s.area[i] + s.area[j] - inter;
+    return uni > 0.0f && inter > thresh * uni;
+}
+
+void suppressScalar(const BoxSoA& s, int i, int begin, float thresh, uint8_t* removed)
+{
+    int32_t label = s.label[i];
+    for (int j = begin; j < s.count; j++) {
+        if (s.label[j] == label && overlaps(s, i, j, thresh))
+            removed[j] = 1;
+    }
+}
+
+// ---------------- x86
+
+#ifdef YOLO_X86
+#ifdef __SSE2__
+float rowMaxSse2(const float* row, int n)
+{
+    __m128 m = _mm_set1_ps(-INFINITY);
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        m = _mm_max_ps(m, _mm_loadu_ps(row + i));
+    m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(1, 0, 3, 2)));
+    m = _mm_max_ps(m, _mm_shuffle_ps(m, m, _MM_SHUFFLE(2, 3, 0, 1)));
+    float r = _mm_cvtss_f32(m);
+    for (; i < n; i++)
+        r = std::max(r, row[i]);
+    return r;
+}
+
+void suppressSse2(const BoxSoA& s, int i, int begin, float thresh, uint8_t* removed)
+{
+    const __m128  zero = _mm_setzero_ps();
+    const __m128  t    = _mm_set1_ps(thresh);
+    const __m128  x1 = _mm_set1_ps(s.x1[i]), y1 = _mm_set1_ps(s.y1[i]);
+    const __m128  x2 = _mm_set1_ps(s.x2[i]), y2 = _mm_set1_ps(s.y2[i]);
+    const __m128  ai = _mm_set1_ps(s.area[i]);
+    const __m128i li = _mm_set1_epi32(s.label[i]);
+
+    for (int j = begin; j < s.count; j += 4) {
+        __m128 w = _mm_max_ps(zero, _mm_sub_ps(_mm_min_ps(x2, _mm_loadu_ps(s.x2 + j)),
+                                               _mm_max_ps(x1, _mm_loadu_ps(s.x1 + j))));
+        __m128 h = _mm_max_ps(zero, _mm_sub_ps(_mm_min_ps(y2, _mm_loadu_ps(s.y2 + j)),
+                                               _mm_max_ps(y1, _mm_loadu_ps(s.y1 + j))));
+        __m128 inter = _mm_mul_ps(w, h);
+        __m128 uni   = _mm_sub_ps(_mm_add_ps(ai, _mm_loadu_ps(s.area + j)), inter);
+        __m128 hit   = _mm_and_ps(_mm_cmpgt_ps(uni, zero), _mm_cmpgt_ps(inter, _mm_mul_ps(t, uni)));
+        __m128i same = _mm_cmpeq_epi32(li, _mm_loadu_si128(reinterpret_cast<const __m128i*>(s.label + j)));
+        int mask = _mm_movemask_ps(_mm_and_ps(hit, _mm_castsi128_ps(same)));
+        while (mask) {
+            removed[j + __builtin_ctz(mask)] = 1;
+            mask &= mask - 1;
+        }
+    }
+}
+#endif
+
+__attribute__((target("avx2")))
+float rowMaxAvx2(const float* row, int n)
+{
+    __m256 m = _mm256_set1_ps(-INFINITY);
+    int i = 0;
+    for (; i + 8 <= n; i += 8)
+        m = _mm256_max_ps(m, _mm256_loadu_ps(row + i));
+    __m128 h = _mm_max_ps(_mm256_castps256_ps128(m), _mm256_extractf128_ps(m, 1));
+    h = _mm_max_ps(h, _mm_shuffle_ps(h, h, _MM_SHUFFLE(1, 0, 3, 2)));
+    h = _mm_max_ps(h, _mm_shuffle_ps(h, h, _MM_SHUFFLE(2, 3, 0, 1)));
+    float r = _mm_cvtss_f32(h);
+    for (; i < n; i++)
+        r = std::max(r, row[i]);
+    return r;
+}
+
+__attribute__((target("avx2")))
+void suppressAvx2(const BoxSoA& s, int i, int begin, float thresh, uint8_t* removed)
+{
+    const __m256  zero = _mm256_setzero_ps();
+    const __m256  t    = _mm256_set1_ps(thresh);
+    const __m256  x1 = _mm256_set1_ps(s.x1[i]), y1 = _mm256_set1_ps(s.y1[i]);
+    const __m256  x2 = _mm256_set1_ps(s.x2[i]), y2 = _mm256_set1_ps(s.y2[i]);
+    const __m256  ai = _mm256_set1_ps(s.area[i]);
+    const __m256i li = _mm256_set1_epi32(s.label[i]);
+
+    for (int j = begin; j < s.count; j += 8) {
+        __m256 w = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_min_ps(x2, _mm256_loadu_ps(s.x2 + j)),
+                                                     _mm256_max_ps(x1, _mm256_loadu_ps(s.x1 + j))));
+        __m256 h = _mm256_max_ps(zero, _mm256_sub_ps(_mm256_min_ps(y2, _mm256_loadu_ps(s.y2 + j)),
+                                                     _mm256_max_ps(y1, _mm256_loadu_ps(s.y1 + j))));
+        __m256 inter = _mm256_mul_ps(w, h);
+        __m256 uni   = _mm256_sub_ps(_mm256_add_ps(ai, _mm256_loadu_ps(s.area + j)), inter);
+        __m256 hit   = _mm256_and_ps(_mm256_cmp_ps(uni, zero, _CMP_GT_OQ),
+                                     _mm256_cmp_ps(inter, _mm256_mul_ps(t, uni), _CMP_GT_OQ));
+        __m256i same = _mm256_cmpeq_epi32(li, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s.label + j)));
+        int mask = _mm256_movemask_ps(_mm256_and_ps(hit, _mm256_castsi256_ps(same)));
+        while (mask) {
+            removed[j + __builtin_ctz(mask)] = 1;
+            mask &= mask - 1;
+        }
+    }
+}
+#endif
+
+// ---------------- ARM
+
+#ifdef YOLO_NEON
+float rowMaxNeon(const float* row, int n)
+{
+    float32x4_t m = vdupq_n_f32(-INFINITY);
+    int i = 0;
+    for (; i + 4 <= n; i += 4)
+        m = vmaxq_f32(m, vld1q_f32(row + i));
+    float32x2_t h = vpmax_f32(vget_low_f32(m), vget_high_f32(m));
+    h = vpmax_f32(h, h);
+    float r = vget_lane_f32(h, 0);
+    for (; i < n; i++)
+        r = std::max(r, row[i]);
+    return r;
+}
+
+void suppressNeon(const BoxSoA& s, int i, int begin, float thresh, uint8_t* removed)
+{
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t t    = vdupq_n_f32(thresh);
+    const float32x4_t x1 = vdupq_n_f32(s.x1[i]), y1 = vdupq_n_f32(s.y1[i]);
+    const float32x4_t x2 = vdupq_n_f32(s.x2[i]), y2 = vdupq_n_f32(s.y2[i]);
+    const float32x4_t ai = vdupq_n_f32(s.area[i]);
+    const int32x4_t   li = vdupq_n_s32(s.label[i]);
+
+    for (int j = begin; j < s.count; j += 4) {
+        float32x4_t w = vmaxq_f32(zero, vsubq_f32(vminq_f32(x2, vld1q_f32(s.x2 + j)),
+                                                  vmaxq_f32(x1, vld1q_f32(s.x1 + j))));
+        float32x4_t h = vmaxq_f32(zero, vsubq_f32(vminq_f32(y2, vld1q_f32(s.y2 + j)),
+                                                  vmaxq_f32(y1, vld1q_f32(s.y1 + j))));
+        float32x4_t inter = vmulq_f32(w, h);
+        float32x4_t uni   = vsubq_f32(vaddq_f32(ai, vld1q_f32(s.area + j)), inter);
+        uint32x4_t  hit   = vandq_u32(vcgtq_f32(uni, zero), vcgtq_f32(inter, vmulq_f32(t, uni)));
+        hit = vandq_u32(hit, vceqq_s32(li, vld1q_s32(s.label + j)));
+
+        // movemask 가 없으므로 64bit 두 개로 확인 (대부분 0)
+        uint64x2_t any = vreinterpretq_u64_u32(hit);
+        if ((vgetq_lane_u64(any, 0) | vgetq_lane_u64(any, 1)) == 0)
+            continue;
+        uint32_t lanes[4];
+        vst1q_u32(lanes, hit);
+        for (int k = 0; k < 4; k++) {
+            if (lanes[k])
+                removed[j + k] = 1;
+        }
+    }
+}
+#endif
+
+} // namespace
+
+
+float rowMax(const float* row, int n, SimdLevel level)
+{
+    switch (level) {
+#ifdef YOLO_X86
+#ifdef __SSE2__
+    case SIMD_SSE2: return rowMaxSse2(row, n);
+#endif
+    case SIMD_AVX2: return rowMaxAvx2(row, n);
+#endif
+#ifdef YOLO_NEON
+    case SIMD_NEON: return rowMaxNeon(row, n);
+#endif
+    default:        return rowMaxScalar(row, n);
+    }
+}
+
+void suppressOverlaps(const BoxSoA& soa, int i, int begin, float iou_thresh, uint8_t* removed, SimdLevel level)
+{
+    switch (level) {
+#ifdef YOLO_X86
+#ifdef __SSE2__
+    case SIMD_SSE2: suppressSse2(soa, i, begin, iou_thresh, removed); break;
+#endif
+    case SIMD_AVX2: suppressAvx2(soa, i, begin, iou_thresh, removed); break;
+#endif
+#ifdef YOLO_NEON
+    case SIMD_NEON: suppressNeon(soa, i, begin, iou_thresh, removed); break;
+#endif
+    default:        suppressScalar(soa, i, begin, iou_thresh, removed); break;
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef YOLO_KERNELS_HPP
+#define YOLO_KERNELS_HPP
+
+#include <cstdint>
+
+#include "simd.hpp"
+
+// YOLO 후처리 hot loop 의 SIMD kernel (SSE2 / AVX2 / NEON / scalar, simd.hpp)
+// scalar 와 SIMD 는 같은 식 (IoU 는 나눗셈 없이 inter > thresh * union) 이라 결과가 같다.
+
+// NMS 입력: score 순으로 정렬된 box 들 (structure of arrays)
+// SIMD 는 끝에서 vector 하나만큼 더 읽으므로 배열은 count + 8 칸, 남는 칸의 label 은 -1
+struct BoxSoA {
+    float*   x1;
+    float*   y1;
+    float*   x2;
+    float*   y2;
+    float*   area;
+    int32_t* label;
+    int      count;
+};
+
+// row[0..n) 최대값
+float rowMax(const float* row, int n, SimdLevel level);
+
+// box i 와 같은 label 이고 IoU > iou_thresh 인 j (begin <= j < soa.count) 의 removed[j] = 1
+void suppressOverlaps(const BoxSoA& soa, int i, int begin, float iou_thresh, uint8_t* removed, SimdLevel level);
+
+#endif
@@ -0,0 +1,156 @@
+#include "yolo_postprocess.hpp"
+#include <algorithm>
+
+
+namespace {
+
+constexpr int SIMD_PAD = 8;   // AVX2 한 vector
+
+} // namespace
+
+
+float iou(const Detection& a, const Detection& b)
+{
+    float y1 = std::max(a.ymin, b.ymin), x1 = std::max(a.xmin, b.xmin);
+    float y2 = std::min(a.ymax, b.ymax), x2 = std::min(a.xmax, b.xmax);
+    float inter = std::max(0.0f, y2 - y1) * std::max(0.0f, x2 - x1);
+    float uni = (a.ymax - a.ymin) * (a.xmax - a.xmin) + (b.ymax - b.ymin) * (b.xmax - b.xmin) - inter;
+    return uni > 0 ? inter / uni : 0.0f;
+}
+
+
+YoloPostprocessor::YoloPostprocessor(int num_boxes, int num_classes, const Config& config)
+    : num_boxes_(num_boxes), num_classes_(num_classes), cfg_(config),
+      level_(config.use_simd ? bestSimdLevel() : SIMD_SCALAR),
+      class_count_(num_classes),
+      x1_(num_boxes + SIMD_PAD), y1_(num_boxes + SIMD_PAD), x2_(num_boxes + SIMD_PAD), y2_(num_boxes + SIMD_PAD),
+      area_(num_boxes + SIMD_PAD), score_(num_boxes + SIMD_PAD), label_(num_boxes + SIMD_PAD),
+      removed_(num_boxes + SIMD_PAD)
+{
+    cand_box_.reserve(num_boxes);
+    cand_score_.reserve(num_boxes);
+    cand_label_.reserve(num_boxes);
+    order_.reserve(num_boxes);
+}
+
+int YoloPostprocessor::run(const float* boxes, const float* scores, Detection* out, int max_out)
+{
+    // 1. threshold: row 최대값만 SIMD 로 보고, 통과한 box 만 argmax (np.argmax 처럼 첫 번째 최대)
+    cand_box_.clear();
+    cand_score_.clear();
+    cand_label_.clear();
+    for (int i = 0; i < num_boxes_; i++) {
+        const float* s = scores + static_cast<size_t>(i) * num_classes_;
+        float best = rowMax(s, num_classes_, level_);
+        if (best < cfg_.score_thresh)
+            continue;
+        int label = 0;
+        while (s[label] != best)
+            label++;
+        cand_box_.push_back(i);
+        cand_score_.push_back(best);
+        cand_label_.push_back(label);
+    }
+
+    // 2. score 순 (같으면 앞 box 먼저), class 당 top_k 개만 SoA 로 decode
+    int n = static_cast<int>(cand_box_.size());
+    order_.resize(n);
+    for (int i = 0; i < n; i++)
+        order_[i] = i;
+    std::sort(order_.begin(), order_.end(), [this](int a, int b) {
+        return cand_score_[a] > cand_score_[b] || (cand_score_[a] == cand_score_[b] && a < b);
+    });
+
+    std::fill(class_count_.begin(), class_count_.end(), 0);
+    int count = 0;
+    for (int k = 0; k < n; k++) {
+        int c = order_[k];
+        int32_t label = cand_label_[c];
+        if (cfg_.top_k > 0 && class_count_[label]++ >= cfg_.top_k)
+            continue;
+
+        const float* b = boxes + static_cast<size_t>(cand_box_[c]) * 4;
+        x1_[count]    = b[0] - b[2] / 2;
+        y1_[count]    = b[1] - b[3] / 2;
+        x2_[count]    = b[0] + b[2] / 2;
+        y2_[count]    = b[1] + b[3] / 2;
+        area_[count]  = (y2_[count] - y1_[count]) * (x2_[count] - x1_[count]);
+        score_[count] = cand_score_[c];
+        label_[count] = label;
+        count++;
+    }
+    for (int k = count; k < count + SIMD_PAD; k++) {
+        x1_[k] = y1_[k] = x2_[k] = y2_[k] = area_[k] = 0.0f;
+        label_[k] = -1;
+    }
+
+    // 3. NMS
+    BoxSoA soa;
+    soa.x1 = &x1_[0];
+    soa.y1 = &y1_[0];
+    soa.x2 = &x2_[0];
+    soa.y2 = &y2_[0];
+    soa.area  = &area_[0];
+    soa.label = &label_[0];
+    soa.count = count;
+    std::fill(removed_.begin(), removed_.begin() + count + SIMD_PAD, 0);
+
+    int kept = 0;
+    for (int i = 0; i < count && kept < max_out; i++) {
+        if (removed_[i])
+            continue;
+        Detection& d = out[kept++];
+        d.xmin  = x1_[i];
+        d.ymin  = y1_[i];
+        d.xmax  = x2_[i];
+        d.ymax  = y2_[i];
+        d.score = score_[i];
+        d.label = label_[i];
+        suppressOverlaps(soa, i, i + 1, cfg_.iou_thresh, &removed_[0], level_);
+    }
+    return kept;
+}
+
+
+// ---- Python(ctypes) 용 C API
+
+void* yolo_post_create(int num_boxes, int num_classes, float score_thresh, float iou_thresh,
+                       int top_k, int use_simd)
+{
+    YoloPostprocessor::Config cfg;
+    cfg.score_thresh = score_thresh;
+    cfg.iou_thresh   = iou_thresh;
+    cfg.top_k        = top_k;
+    cfg.use_simd     = use_simd != 0;
+    return new YoloPostprocessor(num_boxes, num_classes, cfg);
+}
+
+int yolo_post_run(void* handle, const float* boxes, const float* scores,
+                  float* out_boxes, float* out_scores, int32_t* out_labels, int max_out)
+{
+    if (!handle || max_out <= 0)
+        return 0;
+
+    const int STACK_MAX = 256;
+    Detection dets[STACK_MAX];
+    int n = static_cast<YoloPostprocessor*>(handle)->run(boxes, scores, dets, std::min(max_out, STACK_MAX));
+    for (int i = 0; i < n; i++) {
+        out_boxes[i * 4 + 0] = dets[i].ymin;
+        out_boxes[i * 4 + 1] = dets[i].xmin;
+        out_boxes[i * 4 + 2] = dets[i].ymax;
+        out_boxes[i * 4 + 3] = dets[i].xmax;
+        out_scores[i] = dets[i].score;
+        out_labels[i] = dets[i].label;
+    }
+    return n;
+}
+
+const char* yolo_post_simd(void* handle)
+{
+    return handle ? simdName(static_cast<YoloPostprocessor*>(handle)->simdLevel()) : "none";
+}
+
+void yolo_post_destroy(void* handle)
+{
+    delete static_cast<YoloPostprocessor*>(handle);
+}
@@ -0,0 +1,73 @@
+#ifndef YOLO_POSTPROCESS_HPP
+#define YOLO_POSTPROCESS_HPP
+
+#include "yolo_kernels.hpp"
+#include <cstdint>
+#include <vector>
+
+// 검출 결과 하나 (입력 이미지 좌표)
+struct Detection {
+    float ymin, xmin, ymax, xmax;
+    float score;
+    int   label;     // COCO class id
+};
+
+// tflite_yolo_picam.py 의 filter_boxes + nms 와 같은 결과
+// 1. box 마다 최고 score class (SIMD row max, 대부분 여기서 threshold 로 걸러짐)
+// 2. 남은 box 를 decode (cx,cy,w,h → 모서리) 해서 score 순 정렬, class 마다 top_k 개까지
+// 3. structure-of-arrays 로 모아 NMS: 남긴 box 하나와 나머지 전부의 IoU 를 SIMD 로 한 번에
+// scratch 는 생성할 때 잡아 두므로 run() 에서 할당 없음
+class YoloPostprocessor {
+public:
+    struct Config {
+        float score_thresh = 0.2f;
+        float iou_thresh   = 0.3f;
+        int   top_k        = 100;     // class 당 NMS 에 넣을 최대 box 수 (0: 제한 없음)
+        bool  use_simd     = true;    // false: scalar (비교용)
+    };
+
+    YoloPostprocessor(int num_boxes, int num_classes, const Config& config);
+    YoloPostprocessor(int num_boxes, int num_classes) : YoloPostprocessor(num_boxes, num_classes, Config()) {}
+
+    // boxes [num_boxes][4] (cx, cy, w, h), scores [num_boxes][num_classes]
+    // out 에 최대 max_out 개 (score 높은 순), 개수 반환
+    int run(const float* boxes, const float* scores, Detection* out, int max_out);
+
+    SimdLevel simdLevel() const { return level_; }
+    int candidates() const { return static_cast<int>(cand_box_.size()); }   // 직전 run 의 threshold 통과 수
+
+private:
+    int num_boxes_;
+    int num_classes_;
+    Config cfg_;
+    SimdLevel level_;
+
+    // threshold 통과한 box
+    std::vector<int>     cand_box_;
+    std::vector<float>   cand_score_;
+    std::vector<int32_t> cand_label_;
+    std::vector<int>     order_;
+    std::vector<int>     class_count_;
+
+    // NMS 용 SoA (score 순)
+    std::vector<float>   x1_, y1_, x2_, y2_, area_, score_;
+    std::vector<int32_t> label_;
+    std::vector<uint8_t> removed_;
+};
+
+// 두 box 의 IoU (Python iou() 와 같은 식)
+float iou(const Detection& a, const Detection& b);
+
+
+// ---- Python(ctypes) 용 C API
+// out_boxes 는 [max_out][4] (ymin, xmin, ymax, xmax), filter_boxes 반환값과 같은 순서
+extern "C" {
+    void* yolo_post_create(int num_boxes, int num_classes, float score_thresh, float iou_thresh,
+                           int top_k, int use_simd);
+    int   yolo_post_run(void* handle, const float* boxes, const float* scores,
+                        float* out_boxes, float* out_scores, int32_t* out_labels, int max_out);
+    const char* yolo_post_simd(void* handle);
+    void  yolo_post_destroy(void* handle);
+}
+
+#endif